@@ -5,7 +5,16 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include <sea-turtle/allocator.h>
 #include <sea-turtle/integer.h>
+#include <sea-turtle/rope.h>
 #include <sea-turtle/string.h>
+#include <sea-turtle/string_arena.h>
+#include <sea-turtle/string_builder.h>
+#include <sea-turtle/string_cursor.h>
+#include <sea-turtle/string_dictionary.h>
+#include <sea-turtle/string_map.h>
+#include <sea-turtle/string_pool.h>
+#include <sea-turtle/string_view.h>
 
 #endif /* _SEA_TURTLE_SEA_TURTLE_H_ */
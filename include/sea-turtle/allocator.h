@@ -0,0 +1,71 @@
+#ifndef _SEA_TURTLE_ALLOCATOR_H_
+#define _SEA_TURTLE_ALLOCATOR_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sea-urchin.h>
+
+#define SEA_TURTLE_ALLOCATOR_ERROR_OBJECT_IS_INVALID \
+    SEA_URCHIN_ERROR_VALUE_IS_INVALID
+#define SEA_TURTLE_ALLOCATOR_ERROR_OUT_IS_NULL \
+    SEA_URCHIN_ERROR_OUT_IS_NULL
+
+/**
+ * @brief Memory allocator used by strings and integers.
+ * <p>Every function receives <b>context</b> as its first argument so that a
+ * single set of functions may serve many arenas or pools.</p>
+ * <p><b>allocate</b> returns a block of at least <b>size</b> bytes suitably
+ * aligned for any type, or <i>NULL</i> on failure. <b>reallocate</b>
+ * resizes the block at <b>ptr</b>, whose size is <b>size</b>, to
+ * <b>new_size</b> bytes preserving its contents, or returns <i>NULL</i> on
+ * failure leaving the block untouched. <b>deallocate</b> releases the block
+ * at <b>ptr</b>, whose size is <b>size</b>, and is never given
+ * <i>NULL</i>.</p>
+ */
+struct sea_turtle_allocator {
+    void *(*allocate)(void *context, size_t size);
+    void *(*reallocate)(void *context, void *ptr, size_t size,
+                        size_t new_size);
+    void (*deallocate)(void *context, void *ptr, size_t size);
+    void *context;
+};
+
+/**
+ * @brief Set the allocator of the calling thread.
+ * <p>Strings, string builders, string arenas, ropes, string dictionaries,
+ * string maps, string pools and integers allocate memory through the
+ * allocator of the thread they are used in, which by default is the C
+ * library's, maps and pools using the allocator that was current when they
+ * were initialized. Except for integers, memory remembers the allocator it
+ * was allocated from and is resized and released through that allocator
+ * whichever thread does so. Integers must only be modified or invalidated
+ * while the allocator that was current when they were initialized is
+ * current. Objects whose memory is released wholesale, for instance by
+ * resetting a request scoped arena, need never be invalidated. String
+ * pools always use the default allocator for the strings they intern as
+ * those outlive any scope, and so does the code point index built by
+ * sea_turtle_string_at() as any thread reading a string may build it.</p>
+ * <p>Integers are wired through GMP's memory functions which are replaced
+ * process wide on the first call. Integer operations abort if the allocator
+ * fails, as GMP requires.</p>
+ * <p>The allocator is not copied and must remain valid while it is current
+ * or any memory allocated from it is in use.</p>
+ * @param [in] object allocator to use or <i>NULL</i> for the default
+ * allocator.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_ALLOCATOR_ERROR_OBJECT_IS_INVALID if any of the
+ * functions of the allocator is <i>NULL</i>.
+ */
+int sea_turtle_allocator_set(const struct sea_turtle_allocator *object);
+
+/**
+ * @brief Retrieve the allocator of the calling thread.
+ * @param [out] out receive the allocator or <i>NULL</i> if the default
+ * allocator is in use.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_ALLOCATOR_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ */
+int sea_turtle_allocator_get(const struct sea_turtle_allocator **out);
+
+#endif /* _SEA_TURTLE_ALLOCATOR_H_ */
@@ -0,0 +1,250 @@
+#ifndef _SEA_TURTLE_ROPE_H_
+#define _SEA_TURTLE_ROPE_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sea-urchin.h>
+
+#define SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL \
+    SEA_URCHIN_ERROR_OBJECT_IS_NULL
+#define SEA_TURTLE_ROPE_ERROR_OTHER_IS_NULL \
+    SEA_URCHIN_ERROR_OTHER_IS_NULL
+#define SEA_TURTLE_ROPE_ERROR_STRING_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define SEA_TURTLE_ROPE_ERROR_OUT_IS_NULL \
+    SEA_URCHIN_ERROR_OUT_IS_NULL
+#define SEA_TURTLE_ROPE_ERROR_ROPE_IS_EMPTY \
+    SEA_URCHIN_ERROR_IS_EMPTY
+#define SEA_TURTLE_ROPE_ERROR_MEMORY_ALLOCATION_FAILED \
+    SEA_URCHIN_ERROR_MEMORY_ALLOCATION_FAILED
+#define SEA_TURTLE_ROPE_ERROR_AT_IS_NULL \
+    SEA_URCHIN_ERROR_ITEM_IS_NULL
+#define SEA_TURTLE_ROPE_ERROR_INDEX_IS_OUT_OF_BOUNDS \
+    SEA_URCHIN_ERROR_ITEM_IS_OUT_OF_BOUNDS
+#define SEA_TURTLE_ROPE_ERROR_COUNT_IS_OUT_OF_BOUNDS \
+    SEA_URCHIN_ERROR_VALUE_IS_OUT_OF_BOUNDS
+#define SEA_TURTLE_ROPE_ERROR_END_OF_SEQUENCE \
+    SEA_URCHIN_ERROR_END_OF_SEQUENCE
+
+/**
+ * @brief Number of bytes a leaf of a rope is filled up to.
+ */
+#define SEA_TURTLE_ROPE_LEAF_SIZE 1024
+
+struct sea_turtle_string;
+struct sea_turtle_rope_node;
+
+/**
+ * @brief UTF-8 encoded text stored as a balanced tree of strings.
+ * <p>The leaves of the tree are slices of strings with shared buffers and
+ * every node keeps the count of code points below it. Inserting, removing,
+ * splitting and concatenating therefore take logarithmic time regardless of
+ * the length of the text, and no more than a leaf worth of bytes is ever
+ * copied.</p>
+ */
+struct sea_turtle_rope {
+    struct sea_turtle_rope_node *root;
+    struct sea_turtle_rope_node *spare;
+    size_t spares;
+};
+
+/**
+ * @brief Position of an UTF-8 encoded symbol within a rope.
+ * <p>Iterators are invalidated by any modification of the rope.</p>
+ */
+struct sea_turtle_rope_iterator {
+    /* current UTF-8 encoded symbol */
+    const uint8_t *at;
+    /* end of the leaf containing the current UTF-8 encoded symbol */
+    const uint8_t *end;
+    /* code point index of the current UTF-8 encoded symbol */
+    uintmax_t index;
+};
+
+/**
+ * @brief Initialize empty rope.
+ * @param [in] object instance to be initialized.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ */
+int sea_turtle_rope_init(struct sea_turtle_rope *object);
+
+/**
+ * @brief Initialize rope from string.
+ * <p>The value of <b>string</b> is copied at most once and divided into
+ * leaves of about SEA_TURTLE_ROPE_LEAF_SIZE bytes referring to the copy.
+ * If the buffer of <b>string</b> is shared it is not copied at all.</p>
+ * @param [in] object instance to be initialized.
+ * @param [in] string whose value we will copy.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_ROPE_ERROR_STRING_IS_NULL if string is <i>NULL</i>.
+ * @throws SEA_TURTLE_ROPE_ERROR_MEMORY_ALLOCATION_FAILED if there is
+ * insufficient memory to initialize the rope instance.
+ */
+int sea_turtle_rope_init_string(struct sea_turtle_rope *object,
+                                const struct sea_turtle_string *string);
+
+/**
+ * @brief Invalidate rope.
+ * <p>The actual <u>rope instance is not deallocated</u> since it may have
+ * been embedded in a larger structure.</p>
+ * @param [in] object instance to be invalidated.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ */
+int sea_turtle_rope_invalidate(struct sea_turtle_rope *object);
+
+/**
+ * @brief Retrieve the string value of the rope.
+ * <p>A rope consisting of a single leaf that spans a whole shared buffer
+ * is converted without copying.</p>
+ * @param [in] object rope instance.
+ * @param [out] out receive the initialized string instance.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_ROPE_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws SEA_TURTLE_ROPE_ERROR_MEMORY_ALLOCATION_FAILED if there is
+ * insufficient memory to initialize the string instance.
+ */
+int sea_turtle_rope_to_string(const struct sea_turtle_rope *object,
+                              struct sea_turtle_string *out);
+
+/**
+ * @brief Receive the count of code points.
+ * @param [in] object rope instance.
+ * @param [out] out receive the count of code points.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_ROPE_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ */
+int sea_turtle_rope_count(const struct sea_turtle_rope *object,
+                          uintmax_t *out);
+
+/**
+ * @brief Insert string.
+ * @param [in] object rope instance.
+ * @param [in] index code point index at which string is inserted.
+ * @param [in] string whose value we will insert.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_ROPE_ERROR_STRING_IS_NULL if string is <i>NULL</i>.
+ * @throws SEA_TURTLE_ROPE_ERROR_INDEX_IS_OUT_OF_BOUNDS if index is greater
+ * than the count of code points.
+ * @throws SEA_TURTLE_ROPE_ERROR_MEMORY_ALLOCATION_FAILED if there is
+ * insufficient memory to insert the string.
+ */
+int sea_turtle_rope_insert(struct sea_turtle_rope *object,
+                           uintmax_t index,
+                           const struct sea_turtle_string *string);
+
+/**
+ * @brief Remove code points.
+ * @param [in] object rope instance.
+ * @param [in] index code point index of the first code point to remove.
+ * @param [in] count number of code points to remove.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_ROPE_ERROR_INDEX_IS_OUT_OF_BOUNDS if index is greater
+ * than the count of code points.
+ * @throws SEA_TURTLE_ROPE_ERROR_COUNT_IS_OUT_OF_BOUNDS if there are fewer
+ * than count code points from index onwards.
+ * @throws SEA_TURTLE_ROPE_ERROR_MEMORY_ALLOCATION_FAILED if there is
+ * insufficient memory to remove the code points.
+ */
+int sea_turtle_rope_remove(struct sea_turtle_rope *object,
+                           uintmax_t index,
+                           uintmax_t count);
+
+/**
+ * @brief Append rope.
+ * <p>The contents of <b>other</b> are moved to the end of <b>object</b>
+ * leaving <b>other</b> empty.</p>
+ * @param [in] object rope instance.
+ * @param [in] other rope instance whose contents are appended.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_ROPE_ERROR_OTHER_IS_NULL if other is <i>NULL</i>.
+ * @throws SEA_TURTLE_ROPE_ERROR_MEMORY_ALLOCATION_FAILED if there is
+ * insufficient memory to append the rope.
+ */
+int sea_turtle_rope_concat(struct sea_turtle_rope *object,
+                           struct sea_turtle_rope *other);
+
+/**
+ * @brief Split rope.
+ * <p>The code points from <b>index</b> onwards are moved from
+ * <b>object</b> to <b>out</b>.</p>
+ * @param [in] object rope instance.
+ * @param [in] index code point index at which the rope is split.
+ * @param [out] out receive the initialized rope instance.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_ROPE_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws SEA_TURTLE_ROPE_ERROR_INDEX_IS_OUT_OF_BOUNDS if index is greater
+ * than the count of code points.
+ * @throws SEA_TURTLE_ROPE_ERROR_MEMORY_ALLOCATION_FAILED if there is
+ * insufficient memory to split the rope.
+ */
+int sea_turtle_rope_split(struct sea_turtle_rope *object,
+                          uintmax_t index,
+                          struct sea_turtle_rope *out);
+
+/**
+ * @brief Retrieve the first UTF-8 encoded symbol.
+ * @param [in] object rope instance.
+ * @param [out] out receive the iterator positioned at the first UTF-8
+ * encoded symbol.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_ROPE_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws SEA_TURTLE_ROPE_ERROR_ROPE_IS_EMPTY if rope is empty.
+ */
+int sea_turtle_rope_first(const struct sea_turtle_rope *object,
+                          struct sea_turtle_rope_iterator *out);
+
+/**
+ * @brief Retrieve the UTF-8 encoded symbol at code point index.
+ * @param [in] object rope instance.
+ * @param [in] index code point index.
+ * @param [out] out receive the iterator positioned at the UTF-8 encoded
+ * symbol.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_ROPE_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws SEA_TURTLE_ROPE_ERROR_INDEX_IS_OUT_OF_BOUNDS if index is not less
+ * than the count of code points.
+ */
+int sea_turtle_rope_at(const struct sea_turtle_rope *object,
+                       uintmax_t index,
+                       struct sea_turtle_rope_iterator *out);
+
+/**
+ * @brief Advance to the next UTF-8 encoded symbol.
+ * @param [in] object rope instance.
+ * @param [in] at iterator to advance.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_ROPE_ERROR_AT_IS_NULL if at is <i>NULL</i>.
+ * @throws SEA_TURTLE_ROPE_ERROR_END_OF_SEQUENCE if there are no more UTF-8
+ * encoded symbols.
+ */
+int sea_turtle_rope_next(const struct sea_turtle_rope *object,
+                         struct sea_turtle_rope_iterator *at);
+
+/**
+ * @brief Get code point from UTF-8 encoded symbol.
+ * @param [in] object rope instance.
+ * @param [in] at iterator positioned at the UTF-8 encoded symbol.
+ * @param [out] out receive the code point for the UTF-8 encoded symbol.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_ROPE_ERROR_AT_IS_NULL if at is <i>NULL</i>.
+ * @throws SEA_TURTLE_ROPE_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ */
+int sea_turtle_rope_code_point(const struct sea_turtle_rope *object,
+                               const struct sea_turtle_rope_iterator *at,
+                               uint32_t *out);
+
+#endif /* _SEA_TURTLE_ROPE_H_ */
@@ -30,12 +30,131 @@
     SEA_URCHIN_ERROR_VALUE_IS_INVALID
 #define SEA_TURTLE_STRING_ERROR_END_OF_SEQUENCE \
     SEA_URCHIN_ERROR_END_OF_SEQUENCE
+#define SEA_TURTLE_STRING_ERROR_INDEX_IS_OUT_OF_BOUNDS \
+    SEA_URCHIN_ERROR_ITEM_IS_OUT_OF_BOUNDS
+#define SEA_TURTLE_STRING_ERROR_COUNT_IS_OUT_OF_BOUNDS \
+    SEA_URCHIN_ERROR_VALUE_IS_OUT_OF_BOUNDS
+#define SEA_TURTLE_STRING_ERROR_FD_IS_INVALID \
+    SEA_URCHIN_ERROR_ITEM_IS_INVALID
+#define SEA_TURTLE_STRING_ERROR_OFFSET_IS_OUT_OF_BOUNDS \
+    SEA_URCHIN_ERROR_VALUE_IS_OUT_OF_BOUNDS
+#define SEA_TURTLE_STRING_ERROR_NEEDLE_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define SEA_TURTLE_STRING_ERROR_NEEDLE_NOT_FOUND \
+    SEA_URCHIN_ERROR_VALUE_NOT_FOUND
+#define SEA_TURTLE_STRING_ERROR_OTHERS_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define SEA_TURTLE_STRING_ERROR_OTHER_NOT_FOUND \
+    SEA_URCHIN_ERROR_VALUE_NOT_FOUND
+#define SEA_TURTLE_STRING_ERROR_CODE_POINTS_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define SEA_TURTLE_STRING_ERROR_CODE_POINT_IS_INVALID \
+    SEA_URCHIN_ERROR_VALUE_IS_INVALID
+#define SEA_TURTLE_STRING_ERROR_UTF16_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define SEA_TURTLE_STRING_ERROR_UTF16_IS_MALFORMED \
+    SEA_URCHIN_ERROR_VALUE_IS_INVALID
+#define SEA_TURTLE_STRING_ERROR_ORDER_IS_INVALID \
+    SEA_URCHIN_ERROR_VALUE_IS_INVALID
+#define SEA_TURTLE_STRING_ERROR_SIZE_IS_TOO_SMALL \
+    SEA_URCHIN_ERROR_VALUE_IS_OUT_OF_BOUNDS
+#define SEA_TURTLE_STRING_ERROR_DELIMITER_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define SEA_TURTLE_STRING_ERROR_DELIMITER_IS_EMPTY \
+    SEA_URCHIN_ERROR_IS_EMPTY
+#define SEA_TURTLE_STRING_ERROR_BUFFER_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define SEA_TURTLE_STRING_ERROR_BUFFER_IS_MALFORMED \
+    SEA_URCHIN_ERROR_VALUE_IS_INVALID
+#define SEA_TURTLE_STRING_ERROR_LOAD_IS_INVALID \
+    SEA_URCHIN_ERROR_VALUE_IS_INVALID
+#define SEA_TURTLE_STRING_ERROR_COUNT_IS_INVALID \
+    SEA_URCHIN_ERROR_VALUE_IS_INVALID
+
+/**
+ * @brief Largest size, including the <i>NULL</i> terminator, of an UTF-8
+ * sequence that is stored within the string instance itself.
+ */
+#define SEA_TURTLE_STRING_LOCAL_SIZE 23
 
+enum sea_turtle_string_storage {
+    /* data refers to a heap allocated buffer */
+    SEA_TURTLE_STRING_STORAGE_HEAP = 0,
+    /* the bytes are stored in the local buffer of the string instance */
+    SEA_TURTLE_STRING_STORAGE_LOCAL,
+    /* data refers to an immutable reference counted heap allocated buffer */
+    SEA_TURTLE_STRING_STORAGE_SHARED,
+    /* data refers to an immutable buffer owned by an arena or the caller */
+    SEA_TURTLE_STRING_STORAGE_ARENA,
+    /* data refers to a read-only private mapping of a file region */
+    SEA_TURTLE_STRING_STORAGE_MAPPED
+};
+
+enum sea_turtle_string_order {
+    /* by size first then byte by byte, as sea_turtle_string_compare() */
+    SEA_TURTLE_STRING_ORDER_SIZE = 0,
+    /* byte by byte, which for UTF-8 is the order of the code points */
+    SEA_TURTLE_STRING_ORDER_BYTES
+};
+
+enum sea_turtle_string_load {
+    /* validated and counted again as when initialized from chars */
+    SEA_TURTLE_STRING_LOAD_VALIDATE = 0,
+    /* copied as they are once the checksum has been verified */
+    SEA_TURTLE_STRING_LOAD_TRUSTED,
+    /* like trusted but referring to the buffer rather than to copies */
+    SEA_TURTLE_STRING_LOAD_IN_PLACE
+};
+
+enum sea_turtle_string_byte_order {
+    /* UTF-16LE, least significant byte of a code unit first */
+    SEA_TURTLE_STRING_BYTE_ORDER_LITTLE_ENDIAN = 0,
+    /* UTF-16BE, most significant byte of a code unit first */
+    SEA_TURTLE_STRING_BYTE_ORDER_BIG_ENDIAN
+};
+
+/**
+ * @brief Number of code points between the samples of the code point index.
+ */
+#define SEA_TURTLE_STRING_INDEX_INTERVAL 64
+
+struct sea_turtle_string_view;
+
+/**
+ * @brief UTF-8 encoded string.
+ * <p>UTF-8 sequences of up to SEA_TURTLE_STRING_LOCAL_SIZE bytes, including
+ * the <i>NULL</i> terminator, are stored in the <b>local</b> buffer of the
+ * string instance rather than on the heap, in the space otherwise taken by
+ * <b>data</b>, <b>hash</b> and the count of code points. Whether a string
+ * is stored locally follows from its <b>size</b> alone. The string instance
+ * holds no pointer into itself and may therefore be copied with assignment
+ * or memcpy(3). The hash codes of local strings are not cached as they are
+ * cheap to compute again.</p>
+ * <p>The count of code points is only to be read with
+ * sea_turtle_string_count() as the word holding it also holds the storage
+ * of strings that are not stored locally, keeping the string instance at
+ * 32 bytes. Heap buffers are preceded by a header holding their capacity
+ * and the code point index built by sea_turtle_string_at().</p>
+ * <p>Strings whose buffer has been shared using sea_turtle_string_share()
+ * are copied by sea_turtle_string_init_string() in constant time without
+ * memory allocation.</p>
+ */
 struct sea_turtle_string {
-    uint8_t *data;
+    union {
+        struct {
+            uint8_t *data;
+            /* 0 until computed by sea_turtle_string_hash() */
+            uintmax_t hash;
+            /* count of code points with the storage in its top 3 bits */
+            uintmax_t tagged_count;
+        };
+        struct {
+            uint8_t local[SEA_TURTLE_STRING_LOCAL_SIZE];
+            /* count of code points of a string stored locally */
+            uint8_t local_count;
+        };
+    };
     size_t size;
-    uintmax_t count;
-    uintmax_t hash;
 };
 
 /**
@@ -51,6 +170,26 @@ struct sea_turtle_string {
 int sea_turtle_string_init_string(struct sea_turtle_string *object,
                                   const struct sea_turtle_string *other);
 
+/**
+ * @brief Share the buffer of the string.
+ * <p>The buffer is made immutable and reference counted so that copies made
+ * with sea_turtle_string_init_string() refer to the same buffer. The
+ * reference count is updated atomically allowing copies to be made and
+ * invalidated concurrently from multiple threads. A private copy of the
+ * buffer is only made once a shared string needs to be modified.</p>
+ * <p>Strings stored in their local buffer are left as is since copying them
+ * does not require any memory allocation. Heap buffers are shared in place,
+ * also without memory allocation. Strings whose buffer is owned by
+ * a string arena or mapped from a file are given a shared copy of it so
+ * that they no longer depend on the arena or the file.</p>
+ * @param [in] object string instance.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED if there is
+ * insufficient memory to share the buffer.
+ */
+int sea_turtle_string_share(struct sea_turtle_string *object);
+
 /**
  * @brief Initialize string with an UTF-8 sequence.
  * <p>The string instance will be initialized with the contents of the UTF-8
@@ -74,6 +213,86 @@ int sea_turtle_string_init(struct sea_turtle_string *object,
                            size_t size,
                            size_t *out);
 
+/**
+ * @brief Initialize string with the UTF-8 sequence stored in a file.
+ * <p>The file region is mapped into memory rather than copied, read
+ * sequentially once to validate and count it, and then kept read-only.
+ * Like sea_turtle_string_init() the string ends at the first <i>NULL</i>
+ * char occurrence or after <b>size</b> chars, or at the end of the file.
+ * Regions short enough to be stored within the string instance itself are
+ * copied and unmapped right away.</p>
+ * <p>Modifying the string with sea_turtle_string_set_size() copies it out
+ * of the mapping and sea_turtle_string_invalidate() unmaps it. The file must
+ * not be truncated while the string refers to it, while the file descriptor
+ * may be closed as soon as this function returns.</p>
+ * @param [in] object instance to be initialized.
+ * @param [in] fd file descriptor of a regular file open for reading.
+ * @param [in] offset offset in bytes of the region within the file.
+ * @param [in] size upper limit in the number of chars to read up to.
+ * @param [out] out receive the number of chars we have read up to.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_SIZE_IS_ZERO is size is zero.
+ * @throws SEA_TURTLE_STRING_ERROR_FD_IS_INVALID if fd does not refer to a
+ * regular file that can be mapped for reading.
+ * @throws SEA_TURTLE_STRING_ERROR_OFFSET_IS_OUT_OF_BOUNDS if offset is past
+ * the end of the file.
+ * @throws SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_MALFORMED if the file region
+ * does not hold a valid UTF-8 sequence.
+ * @throws SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED if there is
+ * insufficient address space to map the file region.
+ */
+int sea_turtle_string_init_file(struct sea_turtle_string *object,
+                                int fd,
+                                uintmax_t offset,
+                                size_t size,
+                                size_t *out);
+
+/**
+ * @brief Initialize string with code points.
+ * <p>Runs of ASCII code points are encoded a block at a time using the
+ * widest vector instructions the CPU supports.</p>
+ * @param [in] object instance to be initialized.
+ * @param [in] code_points code points to encode.
+ * @param [in] count number of code points.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_CODE_POINTS_IS_NULL if code_points is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_CODE_POINT_IS_INVALID if any code point is
+ * <i>0</i>, a surrogate or greater than <i>0x10FFFF</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED if there is
+ * insufficient memory to initialize the string instance.
+ */
+int sea_turtle_string_init_code_points(struct sea_turtle_string *object,
+                                       const uint32_t *code_points,
+                                       size_t count);
+
+/**
+ * @brief Initialize string with UTF-16 code units.
+ * <p>The code units are validated and measured first so that the UTF-8
+ * sequence is allocated once. Runs of ASCII code units are transcoded a
+ * block at a time using the widest vector instructions the CPU
+ * supports.</p>
+ * @param [in] object instance to be initialized.
+ * @param [in] utf16 first code unit, which does not need to be aligned.
+ * @param [in] count number of code units.
+ * @param [in] order byte order of the code units.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_UTF16_IS_NULL if utf16 is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_ORDER_IS_INVALID if order is not a byte
+ * order.
+ * @throws SEA_TURTLE_STRING_ERROR_UTF16_IS_MALFORMED if a surrogate is not
+ * paired or a code unit is <i>0</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED if there is
+ * insufficient memory to initialize the string instance.
+ */
+int sea_turtle_string_init_utf16(struct sea_turtle_string *object,
+                                 const void *utf16,
+                                 size_t count,
+                                 enum sea_turtle_string_byte_order order);
+
 /**
  * @brief Invalidate string.
  * <p>The actual <u>string instance is not deallocated</u> since it may have
@@ -108,8 +327,166 @@ int sea_turtle_string_count(const struct sea_turtle_string *object,
 int sea_turtle_string_compare(const struct sea_turtle_string *object,
                               const struct sea_turtle_string *other);
 
+/**
+ * @brief Sort array of strings.
+ * <p>Strings are sorted with a multikey quicksort which partitions them on
+ * 8 bytes at a time, cached for every string along with its size, rather
+ * than comparing them in full. Large arrays are split into runs sorted on
+ * threads of their own and merged pairwise, the merges of a round also
+ * running on threads of their own. Equal strings may be reordered.</p>
+ * @param [in] objects first string of the array.
+ * @param [in] count number of strings.
+ * @param [in] order order to sort the strings in.
+ * @param [in] threads maximum number of threads to sort with including the
+ * calling thread, or <i>0</i> for the number of online processors.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL if objects is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_ORDER_IS_INVALID if order is not an
+ * order.
+ * @throws SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED if there is
+ * insufficient memory to sort the strings.
+ */
+int sea_turtle_string_sort(struct sea_turtle_string *objects,
+                           size_t count,
+                           enum sea_turtle_string_order order,
+                           size_t threads);
+
+/**
+ * @brief Retrieve the size of the serialized form of strings.
+ * @param [in] objects first string of the array.
+ * @param [in] count number of strings.
+ * @param [out] out receive the size in bytes.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL if objects is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED if the size
+ * does not fit in a size_t.
+ */
+int sea_turtle_string_serialized_size(
+        const struct sea_turtle_string *objects,
+        size_t count,
+        size_t *out);
+
+/**
+ * @brief Serialize strings.
+ * <p>Next to the bytes of every string its count of code points is
+ * stored, so that sea_turtle_string_deserialize() need not count the
+ * strings again. A checksum of the whole protects the trusted loads. Hash
+ * codes are not stored since they are keyed by the secret seed of the
+ * process, and are computed again when first needed.</p>
+ * @param [in] objects first string of the array.
+ * @param [in] count number of strings.
+ * @param [out] out buffer to receive the serialized strings.
+ * @param [in] size size of the buffer in bytes.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL if objects is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_SIZE_IS_TOO_SMALL if size is less than
+ * the size reported by sea_turtle_string_serialized_size().
+ */
+int sea_turtle_string_serialize(const struct sea_turtle_string *objects,
+                                size_t count,
+                                void *out,
+                                size_t size);
+
+/**
+ * @brief Retrieve the count of serialized strings.
+ * @param [in] buffer serialized strings.
+ * @param [in] size size of the buffer in bytes.
+ * @param [out] out receive the count of strings.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_BUFFER_IS_NULL if buffer is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_BUFFER_IS_MALFORMED if buffer does not
+ * start with the header of serialized strings of size bytes.
+ */
+int sea_turtle_string_serialized_count(const void *buffer,
+                                       size_t size,
+                                       uintmax_t *out);
+
+/**
+ * @brief Initialize strings from their serialized form.
+ * <p>The checksum is always verified. With SEA_TURTLE_STRING_LOAD_VALIDATE
+ * the bytes of every string are then validated and counted again, whereas
+ * with the other loads the stored counts are used as they are. With
+ * SEA_TURTLE_STRING_LOAD_IN_PLACE the strings that do not fit in their
+ * local buffer refer to the buffer itself, which must then neither be
+ * modified nor released before the strings are invalidated, the strings
+ * themselves being copied out of it if modified.</p>
+ * @param [in] objects first of the instances to be initialized.
+ * @param [in] count number of serialized strings.
+ * @param [in] buffer serialized strings.
+ * @param [in] size size of the buffer in bytes.
+ * @param [in] load how to load the strings.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL if objects is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_BUFFER_IS_NULL if buffer is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_LOAD_IS_INVALID if load is not a load.
+ * @throws SEA_TURTLE_STRING_ERROR_BUFFER_IS_MALFORMED if buffer does not
+ * hold serialized strings, its checksum does not match or, when validated,
+ * a string is not a valid UTF-8 sequence of its count of code points.
+ * @throws SEA_TURTLE_STRING_ERROR_COUNT_IS_INVALID if count is not the
+ * count of serialized strings.
+ * @throws SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED if there is
+ * insufficient memory to initialize the strings.
+ */
+int sea_turtle_string_deserialize(struct sea_turtle_string *objects,
+                                  size_t count,
+                                  const void *buffer,
+                                  size_t size,
+                                  enum sea_turtle_string_load load);
+
+/**
+ * @brief Check if two strings are equal.
+ * <p>Cheaper than sea_turtle_string_compare() when only equality matters,
+ * strings of different sizes or whose hash codes have both been computed
+ * and differ are told apart without reading their bytes, and long strings
+ * are compared many bytes at a time.</p>
+ * @param [in] object string instance.
+ * @param [in] other string instance.
+ * @param [out] out receive <i>true</i> if the strings are equal, otherwise
+ * <i>false</i>.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_OTHER_IS_NULL if other is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ */
+int sea_turtle_string_equals(const struct sea_turtle_string *object,
+                             const struct sea_turtle_string *other,
+                             bool *out);
+
+/**
+ * @brief Find the first of many strings equal to a string.
+ * <p>All the candidates are first filtered on their size and, if they have
+ * been computed, hash codes so that the bytes of most unequal candidates
+ * are never read. The hash code of <b>object</b> is computed if it allows
+ * a candidate to be rejected.</p>
+ * @param [in] object string instance.
+ * @param [in] others candidates, any of which may be <i>NULL</i> in which
+ * case it is skipped.
+ * @param [in] count number of candidates.
+ * @param [out] out receive the index of the first candidate equal to
+ * <b>object</b>.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_OTHERS_IS_NULL if others is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_OTHER_NOT_FOUND if none of the candidates
+ * is equal to <b>object</b>.
+ */
+int sea_turtle_string_equals_any(const struct sea_turtle_string *object,
+                                 const struct sea_turtle_string *const *others,
+                                 size_t count,
+                                 size_t *out);
+
 /**
  * @brief Retrieve the hash code.
+ * <p>The hash code is computed from the bytes of the UTF-8 sequence using
+ * a seed that is chosen at random for every process, so that it cannot be
+ * relied upon to remain the same from one run to the next. It is computed
+ * on the first call and kept with the string so that strings which are
+ * never hashed do not pay for it. Concurrent calls on the same string are
+ * safe.</p>
  * @param [in] object string instance.
  * @param [out] out receive the hash code.
  * @return On success <i>0</i>, otherwise an error code.
@@ -119,6 +496,21 @@ int sea_turtle_string_compare(const struct sea_turtle_string *object,
 int sea_turtle_string_hash(const struct sea_turtle_string *object,
                            uintmax_t *out);
 
+/**
+ * @brief Compute the 128-bit hash code.
+ * <p>Unlike the hash code, the 128-bit hash code is not kept with the string
+ * and every call reads the whole UTF-8 sequence. Its low 64 bits are the
+ * same as the hash code.</p>
+ * @param [in] object string instance.
+ * @param [out] out receive the low 64 bits followed by the high 64 bits in
+ * an array of two.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ */
+int sea_turtle_string_hash_128(const struct sea_turtle_string *object,
+                               uint64_t *out);
+
 /**
  * @brief Retrieve the first UTF-8 encoded symbol.
  * @param [in] object string instance.
@@ -186,6 +578,49 @@ int sea_turtle_string_prev(const struct sea_turtle_string *object,
                            const uint8_t *at,
                            const uint8_t **out);
 
+/**
+ * @brief Retrieve the UTF-8 encoded symbol at code point index.
+ * <p>The first lookup into a long string that is not entirely ASCII builds
+ * a sampled index of code point offsets, so that subsequent lookups take
+ * constant time. The index is built at most once, even when looked up from
+ * multiple threads at the same time, and it is kept in the header of the
+ * buffer so that copies of a shared string use the same index. It is
+ * released together with the buffer or as soon as the string is modified.
+ * If there is insufficient memory to build the index, or the buffer is
+ * owned by a string arena or the caller, the symbol is found by walking
+ * the string instead.</p>
+ * @param [in] object string instance.
+ * @param [in] index code point index.
+ * @param [out] out receive the <u>address of</u> the UTF-8 encoded symbol.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_INDEX_IS_OUT_OF_BOUNDS if index is not
+ * less than the count of code points.
+ */
+int sea_turtle_string_at(const struct sea_turtle_string *object,
+                         uintmax_t index,
+                         const uint8_t **out);
+
+/**
+ * @brief Retrieve view of a range of code points.
+ * @param [in] object string instance.
+ * @param [in] index code point index of the first code point.
+ * @param [in] count number of code points.
+ * @param [out] out receive the view of the range of code points.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_INDEX_IS_OUT_OF_BOUNDS if index is
+ * greater than the count of code points.
+ * @throws SEA_TURTLE_STRING_ERROR_COUNT_IS_OUT_OF_BOUNDS if there are fewer
+ * than count code points from index onwards.
+ */
+int sea_turtle_string_substring(const struct sea_turtle_string *object,
+                                uintmax_t index,
+                                uintmax_t count,
+                                struct sea_turtle_string_view *out);
+
 /**
  * @brief Get code point from UTF-8 encoded symbol.
  * @param [in] object string instance.
@@ -204,4 +639,214 @@ int sea_turtle_string_code_point(const struct sea_turtle_string *object,
                                  const uint8_t *at,
                                  uint32_t *out);
 
+/**
+ * @brief Decode a range of code points.
+ * <p>Decoding a string, or a part of it at a time, into a buffer of code
+ * points. Runs of ASCII are decoded a block at a time using the widest
+ * vector instructions the CPU supports.</p>
+ * @param [in] object string instance.
+ * @param [in] index code point index of the first code point.
+ * @param [in] size number of code points that out can hold.
+ * @param [out] out receive the code points from index onwards, until
+ * either out is full or the string ends.
+ * @param [out] count optionally receive the number of code points decoded.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_INDEX_IS_OUT_OF_BOUNDS if index is
+ * greater than the count of code points.
+ */
+int sea_turtle_string_code_points(const struct sea_turtle_string *object,
+                                  uintmax_t index,
+                                  size_t size,
+                                  uint32_t *out,
+                                  size_t *count);
+
+/**
+ * @brief Receive the count of UTF-16 code units the string transcodes to.
+ * @param [in] object string instance.
+ * @param [out] out receive the count of code units.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ */
+int sea_turtle_string_utf16_count(const struct sea_turtle_string *object,
+                                  size_t *out);
+
+/**
+ * @brief Transcode string to UTF-16 code units.
+ * <p>No <i>NULL</i> terminator is written.</p>
+ * @param [in] object string instance.
+ * @param [in] order byte order of the code units.
+ * @param [out] out receive the code units, which does not need to be
+ * aligned.
+ * @param [in] size number of code units out has room for.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_ORDER_IS_INVALID if order is not a byte
+ * order.
+ * @throws SEA_TURTLE_STRING_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_SIZE_IS_TOO_SMALL if size is less than
+ * the count of code units from sea_turtle_string_utf16_count().
+ */
+int sea_turtle_string_to_utf16(const struct sea_turtle_string *object,
+                               enum sea_turtle_string_byte_order order,
+                               void *out,
+                               size_t size);
+
+/**
+ * @brief Find the first occurrence of a string.
+ * <p>Needles of up to 32 bytes are searched for by filtering candidate
+ * positions on their first and last byte, a block at a time using the
+ * widest vector instructions the CPU supports, longer needles with the
+ * Two-Way algorithm which runs in linear time. As both strings are valid
+ * UTF-8 sequences an occurrence always starts at a UTF-8 encoded symbol.
+ * An empty needle is found at the start of the string.</p>
+ * @param [in] object string instance.
+ * @param [in] needle string to search for.
+ * @param [out] out receive the <u>address of</u> the first UTF-8 encoded
+ * symbol of the occurrence.
+ * @param [out] index optionally receive the code point index of the
+ * occurrence.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_NEEDLE_IS_NULL if needle is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_NEEDLE_NOT_FOUND if needle does not occur
+ * in the string.
+ */
+int sea_turtle_string_find(const struct sea_turtle_string *object,
+                           const struct sea_turtle_string *needle,
+                           const uint8_t **out,
+                           uintmax_t *index);
+
+/**
+ * @brief Find the last occurrence of a string.
+ * <p>Searched for as with sea_turtle_string_find() but from the end of the
+ * string. An empty needle is found at the end of the string, that is at
+ * its <i>NULL</i> terminator and code point index equal to the count of
+ * code points.</p>
+ * @param [in] object string instance.
+ * @param [in] needle string to search for.
+ * @param [out] out receive the <u>address of</u> the first UTF-8 encoded
+ * symbol of the occurrence.
+ * @param [out] index optionally receive the code point index of the
+ * occurrence.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_NEEDLE_IS_NULL if needle is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_NEEDLE_NOT_FOUND if needle does not occur
+ * in the string.
+ */
+int sea_turtle_string_rfind(const struct sea_turtle_string *object,
+                            const struct sea_turtle_string *needle,
+                            const uint8_t **out,
+                            uintmax_t *index);
+
+/**
+ * @brief Check if string contains other string.
+ * @param [in] object string instance.
+ * @param [in] needle string to search for.
+ * @param [out] out receive <i>true</i> if needle occurs in the string,
+ * otherwise <i>false</i>.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_NEEDLE_IS_NULL if needle is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ */
+int sea_turtle_string_contains(const struct sea_turtle_string *object,
+                               const struct sea_turtle_string *needle,
+                               bool *out);
+
+/**
+ * @brief Check if string starts with other string.
+ * @param [in] object string instance.
+ * @param [in] needle string to compare with the start of the string.
+ * @param [out] out receive <i>true</i> if the string starts with needle,
+ * otherwise <i>false</i>.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_NEEDLE_IS_NULL if needle is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ */
+int sea_turtle_string_starts_with(const struct sea_turtle_string *object,
+                                  const struct sea_turtle_string *needle,
+                                  bool *out);
+
+/**
+ * @brief Check if string ends with other string.
+ * @param [in] object string instance.
+ * @param [in] needle string to compare with the end of the string.
+ * @param [out] out receive <i>true</i> if the string ends with needle,
+ * otherwise <i>false</i>.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_NEEDLE_IS_NULL if needle is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ */
+int sea_turtle_string_ends_with(const struct sea_turtle_string *object,
+                                const struct sea_turtle_string *needle,
+                                bool *out);
+
+/**
+ * @brief Iterator over the pieces of a string in between delimiters.
+ * <p>Pieces are yielded as views of the string, which must neither be
+ * modified nor released while the iterator is in use.</p>
+ */
+struct sea_turtle_string_split {
+    const uint8_t *at;
+    const uint8_t *end;
+    const uint8_t *delimiter;
+    size_t size;
+    /* pieces left before the rest is yielded whole, or 0 if unlimited */
+    size_t limit;
+    bool skip_empty;
+    /* the string is ASCII so the count of a piece is its size */
+    bool ascii;
+    bool done;
+};
+
+/**
+ * @brief Split string on a delimiter.
+ * <p>No memory is allocated, the pieces are found with the same vectorized
+ * search as sea_turtle_string_find() and yielded one at a time by
+ * sea_turtle_string_split_next().</p>
+ * @param [in] object string instance.
+ * @param [in] delimiter string separating the pieces.
+ * @param [in] limit maximum number of pieces, the last one holding the rest
+ * of the string, or <i>0</i> for no limit.
+ * @param [in] skip_empty <i>true</i> to skip pieces without code points,
+ * otherwise <i>false</i>.
+ * @param [out] out receive the iterator.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_DELIMITER_IS_NULL if delimiter is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_DELIMITER_IS_EMPTY if delimiter is empty.
+ */
+int sea_turtle_string_split(const struct sea_turtle_string *object,
+                            const struct sea_turtle_string *delimiter,
+                            size_t limit,
+                            bool skip_empty,
+                            struct sea_turtle_string_split *out);
+
+/**
+ * @brief Retrieve the next piece of a split string.
+ * <p>The <b>data</b> of the view is the <u>address of</u> the first UTF-8
+ * encoded symbol of the piece within the string, which may be passed on to
+ * sea_turtle_string_code_point() and sea_turtle_string_next() as long as
+ * the piece is not empty.</p>
+ * @param [in] object iterator instance.
+ * @param [out] out receive the view of the piece.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_END_OF_SEQUENCE if there are no more
+ * pieces.
+ */
+int sea_turtle_string_split_next(struct sea_turtle_string_split *object,
+                                 struct sea_turtle_string_view *out);
+
 #endif /* _SEA_TURTLE_STRING_H_ */
@@ -0,0 +1,103 @@
+#ifndef _SEA_TURTLE_STRING_ARENA_H_
+#define _SEA_TURTLE_STRING_ARENA_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sea-urchin.h>
+
+#define SEA_TURTLE_STRING_ARENA_ERROR_OBJECT_IS_NULL \
+    SEA_URCHIN_ERROR_OBJECT_IS_NULL
+#define SEA_TURTLE_STRING_ARENA_ERROR_CHAR_PTR_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define SEA_TURTLE_STRING_ARENA_ERROR_OFFSETS_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define SEA_TURTLE_STRING_ARENA_ERROR_SIZES_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define SEA_TURTLE_STRING_ARENA_ERROR_OUT_IS_NULL \
+    SEA_URCHIN_ERROR_OUT_IS_NULL
+#define SEA_TURTLE_STRING_ARENA_ERROR_CHAR_PTR_IS_MALFORMED \
+    SEA_URCHIN_ERROR_VALUE_IS_INVALID
+#define SEA_TURTLE_STRING_ARENA_ERROR_MEMORY_ALLOCATION_FAILED \
+    SEA_URCHIN_ERROR_MEMORY_ALLOCATION_FAILED
+
+struct sea_turtle_string;
+struct sea_turtle_string_arena_block;
+
+/**
+ * @brief Arena holding the buffers of strings initialized in bulk.
+ * <p>Each call to sea_turtle_string_arena_init_strings() places the values
+ * of all the strings it initializes that do not fit in their local buffer
+ * into a single block of memory. Blocks are only released when the arena
+ * is invalidated, which is why the strings must not be used once their
+ * arena has been invalidated. Invalidating such strings themselves does
+ * not release any memory, and as the block has no room to keep a code point
+ * index sea_turtle_string_at() walks their bytes instead.</p>
+ */
+struct sea_turtle_string_arena {
+    struct sea_turtle_string_arena_block *blocks;
+};
+
+/**
+ * @brief Initialize string arena.
+ * @param [in] object instance to be initialized.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ARENA_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ */
+int sea_turtle_string_arena_init(struct sea_turtle_string_arena *object);
+
+/**
+ * @brief Invalidate string arena.
+ * <p>Every block of the arena is released at once, strings initialized from
+ * the arena are left referring to released memory.</p>
+ * <p>The actual <u>string arena instance is not deallocated</u> since it
+ * may have been embedded in a larger structure.</p>
+ * @param [in] object instance to be invalidated.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ARENA_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ */
+int sea_turtle_string_arena_invalidate(struct sea_turtle_string_arena *object);
+
+/**
+ * @brief Initialize strings in bulk from a packed buffer.
+ * <p>String <i>i</i> is initialized from the UTF-8 sequence of
+ * <b>sizes[i]</b> bytes found at <b>char_ptr + offsets[i]</b>, stopping at
+ * the first <i>NULL</i> byte as sea_turtle_string_init() does. Every value
+ * is validated and counted before any memory is allocated. Values that do
+ * not fit in the local buffer of their string are then copied into one
+ * block allocated from the arena for the whole call.</p>
+ * <p>Strings are initialized all or none, if any value is malformed or
+ * memory allocation fails then none of the strings are initialized.</p>
+ * @param [in] object string arena instance.
+ * @param [in] char_ptr packed buffer of UTF-8 sequences.
+ * @param [in] offsets offset into the buffer of each UTF-8 sequence.
+ * @param [in] sizes upper limit in the number of bytes of each UTF-8
+ * sequence.
+ * @param [in] count number of strings to initialize.
+ * @param [out] out array of <b>count</b> strings to be initialized.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ARENA_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ARENA_ERROR_CHAR_PTR_IS_NULL if char_ptr is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ARENA_ERROR_OFFSETS_IS_NULL if offsets is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ARENA_ERROR_SIZES_IS_NULL if sizes is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ARENA_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ARENA_ERROR_CHAR_PTR_IS_MALFORMED if any of the
+ * UTF-8 sequences is malformed.
+ * @throws SEA_TURTLE_STRING_ARENA_ERROR_MEMORY_ALLOCATION_FAILED if there is
+ * insufficient memory to allocate the block for the values.
+ */
+int sea_turtle_string_arena_init_strings(
+        struct sea_turtle_string_arena *object,
+        const char *char_ptr,
+        const size_t *offsets,
+        const size_t *sizes,
+        size_t count,
+        struct sea_turtle_string *out);
+
+#endif /* _SEA_TURTLE_STRING_ARENA_H_ */
@@ -0,0 +1,205 @@
+#ifndef _SEA_TURTLE_STRING_BUILDER_H_
+#define _SEA_TURTLE_STRING_BUILDER_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sea-urchin.h>
+
+#define SEA_TURTLE_STRING_BUILDER_ERROR_OBJECT_IS_NULL \
+    SEA_URCHIN_ERROR_OBJECT_IS_NULL
+#define SEA_TURTLE_STRING_BUILDER_ERROR_CHAR_PTR_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define SEA_TURTLE_STRING_BUILDER_ERROR_STRING_IS_NULL \
+    SEA_URCHIN_ERROR_OTHER_IS_NULL
+#define SEA_TURTLE_STRING_BUILDER_ERROR_OUT_IS_NULL \
+    SEA_URCHIN_ERROR_OUT_IS_NULL
+#define SEA_TURTLE_STRING_BUILDER_ERROR_SIZE_IS_ZERO \
+    SEA_URCHIN_ERROR_VALUE_IS_ZERO
+#define SEA_TURTLE_STRING_BUILDER_ERROR_CHAR_PTR_IS_MALFORMED \
+    SEA_URCHIN_ERROR_VALUE_IS_INVALID
+#define SEA_TURTLE_STRING_BUILDER_ERROR_CODE_POINT_IS_INVALID \
+    SEA_URCHIN_ERROR_VALUE_IS_INVALID
+#define SEA_TURTLE_STRING_BUILDER_ERROR_MEMORY_ALLOCATION_FAILED \
+    SEA_URCHIN_ERROR_MEMORY_ALLOCATION_FAILED
+#define SEA_TURTLE_STRING_BUILDER_ERROR_CHUNK_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define SEA_TURTLE_STRING_BUILDER_ERROR_CHUNK_IS_MALFORMED \
+    SEA_URCHIN_ERROR_VALUE_IS_INVALID
+#define SEA_TURTLE_STRING_BUILDER_ERROR_SEQUENCE_IS_INCOMPLETE \
+    SEA_URCHIN_ERROR_END_OF_SEQUENCE
+
+struct sea_turtle_string;
+
+/**
+ * @brief Builder of UTF-8 encoded strings.
+ * <p>The buffer grows geometrically so that appending is amortized constant
+ * time per byte. The count of code points is kept up to date as values are
+ * appended so that finishing the string transfers the buffer to it without
+ * copying or reading the buffer again.</p>
+ * <p>Input received in chunks is validated as it arrives using
+ * sea_turtle_string_builder_append_chunk(), which holds on to an UTF-8
+ * encoded symbol cut short by the end of a chunk until the next chunk
+ * completes it.</p>
+ */
+struct sea_turtle_string_builder {
+    uint8_t *data;
+    size_t size;
+    size_t capacity;
+    uintmax_t count;
+    /* leading bytes of the symbol the last chunk ended in the middle of */
+    uint8_t partial[3];
+    uint8_t pending;
+};
+
+/**
+ * @brief Initialize string builder.
+ * @param [in] object instance to be initialized.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_BUILDER_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ */
+int sea_turtle_string_builder_init(struct sea_turtle_string_builder *object);
+
+/**
+ * @brief Invalidate string builder.
+ * <p>The actual <u>string builder instance is not deallocated</u> since it
+ * may have been embedded in a larger structure.</p>
+ * @param [in] object instance to be invalidated.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_BUILDER_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ */
+int sea_turtle_string_builder_invalidate(
+        struct sea_turtle_string_builder *object);
+
+/**
+ * @brief Ensure capacity for additional chars.
+ * @param [in] object string builder instance.
+ * @param [in] size number of chars that can be appended afterwards without
+ * memory allocation.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_BUILDER_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_BUILDER_ERROR_MEMORY_ALLOCATION_FAILED if there
+ * is insufficient memory to grow the buffer or if the string would grow
+ * larger than any string may be.
+ */
+int sea_turtle_string_builder_reserve(struct sea_turtle_string_builder *object,
+                                      size_t size);
+
+/**
+ * @brief Append UTF-8 sequence.
+ * <p>The UTF-8 sequence is read up to the first <i>NULL</i> char occurrence
+ * or <b>size</b> chars have been read. Nothing is appended if the sequence
+ * is malformed.</p>
+ * @param [in] object string builder instance.
+ * @param [in] char_ptr UTF-8 sequence to read.
+ * @param [in] size upper limit in the number of chars to read up to.
+ * @param [out] out optionally receive the number of chars we have read up
+ * to.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_BUILDER_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_BUILDER_ERROR_CHAR_PTR_IS_NULL if char_ptr is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_BUILDER_ERROR_SIZE_IS_ZERO is size is zero.
+ * @throws SEA_TURTLE_STRING_BUILDER_ERROR_CHAR_PTR_IS_MALFORMED if char_ptr
+ * does not refer to a valid UTF-8 sequence.
+ * @throws SEA_TURTLE_STRING_BUILDER_ERROR_SEQUENCE_IS_INCOMPLETE if the last
+ * chunk appended ended in the middle of an UTF-8 encoded symbol.
+ * @throws SEA_TURTLE_STRING_BUILDER_ERROR_MEMORY_ALLOCATION_FAILED if there
+ * is insufficient memory to grow the buffer.
+ */
+int sea_turtle_string_builder_append_char_ptr(
+        struct sea_turtle_string_builder *object,
+        const char *char_ptr,
+        size_t size,
+        size_t *out);
+
+/**
+ * @brief Append code point.
+ * @param [in] object string builder instance.
+ * @param [in] code_point to append UTF-8 encoded.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_BUILDER_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_BUILDER_ERROR_CODE_POINT_IS_INVALID if
+ * code_point is a surrogate or greater than <i>0x10FFFF</i>.
+ * @throws SEA_TURTLE_STRING_BUILDER_ERROR_SEQUENCE_IS_INCOMPLETE if the last
+ * chunk appended ended in the middle of an UTF-8 encoded symbol.
+ * @throws SEA_TURTLE_STRING_BUILDER_ERROR_MEMORY_ALLOCATION_FAILED if there
+ * is insufficient memory to grow the buffer.
+ */
+int sea_turtle_string_builder_append_code_point(
+        struct sea_turtle_string_builder *object,
+        uint32_t code_point);
+
+/**
+ * @brief Append string.
+ * <p>The value of <b>string</b> is already known to be valid and its count
+ * of code points is reused rather than recomputed.</p>
+ * @param [in] object string builder instance.
+ * @param [in] string whose value we will append.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_BUILDER_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_BUILDER_ERROR_STRING_IS_NULL if string is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_BUILDER_ERROR_SEQUENCE_IS_INCOMPLETE if the last
+ * chunk appended ended in the middle of an UTF-8 encoded symbol.
+ * @throws SEA_TURTLE_STRING_BUILDER_ERROR_MEMORY_ALLOCATION_FAILED if there
+ * is insufficient memory to grow the buffer.
+ */
+int sea_turtle_string_builder_append_string(
+        struct sea_turtle_string_builder *object,
+        const struct sea_turtle_string *string);
+
+/**
+ * @brief Append chunk of an UTF-8 sequence.
+ * <p>Chunks may begin or end anywhere, including in the middle of an UTF-8
+ * encoded symbol, and are validated as they are appended so that the input
+ * is neither buffered nor scanned again. The count of code points is kept
+ * up to date while the hash code is computed from the finished string when
+ * first needed. Nothing is appended if the chunk is malformed, which
+ * includes holding a <i>NULL</i> char or a symbol that cannot be
+ * completed.</p>
+ * @param [in] object string builder instance.
+ * @param [in] chunk bytes of the UTF-8 sequence.
+ * @param [in] size number of bytes in the chunk.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_BUILDER_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_BUILDER_ERROR_CHUNK_IS_NULL if chunk is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_BUILDER_ERROR_SIZE_IS_ZERO is size is zero.
+ * @throws SEA_TURTLE_STRING_BUILDER_ERROR_CHUNK_IS_MALFORMED if chunk does
+ * not continue a valid UTF-8 sequence.
+ * @throws SEA_TURTLE_STRING_BUILDER_ERROR_MEMORY_ALLOCATION_FAILED if there
+ * is insufficient memory to grow the buffer.
+ */
+int sea_turtle_string_builder_append_chunk(
+        struct sea_turtle_string_builder *object,
+        const char *chunk,
+        size_t size);
+
+/**
+ * @brief Finish building the string.
+ * <p>The buffer of the string builder is handed over to <b>out</b>
+ * without being copied, unless it is short enough to be stored within the
+ * string instance itself. The string builder is left empty and may be
+ * reused.</p>
+ * @param [in] object string builder instance.
+ * @param [out] out receive the initialized string instance.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_BUILDER_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_BUILDER_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_BUILDER_ERROR_SEQUENCE_IS_INCOMPLETE if the last
+ * chunk appended ended in the middle of an UTF-8 encoded symbol.
+ */
+int sea_turtle_string_builder_finish(struct sea_turtle_string_builder *object,
+                                     struct sea_turtle_string *out);
+
+#endif /* _SEA_TURTLE_STRING_BUILDER_H_ */
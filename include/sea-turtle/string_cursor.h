@@ -0,0 +1,154 @@
+#ifndef _SEA_TURTLE_STRING_CURSOR_H_
+#define _SEA_TURTLE_STRING_CURSOR_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sea-turtle/string.h>
+#include <sea-turtle/string_view.h>
+
+/**
+ * @brief Unchecked position within a valid UTF-8 sequence.
+ * <p>Cursors are meant for hot iteration loops, every operation is inlined
+ * and none of them validates its arguments. The string or view a cursor
+ * was initialized with must neither be modified nor released while the
+ * cursor is in use, the functions of sea_turtle_string remain the checked
+ * way to iterate.</p>
+ * <p>The cursor is positioned in between UTF-8 encoded symbols, <b>at</b>
+ * being the first byte of the symbol sea_turtle_string_cursor_next()
+ * decodes.</p>
+ */
+struct sea_turtle_string_cursor {
+    const uint8_t *begin;
+    const uint8_t *at;
+    const uint8_t *end;
+};
+
+/**
+ * @brief Position cursor before the first code point of string.
+ * @param [in] cursor instance to be initialized.
+ * @param [in] object string instance.
+ */
+static inline void sea_turtle_string_cursor_init(
+        struct sea_turtle_string_cursor *const cursor,
+        const struct sea_turtle_string *const object) {
+    if (!object->size) {
+        *cursor = (struct sea_turtle_string_cursor) {0};
+        return;
+    }
+    /* strings of up to SEA_TURTLE_STRING_LOCAL_SIZE are stored locally */
+    const uint8_t *const data =
+            object->size <= SEA_TURTLE_STRING_LOCAL_SIZE
+            ? object->local
+            : object->data;
+    cursor->begin = data;
+    cursor->at = data;
+    cursor->end = data + object->size - 1;
+}
+
+/**
+ * @brief Position cursor before the first code point of view.
+ * @param [in] cursor instance to be initialized.
+ * @param [in] object view instance.
+ */
+static inline void sea_turtle_string_cursor_init_view(
+        struct sea_turtle_string_cursor *const cursor,
+        const struct sea_turtle_string_view *const object) {
+    if (!object->size) {
+        *cursor = (struct sea_turtle_string_cursor) {0};
+        return;
+    }
+    cursor->begin = object->data;
+    cursor->at = object->data;
+    cursor->end = object->data + object->size;
+}
+
+/**
+ * @brief Position cursor after the last code point.
+ * @param [in] cursor cursor instance.
+ */
+static inline void sea_turtle_string_cursor_seek_end(
+        struct sea_turtle_string_cursor *const cursor) {
+    cursor->at = cursor->end;
+}
+
+/**
+ * @brief Decode the code point after the cursor and move past it.
+ * @param [in] cursor cursor instance.
+ * @param [out] out receive the code point.
+ * @return <i>false</i> if the cursor is after the last code point,
+ * otherwise <i>true</i>.
+ */
+static inline bool sea_turtle_string_cursor_next(
+        struct sea_turtle_string_cursor *const cursor,
+        uint32_t *const out) {
+    const uint8_t *const at = cursor->at;
+    if (at == cursor->end) {
+        return false;
+    }
+    const uint32_t byte = at[0];
+    if (byte < 0x80) {
+        *out = byte;
+        cursor->at = at + 1;
+    } else if (byte < 0xE0) {
+        *out = (byte & 0x1F) << 6 | (at[1] & 0x3F);
+        cursor->at = at + 2;
+    } else if (byte < 0xF0) {
+        *out = (byte & 0x0F) << 12 | (at[1] & 0x3F) << 6 | (at[2] & 0x3F);
+        cursor->at = at + 3;
+    } else {
+        *out = (byte & 0x07) << 18 | (at[1] & 0x3F) << 12
+               | (at[2] & 0x3F) << 6 | (at[3] & 0x3F);
+        cursor->at = at + 4;
+    }
+    return true;
+}
+
+/**
+ * @brief Move before the code point preceding the cursor and decode it.
+ * @param [in] cursor cursor instance.
+ * @param [out] out receive the code point.
+ * @return <i>false</i> if the cursor is before the first code point,
+ * otherwise <i>true</i>.
+ */
+static inline bool sea_turtle_string_cursor_prev(
+        struct sea_turtle_string_cursor *const cursor,
+        uint32_t *const out) {
+    const uint8_t *at = cursor->at;
+    if (at == cursor->begin) {
+        return false;
+    }
+    /* continuation bytes are never the first byte of the sequence */
+    do {
+        at -= 1;
+    } while ((*at & 0xC0) == 0x80);
+    cursor->at = at;
+    sea_turtle_string_cursor_next(cursor, out);
+    cursor->at = at;
+    return true;
+}
+
+/**
+ * @brief Iterate over the code points of a string from first to last.
+ * @param [in] cursor cursor instance, positioned at the code point that
+ * follows <b>code_point</b> within the loop body.
+ * @param [out] code_point receive each code point in turn.
+ * @param [in] object string instance.
+ */
+#define SEA_TURTLE_STRING_FOREACH(cursor, code_point, object) \
+    for (sea_turtle_string_cursor_init((cursor), (object)); \
+         sea_turtle_string_cursor_next((cursor), (code_point));)
+
+/**
+ * @brief Iterate over the code points of a string from last to first.
+ * @param [in] cursor cursor instance, positioned at <b>code_point</b>
+ * within the loop body.
+ * @param [out] code_point receive each code point in turn.
+ * @param [in] object string instance.
+ */
+#define SEA_TURTLE_STRING_FOREACH_REVERSE(cursor, code_point, object) \
+    for (sea_turtle_string_cursor_init((cursor), (object)), \
+         sea_turtle_string_cursor_seek_end((cursor)); \
+         sea_turtle_string_cursor_prev((cursor), (code_point));)
+
+#endif /* _SEA_TURTLE_STRING_CURSOR_H_ */
@@ -0,0 +1,235 @@
+#ifndef _SEA_TURTLE_STRING_DICTIONARY_H_
+#define _SEA_TURTLE_STRING_DICTIONARY_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sea-urchin.h>
+
+#define SEA_TURTLE_STRING_DICTIONARY_ERROR_OBJECT_IS_NULL \
+    SEA_URCHIN_ERROR_OBJECT_IS_NULL
+#define SEA_TURTLE_STRING_DICTIONARY_ERROR_STRINGS_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define SEA_TURTLE_STRING_DICTIONARY_ERROR_STRINGS_ARE_UNSORTED \
+    SEA_URCHIN_ERROR_VALUE_IS_INVALID
+#define SEA_TURTLE_STRING_DICTIONARY_ERROR_BUFFER_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define SEA_TURTLE_STRING_DICTIONARY_ERROR_BUFFER_IS_MALFORMED \
+    SEA_URCHIN_ERROR_VALUE_IS_INVALID
+#define SEA_TURTLE_STRING_DICTIONARY_ERROR_KEY_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define SEA_TURTLE_STRING_DICTIONARY_ERROR_PREFIX_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define SEA_TURTLE_STRING_DICTIONARY_ERROR_AT_IS_NULL \
+    SEA_URCHIN_ERROR_ITEM_IS_NULL
+#define SEA_TURTLE_STRING_DICTIONARY_ERROR_OUT_IS_NULL \
+    SEA_URCHIN_ERROR_OUT_IS_NULL
+#define SEA_TURTLE_STRING_DICTIONARY_ERROR_KEY_NOT_FOUND \
+    SEA_URCHIN_ERROR_VALUE_NOT_FOUND
+#define SEA_TURTLE_STRING_DICTIONARY_ERROR_INDEX_IS_OUT_OF_BOUNDS \
+    SEA_URCHIN_ERROR_ITEM_IS_OUT_OF_BOUNDS
+#define SEA_TURTLE_STRING_DICTIONARY_ERROR_END_OF_SEQUENCE \
+    SEA_URCHIN_ERROR_END_OF_SEQUENCE
+#define SEA_TURTLE_STRING_DICTIONARY_ERROR_MEMORY_ALLOCATION_FAILED \
+    SEA_URCHIN_ERROR_MEMORY_ALLOCATION_FAILED
+
+/* number of terms sharing a bucket, the first of which is stored in full */
+#define SEA_TURTLE_STRING_DICTIONARY_BUCKET_SIZE 16
+
+struct sea_turtle_allocator;
+struct sea_turtle_string;
+
+/**
+ * @brief Immutable sorted set of strings, front coded.
+ * <p>Terms are grouped into buckets of
+ * SEA_TURTLE_STRING_DICTIONARY_BUCKET_SIZE. The first term of a bucket is
+ * stored in full, every other term only stores the length of the prefix it
+ * shares with the term before it followed by the rest of its bytes. An
+ * array with the offset of every bucket allows binary searching the first
+ * terms of the buckets, after which at most a bucket is decoded.</p>
+ * <p>Everything lives in the single buffer <b>data</b> of <b>size</b>
+ * bytes, which is also the serialized form of the dictionary as accepted
+ * by sea_turtle_string_dictionary_init_buffer() in a process with the same
+ * byte order.</p>
+ */
+struct sea_turtle_string_dictionary {
+    uint8_t *data;
+    size_t size;
+    uintmax_t count;
+    /* allocator data came from */
+    const struct sea_turtle_allocator *allocator;
+};
+
+/**
+ * @brief Position within a range of terms of a dictionary.
+ * <p>Iterators are invalidated along with their dictionary.</p>
+ */
+struct sea_turtle_string_dictionary_iterator {
+    /* encoded term to be decoded next */
+    const uint8_t *at;
+    /* index of the term to be decoded next */
+    uintmax_t decoded;
+    /* index of the term to be retrieved next */
+    uintmax_t index;
+    /* index past the last term of the range */
+    uintmax_t end;
+};
+
+/**
+ * @brief Initialize dictionary from sorted strings.
+ * @param [in] object instance to be initialized.
+ * @param [in] strings first string of an array sorted byte by byte, as with
+ * SEA_TURTLE_STRING_ORDER_BYTES, without duplicates.
+ * @param [in] count number of strings.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_DICTIONARY_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_DICTIONARY_ERROR_STRINGS_IS_NULL if strings is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_DICTIONARY_ERROR_STRINGS_ARE_UNSORTED if a
+ * string is not greater than the string before it.
+ * @throws SEA_TURTLE_STRING_DICTIONARY_ERROR_MEMORY_ALLOCATION_FAILED if
+ * there is insufficient memory to initialize the dictionary.
+ */
+int sea_turtle_string_dictionary_init(
+        struct sea_turtle_string_dictionary *object,
+        const struct sea_turtle_string *strings,
+        size_t count);
+
+/**
+ * @brief Initialize dictionary from a serialized dictionary.
+ * <p>The buffer is copied after its every term has been checked to be a
+ * valid UTF-8 sequence greater than the term before it.</p>
+ * @param [in] object instance to be initialized.
+ * @param [in] buffer data of a dictionary.
+ * @param [in] size size of the data of the dictionary.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_DICTIONARY_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_DICTIONARY_ERROR_BUFFER_IS_NULL if buffer is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_DICTIONARY_ERROR_BUFFER_IS_MALFORMED if buffer
+ * does not hold the data of a dictionary.
+ * @throws SEA_TURTLE_STRING_DICTIONARY_ERROR_MEMORY_ALLOCATION_FAILED if
+ * there is insufficient memory to initialize the dictionary.
+ */
+int sea_turtle_string_dictionary_init_buffer(
+        struct sea_turtle_string_dictionary *object,
+        const void *buffer,
+        size_t size);
+
+/**
+ * @brief Invalidate dictionary.
+ * <p>The actual <u>dictionary instance is not deallocated</u> since it may
+ * have been embedded in a larger structure.</p>
+ * @param [in] object instance to be invalidated.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_DICTIONARY_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ */
+int sea_turtle_string_dictionary_invalidate(
+        struct sea_turtle_string_dictionary *object);
+
+/**
+ * @brief Retrieve the count of terms.
+ * @param [in] object dictionary instance.
+ * @param [out] out receive the count of terms.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_DICTIONARY_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_DICTIONARY_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ */
+int sea_turtle_string_dictionary_count(
+        const struct sea_turtle_string_dictionary *object,
+        uintmax_t *out);
+
+/**
+ * @brief Retrieve the index of a term.
+ * @param [in] object dictionary instance.
+ * @param [in] key string to look up.
+ * @param [out] out receive the index of the term.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_DICTIONARY_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_DICTIONARY_ERROR_KEY_IS_NULL if key is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_DICTIONARY_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_DICTIONARY_ERROR_KEY_NOT_FOUND if key is not a
+ * term of the dictionary.
+ */
+int sea_turtle_string_dictionary_find(
+        const struct sea_turtle_string_dictionary *object,
+        const struct sea_turtle_string *key,
+        uintmax_t *out);
+
+/**
+ * @brief Retrieve the term at index.
+ * @param [in] object dictionary instance.
+ * @param [in] index index of the term.
+ * @param [out] out string instance to be initialized with the term.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_DICTIONARY_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_DICTIONARY_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_DICTIONARY_ERROR_INDEX_IS_OUT_OF_BOUNDS if index
+ * is not less than the count of terms.
+ * @throws SEA_TURTLE_STRING_DICTIONARY_ERROR_MEMORY_ALLOCATION_FAILED if
+ * there is insufficient memory to initialize the string.
+ */
+int sea_turtle_string_dictionary_get(
+        const struct sea_turtle_string_dictionary *object,
+        uintmax_t index,
+        struct sea_turtle_string *out);
+
+/**
+ * @brief Retrieve the range of terms starting with prefix.
+ * <p>The terms are retrieved in order with
+ * sea_turtle_string_dictionary_next(). An empty prefix ranges over all the
+ * terms.</p>
+ * @param [in] object dictionary instance.
+ * @param [in] prefix string the terms start with.
+ * @param [out] out receive the iterator positioned at the first term of
+ * the range.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_DICTIONARY_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_DICTIONARY_ERROR_PREFIX_IS_NULL if prefix is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_DICTIONARY_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ */
+int sea_turtle_string_dictionary_prefix(
+        const struct sea_turtle_string_dictionary *object,
+        const struct sea_turtle_string *prefix,
+        struct sea_turtle_string_dictionary_iterator *out);
+
+/**
+ * @brief Retrieve the next term of a range.
+ * <p>Consecutive terms share their prefix, which is why <b>out</b> is
+ * expected to be the same string instance on every call and must be left
+ * untouched in between. Only the bytes following the shared prefix are
+ * copied into it, its buffer being reused whenever possible.</p>
+ * @param [in] object dictionary instance.
+ * @param [in] at iterator to advance.
+ * @param [in] out initialized string instance to receive the term.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_DICTIONARY_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_DICTIONARY_ERROR_AT_IS_NULL if at is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_DICTIONARY_ERROR_OUT_IS_NULL if out is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_DICTIONARY_ERROR_END_OF_SEQUENCE if there are no
+ * more terms in the range.
+ * @throws SEA_TURTLE_STRING_DICTIONARY_ERROR_MEMORY_ALLOCATION_FAILED if
+ * there is insufficient memory to hold the term.
+ */
+int sea_turtle_string_dictionary_next(
+        const struct sea_turtle_string_dictionary *object,
+        struct sea_turtle_string_dictionary_iterator *at,
+        struct sea_turtle_string *out);
+
+#endif /* _SEA_TURTLE_STRING_DICTIONARY_H_ */
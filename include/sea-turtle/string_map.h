@@ -0,0 +1,194 @@
+#ifndef _SEA_TURTLE_STRING_MAP_H_
+#define _SEA_TURTLE_STRING_MAP_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sea-urchin.h>
+
+#define SEA_TURTLE_STRING_MAP_ERROR_OBJECT_IS_NULL \
+    SEA_URCHIN_ERROR_OBJECT_IS_NULL
+#define SEA_TURTLE_STRING_MAP_ERROR_KEY_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define SEA_TURTLE_STRING_MAP_ERROR_KEYS_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define SEA_TURTLE_STRING_MAP_ERROR_VALUES_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define SEA_TURTLE_STRING_MAP_ERROR_CHAR_PTR_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define SEA_TURTLE_STRING_MAP_ERROR_OUT_IS_NULL \
+    SEA_URCHIN_ERROR_OUT_IS_NULL
+#define SEA_TURTLE_STRING_MAP_ERROR_KEY_NOT_FOUND \
+    SEA_URCHIN_ERROR_VALUE_NOT_FOUND
+#define SEA_TURTLE_STRING_MAP_ERROR_MEMORY_ALLOCATION_FAILED \
+    SEA_URCHIN_ERROR_MEMORY_ALLOCATION_FAILED
+
+struct sea_turtle_allocator;
+struct sea_turtle_string;
+struct sea_turtle_string_map_entry;
+
+/**
+ * @brief Hash map from strings to values.
+ * <p>Slots are organized as an open addressing table with one control byte
+ * per slot, holding 7 bits of the hash code of the key or marking the slot
+ * as empty or deleted. A lookup compares the control bytes of 16 slots at
+ * a time with a single vector instruction and only compares the keys of
+ * the slots whose control byte matches. Keys are copied into the slots, so
+ * that short keys are stored locally and shared keys are copied without
+ * memory allocation.</p>
+ */
+struct sea_turtle_string_map {
+    int8_t *controls;
+    struct sea_turtle_string_map_entry *entries;
+    size_t capacity;
+    size_t count;
+    /* insertions into empty slots left before the table must grow */
+    size_t growth;
+    /* allocator of the table, current when the map was initialized */
+    const struct sea_turtle_allocator *allocator;
+};
+
+/**
+ * @brief Initialize string map.
+ * @param [in] object instance to be initialized.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_MAP_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ */
+int sea_turtle_string_map_init(struct sea_turtle_string_map *object);
+
+/**
+ * @brief Invalidate string map.
+ * <p>The keys held by the map are invalidated, the values are left
+ * untouched.</p>
+ * <p>The actual <u>string map instance is not deallocated</u> since it may
+ * have been embedded in a larger structure.</p>
+ * @param [in] object instance to be invalidated.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_MAP_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ */
+int sea_turtle_string_map_invalidate(struct sea_turtle_string_map *object);
+
+/**
+ * @brief Reserve room for entries.
+ * <p>Inserting up to <b>count</b> entries in total will neither grow nor
+ * rebuild the table.</p>
+ * @param [in] object string map instance.
+ * @param [in] count number of entries to make room for.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_MAP_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_MAP_ERROR_MEMORY_ALLOCATION_FAILED if there is
+ * insufficient memory to grow the table.
+ */
+int sea_turtle_string_map_reserve(struct sea_turtle_string_map *object,
+                                  size_t count);
+
+/**
+ * @brief Associate value with key.
+ * <p>If the map already holds an entry for <b>key</b> its value is
+ * replaced, otherwise a copy of <b>key</b> is inserted.</p>
+ * @param [in] object string map instance.
+ * @param [in] key string to associate value with.
+ * @param [in] value value to associate with key.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_MAP_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_MAP_ERROR_KEY_IS_NULL if key is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_MAP_ERROR_MEMORY_ALLOCATION_FAILED if there is
+ * insufficient memory to insert the entry.
+ */
+int sea_turtle_string_map_set(struct sea_turtle_string_map *object,
+                              const struct sea_turtle_string *key,
+                              void *value);
+
+/**
+ * @brief Associate values with keys in bulk.
+ * <p>Room for all the entries is reserved once before any of them is
+ * inserted. Should a key fail to be copied the entries before it remain in
+ * the map.</p>
+ * @param [in] object string map instance.
+ * @param [in] keys strings to associate the values with.
+ * @param [in] values values to associate with the keys.
+ * @param [in] count number of keys and values.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_MAP_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_MAP_ERROR_KEYS_IS_NULL if keys is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_MAP_ERROR_VALUES_IS_NULL if values is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_MAP_ERROR_MEMORY_ALLOCATION_FAILED if there is
+ * insufficient memory to insert the entries.
+ */
+int sea_turtle_string_map_set_all(struct sea_turtle_string_map *object,
+                                  const struct sea_turtle_string *keys,
+                                  void *const *values,
+                                  size_t count);
+
+/**
+ * @brief Retrieve the value associated with key.
+ * @param [in] object string map instance.
+ * @param [in] key string to look up.
+ * @param [out] out receive the value.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_MAP_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_MAP_ERROR_KEY_IS_NULL if key is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_MAP_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_MAP_ERROR_KEY_NOT_FOUND if there is no entry
+ * for key.
+ */
+int sea_turtle_string_map_get(const struct sea_turtle_string_map *object,
+                              const struct sea_turtle_string *key,
+                              void **out);
+
+/**
+ * @brief Retrieve the value associated with a char sequence.
+ * <p>The char sequence is looked up as is, without being validated or
+ * turned into a string first.</p>
+ * @param [in] object string map instance.
+ * @param [in] char_ptr char sequence to look up.
+ * @param [in] size number of chars in the char sequence.
+ * @param [out] out receive the value.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_MAP_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_MAP_ERROR_CHAR_PTR_IS_NULL if char_ptr is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_MAP_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_MAP_ERROR_KEY_NOT_FOUND if there is no entry
+ * for the char sequence.
+ */
+int sea_turtle_string_map_get_chars(const struct sea_turtle_string_map *object,
+                                    const char *char_ptr,
+                                    size_t size,
+                                    void **out);
+
+/**
+ * @brief Remove the entry for key.
+ * @param [in] object string map instance.
+ * @param [in] key string to remove the entry of.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_MAP_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_MAP_ERROR_KEY_IS_NULL if key is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_MAP_ERROR_KEY_NOT_FOUND if there is no entry
+ * for key.
+ */
+int sea_turtle_string_map_remove(struct sea_turtle_string_map *object,
+                                 const struct sea_turtle_string *key);
+
+/**
+ * @brief Retrieve the count of entries.
+ * @param [in] object string map instance.
+ * @param [out] out receive the count of entries.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_MAP_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_MAP_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ */
+int sea_turtle_string_map_count(const struct sea_turtle_string_map *object,
+                                uintmax_t *out);
+
+#endif /* _SEA_TURTLE_STRING_MAP_H_ */
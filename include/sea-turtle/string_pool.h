@@ -0,0 +1,106 @@
+#ifndef _SEA_TURTLE_STRING_POOL_H_
+#define _SEA_TURTLE_STRING_POOL_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sea-urchin.h>
+
+#define SEA_TURTLE_STRING_POOL_ERROR_OBJECT_IS_NULL \
+    SEA_URCHIN_ERROR_OBJECT_IS_NULL
+#define SEA_TURTLE_STRING_POOL_ERROR_OBJECT_IS_INVALID \
+    SEA_URCHIN_ERROR_VALUE_IS_INVALID
+#define SEA_TURTLE_STRING_POOL_ERROR_VALUE_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define SEA_TURTLE_STRING_POOL_ERROR_OUT_IS_NULL \
+    SEA_URCHIN_ERROR_OUT_IS_NULL
+#define SEA_TURTLE_STRING_POOL_ERROR_MEMORY_ALLOCATION_FAILED \
+    SEA_URCHIN_ERROR_MEMORY_ALLOCATION_FAILED
+
+/**
+ * @brief Number of independently locked shards in a string pool.
+ */
+#define SEA_TURTLE_STRING_POOL_SHARDS 64
+
+struct sea_turtle_allocator;
+struct sea_turtle_string;
+struct sea_turtle_string_pool_shard;
+
+/**
+ * @brief Pool of interned strings.
+ * <p>Interning a string yields the one canonical instance that the pool
+ * holds for its value, so interned strings with equal values can be
+ * compared by address. The pool is split into shards, selected by the hash
+ * code of the string, each guarded by its own lock so that many threads can
+ * intern strings at the same time.</p>
+ */
+struct sea_turtle_string_pool {
+    struct sea_turtle_string_pool_shard *shards;
+    /* allocator of the shards, current when the pool was initialized */
+    const struct sea_turtle_allocator *allocator;
+};
+
+/**
+ * @brief Initialize string pool.
+ * @param [in] object instance to be initialized.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_POOL_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_POOL_ERROR_MEMORY_ALLOCATION_FAILED if there is
+ * insufficient memory to initialize the string pool instance.
+ */
+int sea_turtle_string_pool_init(struct sea_turtle_string_pool *object);
+
+/**
+ * @brief Invalidate string pool.
+ * <p>All the canonical string instances held by the pool are invalidated
+ * and released.</p>
+ * <p>The actual <u>string pool instance is not deallocated</u> since it may
+ * have been embedded in a larger structure.</p>
+ * @param [in] object instance to be invalidated.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_POOL_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ */
+int sea_turtle_string_pool_invalidate(struct sea_turtle_string_pool *object);
+
+/**
+ * @brief Intern string.
+ * <p>If the pool does not yet hold a string equal to <b>value</b> then a
+ * copy of <b>value</b> becomes the canonical instance. The canonical
+ * instance is owned by the pool and remains valid until the pool is
+ * invalidated, its buffer is shared so that copying it with
+ * sea_turtle_string_init_string() does not allocate memory.</p>
+ * @param [in] object string pool instance.
+ * @param [in] value string to intern.
+ * @param [out] out receive the canonical instance.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_POOL_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_POOL_ERROR_OBJECT_IS_INVALID if object has
+ * not been initialized or has been invalidated.
+ * @throws SEA_TURTLE_STRING_POOL_ERROR_VALUE_IS_NULL if value is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_POOL_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_POOL_ERROR_MEMORY_ALLOCATION_FAILED if there is
+ * insufficient memory to intern the string.
+ */
+int sea_turtle_string_pool_intern(struct sea_turtle_string_pool *object,
+                                  const struct sea_turtle_string *value,
+                                  const struct sea_turtle_string **out);
+
+/**
+ * @brief Retrieve the count of interned strings.
+ * @param [in] object string pool instance.
+ * @param [out] out receive the count of interned strings.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_POOL_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_POOL_ERROR_OBJECT_IS_INVALID if object has
+ * not been initialized or has been invalidated.
+ * @throws SEA_TURTLE_STRING_POOL_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ */
+int sea_turtle_string_pool_count(struct sea_turtle_string_pool *object,
+                                 uintmax_t *out);
+
+#endif /* _SEA_TURTLE_STRING_POOL_H_ */
@@ -0,0 +1,263 @@
+#ifndef _SEA_TURTLE_STRING_VIEW_H_
+#define _SEA_TURTLE_STRING_VIEW_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sea-urchin.h>
+
+#define SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL \
+    SEA_URCHIN_ERROR_OBJECT_IS_NULL
+#define SEA_TURTLE_STRING_VIEW_ERROR_OTHER_IS_NULL \
+    SEA_URCHIN_ERROR_OTHER_IS_NULL
+#define SEA_TURTLE_STRING_VIEW_ERROR_CHAR_PTR_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define SEA_TURTLE_STRING_VIEW_ERROR_STRING_IS_NULL \
+    SEA_URCHIN_ERROR_VALUE_IS_NULL
+#define SEA_TURTLE_STRING_VIEW_ERROR_OUT_IS_NULL \
+    SEA_URCHIN_ERROR_OUT_IS_NULL
+#define SEA_TURTLE_STRING_VIEW_ERROR_SIZE_IS_ZERO \
+    SEA_URCHIN_ERROR_VALUE_IS_ZERO
+#define SEA_TURTLE_STRING_VIEW_ERROR_CHAR_PTR_IS_MALFORMED \
+    SEA_URCHIN_ERROR_VALUE_IS_INVALID
+#define SEA_TURTLE_STRING_VIEW_ERROR_VIEW_IS_EMPTY \
+    SEA_URCHIN_ERROR_IS_EMPTY
+#define SEA_TURTLE_STRING_VIEW_ERROR_MEMORY_ALLOCATION_FAILED \
+    SEA_URCHIN_ERROR_MEMORY_ALLOCATION_FAILED
+#define SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_NULL \
+    SEA_URCHIN_ERROR_ITEM_IS_NULL
+#define SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_OUT_OF_BOUNDS \
+    SEA_URCHIN_ERROR_ITEM_IS_OUT_OF_BOUNDS
+#define SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_INVALID \
+    SEA_URCHIN_ERROR_VALUE_IS_INVALID
+#define SEA_TURTLE_STRING_VIEW_ERROR_END_OF_SEQUENCE \
+    SEA_URCHIN_ERROR_END_OF_SEQUENCE
+#define SEA_TURTLE_STRING_VIEW_ERROR_INDEX_IS_OUT_OF_BOUNDS \
+    SEA_URCHIN_ERROR_ITEM_IS_OUT_OF_BOUNDS
+#define SEA_TURTLE_STRING_VIEW_ERROR_COUNT_IS_OUT_OF_BOUNDS \
+    SEA_URCHIN_ERROR_VALUE_IS_OUT_OF_BOUNDS
+
+struct sea_turtle_string;
+
+/**
+ * @brief Borrowed UTF-8 encoded string.
+ * <p>A view refers to a valid UTF-8 sequence owned by someone else and
+ * never allocates memory. It is only valid for as long as the bytes it
+ * refers to are neither modified nor released. A view of a string that is
+ * stored in its local buffer refers to that particular string instance.</p>
+ * <p>Unlike a string, the <b>size</b> of a view does not include a
+ * <i>NULL</i> terminator and the bytes it refers to need not be
+ * <i>NULL</i> terminated.</p>
+ */
+struct sea_turtle_string_view {
+    const uint8_t *data;
+    size_t size;
+    uintmax_t count;
+};
+
+/**
+ * @brief Initialize view of an UTF-8 sequence.
+ * <p>The UTF-8 sequence is validated up to the first <i>NULL</i> char
+ * occurrence or <b>size</b> chars have been read.</p>
+ * @param [in] object instance to be initialized.
+ * @param [in] char_ptr UTF-8 sequence to refer to.
+ * @param [in] size upper limit in the number of chars to read up to.
+ * @param [out] out optionally receive the number of chars we have read up
+ * to.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_CHAR_PTR_IS_NULL if char_ptr is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_SIZE_IS_ZERO is size is zero.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_CHAR_PTR_IS_MALFORMED if char_ptr
+ * does not refer to a valid UTF-8 sequence.
+ */
+int sea_turtle_string_view_init(struct sea_turtle_string_view *object,
+                                const char *char_ptr,
+                                size_t size,
+                                size_t *out);
+
+/**
+ * @brief Initialize view of a string.
+ * @param [in] object instance to be initialized.
+ * @param [in] string whose value we will refer to.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_STRING_IS_NULL if string is
+ * <i>NULL</i>.
+ */
+int sea_turtle_string_view_init_string(
+        struct sea_turtle_string_view *object,
+        const struct sea_turtle_string *string);
+
+/**
+ * @brief Retrieve view of a range of code points.
+ * @param [in] object view instance.
+ * @param [in] index code point index of the first code point.
+ * @param [in] count number of code points.
+ * @param [out] out receive the view of the range of code points.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_INDEX_IS_OUT_OF_BOUNDS if index is
+ * greater than the count of code points.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_COUNT_IS_OUT_OF_BOUNDS if there are
+ * fewer than count code points from index onwards.
+ */
+int sea_turtle_string_view_substring(
+        const struct sea_turtle_string_view *object,
+        uintmax_t index,
+        uintmax_t count,
+        struct sea_turtle_string_view *out);
+
+/**
+ * @brief Copy the view into a string.
+ * @param [in] object view instance.
+ * @param [out] out receive the initialized string instance.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_MEMORY_ALLOCATION_FAILED if there is
+ * insufficient memory to initialize the string instance.
+ */
+int sea_turtle_string_view_to_string(
+        const struct sea_turtle_string_view *object,
+        struct sea_turtle_string *out);
+
+/**
+ * @brief Receive the count of code points.
+ * @param [in] object view instance.
+ * @param [out] out receive the count of code points.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ */
+int sea_turtle_string_view_count(const struct sea_turtle_string_view *object,
+                                 uintmax_t *out);
+
+/**
+ * @brief Comparison function for view.
+ * <p>Views are ordered the same way as strings with equal values.</p>
+ * @param [in] object view instance.
+ * @param [in] other view instance.
+ * @return <i>-1</i> if <b>object</b> is <u>less than</u> <b>other</b>,
+ * <i>0</i> if <b>object</b> is <u>equal to</u> <b>other</b> or <i>1</i> if
+ * <b>object</b> is <u>greater than</u> <b>other</b>.
+ * @note If <b>object</b> and <b>other</b> is <i>NULL</i> then abort(3) is
+ * called.
+ */
+int sea_turtle_string_view_compare(const struct sea_turtle_string_view *object,
+                                   const struct sea_turtle_string_view *other);
+
+/**
+ * @brief Compute the hash code.
+ * <p>The hash code is the same as that of a string with an equal value.
+ * It is computed anew on every call since views do not store it.</p>
+ * @param [in] object view instance.
+ * @param [out] out receive the hash code.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ */
+int sea_turtle_string_view_hash(const struct sea_turtle_string_view *object,
+                                uintmax_t *out);
+
+/**
+ * @brief Retrieve the first UTF-8 encoded symbol.
+ * @param [in] object view instance.
+ * @param [out] out receive the <u>address of</u> the first UTF-8 encoded
+ * symbol.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_VIEW_IS_EMPTY if view is empty.
+ */
+int sea_turtle_string_view_first(const struct sea_turtle_string_view *object,
+                                 const uint8_t **out);
+
+/**
+ * @brief Retrieve the last UTF-8 encoded symbol.
+ * @param [in] object view instance.
+ * @param [out] out receive the <u>address of</u> the last UTF-8 encoded
+ * symbol.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_VIEW_IS_EMPTY if view is empty.
+ */
+int sea_turtle_string_view_last(const struct sea_turtle_string_view *object,
+                                const uint8_t **out);
+
+/**
+ * @brief Retrieve the next UTF-8 encoded symbol.
+ * @param [in] object view instance.
+ * @param [in] at current UTF-8 encoded symbol.
+ * @param [out] out receive the <u>address of</u> the next UTF-8 encoded
+ * symbol.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_NULL if at is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_OUT_OF_BOUNDS if at does not
+ * refer to a UTF-8 encoded symbol contained within object.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_INVALID if at does not refer
+ * to a valid UTF-8 encoded symbol.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_END_OF_SEQUENCE if there are no more
+ * UTF-8 encoded symbols.
+ */
+int sea_turtle_string_view_next(const struct sea_turtle_string_view *object,
+                                const uint8_t *at,
+                                const uint8_t **out);
+
+/**
+ * @brief Retrieve the previous UTF-8 encoded symbol.
+ * @param [in] object view instance.
+ * @param [in] at current UTF-8 encoded symbol.
+ * @param [out] out receive the <u>address of</u> the previous UTF-8 encoded
+ * symbol.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_NULL if at is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_OUT_OF_BOUNDS if at does not
+ * refer to a UTF-8 encoded symbol contained within object.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_INVALID if at does not refer
+ * to a valid UTF-8 encoded symbol.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_END_OF_SEQUENCE if there are no more
+ * UTF-8 encoded symbols.
+ */
+int sea_turtle_string_view_prev(const struct sea_turtle_string_view *object,
+                                const uint8_t *at,
+                                const uint8_t **out);
+
+/**
+ * @brief Get code point from UTF-8 encoded symbol.
+ * @param [in] object view instance.
+ * @param [in] at UTF-8 encoded symbol.
+ * @param [out] out receive the code point for the UTF-8 encoded symbol.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL if object is
+ * <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_NULL if at is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_OUT_IS_NULL if out is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_OUT_OF_BOUNDS if at does not
+ * refer to a UTF-8 encoded symbol contained within object.
+ * @throws SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_INVALID if at does not refer
+ * to a valid UTF-8 encoded symbol.
+ */
+int sea_turtle_string_view_code_point(
+        const struct sea_turtle_string_view *object,
+        const uint8_t *at,
+        uint32_t *out);
+
+#endif /* _SEA_TURTLE_STRING_VIEW_H_ */
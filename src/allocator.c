@@ -0,0 +1,134 @@
+#include <stdlib.h>
+#include <pthread.h>
+#include <gmp.h>
+#include <sea-turtle.h>
+#include <seagrass.h>
+
+#include "private/allocator.h"
+
+#ifdef TEST
+#include <test/cmocka.h>
+#endif
+
+static _Thread_local const struct sea_turtle_allocator *current;
+
+/* GMP's memory functions in use before ours were installed */
+static void *(*gmp_allocate)(size_t);
+static void *(*gmp_reallocate)(void *, size_t, size_t);
+static void (*gmp_deallocate)(void *, size_t);
+static pthread_once_t gmp_once = PTHREAD_ONCE_INIT;
+
+/* GMP has no way to report failure so it must never be given NULL */
+static void *sea_turtle_allocator_gmp_allocate(const size_t size) {
+    if (!current) {
+        return gmp_allocate(size);
+    }
+    void *const ptr = current->allocate(current->context, size);
+    if (!ptr) {
+        abort();
+    }
+    return ptr;
+}
+
+static void *sea_turtle_allocator_gmp_reallocate(void *const ptr,
+                                                 const size_t size,
+                                                 const size_t new_size) {
+    if (!current) {
+        return gmp_reallocate(ptr, size, new_size);
+    }
+    void *const result = current->reallocate(current->context, ptr, size,
+                                             new_size);
+    if (!result) {
+        abort();
+    }
+    return result;
+}
+
+static void sea_turtle_allocator_gmp_deallocate(void *const ptr,
+                                                const size_t size) {
+    if (!current) {
+        gmp_deallocate(ptr, size);
+        return;
+    }
+    current->deallocate(current->context, ptr, size);
+}
+
+static void sea_turtle_allocator_gmp_install(void) {
+    mp_get_memory_functions(&gmp_allocate, &gmp_reallocate, &gmp_deallocate);
+    mp_set_memory_functions(sea_turtle_allocator_gmp_allocate,
+                            sea_turtle_allocator_gmp_reallocate,
+                            sea_turtle_allocator_gmp_deallocate);
+}
+
+int sea_turtle_allocator_set(const struct sea_turtle_allocator *const object) {
+    if (object
+        && (!object->allocate || !object->reallocate
+            || !object->deallocate)) {
+        return SEA_TURTLE_ALLOCATOR_ERROR_OBJECT_IS_INVALID;
+    }
+    seagrass_required_true(!pthread_once(
+            &gmp_once, sea_turtle_allocator_gmp_install));
+    current = object;
+    return 0;
+}
+
+int sea_turtle_allocator_get(const struct sea_turtle_allocator **const out) {
+    if (!out) {
+        return SEA_TURTLE_ALLOCATOR_ERROR_OUT_IS_NULL;
+    }
+    *out = current;
+    return 0;
+}
+
+const struct sea_turtle_allocator *sea_turtle_allocator_current(void) {
+    return current;
+}
+
+void *sea_turtle_allocator_allocate(
+        const struct sea_turtle_allocator *const allocator,
+        const size_t size) {
+    return allocator
+           ? allocator->allocate(allocator->context, size)
+           : malloc(size);
+}
+
+void sea_turtle_allocator_deallocate(
+        const struct sea_turtle_allocator *const allocator,
+        void *const ptr,
+        const size_t size) {
+    if (!ptr) {
+        return;
+    }
+    if (allocator) {
+        allocator->deallocate(allocator->context, ptr, size);
+    } else {
+        free(ptr);
+    }
+}
+
+void *sea_turtle_allocator_reallocate(
+        const struct sea_turtle_allocator *const allocator,
+        void *const ptr,
+        const size_t size,
+        const size_t new_size) {
+    if (!allocator) {
+        return realloc(ptr, new_size);
+    }
+    return ptr
+           ? allocator->reallocate(allocator->context, ptr, size, new_size)
+           : allocator->allocate(allocator->context, new_size);
+}
+
+void *sea_turtle_allocate(const size_t size) {
+    return sea_turtle_allocator_allocate(current, size);
+}
+
+void *sea_turtle_reallocate(void *const ptr,
+                            const size_t size,
+                            const size_t new_size) {
+    return sea_turtle_allocator_reallocate(current, ptr, size, new_size);
+}
+
+void sea_turtle_deallocate(void *const ptr, const size_t size) {
+    sea_turtle_allocator_deallocate(current, ptr, size);
+}
@@ -0,0 +1,400 @@
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <seagrass.h>
+
+#include "private/hash.h"
+
+#if defined(SEA_TURTLE_HASH_X86)
+#include <immintrin.h>
+#endif
+
+#ifdef TEST
+#include <test/cmocka.h>
+#endif
+
+/*
+ * Inputs of up to SEA_TURTLE_HASH_LONG bytes are hashed 16 bytes at a time
+ * by folding them into a wide multiplication, as done by wyhash. Longer
+ * inputs are split into stripes of 64 bytes whose eight 64-bit lanes are
+ * accumulated independently, as done by XXH3, which maps directly onto SIMD
+ * registers. Every key is derived from the seed so that colliding inputs
+ * cannot be crafted without knowing it.
+ */
+#define SEA_TURTLE_HASH_W0 UINT64_C(0xA0761D6478BD642F)
+#define SEA_TURTLE_HASH_W1 UINT64_C(0xE7037ED1A0B428DB)
+#define SEA_TURTLE_HASH_W2 UINT64_C(0x8EBC6AF09C88C6E3)
+#define SEA_TURTLE_HASH_W3 UINT64_C(0x589965CC75374CC3)
+
+#define SEA_TURTLE_HASH_P32_1 UINT64_C(0x9E3779B1)
+#define SEA_TURTLE_HASH_P32_2 UINT64_C(0x85EBCA77)
+#define SEA_TURTLE_HASH_P32_3 UINT64_C(0xC2B2AE3D)
+#define SEA_TURTLE_HASH_P64_1 UINT64_C(0x9E3779B185EBCA87)
+#define SEA_TURTLE_HASH_P64_2 UINT64_C(0xC2B2AE3D27D4EB4F)
+#define SEA_TURTLE_HASH_P64_3 UINT64_C(0x165667B19E3779F9)
+#define SEA_TURTLE_HASH_P64_4 UINT64_C(0x85EBCA77C2B2AE63)
+#define SEA_TURTLE_HASH_P64_5 UINT64_C(0x27D4EB2F165667C5)
+
+#define SEA_TURTLE_HASH_STRIPE (8 * SEA_TURTLE_HASH_LANES)
+#define SEA_TURTLE_HASH_BLOCK \
+    (SEA_TURTLE_HASH_STRIPES * SEA_TURTLE_HASH_STRIPE)
+
+static inline uint64_t sea_turtle_hash_read64(const uint8_t *const at) {
+    uint64_t value;
+    memcpy(&value, at, sizeof(value));
+    return value;
+}
+
+static inline uint64_t sea_turtle_hash_read32(const uint8_t *const at) {
+    uint32_t value;
+    memcpy(&value, at, sizeof(value));
+    return value;
+}
+
+/* fold the 128-bit product of a and b into 64 bits */
+static inline uint64_t sea_turtle_hash_mix(const uint64_t a,
+                                           const uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 product = (unsigned __int128) a * b;
+    return (uint64_t) product ^ (uint64_t) (product >> 64);
+#else
+    const uint64_t mask = UINT64_C(0xFFFFFFFF);
+    const uint64_t lo_lo = (a & mask) * (b & mask);
+    const uint64_t hi_lo = (a >> 32) * (b & mask);
+    const uint64_t lo_hi = (a & mask) * (b >> 32);
+    const uint64_t hi_hi = (a >> 32) * (b >> 32);
+    const uint64_t cross = (lo_lo >> 32) + (hi_lo & mask) + lo_hi;
+    const uint64_t upper = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+    const uint64_t lower = (cross << 32) | (lo_lo & mask);
+    return lower ^ upper;
+#endif
+}
+
+static inline uint64_t sea_turtle_hash_avalanche(uint64_t h) {
+    h ^= h >> 37;
+    h *= SEA_TURTLE_HASH_P64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+/* https://prng.di.unimi.it/splitmix64.c */
+static uint64_t sea_turtle_hash_splitmix(uint64_t *const state) {
+    uint64_t z = (*state += UINT64_C(0x9E3779B97F4A7C15));
+    z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+    return z ^ (z >> 31);
+}
+
+void sea_turtle_hash_secret_init(struct sea_turtle_hash_secret *const object,
+                                 const uint64_t seed) {
+    uint64_t state = seed;
+    object->seed = seed;
+    object->state = seed ^ sea_turtle_hash_mix(seed ^ SEA_TURTLE_HASH_W0,
+                                               SEA_TURTLE_HASH_W1);
+    for (size_t i = 0; i < sizeof(object->keys) / sizeof(object->keys[0]);
+         i++) {
+        object->keys[i] = sea_turtle_hash_splitmix(&state);
+    }
+    for (size_t i = 0; i < sizeof(object->merge) / sizeof(object->merge[0]);
+         i++) {
+        object->merge[i] = sea_turtle_hash_splitmix(&state);
+    }
+}
+
+void sea_turtle_hash_accumulate_scalar(uint64_t acc[SEA_TURTLE_HASH_LANES],
+                                       const uint8_t *const begin,
+                                       const uint64_t *const keys,
+                                       const size_t stripes) {
+    for (size_t s = 0; s < stripes; s++) {
+        const uint8_t *const at = begin + s * SEA_TURTLE_HASH_STRIPE;
+        for (size_t i = 0; i < SEA_TURTLE_HASH_LANES; i++) {
+            const uint64_t value = sea_turtle_hash_read64(at + 8 * i);
+            const uint64_t key = value ^ keys[s + i];
+            acc[i ^ 1] += value;
+            acc[i] += (key & UINT64_C(0xFFFFFFFF)) * (key >> 32);
+        }
+    }
+}
+
+void sea_turtle_hash_scramble_scalar(uint64_t acc[SEA_TURTLE_HASH_LANES],
+                                     const uint64_t *const keys) {
+    for (size_t i = 0; i < SEA_TURTLE_HASH_LANES; i++) {
+        uint64_t lane = acc[i];
+        lane ^= lane >> 47;
+        lane ^= keys[i];
+        acc[i] = lane * SEA_TURTLE_HASH_P32_1;
+    }
+}
+
+#if defined(SEA_TURTLE_HASH_X86)
+__attribute__((target("sse2")))
+void sea_turtle_hash_accumulate_sse2(uint64_t acc[SEA_TURTLE_HASH_LANES],
+                                     const uint8_t *const begin,
+                                     const uint64_t *const keys,
+                                     const size_t stripes) {
+    __m128i lanes[SEA_TURTLE_HASH_LANES / 2];
+    for (size_t i = 0; i < SEA_TURTLE_HASH_LANES / 2; i++) {
+        lanes[i] = _mm_loadu_si128((const __m128i *) (acc + 2 * i));
+    }
+    for (size_t s = 0; s < stripes; s++) {
+        const uint8_t *const at = begin + s * SEA_TURTLE_HASH_STRIPE;
+        for (size_t i = 0; i < SEA_TURTLE_HASH_LANES / 2; i++) {
+            const __m128i value = _mm_loadu_si128(
+                    (const __m128i *) (at + 16 * i));
+            const __m128i key = _mm_xor_si128(value, _mm_loadu_si128(
+                    (const __m128i *) (keys + s + 2 * i)));
+            const __m128i product = _mm_mul_epu32(
+                    key, _mm_srli_epi64(key, 32));
+            /* swap the 64-bit halves so that lane i receives lane i ^ 1 */
+            const __m128i swapped = _mm_shuffle_epi32(
+                    value, _MM_SHUFFLE(1, 0, 3, 2));
+            lanes[i] = _mm_add_epi64(lanes[i],
+                                     _mm_add_epi64(product, swapped));
+        }
+    }
+    for (size_t i = 0; i < SEA_TURTLE_HASH_LANES / 2; i++) {
+        _mm_storeu_si128((__m128i *) (acc + 2 * i), lanes[i]);
+    }
+}
+
+__attribute__((target("sse2")))
+void sea_turtle_hash_scramble_sse2(uint64_t acc[SEA_TURTLE_HASH_LANES],
+                                   const uint64_t *const keys) {
+    const __m128i prime = _mm_set1_epi32((int) SEA_TURTLE_HASH_P32_1);
+    for (size_t i = 0; i < SEA_TURTLE_HASH_LANES / 2; i++) {
+        __m128i lane = _mm_loadu_si128((const __m128i *) (acc + 2 * i));
+        lane = _mm_xor_si128(lane, _mm_srli_epi64(lane, 47));
+        lane = _mm_xor_si128(lane, _mm_loadu_si128(
+                (const __m128i *) (keys + 2 * i)));
+        /* 64-bit by 32-bit multiplication out of two 32-bit ones */
+        const __m128i low = _mm_mul_epu32(lane, prime);
+        const __m128i high = _mm_mul_epu32(_mm_srli_epi64(lane, 32), prime);
+        lane = _mm_add_epi64(low, _mm_slli_epi64(high, 32));
+        _mm_storeu_si128((__m128i *) (acc + 2 * i), lane);
+    }
+}
+
+__attribute__((target("avx2")))
+void sea_turtle_hash_accumulate_avx2(uint64_t acc[SEA_TURTLE_HASH_LANES],
+                                     const uint8_t *const begin,
+                                     const uint64_t *const keys,
+                                     const size_t stripes) {
+    __m256i lanes[SEA_TURTLE_HASH_LANES / 4];
+    for (size_t i = 0; i < SEA_TURTLE_HASH_LANES / 4; i++) {
+        lanes[i] = _mm256_loadu_si256((const __m256i *) (acc + 4 * i));
+    }
+    for (size_t s = 0; s < stripes; s++) {
+        const uint8_t *const at = begin + s * SEA_TURTLE_HASH_STRIPE;
+        for (size_t i = 0; i < SEA_TURTLE_HASH_LANES / 4; i++) {
+            const __m256i value = _mm256_loadu_si256(
+                    (const __m256i *) (at + 32 * i));
+            const __m256i key = _mm256_xor_si256(value, _mm256_loadu_si256(
+                    (const __m256i *) (keys + s + 4 * i)));
+            const __m256i product = _mm256_mul_epu32(
+                    key, _mm256_srli_epi64(key, 32));
+            /* swap the 64-bit halves so that lane i receives lane i ^ 1 */
+            const __m256i swapped = _mm256_shuffle_epi32(
+                    value, _MM_SHUFFLE(1, 0, 3, 2));
+            lanes[i] = _mm256_add_epi64(lanes[i],
+                                        _mm256_add_epi64(product, swapped));
+        }
+    }
+    for (size_t i = 0; i < SEA_TURTLE_HASH_LANES / 4; i++) {
+        _mm256_storeu_si256((__m256i *) (acc + 4 * i), lanes[i]);
+    }
+}
+
+__attribute__((target("avx2")))
+void sea_turtle_hash_scramble_avx2(uint64_t acc[SEA_TURTLE_HASH_LANES],
+                                   const uint64_t *const keys) {
+    const __m256i prime = _mm256_set1_epi32((int) SEA_TURTLE_HASH_P32_1);
+    for (size_t i = 0; i < SEA_TURTLE_HASH_LANES / 4; i++) {
+        __m256i lane = _mm256_loadu_si256((const __m256i *) (acc + 4 * i));
+        lane = _mm256_xor_si256(lane, _mm256_srli_epi64(lane, 47));
+        lane = _mm256_xor_si256(lane, _mm256_loadu_si256(
+                (const __m256i *) (keys + 4 * i)));
+        /* 64-bit by 32-bit multiplication out of two 32-bit ones */
+        const __m256i low = _mm256_mul_epu32(lane, prime);
+        const __m256i high = _mm256_mul_epu32(_mm256_srli_epi64(lane, 32),
+                                              prime);
+        lane = _mm256_add_epi64(low, _mm256_slli_epi64(high, 32));
+        _mm256_storeu_si256((__m256i *) (acc + 4 * i), lane);
+    }
+}
+#endif /* defined(SEA_TURTLE_HASH_X86) */
+
+static void (*sea_turtle_hash_accumulate)(
+        uint64_t *, const uint8_t *, const uint64_t *, size_t)
+        = sea_turtle_hash_accumulate_scalar;
+static void (*sea_turtle_hash_scramble)(uint64_t *, const uint64_t *)
+        = sea_turtle_hash_scramble_scalar;
+static struct sea_turtle_hash_secret sea_turtle_hash_secret;
+static pthread_once_t sea_turtle_hash_once = PTHREAD_ONCE_INIT;
+
+/* read the seed from the operating system without allocating memory */
+static uint64_t sea_turtle_hash_entropy(void) {
+    uint64_t seed = 0;
+    const int fd = open("/dev/urandom", O_RDONLY | O_CLOEXEC);
+    if (fd >= 0) {
+        if (sizeof(seed) != read(fd, &seed, sizeof(seed))) {
+            seed = 0;
+        }
+        close(fd);
+    }
+    if (!seed) {
+        /* addresses and time still vary from one process to the next */
+        struct timespec now;
+        seagrass_required_true(!clock_gettime(CLOCK_REALTIME, &now));
+        uint64_t state = (uint64_t) (uintptr_t) &seed;
+        seed = sea_turtle_hash_splitmix(&state)
+               ^ ((uint64_t) now.tv_sec * SEA_TURTLE_HASH_P64_1)
+               ^ (uint64_t) now.tv_nsec
+               ^ ((uint64_t) getpid() << 32);
+    }
+    return seed;
+}
+
+static void sea_turtle_hash_init(void) {
+    sea_turtle_hash_secret_init(&sea_turtle_hash_secret,
+                                sea_turtle_hash_entropy());
+#if defined(SEA_TURTLE_HASH_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        sea_turtle_hash_accumulate = sea_turtle_hash_accumulate_avx2;
+        sea_turtle_hash_scramble = sea_turtle_hash_scramble_avx2;
+    } else if (__builtin_cpu_supports("sse2")) {
+        sea_turtle_hash_accumulate = sea_turtle_hash_accumulate_sse2;
+        sea_turtle_hash_scramble = sea_turtle_hash_scramble_sse2;
+    }
+#endif
+}
+
+static uint64_t sea_turtle_hash_short(
+        const struct sea_turtle_hash_secret *const secret,
+        const uint8_t *const begin,
+        const size_t length,
+        uint64_t *const high) {
+    uint64_t a;
+    uint64_t b;
+    uint64_t s = secret->state;
+    uint64_t t = secret->state ^ SEA_TURTLE_HASH_W2;
+    if (length <= 16) {
+        if (length >= 4) {
+            /* overlapping reads cover every byte of 4 up to 16 bytes */
+            const size_t o = (length >> 3) << 2;
+            a = (sea_turtle_hash_read32(begin) << 32)
+                | sea_turtle_hash_read32(begin + o);
+            b = (sea_turtle_hash_read32(begin + length - 4) << 32)
+                | sea_turtle_hash_read32(begin + length - 4 - o);
+        } else {
+            a = ((uint64_t) begin[0] << 16)
+                | ((uint64_t) begin[length >> 1] << 8)
+                | begin[length - 1];
+            b = 0;
+        }
+    } else {
+        const uint8_t *at = begin;
+        for (size_t i = length; i > 16; i -= 16, at += 16) {
+            const uint64_t x = sea_turtle_hash_read64(at);
+            const uint64_t y = sea_turtle_hash_read64(at + 8);
+            s = sea_turtle_hash_mix(x ^ SEA_TURTLE_HASH_W1, y ^ s);
+            if (high) {
+                t = sea_turtle_hash_mix(x ^ SEA_TURTLE_HASH_W3, y ^ t);
+            }
+        }
+        a = sea_turtle_hash_read64(begin + length - 16);
+        b = sea_turtle_hash_read64(begin + length - 8);
+    }
+    if (high) {
+        *high = sea_turtle_hash_mix(
+                SEA_TURTLE_HASH_W2 ^ length,
+                sea_turtle_hash_mix(a ^ SEA_TURTLE_HASH_W3, b ^ t));
+    }
+    return sea_turtle_hash_mix(
+            SEA_TURTLE_HASH_W1 ^ length,
+            sea_turtle_hash_mix(a ^ SEA_TURTLE_HASH_W1, b ^ s));
+}
+
+static uint64_t sea_turtle_hash_merge(const uint64_t *const acc,
+                                      const uint64_t *const keys,
+                                      uint64_t h) {
+    for (size_t i = 0; i < SEA_TURTLE_HASH_LANES; i += 2) {
+        h += sea_turtle_hash_mix(acc[i] ^ keys[i],
+                                 acc[1 + i] ^ keys[1 + i]);
+    }
+    return sea_turtle_hash_avalanche(h);
+}
+
+static uint64_t sea_turtle_hash_long(
+        const struct sea_turtle_hash_secret *const secret,
+        const uint8_t *const begin,
+        const size_t length,
+        uint64_t *const high) {
+    uint64_t acc[SEA_TURTLE_HASH_LANES] = {
+            SEA_TURTLE_HASH_P32_3, SEA_TURTLE_HASH_P64_1,
+            SEA_TURTLE_HASH_P64_2, SEA_TURTLE_HASH_P64_3,
+            SEA_TURTLE_HASH_P64_4, SEA_TURTLE_HASH_P32_2,
+            SEA_TURTLE_HASH_P64_5, SEA_TURTLE_HASH_P32_1
+    };
+    /* the last stripe is always processed on its own */
+    const size_t blocks = (length - 1) / SEA_TURTLE_HASH_BLOCK;
+    const uint8_t *at = begin;
+    for (size_t i = 0; i < blocks; i++, at += SEA_TURTLE_HASH_BLOCK) {
+        sea_turtle_hash_accumulate(acc, at, secret->keys,
+                                   SEA_TURTLE_HASH_STRIPES);
+        sea_turtle_hash_scramble(acc,
+                                 secret->keys + SEA_TURTLE_HASH_STRIPES);
+    }
+    const size_t stripes = (size_t) (begin + length - 1 - at)
+                           / SEA_TURTLE_HASH_STRIPE;
+    sea_turtle_hash_accumulate(acc, at, secret->keys, stripes);
+    sea_turtle_hash_accumulate(acc,
+                               begin + length - SEA_TURTLE_HASH_STRIPE,
+                               secret->keys + SEA_TURTLE_HASH_LANES - 1, 1);
+    if (high) {
+        *high = sea_turtle_hash_merge(acc,
+                                      secret->merge + SEA_TURTLE_HASH_LANES,
+                                      ~(length * SEA_TURTLE_HASH_P64_2));
+    }
+    return sea_turtle_hash_merge(acc, secret->merge,
+                                 length * SEA_TURTLE_HASH_P64_1);
+}
+
+uint64_t sea_turtle_hash_with_secret(
+        const struct sea_turtle_hash_secret *const secret,
+        const uint8_t *const begin,
+        const size_t length,
+        uint64_t *const high) {
+    seagrass_required_true(!pthread_once(&sea_turtle_hash_once,
+                                         sea_turtle_hash_init));
+    if (!length) {
+        /* matches the hash code of an empty string */
+        if (high) {
+            *high = 0;
+        }
+        return 0;
+    }
+    return length <= SEA_TURTLE_HASH_LONG
+           ? sea_turtle_hash_short(secret, begin, length, high)
+           : sea_turtle_hash_long(secret, begin, length, high);
+}
+
+uint64_t sea_turtle_hash_seed(void) {
+    seagrass_required_true(!pthread_once(&sea_turtle_hash_once,
+                                         sea_turtle_hash_init));
+    return sea_turtle_hash_secret.seed;
+}
+
+uint64_t sea_turtle_hash(const uint8_t *const begin, const size_t length) {
+    return sea_turtle_hash_with_secret(&sea_turtle_hash_secret, begin,
+                                       length, NULL);
+}
+
+void sea_turtle_hash_128(const uint8_t *const begin,
+                         const size_t length,
+                         uint64_t out[2]) {
+    out[0] = sea_turtle_hash_with_secret(&sea_turtle_hash_secret, begin,
+                                         length, &out[1]);
+}
@@ -0,0 +1,74 @@
+#ifndef _SEA_TURTLE_PRIVATE_ALLOCATOR_H_
+#define _SEA_TURTLE_PRIVATE_ALLOCATOR_H_
+
+#include <stddef.h>
+
+struct sea_turtle_allocator;
+
+/**
+ * @brief Retrieve the allocator of the calling thread.
+ * @return allocator or <i>NULL</i> if the default allocator is in use.
+ */
+const struct sea_turtle_allocator *sea_turtle_allocator_current(void);
+
+/**
+ * @brief Allocate memory from the given allocator.
+ * @param [in] allocator allocator or <i>NULL</i> for the default allocator.
+ * @param [in] size number of bytes.
+ * @return memory block or <i>NULL</i> on failure.
+ */
+void *sea_turtle_allocator_allocate(
+        const struct sea_turtle_allocator *allocator,
+        size_t size);
+
+/**
+ * @brief Resize memory using the given allocator.
+ * @param [in] allocator allocator or <i>NULL</i> for the default allocator.
+ * @param [in] ptr memory block or <i>NULL</i> to allocate a new one.
+ * @param [in] size number of bytes of the memory block.
+ * @param [in] new_size number of bytes the memory block should have.
+ * @return resized memory block or <i>NULL</i> on failure in which case the
+ * memory block is left untouched.
+ */
+void *sea_turtle_allocator_reallocate(
+        const struct sea_turtle_allocator *allocator,
+        void *ptr,
+        size_t size,
+        size_t new_size);
+
+/**
+ * @brief Release memory to the given allocator.
+ * @param [in] allocator allocator or <i>NULL</i> for the default allocator.
+ * @param [in] ptr memory block which may be <i>NULL</i>.
+ * @param [in] size number of bytes of the memory block.
+ */
+void sea_turtle_allocator_deallocate(
+        const struct sea_turtle_allocator *allocator,
+        void *ptr,
+        size_t size);
+
+/**
+ * @brief Allocate memory from the allocator of the calling thread.
+ * @param [in] size number of bytes.
+ * @return memory block or <i>NULL</i> on failure.
+ */
+void *sea_turtle_allocate(size_t size);
+
+/**
+ * @brief Resize memory using the allocator of the calling thread.
+ * @param [in] ptr memory block or <i>NULL</i> to allocate a new one.
+ * @param [in] size number of bytes of the memory block.
+ * @param [in] new_size number of bytes the memory block should have.
+ * @return resized memory block or <i>NULL</i> on failure in which case the
+ * memory block is left untouched.
+ */
+void *sea_turtle_reallocate(void *ptr, size_t size, size_t new_size);
+
+/**
+ * @brief Release memory to the allocator of the calling thread.
+ * @param [in] ptr memory block which may be <i>NULL</i>.
+ * @param [in] size number of bytes of the memory block.
+ */
+void sea_turtle_deallocate(void *ptr, size_t size);
+
+#endif /* _SEA_TURTLE_PRIVATE_ALLOCATOR_H_ */
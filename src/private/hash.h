@@ -0,0 +1,133 @@
+#ifndef _SEA_TURTLE_PRIVATE_HASH_H_
+#define _SEA_TURTLE_PRIVATE_HASH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SEA_TURTLE_HASH_X86 1
+#endif
+
+/* number of 64-bit lanes in a stripe of 64 bytes */
+#define SEA_TURTLE_HASH_LANES 8
+/* number of stripes accumulated before the lanes are scrambled */
+#define SEA_TURTLE_HASH_STRIPES 16
+/* inputs longer than this are hashed in stripes */
+#define SEA_TURTLE_HASH_LONG 256
+
+/**
+ * @brief Keys derived from the seed of the hash function.
+ */
+struct sea_turtle_hash_secret {
+    uint64_t seed;
+    uint64_t state;
+    uint64_t keys[SEA_TURTLE_HASH_STRIPES + SEA_TURTLE_HASH_LANES];
+    uint64_t merge[2 * SEA_TURTLE_HASH_LANES];
+};
+
+/**
+ * @brief Derive the keys of the hash function from seed.
+ * @param [out] object receive the keys.
+ * @param [in] seed value from which the keys are derived.
+ */
+void sea_turtle_hash_secret_init(struct sea_turtle_hash_secret *object,
+                                 uint64_t seed);
+
+/**
+ * @brief Retrieve the seed of the hash function.
+ * <p>The seed is read from the random number generator of the operating
+ * system on first use and remains the same for the lifetime of the
+ * process.</p>
+ * @return seed of the hash function.
+ */
+uint64_t sea_turtle_hash_seed(void);
+
+/**
+ * @brief Hash bytes using the seed of the process.
+ * @param [in] begin first byte.
+ * @param [in] length number of bytes.
+ * @return hash code of the bytes which is <i>0</i> if length is <i>0</i>.
+ */
+uint64_t sea_turtle_hash(const uint8_t *begin, size_t length);
+
+/**
+ * @brief Hash bytes into 128 bits using the seed of the process.
+ * @param [in] begin first byte.
+ * @param [in] length number of bytes.
+ * @param [out] out receive the low 64 bits, which are the same as those
+ * computed by sea_turtle_hash(), followed by the high 64 bits.
+ */
+void sea_turtle_hash_128(const uint8_t *begin, size_t length,
+                         uint64_t out[2]);
+
+/**
+ * @brief Hash bytes using the given keys.
+ * @param [in] secret keys of the hash function.
+ * @param [in] begin first byte.
+ * @param [in] length number of bytes.
+ * @param [out] high receive the high 64 bits of the 128-bit hash code, or
+ * <i>NULL</i> if only the low 64 bits are needed.
+ * @return low 64 bits of the hash code.
+ */
+uint64_t sea_turtle_hash_with_secret(
+        const struct sea_turtle_hash_secret *secret,
+        const uint8_t *begin,
+        size_t length,
+        uint64_t *high);
+
+/**
+ * @brief Portable implementation of the stripe accumulation kernel.
+ * @param [in,out] acc accumulator lanes.
+ * @param [in] begin first byte of <b>stripes</b> stripes of 64 bytes.
+ * @param [in] keys keys of the first stripe, each subsequent stripe uses
+ * keys offset by one more.
+ * @param [in] stripes number of stripes.
+ */
+void sea_turtle_hash_accumulate_scalar(uint64_t acc[SEA_TURTLE_HASH_LANES],
+                                       const uint8_t *begin,
+                                       const uint64_t *keys,
+                                       size_t stripes);
+
+/**
+ * @brief Portable implementation of the lane scrambling kernel.
+ * @param [in,out] acc accumulator lanes.
+ * @param [in] keys one key per lane.
+ */
+void sea_turtle_hash_scramble_scalar(uint64_t acc[SEA_TURTLE_HASH_LANES],
+                                     const uint64_t *keys);
+
+#if defined(SEA_TURTLE_HASH_X86)
+/**
+ * @brief SSE2 implementation of the stripe accumulation kernel.
+ * @note Must only be called if the CPU supports SSE2.
+ */
+void sea_turtle_hash_accumulate_sse2(uint64_t acc[SEA_TURTLE_HASH_LANES],
+                                     const uint8_t *begin,
+                                     const uint64_t *keys,
+                                     size_t stripes);
+
+/**
+ * @brief SSE2 implementation of the lane scrambling kernel.
+ * @note Must only be called if the CPU supports SSE2.
+ */
+void sea_turtle_hash_scramble_sse2(uint64_t acc[SEA_TURTLE_HASH_LANES],
+                                   const uint64_t *keys);
+
+/**
+ * @brief AVX2 implementation of the stripe accumulation kernel.
+ * @note Must only be called if the CPU supports AVX2.
+ */
+void sea_turtle_hash_accumulate_avx2(uint64_t acc[SEA_TURTLE_HASH_LANES],
+                                     const uint8_t *begin,
+                                     const uint64_t *keys,
+                                     size_t stripes);
+
+/**
+ * @brief AVX2 implementation of the lane scrambling kernel.
+ * @note Must only be called if the CPU supports AVX2.
+ */
+void sea_turtle_hash_scramble_avx2(uint64_t acc[SEA_TURTLE_HASH_LANES],
+                                   const uint64_t *keys);
+#endif
+
+#endif /* _SEA_TURTLE_PRIVATE_HASH_H_ */
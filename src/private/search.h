@@ -0,0 +1,102 @@
+#ifndef _SEA_TURTLE_PRIVATE_SEARCH_H_
+#define _SEA_TURTLE_PRIVATE_SEARCH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SEA_TURTLE_SEARCH_X86 1
+#endif
+
+/**
+ * @brief Longest needle searched for by filtering candidate positions on
+ * their first and last byte, longer needles are searched for with the
+ * Two-Way algorithm which runs in linear time whatever their content.
+ */
+#define SEA_TURTLE_SEARCH_SHORT 32
+
+/**
+ * @brief Find the first occurrence of needle in haystack.
+ * <p>The implementation best suited to the running CPU is selected on first
+ * use.</p>
+ * @param [in] haystack first byte to search through.
+ * @param [in] length number of bytes in haystack.
+ * @param [in] needle first byte of the sequence to search for.
+ * @param [in] size number of bytes in needle which must not be zero.
+ * @return address of the first occurrence or <i>NULL</i> if there is none.
+ */
+const uint8_t *sea_turtle_search_forward(const uint8_t *haystack,
+                                         size_t length,
+                                         const uint8_t *needle,
+                                         size_t size);
+
+/**
+ * @brief Find the last occurrence of needle in haystack.
+ * @param [in] haystack first byte to search through.
+ * @param [in] length number of bytes in haystack.
+ * @param [in] needle first byte of the sequence to search for.
+ * @param [in] size number of bytes in needle which must not be zero.
+ * @return address of the last occurrence or <i>NULL</i> if there is none.
+ */
+const uint8_t *sea_turtle_search_backward(const uint8_t *haystack,
+                                          size_t length,
+                                          const uint8_t *needle,
+                                          size_t size);
+
+/**
+ * @brief Portable implementation of the short needle search kernels.
+ */
+const uint8_t *sea_turtle_search_forward_scalar(const uint8_t *haystack,
+                                                size_t length,
+                                                const uint8_t *needle,
+                                                size_t size);
+
+const uint8_t *sea_turtle_search_backward_scalar(const uint8_t *haystack,
+                                                 size_t length,
+                                                 const uint8_t *needle,
+                                                 size_t size);
+
+/**
+ * @brief Two-Way implementation of the search, used for long needles.
+ */
+const uint8_t *sea_turtle_search_forward_two_way(const uint8_t *haystack,
+                                                 size_t length,
+                                                 const uint8_t *needle,
+                                                 size_t size);
+
+const uint8_t *sea_turtle_search_backward_two_way(const uint8_t *haystack,
+                                                  size_t length,
+                                                  const uint8_t *needle,
+                                                  size_t size);
+
+#if defined(SEA_TURTLE_SEARCH_X86)
+/**
+ * @brief SSE4.2 implementation of the short needle search kernels.
+ * @note Must only be called if the CPU supports SSE4.2.
+ */
+const uint8_t *sea_turtle_search_forward_sse42(const uint8_t *haystack,
+                                               size_t length,
+                                               const uint8_t *needle,
+                                               size_t size);
+
+const uint8_t *sea_turtle_search_backward_sse42(const uint8_t *haystack,
+                                                size_t length,
+                                                const uint8_t *needle,
+                                                size_t size);
+
+/**
+ * @brief AVX2 implementation of the short needle search kernels.
+ * @note Must only be called if the CPU supports AVX2.
+ */
+const uint8_t *sea_turtle_search_forward_avx2(const uint8_t *haystack,
+                                              size_t length,
+                                              const uint8_t *needle,
+                                              size_t size);
+
+const uint8_t *sea_turtle_search_backward_avx2(const uint8_t *haystack,
+                                               size_t length,
+                                               const uint8_t *needle,
+                                               size_t size);
+#endif
+
+#endif /* _SEA_TURTLE_PRIVATE_SEARCH_H_ */
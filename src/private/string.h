@@ -4,8 +4,39 @@
 #include <stddef.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <limits.h>
+#include <stdatomic.h>
 #include <sea-turtle.h>
 
+/* number of bits of the count of code points below the storage */
+#define SEA_TURTLE_STRING_COUNT_BITS (sizeof(uintmax_t) * CHAR_BIT - 3)
+#define SEA_TURTLE_STRING_COUNT_MAX (UINTMAX_MAX >> 3)
+
+/* largest size of a string, so that its count of code points leaves the
+ * top bits of its word to the storage */
+#define SEA_TURTLE_STRING_SIZE_MAX \
+    (SEA_TURTLE_STRING_COUNT_MAX < SIZE_MAX \
+     ? (size_t) SEA_TURTLE_STRING_COUNT_MAX \
+     : SIZE_MAX)
+
+/**
+ * @brief Header ahead of the buffer of a string that owns or shares it.
+ * <p>Heap and shared buffers directly follow their header. The header of a
+ * file mapping has the page ahead of the mapped file region to itself.</p>
+ */
+struct sea_turtle_string_buffer {
+    /* number of strings referring to a shared buffer */
+    atomic_size_t references;
+    /* allocator the buffer came from, so it may be released from any thread */
+    const struct sea_turtle_allocator *allocator;
+    /* number of bytes allocated for data, or of the whole mapping */
+    size_t capacity;
+    /* byte offset of every SEA_TURTLE_STRING_INDEX_INTERVAL-th code point,
+     * or NULL if not yet built */
+    size_t *index;
+    uint8_t data[];
+};
+
 /**
  * @brief Check if char sequence contains a valid UTF-8 sequence.
  * @param [in] char_ptr pointer to char sequence.
@@ -26,10 +57,158 @@ int sea_turtle_string_is_utf8_sequence(const char *char_ptr,
                                        size_t *out,
                                        uintmax_t *count);
 
+/**
+ * @brief Check if the string is stored in its local buffer.
+ * @param [in] object string instance.
+ * @return <i>true</i> if the string is stored locally, which follows from
+ * its size alone, otherwise <i>false</i>.
+ */
+static inline bool sea_turtle_string_is_local(
+        const struct sea_turtle_string *const object) {
+    return object->size && object->size <= SEA_TURTLE_STRING_LOCAL_SIZE;
+}
+
+/**
+ * @brief Retrieve the storage.
+ * @param [in] object string instance.
+ * @return the storage of the string.
+ */
+static inline enum sea_turtle_string_storage sea_turtle_string_storage_of(
+        const struct sea_turtle_string *const object) {
+    return sea_turtle_string_is_local(object)
+           ? SEA_TURTLE_STRING_STORAGE_LOCAL
+           : (enum sea_turtle_string_storage)
+                   (object->tagged_count >> SEA_TURTLE_STRING_COUNT_BITS);
+}
+
+/**
+ * @brief Set the storage of a string that is not stored locally.
+ * <p>The size of the string must have been set beforehand.</p>
+ * @param [in] object string instance.
+ * @param [in] storage storage other than local.
+ */
+static inline void sea_turtle_string_set_storage(
+        struct sea_turtle_string *const object,
+        const enum sea_turtle_string_storage storage) {
+    object->tagged_count = (object->tagged_count
+                            & SEA_TURTLE_STRING_COUNT_MAX)
+                           | (uintmax_t) storage
+                             << SEA_TURTLE_STRING_COUNT_BITS;
+}
+
+/**
+ * @brief Retrieve the count of code points.
+ * @param [in] object string instance.
+ * @return the count of code points.
+ */
+static inline uintmax_t sea_turtle_string_count_of(
+        const struct sea_turtle_string *const object) {
+    return sea_turtle_string_is_local(object)
+           ? object->local_count
+           : object->tagged_count & SEA_TURTLE_STRING_COUNT_MAX;
+}
+
+/**
+ * @brief Set the count of code points.
+ * <p>The size of the string must have been set beforehand.</p>
+ * @param [in] object string instance.
+ * @param [in] count count of code points.
+ */
+static inline void sea_turtle_string_set_count(
+        struct sea_turtle_string *const object,
+        const uintmax_t count) {
+    if (sea_turtle_string_is_local(object)) {
+        object->local_count = count;
+    } else {
+        object->tagged_count = (object->tagged_count
+                                & ~SEA_TURTLE_STRING_COUNT_MAX)
+                               | count;
+    }
+}
+
+/**
+ * @brief Retrieve the backing buffer.
+ * @param [in] object string instance.
+ * @return the local buffer if the string is stored locally, otherwise the
+ * buffer that <b>data</b> refers to.
+ */
+static inline uint8_t *sea_turtle_string_bytes(
+        const struct sea_turtle_string *const object) {
+    return sea_turtle_string_is_local(object)
+           ? (uint8_t *) object->local
+           : object->data;
+}
+
+/**
+ * @brief Retrieve the hash code if it has been computed.
+ * @param [in] object string instance.
+ * @return the hash code or <i>0</i> if it has yet to be computed, which it
+ * always has for strings stored locally.
+ */
+static inline uintmax_t sea_turtle_string_cached_hash(
+        const struct sea_turtle_string *const object) {
+    return sea_turtle_string_is_local(object)
+           ? 0
+           : __atomic_load_n(&object->hash, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Retrieve the header of the buffer of a string.
+ * @param [in] object string instance.
+ * @return the header or <i>NULL</i> if the string is empty, stored locally
+ * or refers to a buffer owned by a string arena or the caller.
+ */
+struct sea_turtle_string_buffer *sea_turtle_string_buffer_of(
+        const struct sea_turtle_string *object);
+
+/**
+ * @brief Allocate or resize a heap buffer.
+ * <p>A new heap buffer is allocated from the allocator of the calling
+ * thread, which the heap buffer then keeps using whichever thread resizes
+ * or releases it.</p>
+ * @param [in] data heap buffer or <i>NULL</i> to allocate one.
+ * @param [in] capacity number of bytes the heap buffer should have.
+ * @return resized heap buffer or <i>NULL</i> on failure in which case the
+ * heap buffer is left untouched.
+ */
+uint8_t *sea_turtle_string_buffer_resize(uint8_t *data, size_t capacity);
+
+/**
+ * @brief Release a heap buffer to the allocator it came from.
+ * <p>The code point index of the buffer must have been released.</p>
+ * @param [in] data heap buffer which may be <i>NULL</i>.
+ */
+void sea_turtle_string_buffer_release(uint8_t *data);
+
+/**
+ * @brief Initialize string from other string with a shared buffer.
+ * <p>Unlike sea_turtle_string_init_string() followed by
+ * sea_turtle_string_share() the value of <b>other</b> is copied only once
+ * when its buffer is neither shared nor local, into a buffer allocated
+ * from <b>allocator</b> rather than the allocator of the calling
+ * thread.</p>
+ * @param [in] object instance to be initialized.
+ * @param [in] other string whose value we will copy.
+ * @param [in] allocator allocator of the copy or <i>NULL</i> for the
+ * default allocator.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL if object is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_OTHER_IS_NULL if other is <i>NULL</i>.
+ * @throws SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED if there is
+ * insufficient memory to initialize the string instance.
+ */
+int sea_turtle_string_init_shared(
+        struct sea_turtle_string *object,
+        const struct sea_turtle_string *other,
+        const struct sea_turtle_allocator *allocator);
+
 /**
  * @brief Set the size of the backing buffer.
  * <p>Resizing the backing buffer while ensuring that it is <i>NULL</i>
- * terminated.</p>
+ * terminated. Sizes up to SEA_TURTLE_STRING_LOCAL_SIZE are stored in the
+ * local buffer of the string instance. A shared buffer is copied, and the
+ * reference to it dropped, before the string is modified. So is a buffer
+ * owned by a string arena, or a file mapping which is then unmapped.</p>
  * @param [in] object string instance.
  * @param [in] size desired size of backing buffer including <i>NULL</i>
  * terminator.
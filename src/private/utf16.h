@@ -0,0 +1,110 @@
+#ifndef _SEA_TURTLE_PRIVATE_UTF16_H_
+#define _SEA_TURTLE_PRIVATE_UTF16_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sea-turtle.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SEA_TURTLE_UTF16_X86 1
+#endif
+
+/**
+ * @brief Validate UTF-16 sequence and measure its UTF-8 encoding.
+ * @param [in] begin first byte of the first code unit.
+ * @param [in] count number of code units.
+ * @param [in] big <i>true</i> if code units are big endian, otherwise
+ * <i>false</i>.
+ * @param [out] size receive the number of bytes of the UTF-8 encoding.
+ * @param [out] code_points receive the count of code points.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_UTF16_IS_MALFORMED if a surrogate is not
+ * paired or a code unit is <i>0</i>.
+ */
+int sea_turtle_utf16_measure(const uint8_t *begin,
+                             size_t count,
+                             bool big,
+                             size_t *size,
+                             uintmax_t *code_points);
+
+/**
+ * @brief Transcode UTF-16 sequence to UTF-8.
+ * <p>The implementation best suited to the running CPU is selected on first
+ * use.</p>
+ * @param [in] begin first byte of the first code unit of a sequence that
+ * sea_turtle_utf16_measure() accepts.
+ * @param [in] count number of code units.
+ * @param [in] big <i>true</i> if code units are big endian, otherwise
+ * <i>false</i>.
+ * @param [out] out receive the UTF-8 encoded symbols.
+ */
+void sea_turtle_utf16_to_utf8(const uint8_t *begin,
+                              size_t count,
+                              bool big,
+                              uint8_t *out);
+
+/**
+ * @brief Transcode UTF-8 sequence to UTF-16.
+ * <p>The implementation best suited to the running CPU is selected on first
+ * use.</p>
+ * @param [in] begin first byte of a valid UTF-8 sequence.
+ * @param [in] length number of bytes.
+ * @param [in] big <i>true</i> to write big endian code units, otherwise
+ * <i>false</i>.
+ * @param [out] out receive the code units.
+ * @param [in] count number of code units the sequence transcodes to.
+ */
+void sea_turtle_utf16_from_utf8(const uint8_t *begin,
+                                size_t length,
+                                bool big,
+                                uint8_t *out,
+                                size_t count);
+
+/**
+ * @brief Portable implementation of the transcoding kernels.
+ */
+void sea_turtle_utf16_to_utf8_scalar(const uint8_t *begin,
+                                     size_t count,
+                                     bool big,
+                                     uint8_t *out);
+
+void sea_turtle_utf16_from_utf8_scalar(const uint8_t *begin,
+                                       size_t length,
+                                       bool big,
+                                       uint8_t *out,
+                                       size_t count);
+
+#if defined(SEA_TURTLE_UTF16_X86)
+/**
+ * @brief SSE4.2 implementation of the transcoding kernels.
+ * @note Must only be called if the CPU supports SSE4.2.
+ */
+void sea_turtle_utf16_to_utf8_sse42(const uint8_t *begin,
+                                    size_t count,
+                                    bool big,
+                                    uint8_t *out);
+
+void sea_turtle_utf16_from_utf8_sse42(const uint8_t *begin,
+                                      size_t length,
+                                      bool big,
+                                      uint8_t *out,
+                                      size_t count);
+
+/**
+ * @brief AVX2 implementation of the transcoding kernels.
+ * @note Must only be called if the CPU supports AVX2.
+ */
+void sea_turtle_utf16_to_utf8_avx2(const uint8_t *begin,
+                                   size_t count,
+                                   bool big,
+                                   uint8_t *out);
+
+void sea_turtle_utf16_from_utf8_avx2(const uint8_t *begin,
+                                     size_t length,
+                                     bool big,
+                                     uint8_t *out,
+                                     size_t count);
+#endif
+
+#endif /* _SEA_TURTLE_PRIVATE_UTF16_H_ */
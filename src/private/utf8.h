@@ -0,0 +1,165 @@
+#ifndef _SEA_TURTLE_PRIVATE_UTF8_H_
+#define _SEA_TURTLE_PRIVATE_UTF8_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sea-turtle.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SEA_TURTLE_UTF8_X86 1
+#endif
+
+/**
+ * @brief Validate UTF-8 sequence.
+ * <p>Bytes are processed until <b>size</b> bytes have been read or a
+ * <i>NULL</i> byte is encountered. The implementation best suited to the
+ * running CPU is selected on first use.</p>
+ * @param [in] begin first byte of the sequence.
+ * @param [in] size upper limit in the number of bytes to read up to.
+ * @param [out] out receive the number of bytes before the <i>NULL</i> byte
+ * or <b>size</b> if none was found.
+ * @param [out] count receive the count of code points.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_MALFORMED if the bytes do not
+ * form a valid UTF-8 sequence.
+ */
+int sea_turtle_utf8_validate(const uint8_t *begin,
+                             size_t size,
+                             size_t *out,
+                             uintmax_t *count);
+
+/**
+ * @brief Find the UTF-8 sequence cut short at the end of bytes.
+ * @param [in] begin first byte.
+ * @param [in] length number of bytes.
+ * @return number of trailing bytes, at most 3, that begin a valid UTF-8
+ * encoded symbol missing its last bytes, otherwise <i>0</i> which leaves
+ * any malformed trailing bytes for validation to report.
+ */
+size_t sea_turtle_utf8_incomplete(const uint8_t *begin, size_t length);
+
+/**
+ * @brief Decode UTF-8 encoded symbols into code points.
+ * <p>The implementation best suited to the running CPU is selected on first
+ * use.</p>
+ * @param [in] begin first UTF-8 encoded symbol of a valid UTF-8 sequence.
+ * @param [in] end address past the last byte that may be read, which is
+ * never read past even though decoding stops after <b>count</b> symbols.
+ * @param [in] count number of symbols to decode, all of which must lie
+ * before <b>end</b>.
+ * @param [out] out receive <b>count</b> code points.
+ * @return address past the last byte of the last decoded symbol.
+ */
+const uint8_t *sea_turtle_utf8_decode(const uint8_t *begin,
+                                      const uint8_t *end,
+                                      size_t count,
+                                      uint32_t *out);
+
+/**
+ * @brief Compute the size of the UTF-8 encoding of code points.
+ * @param [in] begin first code point.
+ * @param [in] count number of code points.
+ * @param [out] out receive the number of bytes of the encoding.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_CODE_POINT_IS_INVALID if any code point is
+ * <i>0</i>, a surrogate or greater than <i>0x10FFFF</i>.
+ */
+int sea_turtle_utf8_encoded_size(const uint32_t *begin,
+                                 size_t count,
+                                 size_t *out);
+
+/**
+ * @brief Encode code points as UTF-8 encoded symbols.
+ * @param [in] begin first of code points that
+ * sea_turtle_utf8_encoded_size() accepts.
+ * @param [in] count number of code points.
+ * @param [out] out receive the UTF-8 encoded symbols.
+ * @return address past the last byte written.
+ */
+uint8_t *sea_turtle_utf8_encode(const uint32_t *begin,
+                                size_t count,
+                                uint8_t *out);
+
+/**
+ * @brief Portable implementation of the UTF-8 validation kernel.
+ * @param [in] begin first byte of the sequence.
+ * @param [in] length number of bytes in the sequence, all of which must be
+ * readable.
+ * @param [out] count receive the count of code points.
+ * @return On success <i>0</i>, otherwise an error code.
+ * @throws SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_MALFORMED if the bytes do not
+ * form a valid UTF-8 sequence.
+ */
+int sea_turtle_utf8_validate_scalar(const uint8_t *begin,
+                                    size_t length,
+                                    uintmax_t *count);
+
+/**
+ * @brief Portable implementation of the decoding kernel.
+ */
+const uint8_t *sea_turtle_utf8_decode_scalar(const uint8_t *begin,
+                                             const uint8_t *end,
+                                             size_t count,
+                                             uint32_t *out);
+
+/**
+ * @brief Portable implementation of the encoding kernel.
+ */
+uint8_t *sea_turtle_utf8_encode_scalar(const uint32_t *begin,
+                                       size_t count,
+                                       uint8_t *out);
+
+#if defined(SEA_TURTLE_UTF8_X86)
+/**
+ * @brief SSE4.2 implementation of the UTF-8 validation kernel.
+ * @note Must only be called if the CPU supports SSE4.2.
+ */
+int sea_turtle_utf8_validate_sse42(const uint8_t *begin,
+                                   size_t length,
+                                   uintmax_t *count);
+
+/**
+ * @brief AVX2 implementation of the UTF-8 validation kernel.
+ * @note Must only be called if the CPU supports AVX2.
+ */
+int sea_turtle_utf8_validate_avx2(const uint8_t *begin,
+                                  size_t length,
+                                  uintmax_t *count);
+
+/**
+ * @brief AVX-512 implementation of the UTF-8 validation kernel.
+ * @note Must only be called if the CPU supports AVX-512BW.
+ */
+int sea_turtle_utf8_validate_avx512(const uint8_t *begin,
+                                    size_t length,
+                                    uintmax_t *count);
+
+/**
+ * @brief SSE4.2 implementation of the decoding and encoding kernels.
+ * @note Must only be called if the CPU supports SSE4.2.
+ */
+const uint8_t *sea_turtle_utf8_decode_sse42(const uint8_t *begin,
+                                            const uint8_t *end,
+                                            size_t count,
+                                            uint32_t *out);
+
+uint8_t *sea_turtle_utf8_encode_sse42(const uint32_t *begin,
+                                      size_t count,
+                                      uint8_t *out);
+
+/**
+ * @brief AVX2 implementation of the decoding and encoding kernels.
+ * @note Must only be called if the CPU supports AVX2.
+ */
+const uint8_t *sea_turtle_utf8_decode_avx2(const uint8_t *begin,
+                                           const uint8_t *end,
+                                           size_t count,
+                                           uint32_t *out);
+
+uint8_t *sea_turtle_utf8_encode_avx2(const uint32_t *begin,
+                                     size_t count,
+                                     uint8_t *out);
+#endif
+
+#endif /* _SEA_TURTLE_PRIVATE_UTF8_H_ */
@@ -0,0 +1,690 @@
+#include <stdlib.h>
+#include <string.h>
+#include <sea-turtle.h>
+#include <seagrass.h>
+
+#include "private/allocator.h"
+#include "private/string.h"
+
+#ifdef TEST
+#include <test/cmocka.h>
+#endif
+
+/*
+ * Branches have a height of at least 1 and both children present. Leaves
+ * have a height of 0 and refer to <b>size</b> bytes of the shared or local
+ * buffer of <b>string</b> starting at <b>offset</b>.
+ */
+struct sea_turtle_rope_node {
+    struct sea_turtle_rope_node *left;
+    struct sea_turtle_rope_node *right;
+    size_t size;
+    uintmax_t count;
+    size_t offset;
+    unsigned height;
+    struct sea_turtle_string string;
+    /* allocator the node came from, kept across reuse as a spare */
+    const struct sea_turtle_allocator *allocator;
+};
+
+/* only the first byte of an UTF-8 encoded symbol is not 10xxxxxx */
+static inline bool sea_turtle_rope_is_continuation(const uint8_t byte) {
+    return (byte & 0xC0) == 0x80;
+}
+
+static inline size_t sea_turtle_rope_symbol_length(const uint8_t byte) {
+    return byte < 0x80 ? 1 : byte >= 0xF0 ? 4 : byte >= 0xE0 ? 3 : 2;
+}
+
+static uintmax_t sea_turtle_rope_count_of(const uint8_t *const begin,
+                                          const size_t size) {
+    uintmax_t count = 0;
+    for (size_t i = 0; i < size; i++) {
+        count += !sea_turtle_rope_is_continuation(begin[i]);
+    }
+    return count;
+}
+
+static inline const uint8_t *sea_turtle_rope_leaf_bytes(
+        const struct sea_turtle_rope_node *const node) {
+    return sea_turtle_string_bytes(&node->string) + node->offset;
+}
+
+/* byte offset of the code point at index within the leaf */
+static size_t sea_turtle_rope_leaf_offset(
+        const struct sea_turtle_rope_node *const node,
+        const uintmax_t index) {
+    if (node->size == node->count) {
+        return index;
+    }
+    const uint8_t *const bytes = sea_turtle_rope_leaf_bytes(node);
+    size_t i = 0;
+    for (uintmax_t c = 0; c < index; c++) {
+        i += sea_turtle_rope_symbol_length(bytes[i]);
+    }
+    return i;
+}
+
+/* spare nodes are linked through left and guarantee that edits succeed */
+static void sea_turtle_rope_give(struct sea_turtle_rope *const object,
+                                 struct sea_turtle_rope_node *const node) {
+    node->left = object->spare;
+    object->spare = node;
+    object->spares += 1;
+}
+
+static struct sea_turtle_rope_node *sea_turtle_rope_take(
+        struct sea_turtle_rope *const object) {
+    struct sea_turtle_rope_node *const node = object->spare;
+    seagrass_required_true(node);
+    object->spare = node->left;
+    object->spares -= 1;
+    *node = (struct sea_turtle_rope_node) {
+            .allocator = node->allocator
+    };
+    return node;
+}
+
+static void sea_turtle_rope_deallocate(struct sea_turtle_rope_node *const node) {
+    sea_turtle_allocator_deallocate(node->allocator, node, sizeof(*node));
+}
+
+/*
+ * A split allocates at most one node per level of the tree plus one leaf
+ * and a join at most one node, so an edit never needs more than this.
+ */
+static size_t sea_turtle_rope_need(const struct sea_turtle_rope *const object) {
+    const size_t height = object->root ? object->root->height : 0;
+    return 2 * height + 6;
+}
+
+static int sea_turtle_rope_reserve(struct sea_turtle_rope *const object,
+                                   const size_t count) {
+    while (object->spares < count) {
+        const struct sea_turtle_allocator *const allocator
+                = sea_turtle_allocator_current();
+        struct sea_turtle_rope_node *const node
+                = sea_turtle_allocator_allocate(allocator, sizeof(*node));
+        if (!node) {
+            return SEA_TURTLE_ROPE_ERROR_MEMORY_ALLOCATION_FAILED;
+        }
+        node->allocator = allocator;
+        sea_turtle_rope_give(object, node);
+    }
+    return 0;
+}
+
+static void sea_turtle_rope_trim(struct sea_turtle_rope *const object) {
+    const size_t need = sea_turtle_rope_need(object);
+    while (object->spares > need) {
+        sea_turtle_rope_deallocate(sea_turtle_rope_take(object));
+    }
+}
+
+static void sea_turtle_rope_release(struct sea_turtle_rope_node *const node) {
+    if (!node) {
+        return;
+    }
+    if (node->height) {
+        sea_turtle_rope_release(node->left);
+        sea_turtle_rope_release(node->right);
+    } else {
+        seagrass_required_true(!sea_turtle_string_invalidate(&node->string));
+    }
+    sea_turtle_rope_deallocate(node);
+}
+
+static void sea_turtle_rope_update(struct sea_turtle_rope_node *const node) {
+    const unsigned left = node->left->height;
+    const unsigned right = node->right->height;
+    node->height = 1 + (left > right ? left : right);
+    node->size = node->left->size + node->right->size;
+    node->count = node->left->count + node->right->count;
+}
+
+static struct sea_turtle_rope_node *sea_turtle_rope_rotate_left(
+        struct sea_turtle_rope_node *const node) {
+    struct sea_turtle_rope_node *const right = node->right;
+    node->right = right->left;
+    sea_turtle_rope_update(node);
+    right->left = node;
+    sea_turtle_rope_update(right);
+    return right;
+}
+
+static struct sea_turtle_rope_node *sea_turtle_rope_rotate_right(
+        struct sea_turtle_rope_node *const node) {
+    struct sea_turtle_rope_node *const left = node->left;
+    node->left = left->right;
+    sea_turtle_rope_update(node);
+    left->right = node;
+    sea_turtle_rope_update(left);
+    return left;
+}
+
+static struct sea_turtle_rope_node *sea_turtle_rope_balance(
+        struct sea_turtle_rope_node *node) {
+    sea_turtle_rope_update(node);
+    if (node->left->height > 1 + node->right->height) {
+        if (node->left->left->height < node->left->right->height) {
+            node->left = sea_turtle_rope_rotate_left(node->left);
+        }
+        node = sea_turtle_rope_rotate_right(node);
+    } else if (node->right->height > 1 + node->left->height) {
+        if (node->right->right->height < node->right->left->height) {
+            node->right = sea_turtle_rope_rotate_right(node->right);
+        }
+        node = sea_turtle_rope_rotate_left(node);
+    }
+    return node;
+}
+
+/* make the leaf refer to the whole of string taking over its buffer */
+static void sea_turtle_rope_leaf_set(struct sea_turtle_rope_node *const node,
+                                     const struct sea_turtle_string *const
+                                     string) {
+    node->string = *string;
+    node->offset = 0;
+    node->size = string->size - 1;
+    node->count = sea_turtle_string_count_of(string);
+    node->height = 0;
+}
+
+/* copy two adjacent small leaves into the left one */
+static int sea_turtle_rope_merge(struct sea_turtle_rope_node *const left,
+                                 const struct sea_turtle_rope_node *const
+                                 right) {
+    int error;
+    struct sea_turtle_string string = {0};
+    if ((error = sea_turtle_string_set_size(
+            &string, 1 + left->size + right->size))) {
+        return error;
+    }
+    uint8_t *const bytes = sea_turtle_string_bytes(&string);
+    memcpy(bytes, sea_turtle_rope_leaf_bytes(left), left->size);
+    memcpy(bytes + left->size, sea_turtle_rope_leaf_bytes(right),
+           right->size);
+    sea_turtle_string_set_count(&string, left->count + right->count);
+    if ((error = sea_turtle_string_share(&string))) {
+        seagrass_required_true(!sea_turtle_string_invalidate(&string));
+        return error;
+    }
+    seagrass_required_true(!sea_turtle_string_invalidate(&left->string));
+    sea_turtle_rope_leaf_set(left, &string);
+    return 0;
+}
+
+static struct sea_turtle_rope_node *sea_turtle_rope_branch(
+        struct sea_turtle_rope *const object,
+        struct sea_turtle_rope_node *const left,
+        struct sea_turtle_rope_node *const right) {
+    /* keep typing from fragmenting the text into tiny leaves */
+    if (!left->height && !right->height
+        && left->size + right->size <= SEA_TURTLE_ROPE_LEAF_SIZE
+        && !sea_turtle_rope_merge(left, right)) {
+        seagrass_required_true(!sea_turtle_string_invalidate(&right->string));
+        sea_turtle_rope_give(object, right);
+        return left;
+    }
+    struct sea_turtle_rope_node *const node = sea_turtle_rope_take(object);
+    node->left = left;
+    node->right = right;
+    sea_turtle_rope_update(node);
+    return node;
+}
+
+static struct sea_turtle_rope_node *sea_turtle_rope_join(
+        struct sea_turtle_rope *const object,
+        struct sea_turtle_rope_node *const left,
+        struct sea_turtle_rope_node *const right) {
+    if (!left) {
+        return right;
+    }
+    if (!right) {
+        return left;
+    }
+    if (left->height > 1 + right->height) {
+        left->right = sea_turtle_rope_join(object, left->right, right);
+        return sea_turtle_rope_balance(left);
+    }
+    if (right->height > 1 + left->height) {
+        right->left = sea_turtle_rope_join(object, left, right->left);
+        return sea_turtle_rope_balance(right);
+    }
+    return sea_turtle_rope_branch(object, left, right);
+}
+
+static void sea_turtle_rope_split_node(
+        struct sea_turtle_rope *const object,
+        struct sea_turtle_rope_node *const node,
+        const uintmax_t index,
+        struct sea_turtle_rope_node **const left,
+        struct sea_turtle_rope_node **const right) {
+    if (!index) {
+        *left = NULL;
+        *right = node;
+        return;
+    }
+    if (index == node->count) {
+        *left = node;
+        *right = NULL;
+        return;
+    }
+    if (!node->height) {
+        /* both halves refer to the same buffer */
+        const size_t offset = sea_turtle_rope_leaf_offset(node, index);
+        struct sea_turtle_rope_node *const other
+                = sea_turtle_rope_take(object);
+        seagrass_required_true(!sea_turtle_string_init_string(
+                &other->string, &node->string));
+        other->offset = node->offset + offset;
+        other->size = node->size - offset;
+        other->count = node->count - index;
+        node->size = offset;
+        node->count = index;
+        *left = node;
+        *right = other;
+        return;
+    }
+    struct sea_turtle_rope_node *const l = node->left;
+    struct sea_turtle_rope_node *const r = node->right;
+    struct sea_turtle_rope_node *middle;
+    sea_turtle_rope_give(object, node);
+    if (index <= l->count) {
+        sea_turtle_rope_split_node(object, l, index, left, &middle);
+        *right = sea_turtle_rope_join(object, middle, r);
+    } else {
+        sea_turtle_rope_split_node(object, r, index - l->count, &middle,
+                                   right);
+        *left = sea_turtle_rope_join(object, l, middle);
+    }
+}
+
+struct sea_turtle_rope_chunks {
+    const struct sea_turtle_string *string;
+    const uint8_t *bytes;
+    size_t offset;
+    size_t size;
+    size_t leaves;
+};
+
+static struct sea_turtle_rope_node *sea_turtle_rope_build(
+        struct sea_turtle_rope *const object,
+        struct sea_turtle_rope_chunks *const chunks,
+        const size_t leaves) {
+    if (leaves > 1) {
+        struct sea_turtle_rope_node *const node
+                = sea_turtle_rope_take(object);
+        node->left = sea_turtle_rope_build(object, chunks, leaves / 2);
+        node->right = sea_turtle_rope_build(object, chunks,
+                                            leaves - leaves / 2);
+        sea_turtle_rope_update(node);
+        return node;
+    }
+    const size_t remaining = chunks->size - chunks->offset;
+    size_t end = chunks->size;
+    if (chunks->leaves > 1) {
+        /* spread the bytes evenly and end on a symbol boundary */
+        const size_t target = (remaining + chunks->leaves - 1)
+                              / chunks->leaves;
+        end = chunks->offset + target;
+        for (; end > chunks->offset
+               && sea_turtle_rope_is_continuation(chunks->bytes[end]);
+               end--);
+        if (end == chunks->offset) {
+            for (end = chunks->offset + target;
+                 sea_turtle_rope_is_continuation(chunks->bytes[end]);
+                 end++);
+        }
+    }
+    struct sea_turtle_rope_node *const node = sea_turtle_rope_take(object);
+    seagrass_required_true(!sea_turtle_string_init_string(
+            &node->string, chunks->string));
+    node->offset = chunks->offset;
+    node->size = end - chunks->offset;
+    node->count = sea_turtle_rope_count_of(chunks->bytes + chunks->offset,
+                                           node->size);
+    chunks->offset = end;
+    chunks->leaves -= 1;
+    return node;
+}
+
+/* build a balanced tree of leaves over a shared copy of string */
+static int sea_turtle_rope_tree(struct sea_turtle_rope *const object,
+                                const struct sea_turtle_string *const string,
+                                const size_t extra,
+                                struct sea_turtle_rope_node **const out) {
+    if (!string->size) {
+        *out = NULL;
+        return sea_turtle_rope_reserve(object, extra);
+    }
+    int error;
+    struct sea_turtle_string shared;
+    if ((error = sea_turtle_string_init_shared(
+            &shared, string, sea_turtle_allocator_current()))) {
+        seagrass_required_true(
+                SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED == error);
+        return SEA_TURTLE_ROPE_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    const size_t size = shared.size - 1;
+    const size_t leaves = (size + SEA_TURTLE_ROPE_LEAF_SIZE - 1)
+                          / SEA_TURTLE_ROPE_LEAF_SIZE;
+    if ((error = sea_turtle_rope_reserve(object, 2 * leaves - 1 + extra))) {
+        seagrass_required_true(!sea_turtle_string_invalidate(&shared));
+        return error;
+    }
+    struct sea_turtle_rope_chunks chunks = {
+            .string = &shared,
+            .bytes = sea_turtle_string_bytes(&shared),
+            .size = size,
+            .leaves = leaves
+    };
+    *out = sea_turtle_rope_build(object, &chunks, leaves);
+    seagrass_required_true(!sea_turtle_string_invalidate(&shared));
+    return 0;
+}
+
+int sea_turtle_rope_init(struct sea_turtle_rope *const object) {
+    if (!object) {
+        return SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL;
+    }
+    *object = (struct sea_turtle_rope) {0};
+    return 0;
+}
+
+int sea_turtle_rope_init_string(struct sea_turtle_rope *const object,
+                                const struct sea_turtle_string *const string) {
+    if (!object) {
+        return SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL;
+    }
+    if (!string) {
+        return SEA_TURTLE_ROPE_ERROR_STRING_IS_NULL;
+    }
+    *object = (struct sea_turtle_rope) {0};
+    int error;
+    if ((error = sea_turtle_rope_tree(object, string, 0, &object->root))) {
+        seagrass_required_true(!sea_turtle_rope_invalidate(object));
+        return error;
+    }
+    sea_turtle_rope_trim(object);
+    return 0;
+}
+
+int sea_turtle_rope_invalidate(struct sea_turtle_rope *const object) {
+    if (!object) {
+        return SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL;
+    }
+    sea_turtle_rope_release(object->root);
+    while (object->spare) {
+        sea_turtle_rope_deallocate(sea_turtle_rope_take(object));
+    }
+    *object = (struct sea_turtle_rope) {0};
+    return 0;
+}
+
+static uint8_t *sea_turtle_rope_copy(
+        const struct sea_turtle_rope_node *const node,
+        uint8_t *const to) {
+    if (node->height) {
+        return sea_turtle_rope_copy(
+                node->right, sea_turtle_rope_copy(node->left, to));
+    }
+    memcpy(to, sea_turtle_rope_leaf_bytes(node), node->size);
+    return to + node->size;
+}
+
+int sea_turtle_rope_to_string(const struct sea_turtle_rope *const object,
+                              struct sea_turtle_string *const out) {
+    if (!object) {
+        return SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_ROPE_ERROR_OUT_IS_NULL;
+    }
+    const struct sea_turtle_rope_node *const root = object->root;
+    if (!root) {
+        *out = (struct sea_turtle_string) {0};
+        return 0;
+    }
+    if (!root->height && !root->offset
+        && root->size == root->string.size - 1) {
+        seagrass_required_true(!sea_turtle_string_init_string(
+                out, &root->string));
+        return 0;
+    }
+    *out = (struct sea_turtle_string) {0};
+    if (sea_turtle_string_set_size(out, 1 + root->size)) {
+        return SEA_TURTLE_ROPE_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    uint8_t *const bytes = sea_turtle_string_bytes(out);
+    sea_turtle_rope_copy(root, bytes);
+    sea_turtle_string_set_count(out, root->count);
+    return 0;
+}
+
+int sea_turtle_rope_count(const struct sea_turtle_rope *const object,
+                          uintmax_t *const out) {
+    if (!object) {
+        return SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_ROPE_ERROR_OUT_IS_NULL;
+    }
+    *out = object->root ? object->root->count : 0;
+    return 0;
+}
+
+int sea_turtle_rope_insert(struct sea_turtle_rope *const object,
+                           const uintmax_t index,
+                           const struct sea_turtle_string *const string) {
+    if (!object) {
+        return SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL;
+    }
+    if (!string) {
+        return SEA_TURTLE_ROPE_ERROR_STRING_IS_NULL;
+    }
+    struct sea_turtle_rope_node *const root = object->root;
+    if (index > (root ? root->count : 0)) {
+        return SEA_TURTLE_ROPE_ERROR_INDEX_IS_OUT_OF_BOUNDS;
+    }
+    int error;
+    struct sea_turtle_rope_node *middle;
+    if ((error = sea_turtle_rope_tree(object, string,
+                                      sea_turtle_rope_need(object),
+                                      &middle))) {
+        return error;
+    }
+    if (middle) {
+        struct sea_turtle_rope_node *left = NULL;
+        struct sea_turtle_rope_node *right = NULL;
+        if (root) {
+            sea_turtle_rope_split_node(object, root, index, &left, &right);
+        }
+        object->root = sea_turtle_rope_join(
+                object, sea_turtle_rope_join(object, left, middle), right);
+    }
+    sea_turtle_rope_trim(object);
+    return 0;
+}
+
+int sea_turtle_rope_remove(struct sea_turtle_rope *const object,
+                           const uintmax_t index,
+                           const uintmax_t count) {
+    if (!object) {
+        return SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL;
+    }
+    struct sea_turtle_rope_node *const root = object->root;
+    const uintmax_t total = root ? root->count : 0;
+    if (index > total) {
+        return SEA_TURTLE_ROPE_ERROR_INDEX_IS_OUT_OF_BOUNDS;
+    }
+    if (count > total - index) {
+        return SEA_TURTLE_ROPE_ERROR_COUNT_IS_OUT_OF_BOUNDS;
+    }
+    if (!count) {
+        return 0;
+    }
+    int error;
+    if ((error = sea_turtle_rope_reserve(object,
+                                         sea_turtle_rope_need(object)))) {
+        return error;
+    }
+    struct sea_turtle_rope_node *left;
+    struct sea_turtle_rope_node *middle;
+    struct sea_turtle_rope_node *right;
+    sea_turtle_rope_split_node(object, root, index, &left, &middle);
+    sea_turtle_rope_split_node(object, middle, count, &middle, &right);
+    sea_turtle_rope_release(middle);
+    object->root = sea_turtle_rope_join(object, left, right);
+    sea_turtle_rope_trim(object);
+    return 0;
+}
+
+int sea_turtle_rope_concat(struct sea_turtle_rope *const object,
+                           struct sea_turtle_rope *const other) {
+    if (!object) {
+        return SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL;
+    }
+    if (!other) {
+        return SEA_TURTLE_ROPE_ERROR_OTHER_IS_NULL;
+    }
+    if (object == other) {
+        /* appending a rope to itself would share its nodes */
+        struct sea_turtle_string string;
+        int error;
+        if ((error = sea_turtle_rope_to_string(object, &string))) {
+            return error;
+        }
+        const uintmax_t count = object->root ? object->root->count : 0;
+        error = sea_turtle_rope_insert(object, count, &string);
+        seagrass_required_true(!sea_turtle_string_invalidate(&string));
+        return error;
+    }
+    if (sea_turtle_rope_reserve(object, 1)) {
+        return SEA_TURTLE_ROPE_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    object->root = sea_turtle_rope_join(object, object->root, other->root);
+    other->root = NULL;
+    sea_turtle_rope_trim(object);
+    sea_turtle_rope_trim(other);
+    return 0;
+}
+
+int sea_turtle_rope_split(struct sea_turtle_rope *const object,
+                          const uintmax_t index,
+                          struct sea_turtle_rope *const out) {
+    if (!object) {
+        return SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_ROPE_ERROR_OUT_IS_NULL;
+    }
+    struct sea_turtle_rope_node *const root = object->root;
+    if (index > (root ? root->count : 0)) {
+        return SEA_TURTLE_ROPE_ERROR_INDEX_IS_OUT_OF_BOUNDS;
+    }
+    int error;
+    if ((error = sea_turtle_rope_reserve(object,
+                                         sea_turtle_rope_need(object)))) {
+        return error;
+    }
+    *out = (struct sea_turtle_rope) {0};
+    if (root) {
+        sea_turtle_rope_split_node(object, root, index, &object->root,
+                                   &out->root);
+    }
+    sea_turtle_rope_trim(object);
+    return 0;
+}
+
+/* position iterator at the code point with index */
+static void sea_turtle_rope_seek(const struct sea_turtle_rope *const object,
+                                 const uintmax_t index,
+                                 struct sea_turtle_rope_iterator *const out) {
+    const struct sea_turtle_rope_node *node = object->root;
+    uintmax_t i = index;
+    while (node->height) {
+        if (i < node->left->count) {
+            node = node->left;
+        } else {
+            i -= node->left->count;
+            node = node->right;
+        }
+    }
+    const uint8_t *const bytes = sea_turtle_rope_leaf_bytes(node);
+    out->at = bytes + sea_turtle_rope_leaf_offset(node, i);
+    out->end = bytes + node->size;
+    out->index = index;
+}
+
+int sea_turtle_rope_first(const struct sea_turtle_rope *const object,
+                          struct sea_turtle_rope_iterator *const out) {
+    if (!object) {
+        return SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_ROPE_ERROR_OUT_IS_NULL;
+    }
+    if (!object->root) {
+        return SEA_TURTLE_ROPE_ERROR_ROPE_IS_EMPTY;
+    }
+    sea_turtle_rope_seek(object, 0, out);
+    return 0;
+}
+
+int sea_turtle_rope_at(const struct sea_turtle_rope *const object,
+                       const uintmax_t index,
+                       struct sea_turtle_rope_iterator *const out) {
+    if (!object) {
+        return SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_ROPE_ERROR_OUT_IS_NULL;
+    }
+    if (!object->root || index >= object->root->count) {
+        return SEA_TURTLE_ROPE_ERROR_INDEX_IS_OUT_OF_BOUNDS;
+    }
+    sea_turtle_rope_seek(object, index, out);
+    return 0;
+}
+
+int sea_turtle_rope_next(const struct sea_turtle_rope *const object,
+                         struct sea_turtle_rope_iterator *const at) {
+    if (!object) {
+        return SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL;
+    }
+    if (!at) {
+        return SEA_TURTLE_ROPE_ERROR_AT_IS_NULL;
+    }
+    if (!object->root || 1 + at->index >= object->root->count) {
+        return SEA_TURTLE_ROPE_ERROR_END_OF_SEQUENCE;
+    }
+    at->at += sea_turtle_rope_symbol_length(*at->at);
+    at->index += 1;
+    if (at->at == at->end) {
+        /* descend again only when crossing into the next leaf */
+        sea_turtle_rope_seek(object, at->index, at);
+    }
+    return 0;
+}
+
+int sea_turtle_rope_code_point(const struct sea_turtle_rope *const object,
+                               const struct sea_turtle_rope_iterator *const at,
+                               uint32_t *const out) {
+    if (!object) {
+        return SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL;
+    }
+    if (!at) {
+        return SEA_TURTLE_ROPE_ERROR_AT_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_ROPE_ERROR_OUT_IS_NULL;
+    }
+    const size_t n = sea_turtle_rope_symbol_length(*at->at);
+    uint32_t code_point = at->at[0] & (n > 1 ? 0x7F >> n : 0x7F);
+    for (size_t o = 1; o < n; o++) {
+        code_point = (code_point << 6) | (at->at[o] & 0x3F);
+    }
+    *out = code_point;
+    return 0;
+}
@@ -0,0 +1,376 @@
+#include <stdbool.h>
+#include <string.h>
+#include <stddef.h>
+#include <pthread.h>
+#include <sea-turtle.h>
+#include <seagrass.h>
+
+#include "private/search.h"
+
+#if defined(SEA_TURTLE_SEARCH_X86)
+#include <immintrin.h>
+#endif
+
+#ifdef TEST
+#include <test/cmocka.h>
+#endif
+
+const uint8_t *sea_turtle_search_forward_scalar(const uint8_t *const haystack,
+                                                const size_t length,
+                                                const uint8_t *const needle,
+                                                const size_t size) {
+    if (size > length) {
+        return NULL;
+    }
+    const uint8_t *const last = haystack + length - size;
+    for (const uint8_t *at = haystack; at <= last; at++) {
+        if (!(at = memchr(at, needle[0], 1 + last - at))) {
+            return NULL;
+        }
+        if (!memcmp(1 + at, 1 + needle, size - 1)) {
+            return at;
+        }
+    }
+    return NULL;
+}
+
+const uint8_t *sea_turtle_search_backward_scalar(const uint8_t *const haystack,
+                                                 const size_t length,
+                                                 const uint8_t *const needle,
+                                                 const size_t size) {
+    if (size > length) {
+        return NULL;
+    }
+    for (const uint8_t *at = haystack + length - size;; at--) {
+        if (needle[0] == *at && !memcmp(1 + at, 1 + needle, size - 1)) {
+            return at;
+        }
+        if (haystack == at) {
+            return NULL;
+        }
+    }
+}
+
+/*
+ * Two-Way string matching by Maxime Crochemore and Dominique Perrin. The
+ * needle is split at a critical factorization into a left and a right part,
+ * the right part is matched left to right and then the left part right to
+ * left, mismatches shifting the needle by an amount derived from the period
+ * of the needle. Searching backwards is searching forwards through the
+ * reversed haystack for the reversed needle, so every byte is read through
+ * sea_turtle_search_byte().
+ */
+static inline uint8_t sea_turtle_search_byte(const uint8_t *const begin,
+                                             const size_t length,
+                                             const size_t i,
+                                             const bool reverse) {
+    return reverse ? begin[length - 1 - i] : begin[i];
+}
+
+/* start of the maximal suffix, minus one, for the given ordering */
+static ptrdiff_t sea_turtle_search_maximal_suffix(const uint8_t *const needle,
+                                                  const ptrdiff_t size,
+                                                  const bool reverse,
+                                                  const bool inverse,
+                                                  ptrdiff_t *const period) {
+    ptrdiff_t suffix = -1;
+    ptrdiff_t j = 0;
+    ptrdiff_t k = 1;
+    ptrdiff_t p = 1;
+    while (j + k < size) {
+        const uint8_t a = sea_turtle_search_byte(needle, size, j + k,
+                                                 reverse);
+        const uint8_t b = sea_turtle_search_byte(needle, size, suffix + k,
+                                                 reverse);
+        if (inverse ? a > b : a < b) {
+            j += k;
+            k = 1;
+            p = j - suffix;
+        } else if (a == b) {
+            if (k != p) {
+                k += 1;
+            } else {
+                j += p;
+                k = 1;
+            }
+        } else {
+            suffix = j;
+            j = suffix + 1;
+            k = p = 1;
+        }
+    }
+    *period = p;
+    return suffix;
+}
+
+/* position of the first occurrence counted in the direction of the search */
+static size_t sea_turtle_search_two_way(const uint8_t *const haystack,
+                                        const ptrdiff_t length,
+                                        const uint8_t *const needle,
+                                        const ptrdiff_t size,
+                                        const bool reverse) {
+#define H(i) sea_turtle_search_byte(haystack, length, (i), reverse)
+#define N(i) sea_turtle_search_byte(needle, size, (i), reverse)
+    if (size > length) {
+        return SIZE_MAX;
+    }
+    ptrdiff_t p;
+    ptrdiff_t q;
+    const ptrdiff_t i = sea_turtle_search_maximal_suffix(
+            needle, size, reverse, false, &p);
+    const ptrdiff_t j = sea_turtle_search_maximal_suffix(
+            needle, size, reverse, true, &q);
+    const ptrdiff_t ell = i > j ? i : j;
+    ptrdiff_t period = i > j ? p : q;
+    ptrdiff_t k = 0;
+    for (; k <= ell && N(k) == N(k + period); k++);
+    if (k > ell) {
+        /* periodic needle, remember how much of it is known to match */
+        ptrdiff_t memory = -1;
+        for (ptrdiff_t at = 0; at <= length - size;) {
+            k = (ell > memory ? ell : memory) + 1;
+            for (; k < size && N(k) == H(k + at); k++);
+            if (k < size) {
+                at += k - ell;
+                memory = -1;
+                continue;
+            }
+            for (k = ell; k > memory && N(k) == H(k + at); k--);
+            if (k <= memory) {
+                return at;
+            }
+            at += period;
+            memory = size - period - 1;
+        }
+        return SIZE_MAX;
+    }
+    period = 1 + (ell + 1 > size - ell - 1 ? ell + 1 : size - ell - 1);
+    for (ptrdiff_t at = 0; at <= length - size;) {
+        k = ell + 1;
+        for (; k < size && N(k) == H(k + at); k++);
+        if (k < size) {
+            at += k - ell;
+            continue;
+        }
+        for (k = ell; k >= 0 && N(k) == H(k + at); k--);
+        if (k < 0) {
+            return at;
+        }
+        at += period;
+    }
+    return SIZE_MAX;
+#undef H
+#undef N
+}
+
+const uint8_t *sea_turtle_search_forward_two_way(const uint8_t *const haystack,
+                                                 const size_t length,
+                                                 const uint8_t *const needle,
+                                                 const size_t size) {
+    const size_t at = sea_turtle_search_two_way(haystack, length, needle,
+                                                size, false);
+    return SIZE_MAX == at ? NULL : haystack + at;
+}
+
+const uint8_t *sea_turtle_search_backward_two_way(
+        const uint8_t *const haystack,
+        const size_t length,
+        const uint8_t *const needle,
+        const size_t size) {
+    const size_t at = sea_turtle_search_two_way(haystack, length, needle,
+                                                size, true);
+    return SIZE_MAX == at ? NULL : haystack + length - size - at;
+}
+
+#if defined(SEA_TURTLE_SEARCH_X86)
+/*
+ * Candidate positions are filtered a block at a time by comparing the bytes
+ * they start with against the first byte of the needle and the bytes the
+ * needle would end at against its last byte, as described by Wojciech Muła
+ * in "SIMD-friendly algorithms for substring searching". Only positions
+ * passing both comparisons are compared in full, and positions too close to
+ * the end of the haystack to fill a block are left to the scalar kernel.
+ */
+__attribute__((target("sse4.2")))
+const uint8_t *sea_turtle_search_forward_sse42(const uint8_t *const haystack,
+                                               const size_t length,
+                                               const uint8_t *const needle,
+                                               const size_t size) {
+    const __m128i first = _mm_set1_epi8((char) needle[0]);
+    const __m128i last = _mm_set1_epi8((char) needle[size - 1]);
+    size_t i = 0;
+    for (; size - 1 + i + 16 <= length; i += 16) {
+        const __m128i begins = _mm_loadu_si128(
+                (const __m128i *) (haystack + i));
+        const __m128i ends = _mm_loadu_si128(
+                (const __m128i *) (haystack + i + size - 1));
+        uint32_t mask = _mm_movemask_epi8(_mm_and_si128(
+                _mm_cmpeq_epi8(first, begins),
+                _mm_cmpeq_epi8(last, ends)));
+        for (; mask; mask &= mask - 1) {
+            const uint8_t *const at = haystack + i + __builtin_ctz(mask);
+            if (!memcmp(1 + at, 1 + needle, size - 1)) {
+                return at;
+            }
+        }
+    }
+    return sea_turtle_search_forward_scalar(haystack + i, length - i,
+                                            needle, size);
+}
+
+__attribute__((target("sse4.2")))
+const uint8_t *sea_turtle_search_backward_sse42(const uint8_t *const haystack,
+                                                const size_t length,
+                                                const uint8_t *const needle,
+                                                const size_t size) {
+    if (size > length) {
+        return NULL;
+    }
+    const __m128i first = _mm_set1_epi8((char) needle[0]);
+    const __m128i last = _mm_set1_epi8((char) needle[size - 1]);
+    /* number of candidate positions yet to be filtered */
+    size_t end = 1 + length - size;
+    for (; end >= 16; end -= 16) {
+        const size_t i = end - 16;
+        const __m128i begins = _mm_loadu_si128(
+                (const __m128i *) (haystack + i));
+        const __m128i ends = _mm_loadu_si128(
+                (const __m128i *) (haystack + i + size - 1));
+        uint32_t mask = _mm_movemask_epi8(_mm_and_si128(
+                _mm_cmpeq_epi8(first, begins),
+                _mm_cmpeq_epi8(last, ends)));
+        while (mask) {
+            const int bit = 31 - __builtin_clz(mask);
+            const uint8_t *const at = haystack + i + bit;
+            if (!memcmp(1 + at, 1 + needle, size - 1)) {
+                return at;
+            }
+            mask &= ~(UINT32_C(1) << bit);
+        }
+    }
+    return sea_turtle_search_backward_scalar(haystack, end + size - 1,
+                                             needle, size);
+}
+
+__attribute__((target("avx2")))
+const uint8_t *sea_turtle_search_forward_avx2(const uint8_t *const haystack,
+                                              const size_t length,
+                                              const uint8_t *const needle,
+                                              const size_t size) {
+    const __m256i first = _mm256_set1_epi8((char) needle[0]);
+    const __m256i last = _mm256_set1_epi8((char) needle[size - 1]);
+    size_t i = 0;
+    for (; size - 1 + i + 32 <= length; i += 32) {
+        const __m256i begins = _mm256_loadu_si256(
+                (const __m256i *) (haystack + i));
+        const __m256i ends = _mm256_loadu_si256(
+                (const __m256i *) (haystack + i + size - 1));
+        uint32_t mask = (uint32_t) _mm256_movemask_epi8(_mm256_and_si256(
+                _mm256_cmpeq_epi8(first, begins),
+                _mm256_cmpeq_epi8(last, ends)));
+        for (; mask; mask &= mask - 1) {
+            const uint8_t *const at = haystack + i + __builtin_ctz(mask);
+            if (!memcmp(1 + at, 1 + needle, size - 1)) {
+                return at;
+            }
+        }
+    }
+    return sea_turtle_search_forward_sse42(haystack + i, length - i,
+                                           needle, size);
+}
+
+__attribute__((target("avx2")))
+const uint8_t *sea_turtle_search_backward_avx2(const uint8_t *const haystack,
+                                               const size_t length,
+                                               const uint8_t *const needle,
+                                               const size_t size) {
+    if (size > length) {
+        return NULL;
+    }
+    const __m256i first = _mm256_set1_epi8((char) needle[0]);
+    const __m256i last = _mm256_set1_epi8((char) needle[size - 1]);
+    size_t end = 1 + length - size;
+    for (; end >= 32; end -= 32) {
+        const size_t i = end - 32;
+        const __m256i begins = _mm256_loadu_si256(
+                (const __m256i *) (haystack + i));
+        const __m256i ends = _mm256_loadu_si256(
+                (const __m256i *) (haystack + i + size - 1));
+        uint32_t mask = (uint32_t) _mm256_movemask_epi8(_mm256_and_si256(
+                _mm256_cmpeq_epi8(first, begins),
+                _mm256_cmpeq_epi8(last, ends)));
+        while (mask) {
+            const int bit = 31 - __builtin_clz(mask);
+            const uint8_t *const at = haystack + i + bit;
+            if (!memcmp(1 + at, 1 + needle, size - 1)) {
+                return at;
+            }
+            mask &= ~(UINT32_C(1) << bit);
+        }
+    }
+    return sea_turtle_search_backward_sse42(haystack, end + size - 1,
+                                            needle, size);
+}
+#endif /* defined(SEA_TURTLE_SEARCH_X86) */
+
+static const uint8_t *(*sea_turtle_search_forward_implementation)(
+        const uint8_t *, size_t, const uint8_t *, size_t)
+        = sea_turtle_search_forward_scalar;
+static const uint8_t *(*sea_turtle_search_backward_implementation)(
+        const uint8_t *, size_t, const uint8_t *, size_t)
+        = sea_turtle_search_backward_scalar;
+static pthread_once_t sea_turtle_search_once = PTHREAD_ONCE_INIT;
+
+static void sea_turtle_search_select(void) {
+#if defined(SEA_TURTLE_SEARCH_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        sea_turtle_search_forward_implementation =
+                sea_turtle_search_forward_avx2;
+        sea_turtle_search_backward_implementation =
+                sea_turtle_search_backward_avx2;
+    } else if (__builtin_cpu_supports("sse4.2")) {
+        sea_turtle_search_forward_implementation =
+                sea_turtle_search_forward_sse42;
+        sea_turtle_search_backward_implementation =
+                sea_turtle_search_backward_sse42;
+    }
+#endif
+}
+
+const uint8_t *sea_turtle_search_forward(const uint8_t *const haystack,
+                                         const size_t length,
+                                         const uint8_t *const needle,
+                                         const size_t size) {
+    if (size > length) {
+        return NULL;
+    }
+    if (1 == size) {
+        return memchr(haystack, needle[0], length);
+    }
+    if (size > SEA_TURTLE_SEARCH_SHORT) {
+        return sea_turtle_search_forward_two_way(haystack, length, needle,
+                                                 size);
+    }
+    seagrass_required_true(!pthread_once(&sea_turtle_search_once,
+                                         sea_turtle_search_select));
+    return sea_turtle_search_forward_implementation(haystack, length,
+                                                    needle, size);
+}
+
+const uint8_t *sea_turtle_search_backward(const uint8_t *const haystack,
+                                          const size_t length,
+                                          const uint8_t *const needle,
+                                          const size_t size) {
+    if (size > length) {
+        return NULL;
+    }
+    if (size > SEA_TURTLE_SEARCH_SHORT) {
+        return sea_turtle_search_backward_two_way(haystack, length, needle,
+                                                  size);
+    }
+    seagrass_required_true(!pthread_once(&sea_turtle_search_once,
+                                         sea_turtle_search_select));
+    return sea_turtle_search_backward_implementation(haystack, length,
+                                                     needle, size);
+}
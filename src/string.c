@@ -1,14 +1,159 @@
 #include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
+#include <assert.h>
+#include <stdatomic.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sea-turtle.h>
 #include <seagrass.h>
 
+#include "private/allocator.h"
+#include "private/hash.h"
+#include "private/search.h"
 #include "private/string.h"
+#include "private/utf16.h"
+#include "private/utf8.h"
 
 #ifdef TEST
 #include <test/cmocka.h>
 #endif
 
+static_assert(sizeof(struct sea_turtle_string) <= 32,
+              "strings must remain half a cache line");
+
+struct sea_turtle_string_buffer *sea_turtle_string_buffer_of(
+        const struct sea_turtle_string *const object) {
+    if (!object->size) {
+        return NULL;
+    }
+    switch (sea_turtle_string_storage_of(object)) {
+        case SEA_TURTLE_STRING_STORAGE_HEAP:
+        case SEA_TURTLE_STRING_STORAGE_SHARED:
+            return (struct sea_turtle_string_buffer *)
+                    (object->data
+                     - offsetof(struct sea_turtle_string_buffer, data));
+        case SEA_TURTLE_STRING_STORAGE_MAPPED: {
+            /* the header has the page ahead of the file region to itself */
+            const size_t page = sysconf(_SC_PAGESIZE);
+            return (struct sea_turtle_string_buffer *)
+                    (object->data - (uintptr_t) object->data % page - page);
+        }
+        default:
+            return NULL;
+    }
+}
+
+static uint8_t *sea_turtle_string_buffer_allocate(
+        const struct sea_turtle_allocator *const allocator,
+        const size_t capacity) {
+    struct sea_turtle_string_buffer *buffer;
+    if (capacity > SIZE_MAX - sizeof(*buffer)
+        || !(buffer = sea_turtle_allocator_allocate(
+                allocator, sizeof(*buffer) + capacity))) {
+        return NULL;
+    }
+    atomic_init(&buffer->references, 1);
+    buffer->allocator = allocator;
+    buffer->capacity = capacity;
+    buffer->index = NULL;
+    return buffer->data;
+}
+
+uint8_t *sea_turtle_string_buffer_resize(uint8_t *const data,
+                                         const size_t capacity) {
+    if (!data) {
+        return sea_turtle_string_buffer_allocate(
+                sea_turtle_allocator_current(), capacity);
+    }
+    struct sea_turtle_string_buffer *buffer
+            = (struct sea_turtle_string_buffer *)
+                    (data - offsetof(struct sea_turtle_string_buffer, data));
+    if (capacity > SIZE_MAX - sizeof(*buffer)
+        || !(buffer = sea_turtle_allocator_reallocate(
+                buffer->allocator, buffer,
+                sizeof(*buffer) + buffer->capacity,
+                sizeof(*buffer) + capacity))) {
+        return NULL;
+    }
+    buffer->capacity = capacity;
+    return buffer->data;
+}
+
+void sea_turtle_string_buffer_release(uint8_t *const data) {
+    if (!data) {
+        return;
+    }
+    struct sea_turtle_string_buffer *const buffer
+            = (struct sea_turtle_string_buffer *)
+                    (data - offsetof(struct sea_turtle_string_buffer, data));
+    sea_turtle_allocator_deallocate(buffer->allocator, buffer,
+                                    sizeof(*buffer) + buffer->capacity);
+}
+
+static size_t sea_turtle_string_index_size(
+        const struct sea_turtle_string *const object) {
+    const size_t samples = 1 + (sea_turtle_string_count_of(object) - 1)
+                               / SEA_TURTLE_STRING_INDEX_INTERVAL;
+    return samples * sizeof(size_t);
+}
+
+/*
+ * the code point index describes the buffer it was built for, as it may be
+ * built from any thread reading the string it always uses the default
+ * allocator
+ */
+static void sea_turtle_string_release_index(
+        const struct sea_turtle_string *const object,
+        struct sea_turtle_string_buffer *const buffer) {
+    if (buffer && buffer->index) {
+        sea_turtle_allocator_deallocate(
+                NULL, buffer->index, sea_turtle_string_index_size(object));
+        buffer->index = NULL;
+    }
+}
+
+/* release the buffer of the string unless other strings share it */
+static void sea_turtle_string_release(
+        const struct sea_turtle_string *const object) {
+    struct sea_turtle_string_buffer *const buffer
+            = sea_turtle_string_buffer_of(object);
+    const enum sea_turtle_string_storage storage
+            = sea_turtle_string_storage_of(object);
+    if (!buffer
+        || (SEA_TURTLE_STRING_STORAGE_SHARED == storage
+            && 1 != atomic_fetch_sub_explicit(&buffer->references, 1,
+                                              memory_order_acq_rel))) {
+        return;
+    }
+    sea_turtle_string_release_index(object, buffer);
+    switch (storage) {
+        case SEA_TURTLE_STRING_STORAGE_HEAP:
+        case SEA_TURTLE_STRING_STORAGE_SHARED:
+            sea_turtle_string_buffer_release(object->data);
+            break;
+        case SEA_TURTLE_STRING_STORAGE_MAPPED:
+            seagrass_required_true(!munmap(buffer, buffer->capacity));
+            break;
+        default:
+            break;
+    }
+}
+
+/* copy of the buffer of a string that is neither empty nor local */
+static uint8_t *sea_turtle_string_copy(
+        const struct sea_turtle_string *const object,
+        const struct sea_turtle_allocator *const allocator) {
+    uint8_t *const data = sea_turtle_string_buffer_allocate(allocator,
+                                                            object->size);
+    if (data) {
+        memcpy(data, object->data, object->size);
+    }
+    return data;
+}
+
 int sea_turtle_string_init_string(
         struct sea_turtle_string *const object,
         const struct sea_turtle_string *const other) {
@@ -18,13 +163,87 @@ int sea_turtle_string_init_string(
     if (!other) {
         return SEA_TURTLE_STRING_ERROR_OTHER_IS_NULL;
     }
-    void *data = malloc(other->size);
+    if (sea_turtle_string_is_local(other)) {
+        *object = *other;
+        return 0;
+    }
+    if (!other->size) {
+        *object = (struct sea_turtle_string) {0};
+        return 0;
+    }
+    if (SEA_TURTLE_STRING_STORAGE_SHARED
+        == sea_turtle_string_storage_of(other)) {
+        atomic_fetch_add_explicit(
+                &sea_turtle_string_buffer_of(other)->references, 1,
+                memory_order_relaxed);
+        *object = *other;
+        return 0;
+    }
+    uint8_t *const data = sea_turtle_string_copy(
+            other, sea_turtle_allocator_current());
     if (!data) {
         return SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED;
     }
     *object = *other;
-    memcpy(data, other->data, other->size);
     object->data = data;
+    sea_turtle_string_set_storage(object, SEA_TURTLE_STRING_STORAGE_HEAP);
+    return 0;
+}
+
+int sea_turtle_string_share(struct sea_turtle_string *const object) {
+    if (!object) {
+        return SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL;
+    }
+    const enum sea_turtle_string_storage storage
+            = sea_turtle_string_storage_of(object);
+    if ((SEA_TURTLE_STRING_STORAGE_HEAP != storage
+         && SEA_TURTLE_STRING_STORAGE_ARENA != storage
+         && SEA_TURTLE_STRING_STORAGE_MAPPED != storage)
+        || !object->size) {
+        return 0;
+    }
+    /* heap buffers already carry a reference count and their allocator */
+    if (SEA_TURTLE_STRING_STORAGE_HEAP == storage) {
+        sea_turtle_string_set_storage(object,
+                                      SEA_TURTLE_STRING_STORAGE_SHARED);
+        return 0;
+    }
+    uint8_t *const data = sea_turtle_string_copy(
+            object, sea_turtle_allocator_current());
+    if (!data) {
+        return SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    sea_turtle_string_release(object);
+    object->data = data;
+    sea_turtle_string_set_storage(object, SEA_TURTLE_STRING_STORAGE_SHARED);
+    return 0;
+}
+
+int sea_turtle_string_init_shared(
+        struct sea_turtle_string *const object,
+        const struct sea_turtle_string *const other,
+        const struct sea_turtle_allocator *const allocator) {
+    if (!object) {
+        return SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL;
+    }
+    if (!other) {
+        return SEA_TURTLE_STRING_ERROR_OTHER_IS_NULL;
+    }
+    const enum sea_turtle_string_storage storage
+            = sea_turtle_string_storage_of(other);
+    if ((SEA_TURTLE_STRING_STORAGE_HEAP != storage
+         && SEA_TURTLE_STRING_STORAGE_ARENA != storage
+         && SEA_TURTLE_STRING_STORAGE_MAPPED != storage)
+        || !other->size) {
+        return sea_turtle_string_init_string(object, other);
+    }
+    uint8_t *const data = sea_turtle_string_copy(other, allocator);
+    if (!data) {
+        return SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    *object = *other;
+    object->data = data;
+    sea_turtle_string_set_storage(object, SEA_TURTLE_STRING_STORAGE_SHARED);
     return 0;
 }
 
@@ -43,48 +262,203 @@ int sea_turtle_string_init(struct sea_turtle_string *const object,
     }
     int error;
     *object = (struct sea_turtle_string) {0};
+    /* validate and count ahead of allocating the buffer so that malformed
+     * input is reported ahead of failed memory allocation */
     size_t count;
-    if ((error = sea_turtle_string_is_utf8_sequence(
-            char_ptr, size, &count, &object->count))) {
-        seagrass_required_true(
-                SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_MALFORMED
-                == error);
+    uintmax_t c;
+    if ((error = sea_turtle_utf8_validate((const uint8_t *) char_ptr, size,
+                                          &count, &c))) {
         return error;
     }
     if (!count) {
+        if (out) {
+            *out = 0;
+        }
         return 0;
     }
-    uintmax_t alloc;
     /* add 1 to accommodate the NULL termination char */
-    if ((error = seagrass_uintmax_t_add(1, count, &alloc))
-        || alloc > SIZE_MAX) {
+    if (SIZE_MAX == count
+        || (error = sea_turtle_string_set_size(object, 1 + count))) {
         seagrass_required_true(
-                SEAGRASS_UINTMAX_T_ERROR_RESULT_IS_INCONSISTENT
+                SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED
                 == error || !error);
         return SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED;
     }
-    if ((error = sea_turtle_string_set_size(object, alloc))) {
+    memcpy(sea_turtle_string_bytes(object), char_ptr, count);
+    sea_turtle_string_set_count(object, c);
+    if (out) {
+        *out = count;
+    }
+    return 0;
+}
+
+int sea_turtle_string_init_code_points(struct sea_turtle_string *const object,
+                                       const uint32_t *const code_points,
+                                       const size_t count) {
+    if (!object) {
+        return SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL;
+    }
+    if (!code_points) {
+        return SEA_TURTLE_STRING_ERROR_CODE_POINTS_IS_NULL;
+    }
+    *object = (struct sea_turtle_string) {0};
+    size_t size;
+    int error;
+    if ((error = sea_turtle_utf8_encoded_size(code_points, count, &size))) {
+        return error;
+    }
+    if (!size) {
+        return 0;
+    }
+    /* add 1 to accommodate the NULL termination char */
+    if ((error = sea_turtle_string_set_size(object, 1 + size))) {
         seagrass_required_true(
                 SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED
                 == error);
         return error;
     }
-    memcpy(object->data, char_ptr, count);
-    /* calculate hashcode */
-    const uint8_t *at;
-    seagrass_required_true(!sea_turtle_string_first(object, &at));
-    do {
-        uint32_t code_point;
-        seagrass_required_true(!sea_turtle_string_code_point(
-                object, at, &code_point));
-        object->hash = 31 * object->hash + code_point;
-    } while (!(error = sea_turtle_string_next(object, at, &at)));
-    seagrass_required_true(
-            SEA_TURTLE_STRING_ERROR_END_OF_SEQUENCE
-            == error);
+    sea_turtle_utf8_encode(code_points, count,
+                           sea_turtle_string_bytes(object));
+    sea_turtle_string_set_count(object, count);
+    return 0;
+}
+
+int sea_turtle_string_init_utf16(
+        struct sea_turtle_string *const object,
+        const void *const utf16,
+        const size_t count,
+        const enum sea_turtle_string_byte_order order) {
+    if (!object) {
+        return SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL;
+    }
+    if (!utf16) {
+        return SEA_TURTLE_STRING_ERROR_UTF16_IS_NULL;
+    }
+    if (SEA_TURTLE_STRING_BYTE_ORDER_LITTLE_ENDIAN != order
+        && SEA_TURTLE_STRING_BYTE_ORDER_BIG_ENDIAN != order) {
+        return SEA_TURTLE_STRING_ERROR_ORDER_IS_INVALID;
+    }
+    *object = (struct sea_turtle_string) {0};
+    const bool big = SEA_TURTLE_STRING_BYTE_ORDER_BIG_ENDIAN == order;
+    size_t size;
+    uintmax_t code_points;
+    int error;
+    if ((error = sea_turtle_utf16_measure(utf16, count, big, &size,
+                                          &code_points))) {
+        return error;
+    }
+    if (!size) {
+        return 0;
+    }
+    /* add 1 to accommodate the NULL termination char */
+    if ((error = sea_turtle_string_set_size(object, 1 + size))) {
+        seagrass_required_true(
+                SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED
+                == error);
+        return error;
+    }
+    sea_turtle_utf16_to_utf8(utf16, count, big,
+                             sea_turtle_string_bytes(object));
+    sea_turtle_string_set_count(object, code_points);
+    return 0;
+}
+
+int sea_turtle_string_init_file(struct sea_turtle_string *const object,
+                                const int fd,
+                                const uintmax_t offset,
+                                const size_t size,
+                                size_t *const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL;
+    }
+    if (!size) {
+        return SEA_TURTLE_STRING_ERROR_SIZE_IS_ZERO;
+    }
+    struct stat status;
+    if (fd < 0 || fstat(fd, &status) || !S_ISREG(status.st_mode)) {
+        return SEA_TURTLE_STRING_ERROR_FD_IS_INVALID;
+    }
+    if (offset > (uintmax_t) status.st_size) {
+        return SEA_TURTLE_STRING_ERROR_OFFSET_IS_OUT_OF_BOUNDS;
+    }
+    *object = (struct sea_turtle_string) {0};
+    const uintmax_t available = status.st_size - offset;
+    const size_t length = available < size ? available : size;
+    if (!length) {
+        if (out) {
+            *out = 0;
+        }
+        return 0;
+    }
+    const size_t page = sysconf(_SC_PAGESIZE);
+    const size_t skip = offset % page;
+    /* add 1 to accommodate the NULL termination char */
+    if (length > SIZE_MAX - skip - 2 * page) {
+        return SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    const size_t capacity = (skip + length + page) / page * page;
+    /*
+     * the file is mapped over anonymous memory so that the NULL termination
+     * char has a page to go to even if the region ends where the file ends,
+     * the page ahead of the region holding the header of the mapping
+     */
+    uint8_t *const base = mmap(NULL, page + capacity, PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (MAP_FAILED == base) {
+        return SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    uint8_t *const region = base + page;
+    const uintmax_t file = status.st_size - (offset - skip);
+    if (MAP_FAILED == mmap(region, file < capacity ? file : capacity,
+                           PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED,
+                           fd, (off_t) (offset - skip))) {
+        const int error = errno;
+        seagrass_required_true(!munmap(base, page + capacity));
+        return ENOMEM == error
+               ? SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED
+               : SEA_TURTLE_STRING_ERROR_FD_IS_INVALID;
+    }
+    uint8_t *const data = region + skip;
+    /* only the page holding the NULL termination char is copied */
+    data[length] = 0;
+    seagrass_required_true(!mprotect(region, capacity, PROT_READ));
+    (void) madvise(region, capacity, MADV_SEQUENTIAL);
+    size_t count;
+    uintmax_t code_points;
+    int error;
+    if ((error = sea_turtle_utf8_validate(data, length, &count,
+                                          &code_points))) {
+        seagrass_required_true(
+                SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_MALFORMED
+                == error);
+        seagrass_required_true(!munmap(base, page + capacity));
+        *object = (struct sea_turtle_string) {0};
+        return error;
+    }
+    (void) madvise(region, capacity, MADV_NORMAL);
     if (out) {
         *out = count;
     }
+    if (!count) {
+        seagrass_required_true(!munmap(base, page + capacity));
+        return 0;
+    }
+    object->size = 1 + count;
+    if (sea_turtle_string_is_local(object)) {
+        memcpy(object->local, data, object->size);
+        seagrass_required_true(!munmap(base, page + capacity));
+        sea_turtle_string_set_count(object, code_points);
+        return 0;
+    }
+    struct sea_turtle_string_buffer *const buffer
+            = (struct sea_turtle_string_buffer *) base;
+    atomic_init(&buffer->references, 1);
+    buffer->allocator = NULL;
+    buffer->capacity = page + capacity;
+    buffer->index = NULL;
+    object->data = data;
+    sea_turtle_string_set_storage(object, SEA_TURTLE_STRING_STORAGE_MAPPED);
+    sea_turtle_string_set_count(object, code_points);
     return 0;
 }
 
@@ -92,7 +466,7 @@ int sea_turtle_string_invalidate(struct sea_turtle_string *const object) {
     if (!object) {
         return SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL;
     }
-    free(object->data);
+    sea_turtle_string_release(object);
     *object = (struct sea_turtle_string) {0};
     return 0;
 }
@@ -110,122 +484,8 @@ int sea_turtle_string_is_utf8_sequence(const char *const char_ptr,
     if (!out) {
         return SEA_TURTLE_STRING_ERROR_OUT_IS_NULL;
     }
-    /* https://www.rfc-editor.org/rfc/rfc3629#section-4 */
-    int error;
-    uintmax_t i = 0, o = 0, c = 0;
-    const uint8_t *byte = (const uint8_t *) char_ptr;
-    while (byte[i] && i < size) {
-        seagrass_required_true(!seagrass_uintmax_t_add(1, c, &c));
-        /* UTF8-1 */
-        if (byte[i] <= 0x7F) {
-            if ((error = seagrass_uintmax_t_add(1, i, &i)) || i > size) {
-                seagrass_required_true(
-                        SEAGRASS_UINTMAX_T_ERROR_RESULT_IS_INCONSISTENT
-                        == error || !error);
-                return SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_MALFORMED;
-            }
-            continue;
-        }
-        if ((error = seagrass_uintmax_t_add(1, i, &o)) || o >= size) {
-            seagrass_required_true(
-                    SEAGRASS_UINTMAX_T_ERROR_RESULT_IS_INCONSISTENT
-                    == error || !error);
-            return SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_MALFORMED;
-        }
-        /* UTF8-2 */
-        if (byte[i] >= 0xC2
-            && byte[i] <= 0xDF
-            && byte[1 + i] >= 0x80
-            && byte[1 + i] <= 0xBF) {
-            if ((error = seagrass_uintmax_t_add(2, i, &i)) || i > size) {
-                seagrass_required_true(
-                        SEAGRASS_UINTMAX_T_ERROR_RESULT_IS_INCONSISTENT
-                        == error || !error);
-                return SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_MALFORMED;
-            }
-            continue;
-        }
-        if ((error = seagrass_uintmax_t_add(2, i, &o)) || o >= size) {
-            seagrass_required_true(
-                    SEAGRASS_UINTMAX_T_ERROR_RESULT_IS_INCONSISTENT
-                    == error || !error);
-            return SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_MALFORMED;
-        }
-        /* UTF8-3 */
-        if ((byte[i] == 0xE0
-             && byte[1 + i] >= 0xA0
-             && byte[1 + i] <= 0xBF
-             && byte[2 + i] >= 0x80
-             && byte[2 + i] <= 0xBF)
-            || (byte[i] >= 0xE1
-                && byte[i] <= 0xEC
-                && byte[1 + i] >= 0x80
-                && byte[1 + i] <= 0xBF
-                && byte[2 + i] >= 0x80
-                && byte[2 + i] <= 0xBF)
-            || (byte[i] == 0xED
-                && byte[1 + i] >= 0x80
-                && byte[1 + i] <= 0x9F
-                && byte[2 + i] >= 0x80
-                && byte[2 + i] <= 0xBF)
-            || (byte[i] >= 0xEE
-                && byte[i] <= 0xEF
-                && byte[1 + i] >= 0x80
-                && byte[1 + i] <= 0xBF
-                && byte[2 + i] >= 0x80
-                && byte[2 + i] <= 0xBF)) {
-            if ((error = seagrass_uintmax_t_add(3, i, &i)) || i > size) {
-                seagrass_required_true(
-                        SEAGRASS_UINTMAX_T_ERROR_RESULT_IS_INCONSISTENT
-                        == error || !error);
-                return SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_MALFORMED;
-            }
-            continue;
-        }
-        if ((error = seagrass_uintmax_t_add(3, i, &o)) || o >= size) {
-            seagrass_required_true(
-                    SEAGRASS_UINTMAX_T_ERROR_RESULT_IS_INCONSISTENT
-                    == error || !error);
-            return SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_MALFORMED;
-        }
-        /* UTF8-4 */
-        if ((byte[i] == 0xF0
-             && byte[1 + i] >= 0x90
-             && byte[1 + i] <= 0xBF
-             && byte[2 + i] >= 0x80
-             && byte[2 + i] <= 0xBF
-             && byte[3 + i] >= 0x80
-             && byte[3 + i] <= 0xBF)
-            || (byte[i] >= 0xF1
-                && byte[i] <= 0xF3
-                && byte[1 + i] >= 0x80
-                && byte[1 + i] <= 0xBF
-                && byte[2 + i] >= 0x80
-                && byte[2 + i] <= 0xBF
-                && byte[3 + i] >= 0x80
-                && byte[3 + i] <= 0xBF)
-            || (byte[i] == 0xF4
-                && byte[1 + i] >= 0x80
-                && byte[1 + i] <= 0x8F
-                && byte[2 + i] >= 0x80
-                && byte[2 + i] <= 0xBF
-                && byte[3 + i] >= 0x80
-                && byte[3 + i] <= 0xBF)) {
-            if ((error = seagrass_uintmax_t_add(4, i, &i)) || i > size) {
-                seagrass_required_true(
-                        SEAGRASS_UINTMAX_T_ERROR_RESULT_IS_INCONSISTENT
-                        == error || !error);
-                return SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_MALFORMED;
-            }
-            continue;
-        }
-        return SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_MALFORMED;
-    }
-    if (count) {
-        *count = c;
-    }
-    *out = i;
-    return 0;
+    return sea_turtle_utf8_validate((const uint8_t *) char_ptr, size, out,
+                                    count);
 }
 
 int sea_turtle_string_count(const struct sea_turtle_string *const object,
@@ -236,7 +496,7 @@ int sea_turtle_string_count(const struct sea_turtle_string *const object,
     if (!out) {
         return SEA_TURTLE_STRING_ERROR_OUT_IS_NULL;
     }
-    *out = object->count;
+    *out = sea_turtle_string_count_of(object);
     return 0;
 }
 
@@ -249,11 +509,27 @@ int sea_turtle_string_compare(const struct sea_turtle_string *const object,
     if (!object) {
         return 1;
     }
+    /* the same instance is trivially equal, distinct ones are compared below */
+    if (object == other) {
+        return 0;
+    }
     int result = seagrass_uintmax_t_compare(object->size, other->size);
     if (result) {
         return result;
     }
-    result = memcmp(object->data, other->data, object->size);
+    /* empty strings have no buffer and copies of a shared string refer to
+     * the same buffer */
+    if (!object->size
+        || (SEA_TURTLE_STRING_STORAGE_SHARED
+            == sea_turtle_string_storage_of(object)
+            && SEA_TURTLE_STRING_STORAGE_SHARED
+               == sea_turtle_string_storage_of(other)
+            && object->data == other->data)) {
+        return 0;
+    }
+    result = memcmp(sea_turtle_string_bytes(object),
+                    sea_turtle_string_bytes(other),
+                    object->size);
     if (result < 0) {
         return (-1);
     } else if (result > 0) {
@@ -262,6 +538,103 @@ int sea_turtle_string_compare(const struct sea_turtle_string *const object,
     return 0;
 }
 
+/* equality of byte sequences of the same size */
+static bool sea_turtle_string_bytes_equal(const uint8_t *const a,
+                                          const uint8_t *const b,
+                                          const size_t size) {
+    size_t i = 0;
+    /* 32 bytes at a time with a single branch, which compiles down to
+     * vector loads and compares */
+    for (; i + 32 <= size; i += 32) {
+        uint64_t x[4];
+        uint64_t y[4];
+        memcpy(x, a + i, sizeof(x));
+        memcpy(y, b + i, sizeof(y));
+        if ((x[0] ^ y[0]) | (x[1] ^ y[1]) | (x[2] ^ y[2]) | (x[3] ^ y[3])) {
+            return false;
+        }
+    }
+    return !memcmp(a + i, b + i, size - i);
+}
+
+/* equality of strings already known to be of the same size */
+static bool sea_turtle_string_equal(
+        const struct sea_turtle_string *const object,
+        const struct sea_turtle_string *const other) {
+    if (object == other || !object->size) {
+        return true;
+    }
+    const uintmax_t a = sea_turtle_string_cached_hash(object);
+    const uintmax_t b = sea_turtle_string_cached_hash(other);
+    if (a && b && a != b) {
+        return false;
+    }
+    /* copies of a shared string refer to the same buffer */
+    if (SEA_TURTLE_STRING_STORAGE_SHARED
+        == sea_turtle_string_storage_of(object)
+        && SEA_TURTLE_STRING_STORAGE_SHARED
+           == sea_turtle_string_storage_of(other)
+        && object->data == other->data) {
+        return true;
+    }
+    return sea_turtle_string_bytes_equal(sea_turtle_string_bytes(object),
+                                         sea_turtle_string_bytes(other),
+                                         object->size - 1);
+}
+
+int sea_turtle_string_equals(const struct sea_turtle_string *const object,
+                             const struct sea_turtle_string *const other,
+                             bool *const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL;
+    }
+    if (!other) {
+        return SEA_TURTLE_STRING_ERROR_OTHER_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_ERROR_OUT_IS_NULL;
+    }
+    *out = object->size == other->size
+           && sea_turtle_string_equal(object, other);
+    return 0;
+}
+
+int sea_turtle_string_equals_any(
+        const struct sea_turtle_string *const object,
+        const struct sea_turtle_string *const *const others,
+        const size_t count,
+        size_t *const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL;
+    }
+    if (!others) {
+        return SEA_TURTLE_STRING_ERROR_OTHERS_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_ERROR_OUT_IS_NULL;
+    }
+    uintmax_t hash = sea_turtle_string_cached_hash(object);
+    for (size_t i = 0; i < count; i++) {
+        const struct sea_turtle_string *const other = others[i];
+        if (!other || object->size != other->size) {
+            continue;
+        }
+        const uintmax_t other_hash = sea_turtle_string_cached_hash(other);
+        /* hashing the object once pays off over the candidates */
+        if (other_hash && !hash && object->size) {
+            seagrass_required_true(!sea_turtle_string_hash(object, &hash));
+        }
+        if (hash && other_hash && hash != other_hash) {
+            continue;
+        }
+        if (sea_turtle_string_equal(object, other)) {
+            *out = i;
+            return 0;
+        }
+    }
+    return SEA_TURTLE_STRING_ERROR_OTHER_NOT_FOUND;
+}
+
 int sea_turtle_string_hash(const struct sea_turtle_string *const object,
                            uintmax_t *const out) {
     if (!object) {
@@ -270,8 +643,35 @@ int sea_turtle_string_hash(const struct sea_turtle_string *const object,
     if (!out) {
         return SEA_TURTLE_STRING_ERROR_OUT_IS_NULL;
     }
-    *out = object->hash;
-    return true;
+    if (sea_turtle_string_is_local(object)) {
+        *out = sea_turtle_hash(object->local, object->size - 1);
+        return 0;
+    }
+    /* the hash is a cache so it is published even through a const string
+     * and threads racing to compute it store the same value */
+    uintmax_t *const slot = (uintmax_t *) &object->hash;
+    uintmax_t hash = __atomic_load_n(slot, __ATOMIC_RELAXED);
+    if (!hash && object->size) {
+        hash = sea_turtle_hash(sea_turtle_string_bytes(object),
+                               object->size - 1);
+        __atomic_store_n(slot, hash, __ATOMIC_RELAXED);
+    }
+    *out = hash;
+    return 0;
+}
+
+int sea_turtle_string_hash_128(const struct sea_turtle_string *const object,
+                               uint64_t *const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_ERROR_OUT_IS_NULL;
+    }
+    sea_turtle_hash_128(sea_turtle_string_bytes(object),
+                        object->size ? object->size - 1 : 0,
+                        out);
+    return 0;
 }
 
 int sea_turtle_string_set_size(struct sea_turtle_string *const object,
@@ -282,21 +682,64 @@ int sea_turtle_string_set_size(struct sea_turtle_string *const object,
     uintmax_t new;
     seagrass_required_true(!seagrass_uintmax_t_maximum(
             1, size, &new));
-    if (new > SIZE_MAX) {
+    if (new > SEA_TURTLE_STRING_SIZE_MAX) {
         return SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED;
     }
-    if (new == object->size) {
-        return 0;
-    }
-    uint8_t *data = object->data
-                    ? realloc(object->data, new)
-                    : malloc(new);
-    if (!data) {
-        return SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED;
+    const enum sea_turtle_string_storage storage
+            = sea_turtle_string_storage_of(object);
+    /* the count outlives moving the bytes over the word holding it */
+    const uintmax_t count = sea_turtle_string_count_of(object);
+    uint8_t *data = NULL;
+    if (SEA_TURTLE_STRING_STORAGE_SHARED == storage
+        || SEA_TURTLE_STRING_STORAGE_ARENA == storage
+        || SEA_TURTLE_STRING_STORAGE_MAPPED == storage) {
+        /* copy on write */
+        const struct sea_turtle_string previous = *object;
+        if (new > SEA_TURTLE_STRING_LOCAL_SIZE
+            && !(data = sea_turtle_string_buffer_resize(NULL, new))) {
+            return SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED;
+        }
+        uint8_t *const to = data ? data : object->local;
+        memcpy(to, previous.data, new < previous.size
+                                  ? new
+                                  : previous.size);
+        sea_turtle_string_release(&previous);
+        to[new - 1] = 0;
+    } else if (new <= SEA_TURTLE_STRING_LOCAL_SIZE) {
+        if (SEA_TURTLE_STRING_STORAGE_HEAP == storage && object->size) {
+            const struct sea_turtle_string previous = *object;
+            memcpy(object->local, previous.data, new < previous.size
+                                                 ? new
+                                                 : previous.size);
+            sea_turtle_string_release(&previous);
+        }
+        object->local[new - 1] = 0;
+    } else if (SEA_TURTLE_STRING_STORAGE_LOCAL == storage) {
+        if (!(data = sea_turtle_string_buffer_resize(NULL, new))) {
+            return SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED;
+        }
+        memcpy(data, object->local, object->size);
+        data[new - 1] = 0;
+    } else {
+        sea_turtle_string_release_index(
+                object, sea_turtle_string_buffer_of(object));
+        object->hash = 0;
+        if (new == object->size) {
+            return 0;
+        }
+        if (!(data = sea_turtle_string_buffer_resize(object->data, new))) {
+            return SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED;
+        }
+        data[new - 1] = 0;
     }
-    data[new - 1] = 0;
-    object->data = data;
     object->size = new;
+    if (data) {
+        object->data = data;
+        object->hash = 0;
+        object->tagged_count = 0;
+        sea_turtle_string_set_storage(object, SEA_TURTLE_STRING_STORAGE_HEAP);
+    }
+    sea_turtle_string_set_count(object, count);
     return 0;
 }
 
@@ -308,10 +751,10 @@ int sea_turtle_string_first(const struct sea_turtle_string *const object,
     if (!out) {
         return SEA_TURTLE_STRING_ERROR_OUT_IS_NULL;
     }
-    if (!object->count) {
+    if (!sea_turtle_string_count_of(object)) {
         return SEA_TURTLE_STRING_ERROR_STRING_IS_EMPTY;
     }
-    *out = object->data;
+    *out = sea_turtle_string_bytes(object);
     return 0;
 }
 
@@ -323,10 +766,10 @@ int sea_turtle_string_last(const struct sea_turtle_string *const object,
     if (!out) {
         return SEA_TURTLE_STRING_ERROR_OUT_IS_NULL;
     }
-    if (!object->count) {
+    if (!sea_turtle_string_count_of(object)) {
         return SEA_TURTLE_STRING_ERROR_STRING_IS_EMPTY;
     }
-    const uint8_t *end = object->data + object->size - 1;
+    const uint8_t *end = sea_turtle_string_bytes(object) + object->size - 1;
     seagrass_required_true(!sea_turtle_string_prev(object, end, out));
     return 0;
 }
@@ -343,8 +786,9 @@ int sea_turtle_string_next(const struct sea_turtle_string *const object,
     if (!out) {
         return SEA_TURTLE_STRING_ERROR_OUT_IS_NULL;
     }
-    const uint8_t *const end = object->data + object->size - 1;
-    if (at < object->data || end < at) {
+    const uint8_t *const data = sea_turtle_string_bytes(object);
+    const uint8_t *const end = data + object->size - 1;
+    if (at < data || end < at) {
         return SEA_TURTLE_STRING_ERROR_AT_IS_OUT_OF_BOUNDS;
     }
     const uint8_t byte = *at;
@@ -376,8 +820,9 @@ int sea_turtle_string_prev(const struct sea_turtle_string *const object,
     if (!out) {
         return SEA_TURTLE_STRING_ERROR_OUT_IS_NULL;
     }
-    const uint8_t *const end = object->data + object->size - 1;
-    if (at < object->data || end < at) {
+    const uint8_t *const data = sea_turtle_string_bytes(object);
+    const uint8_t *const end = data + object->size - 1;
+    if (at < data || end < at) {
         return SEA_TURTLE_STRING_ERROR_AT_IS_OUT_OF_BOUNDS;
     }
     const uint8_t byte = *at;
@@ -390,15 +835,144 @@ int sea_turtle_string_prev(const struct sea_turtle_string *const object,
         return SEA_TURTLE_STRING_ERROR_AT_IS_INVALID;
     }
     size_t i = 4;
-    for (; *out >= object->data && i && (**out & 0xC0) == 0x80; i--, *out -= 1);
+    for (; *out >= data && i && (**out & 0xC0) == 0x80; i--, *out -= 1);
     if (!i) {
         return SEA_TURTLE_STRING_ERROR_AT_IS_INVALID;
     }
-    return *out < object->data
+    return *out < data
            ? SEA_TURTLE_STRING_ERROR_END_OF_SEQUENCE
            : 0;
 }
 
+/* skip count UTF-8 encoded symbols of a valid UTF-8 sequence */
+static const uint8_t *sea_turtle_string_skip(const uint8_t *at,
+                                             uintmax_t count) {
+    for (; count; count--) {
+        const uint8_t byte = *at;
+        at += byte < 0x80 ? 1 : byte >= 0xF0 ? 4 : byte >= 0xE0 ? 3 : 2;
+    }
+    return at;
+}
+
+static size_t *sea_turtle_string_build_index(
+        const struct sea_turtle_string *const object) {
+    const size_t size = sea_turtle_string_index_size(object);
+    const size_t samples = size / sizeof(size_t);
+    size_t *const index = sea_turtle_allocator_allocate(NULL, size);
+    if (!index) {
+        return NULL;
+    }
+    const uint8_t *const data = object->data;
+    const uint8_t *at = data;
+    index[0] = 0;
+    for (size_t i = 1; i < samples; i++) {
+        at = sea_turtle_string_skip(at, SEA_TURTLE_STRING_INDEX_INTERVAL);
+        index[i] = at - data;
+    }
+    return index;
+}
+
+/*
+ * the index is kept in the header of the buffer, strings with a buffer
+ * owned by an arena or the caller have nowhere to keep it
+ */
+static const size_t *sea_turtle_string_index(
+        const struct sea_turtle_string *const object) {
+    struct sea_turtle_string_buffer *const buffer
+            = sea_turtle_string_buffer_of(object);
+    if (!buffer) {
+        return NULL;
+    }
+    size_t **const slot = &buffer->index;
+    size_t *index = __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+    if (index) {
+        return index;
+    }
+    if (!(index = sea_turtle_string_build_index(object))) {
+        return NULL;
+    }
+    size_t *expected = NULL;
+    if (!__atomic_compare_exchange_n(slot, &expected, index, false,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        /* another thread published its index first */
+        sea_turtle_allocator_deallocate(
+                NULL, index, sea_turtle_string_index_size(object));
+        index = expected;
+    }
+    return index;
+}
+
+int sea_turtle_string_at(const struct sea_turtle_string *const object,
+                         const uintmax_t index,
+                         const uint8_t **const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_ERROR_OUT_IS_NULL;
+    }
+    const uintmax_t count = sea_turtle_string_count_of(object);
+    if (index >= count) {
+        return SEA_TURTLE_STRING_ERROR_INDEX_IS_OUT_OF_BOUNDS;
+    }
+    const uint8_t *const data = sea_turtle_string_bytes(object);
+    /* every code point of an ASCII string is a single byte */
+    if (count == object->size - 1) {
+        *out = data + index;
+        return 0;
+    }
+    const size_t *samples;
+    if (index < SEA_TURTLE_STRING_INDEX_INTERVAL
+        || !(samples = sea_turtle_string_index(object))) {
+        *out = sea_turtle_string_skip(data, index);
+        return 0;
+    }
+    *out = sea_turtle_string_skip(
+            data + samples[index / SEA_TURTLE_STRING_INDEX_INTERVAL],
+            index % SEA_TURTLE_STRING_INDEX_INTERVAL);
+    return 0;
+}
+
+int sea_turtle_string_substring(const struct sea_turtle_string *const object,
+                                const uintmax_t index,
+                                const uintmax_t count,
+                                struct sea_turtle_string_view *const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_ERROR_OUT_IS_NULL;
+    }
+    const uintmax_t total = sea_turtle_string_count_of(object);
+    if (index > total) {
+        return SEA_TURTLE_STRING_ERROR_INDEX_IS_OUT_OF_BOUNDS;
+    }
+    if (count > total - index) {
+        return SEA_TURTLE_STRING_ERROR_COUNT_IS_OUT_OF_BOUNDS;
+    }
+    if (!object->size) {
+        *out = (struct sea_turtle_string_view) {0};
+        return 0;
+    }
+    const uint8_t *const end = sea_turtle_string_bytes(object)
+                               + object->size - 1;
+    const uint8_t *begin = end;
+    const uint8_t *last = end;
+    if (index < total) {
+        seagrass_required_true(!sea_turtle_string_at(object, index, &begin));
+    }
+    if (index + count < total) {
+        seagrass_required_true(!sea_turtle_string_at(
+                object, index + count, &last));
+    }
+    *out = (struct sea_turtle_string_view) {
+            .data = begin,
+            .size = last - begin,
+            .count = count
+    };
+    return 0;
+}
+
 int sea_turtle_string_code_point(const struct sea_turtle_string *const object,
                                  const uint8_t *const at,
                                  uint32_t *const out) {
@@ -411,8 +985,9 @@ int sea_turtle_string_code_point(const struct sea_turtle_string *const object,
     if (!out) {
         return SEA_TURTLE_STRING_ERROR_OUT_IS_NULL;
     }
-    const uint8_t *const end = object->data + object->size - 1;
-    if (at < object->data || end < at) {
+    const uint8_t *const data = sea_turtle_string_bytes(object);
+    const uint8_t *const end = data + object->size - 1;
+    if (at < data || end < at) {
         return SEA_TURTLE_STRING_ERROR_AT_IS_OUT_OF_BOUNDS;
     }
     uintmax_t i;
@@ -443,3 +1018,327 @@ int sea_turtle_string_code_point(const struct sea_turtle_string *const object,
     return 0;
 }
 
+
+int sea_turtle_string_code_points(const struct sea_turtle_string *const object,
+                                  const uintmax_t index,
+                                  const size_t size,
+                                  uint32_t *const out,
+                                  size_t *const count) {
+    if (!object) {
+        return SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_ERROR_OUT_IS_NULL;
+    }
+    const uintmax_t total = sea_turtle_string_count_of(object);
+    if (index > total) {
+        return SEA_TURTLE_STRING_ERROR_INDEX_IS_OUT_OF_BOUNDS;
+    }
+    const size_t n = total - index < size
+                     ? total - index
+                     : size;
+    if (n) {
+        const uint8_t *at;
+        seagrass_required_true(!sea_turtle_string_at(object, index, &at));
+        sea_turtle_utf8_decode(at, sea_turtle_string_bytes(object)
+                                   + object->size, n, out);
+    }
+    if (count) {
+        *count = n;
+    }
+    return 0;
+}
+
+/* code points beyond the BMP, and only those, start with 0xF0 or more */
+static size_t sea_turtle_string_utf16_units(
+        const struct sea_turtle_string *const object) {
+    const uintmax_t count = sea_turtle_string_count_of(object);
+    if (count == object->size - 1 || !object->size) {
+        return count;
+    }
+    const uint8_t *const data = sea_turtle_string_bytes(object);
+    size_t units = count;
+    for (size_t i = 0; i < object->size - 1; i++) {
+        units += data[i] >= 0xF0;
+    }
+    return units;
+}
+
+int sea_turtle_string_utf16_count(const struct sea_turtle_string *const object,
+                                  size_t *const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_ERROR_OUT_IS_NULL;
+    }
+    *out = sea_turtle_string_utf16_units(object);
+    return 0;
+}
+
+int sea_turtle_string_to_utf16(const struct sea_turtle_string *const object,
+                               const enum sea_turtle_string_byte_order order,
+                               void *const out,
+                               const size_t size) {
+    if (!object) {
+        return SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL;
+    }
+    if (SEA_TURTLE_STRING_BYTE_ORDER_LITTLE_ENDIAN != order
+        && SEA_TURTLE_STRING_BYTE_ORDER_BIG_ENDIAN != order) {
+        return SEA_TURTLE_STRING_ERROR_ORDER_IS_INVALID;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_ERROR_OUT_IS_NULL;
+    }
+    const size_t units = sea_turtle_string_utf16_units(object);
+    if (size < units) {
+        return SEA_TURTLE_STRING_ERROR_SIZE_IS_TOO_SMALL;
+    }
+    if (units) {
+        sea_turtle_utf16_from_utf8(
+                sea_turtle_string_bytes(object), object->size - 1,
+                SEA_TURTLE_STRING_BYTE_ORDER_BIG_ENDIAN == order, out, units);
+    }
+    return 0;
+}
+
+/* code point index of a UTF-8 encoded symbol of the string */
+static uintmax_t sea_turtle_string_index_of(
+        const struct sea_turtle_string *const object,
+        const uint8_t *const data,
+        const uint8_t *const at) {
+    const size_t offset = at - data;
+    const uintmax_t count = sea_turtle_string_count_of(object);
+    if (count == object->size - 1) {
+        return offset;
+    }
+    uintmax_t index = 0;
+    const uint8_t *from = data;
+    const size_t *samples;
+    /* start counting from the last sample at or before the symbol */
+    if (offset >= SEA_TURTLE_STRING_INDEX_INTERVAL
+        && (samples = sea_turtle_string_index(object))) {
+        size_t low = 0;
+        size_t high = 1 + (count - 1) / SEA_TURTLE_STRING_INDEX_INTERVAL;
+        while (high - low > 1) {
+            const size_t middle = low + (high - low) / 2;
+            if (samples[middle] <= offset) {
+                low = middle;
+            } else {
+                high = middle;
+            }
+        }
+        index = low * SEA_TURTLE_STRING_INDEX_INTERVAL;
+        from = data + samples[low];
+    }
+    for (; from < at; from++) {
+        index += (*from & 0xC0) != 0x80;
+    }
+    return index;
+}
+
+static size_t sea_turtle_string_length(
+        const struct sea_turtle_string *const object) {
+    return object->size ? object->size - 1 : 0;
+}
+
+int sea_turtle_string_find(const struct sea_turtle_string *const object,
+                           const struct sea_turtle_string *const needle,
+                           const uint8_t **const out,
+                           uintmax_t *const index) {
+    if (!object) {
+        return SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL;
+    }
+    if (!needle) {
+        return SEA_TURTLE_STRING_ERROR_NEEDLE_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_ERROR_OUT_IS_NULL;
+    }
+    const uint8_t *const data = sea_turtle_string_bytes(object);
+    const size_t size = sea_turtle_string_length(needle);
+    const uint8_t *at = data;
+    if (size && !(at = sea_turtle_search_forward(
+            data, sea_turtle_string_length(object),
+            sea_turtle_string_bytes(needle), size))) {
+        return SEA_TURTLE_STRING_ERROR_NEEDLE_NOT_FOUND;
+    }
+    *out = at;
+    if (index) {
+        *index = sea_turtle_string_index_of(object, data, at);
+    }
+    return 0;
+}
+
+int sea_turtle_string_rfind(const struct sea_turtle_string *const object,
+                            const struct sea_turtle_string *const needle,
+                            const uint8_t **const out,
+                            uintmax_t *const index) {
+    if (!object) {
+        return SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL;
+    }
+    if (!needle) {
+        return SEA_TURTLE_STRING_ERROR_NEEDLE_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_ERROR_OUT_IS_NULL;
+    }
+    const uint8_t *const data = sea_turtle_string_bytes(object);
+    const size_t length = sea_turtle_string_length(object);
+    const size_t size = sea_turtle_string_length(needle);
+    if (!size) {
+        *out = length ? data + length : data;
+        if (index) {
+            *index = sea_turtle_string_count_of(object);
+        }
+        return 0;
+    }
+    const uint8_t *const at = sea_turtle_search_backward(
+            data, length, sea_turtle_string_bytes(needle), size);
+    if (!at) {
+        return SEA_TURTLE_STRING_ERROR_NEEDLE_NOT_FOUND;
+    }
+    *out = at;
+    if (index) {
+        *index = sea_turtle_string_index_of(object, data, at);
+    }
+    return 0;
+}
+
+int sea_turtle_string_contains(const struct sea_turtle_string *const object,
+                               const struct sea_turtle_string *const needle,
+                               bool *const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL;
+    }
+    if (!needle) {
+        return SEA_TURTLE_STRING_ERROR_NEEDLE_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_ERROR_OUT_IS_NULL;
+    }
+    const size_t size = sea_turtle_string_length(needle);
+    *out = !size || sea_turtle_search_forward(
+            sea_turtle_string_bytes(object),
+            sea_turtle_string_length(object),
+            sea_turtle_string_bytes(needle), size);
+    return 0;
+}
+
+int sea_turtle_string_starts_with(const struct sea_turtle_string *const object,
+                                  const struct sea_turtle_string *const needle,
+                                  bool *const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL;
+    }
+    if (!needle) {
+        return SEA_TURTLE_STRING_ERROR_NEEDLE_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_ERROR_OUT_IS_NULL;
+    }
+    const size_t size = sea_turtle_string_length(needle);
+    *out = !size
+           || (size <= sea_turtle_string_length(object)
+               && !memcmp(sea_turtle_string_bytes(object),
+                          sea_turtle_string_bytes(needle), size));
+    return 0;
+}
+
+int sea_turtle_string_ends_with(const struct sea_turtle_string *const object,
+                                const struct sea_turtle_string *const needle,
+                                bool *const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL;
+    }
+    if (!needle) {
+        return SEA_TURTLE_STRING_ERROR_NEEDLE_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_ERROR_OUT_IS_NULL;
+    }
+    const size_t length = sea_turtle_string_length(object);
+    const size_t size = sea_turtle_string_length(needle);
+    *out = !size
+           || (size <= length
+               && !memcmp(sea_turtle_string_bytes(object) + length - size,
+                          sea_turtle_string_bytes(needle), size));
+    return 0;
+}
+
+int sea_turtle_string_split(const struct sea_turtle_string *const object,
+                            const struct sea_turtle_string *const delimiter,
+                            const size_t limit,
+                            const bool skip_empty,
+                            struct sea_turtle_string_split *const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL;
+    }
+    if (!delimiter) {
+        return SEA_TURTLE_STRING_ERROR_DELIMITER_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_ERROR_OUT_IS_NULL;
+    }
+    const size_t size = sea_turtle_string_length(delimiter);
+    if (!size) {
+        return SEA_TURTLE_STRING_ERROR_DELIMITER_IS_EMPTY;
+    }
+    const uint8_t *const data = sea_turtle_string_bytes(object);
+    const size_t length = sea_turtle_string_length(object);
+    *out = (struct sea_turtle_string_split) {
+            .at = data,
+            .end = data + length,
+            .delimiter = sea_turtle_string_bytes(delimiter),
+            .size = size,
+            .limit = limit,
+            .skip_empty = skip_empty,
+            .ascii = sea_turtle_string_count_of(object) == length
+    };
+    return 0;
+}
+
+int sea_turtle_string_split_next(struct sea_turtle_string_split *const object,
+                                 struct sea_turtle_string_view *const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_ERROR_OUT_IS_NULL;
+    }
+    while (!object->done) {
+        const uint8_t *const begin = object->at;
+        const size_t length = object->end - begin;
+        const uint8_t *found = NULL;
+        if (1 != object->limit && object->size <= length) {
+            found = sea_turtle_search_forward(begin, length,
+                                              object->delimiter,
+                                              object->size);
+        }
+        const uint8_t *const stop = found ? found : object->end;
+        if (found) {
+            object->at = found + object->size;
+        } else {
+            object->done = true;
+        }
+        if (object->skip_empty && stop == begin) {
+            continue;
+        }
+        if (object->limit > 1) {
+            object->limit -= 1;
+        }
+        uintmax_t count = stop - begin;
+        if (!object->ascii) {
+            for (const uint8_t *at = begin; at < stop; at++) {
+                count -= (*at & 0xC0) == 0x80;
+            }
+        }
+        *out = (struct sea_turtle_string_view) {
+                .data = begin,
+                .size = stop - begin,
+                .count = count
+        };
+        return 0;
+    }
+    return SEA_TURTLE_STRING_ERROR_END_OF_SEQUENCE;
+}
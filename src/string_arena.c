@@ -0,0 +1,130 @@
+#include <stdlib.h>
+#include <string.h>
+#include <sea-turtle.h>
+#include <seagrass.h>
+
+#include "private/allocator.h"
+#include "private/string.h"
+#include "private/utf8.h"
+
+#ifdef TEST
+#include <test/cmocka.h>
+#endif
+
+struct sea_turtle_string_arena_block {
+    struct sea_turtle_string_arena_block *next;
+    /* blocks are released to the allocator they came from */
+    const struct sea_turtle_allocator *allocator;
+    size_t size;
+    uint8_t data[];
+};
+
+int sea_turtle_string_arena_init(
+        struct sea_turtle_string_arena *const object) {
+    if (!object) {
+        return SEA_TURTLE_STRING_ARENA_ERROR_OBJECT_IS_NULL;
+    }
+    *object = (struct sea_turtle_string_arena) {0};
+    return 0;
+}
+
+int sea_turtle_string_arena_invalidate(
+        struct sea_turtle_string_arena *const object) {
+    if (!object) {
+        return SEA_TURTLE_STRING_ARENA_ERROR_OBJECT_IS_NULL;
+    }
+    struct sea_turtle_string_arena_block *block = object->blocks;
+    while (block) {
+        struct sea_turtle_string_arena_block *const next = block->next;
+        sea_turtle_allocator_deallocate(block->allocator, block, block->size);
+        block = next;
+    }
+    *object = (struct sea_turtle_string_arena) {0};
+    return 0;
+}
+
+int sea_turtle_string_arena_init_strings(
+        struct sea_turtle_string_arena *const object,
+        const char *const char_ptr,
+        const size_t *const offsets,
+        const size_t *const sizes,
+        const size_t count,
+        struct sea_turtle_string *const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_ARENA_ERROR_OBJECT_IS_NULL;
+    }
+    if (!char_ptr) {
+        return SEA_TURTLE_STRING_ARENA_ERROR_CHAR_PTR_IS_NULL;
+    }
+    if (!offsets) {
+        return SEA_TURTLE_STRING_ARENA_ERROR_OFFSETS_IS_NULL;
+    }
+    if (!sizes) {
+        return SEA_TURTLE_STRING_ARENA_ERROR_SIZES_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_ARENA_ERROR_OUT_IS_NULL;
+    }
+    /* the length and count of every value are kept in its string until it
+     * is copied, every value being validated ahead of allocating the block
+     * so that malformed input is reported ahead of failed allocation */
+    uintmax_t total = sizeof(struct sea_turtle_string_arena_block);
+    for (size_t i = 0; i < count; i++) {
+        size_t length;
+        uintmax_t c;
+        int error;
+        if ((error = sea_turtle_utf8_validate(
+                (const uint8_t *) char_ptr + offsets[i], sizes[i], &length,
+                &c))) {
+            seagrass_required_true(
+                    SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_MALFORMED == error);
+            memset(out, 0, count * sizeof(*out));
+            return SEA_TURTLE_STRING_ARENA_ERROR_CHAR_PTR_IS_MALFORMED;
+        }
+        out[i].size = length;
+        out[i].tagged_count = c;
+        /* add 1 to accommodate the NULL termination char */
+        if (length >= SEA_TURTLE_STRING_LOCAL_SIZE
+            && (length >= SEA_TURTLE_STRING_SIZE_MAX
+                || seagrass_uintmax_t_add(total, 1 + length, &total))) {
+            total = UINTMAX_MAX;
+        }
+    }
+    struct sea_turtle_string_arena_block *block = NULL;
+    if (total > sizeof(*block)
+        && (total > SIZE_MAX || !(block = sea_turtle_allocate(total)))) {
+        memset(out, 0, count * sizeof(*out));
+        return SEA_TURTLE_STRING_ARENA_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    uint8_t *at = block ? block->data : NULL;
+    for (size_t i = 0; i < count; i++) {
+        struct sea_turtle_string *const string = &out[i];
+        const size_t length = string->size;
+        const uintmax_t c = string->tagged_count;
+        if (!length) {
+            *string = (struct sea_turtle_string) {0};
+            continue;
+        }
+        const bool local = length < SEA_TURTLE_STRING_LOCAL_SIZE;
+        uint8_t *const data = local ? string->local : at;
+        memcpy(data, char_ptr + offsets[i], length);
+        data[length] = 0;
+        string->size = 1 + length;
+        if (!local) {
+            string->data = data;
+            string->hash = 0;
+            string->tagged_count = 0;
+            sea_turtle_string_set_storage(string,
+                                          SEA_TURTLE_STRING_STORAGE_ARENA);
+            at += 1 + length;
+        }
+        sea_turtle_string_set_count(string, c);
+    }
+    if (block) {
+        block->allocator = sea_turtle_allocator_current();
+        block->size = total;
+        block->next = object->blocks;
+        object->blocks = block;
+    }
+    return 0;
+}
@@ -0,0 +1,292 @@
+#include <stdlib.h>
+#include <string.h>
+#include <sea-turtle.h>
+#include <seagrass.h>
+
+#include "private/allocator.h"
+#include "private/string.h"
+#include "private/utf8.h"
+
+#ifdef TEST
+#include <test/cmocka.h>
+#endif
+
+#define SEA_TURTLE_STRING_BUILDER_MINIMUM_CAPACITY 64
+
+int sea_turtle_string_builder_init(
+        struct sea_turtle_string_builder *const object) {
+    if (!object) {
+        return SEA_TURTLE_STRING_BUILDER_ERROR_OBJECT_IS_NULL;
+    }
+    *object = (struct sea_turtle_string_builder) {0};
+    return 0;
+}
+
+int sea_turtle_string_builder_invalidate(
+        struct sea_turtle_string_builder *const object) {
+    if (!object) {
+        return SEA_TURTLE_STRING_BUILDER_ERROR_OBJECT_IS_NULL;
+    }
+    sea_turtle_string_buffer_release(object->data);
+    *object = (struct sea_turtle_string_builder) {0};
+    return 0;
+}
+
+int sea_turtle_string_builder_reserve(
+        struct sea_turtle_string_builder *const object,
+        const size_t size) {
+    if (!object) {
+        return SEA_TURTLE_STRING_BUILDER_ERROR_OBJECT_IS_NULL;
+    }
+    /* add 1 to accommodate the NULL termination char, keeping the size of
+     * the string to be finished within that of any string */
+    if (size > SEA_TURTLE_STRING_SIZE_MAX - 1 - object->size) {
+        return SEA_TURTLE_STRING_BUILDER_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    const size_t needed = object->size + size + 1;
+    if (needed <= object->capacity) {
+        return 0;
+    }
+    size_t capacity = object->capacity > SIZE_MAX / 2
+                      ? SIZE_MAX
+                      : 2 * object->capacity;
+    if (capacity < SEA_TURTLE_STRING_BUILDER_MINIMUM_CAPACITY) {
+        capacity = SEA_TURTLE_STRING_BUILDER_MINIMUM_CAPACITY;
+    }
+    if (capacity < needed) {
+        capacity = needed;
+    }
+    /* the buffer is a heap buffer of a string ready to be handed over */
+    uint8_t *const data = sea_turtle_string_buffer_resize(object->data,
+                                                          capacity);
+    if (!data) {
+        return SEA_TURTLE_STRING_BUILDER_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    object->data = data;
+    object->capacity = capacity;
+    return 0;
+}
+
+int sea_turtle_string_builder_append_char_ptr(
+        struct sea_turtle_string_builder *const object,
+        const char *const char_ptr,
+        const size_t size,
+        size_t *const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_BUILDER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!char_ptr) {
+        return SEA_TURTLE_STRING_BUILDER_ERROR_CHAR_PTR_IS_NULL;
+    }
+    if (!size) {
+        return SEA_TURTLE_STRING_BUILDER_ERROR_SIZE_IS_ZERO;
+    }
+    if (object->pending) {
+        return SEA_TURTLE_STRING_BUILDER_ERROR_SEQUENCE_IS_INCOMPLETE;
+    }
+    size_t length;
+    uintmax_t count;
+    int error;
+    /* validate ahead of reserving so a malformed sequence leaves no trace
+     * and is reported ahead of failed memory allocation */
+    if ((error = sea_turtle_utf8_validate((const uint8_t *) char_ptr, size,
+                                          &length, &count))) {
+        seagrass_required_true(
+                SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_MALFORMED == error);
+        return SEA_TURTLE_STRING_BUILDER_ERROR_CHAR_PTR_IS_MALFORMED;
+    }
+    if ((error = sea_turtle_string_builder_reserve(object, length))) {
+        return error;
+    }
+    memcpy(object->data + object->size, char_ptr, length);
+    object->size += length;
+    object->count += count;
+    if (out) {
+        *out = length;
+    }
+    return 0;
+}
+
+int sea_turtle_string_builder_append_code_point(
+        struct sea_turtle_string_builder *const object,
+        const uint32_t code_point) {
+    if (!object) {
+        return SEA_TURTLE_STRING_BUILDER_ERROR_OBJECT_IS_NULL;
+    }
+    if (code_point > 0x10FFFF
+        || (code_point >= 0xD800 && code_point <= 0xDFFF)) {
+        return SEA_TURTLE_STRING_BUILDER_ERROR_CODE_POINT_IS_INVALID;
+    }
+    if (object->pending) {
+        return SEA_TURTLE_STRING_BUILDER_ERROR_SEQUENCE_IS_INCOMPLETE;
+    }
+    const size_t n = code_point < 0x80
+                     ? 1
+                     : code_point < 0x800
+                       ? 2
+                       : code_point < 0x10000 ? 3 : 4;
+    int error;
+    if ((error = sea_turtle_string_builder_reserve(object, n))) {
+        return error;
+    }
+    uint8_t *const at = object->data + object->size;
+    switch (n) {
+        case 1:
+            at[0] = code_point;
+            break;
+        case 2:
+            at[0] = 0xC0 | (code_point >> 6);
+            at[1] = 0x80 | (code_point & 0x3F);
+            break;
+        case 3:
+            at[0] = 0xE0 | (code_point >> 12);
+            at[1] = 0x80 | ((code_point >> 6) & 0x3F);
+            at[2] = 0x80 | (code_point & 0x3F);
+            break;
+        default:
+            at[0] = 0xF0 | (code_point >> 18);
+            at[1] = 0x80 | ((code_point >> 12) & 0x3F);
+            at[2] = 0x80 | ((code_point >> 6) & 0x3F);
+            at[3] = 0x80 | (code_point & 0x3F);
+            break;
+    }
+    object->size += n;
+    object->count += 1;
+    return 0;
+}
+
+int sea_turtle_string_builder_append_string(
+        struct sea_turtle_string_builder *const object,
+        const struct sea_turtle_string *const string) {
+    if (!object) {
+        return SEA_TURTLE_STRING_BUILDER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!string) {
+        return SEA_TURTLE_STRING_BUILDER_ERROR_STRING_IS_NULL;
+    }
+    if (object->pending) {
+        return SEA_TURTLE_STRING_BUILDER_ERROR_SEQUENCE_IS_INCOMPLETE;
+    }
+    if (!string->size) {
+        return 0;
+    }
+    const size_t length = string->size - 1;
+    int error;
+    if ((error = sea_turtle_string_builder_reserve(object, length))) {
+        return error;
+    }
+    memcpy(object->data + object->size, sea_turtle_string_bytes(string),
+           length);
+    object->size += length;
+    object->count += sea_turtle_string_count_of(string);
+    return 0;
+}
+
+int sea_turtle_string_builder_append_chunk(
+        struct sea_turtle_string_builder *const object,
+        const char *const chunk,
+        const size_t size) {
+    if (!object) {
+        return SEA_TURTLE_STRING_BUILDER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!chunk) {
+        return SEA_TURTLE_STRING_BUILDER_ERROR_CHUNK_IS_NULL;
+    }
+    if (!size) {
+        return SEA_TURTLE_STRING_BUILDER_ERROR_SIZE_IS_ZERO;
+    }
+    const uint8_t *begin = (const uint8_t *) chunk;
+    size_t length = size;
+    /* complete the symbol that the previous chunk ended in the middle of */
+    uint8_t symbol[4];
+    size_t completed = 0;
+    const size_t pending = object->pending;
+    if (pending) {
+        const uint8_t lead = object->partial[0];
+        const size_t n = lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : 2;
+        const size_t need = n - pending;
+        const size_t taken = need < length ? need : length;
+        memcpy(symbol, object->partial, pending);
+        memcpy(symbol + pending, begin, taken);
+        uintmax_t c;
+        if (taken < need) {
+            if (sea_turtle_utf8_incomplete(symbol, pending + taken)
+                != pending + taken) {
+                return SEA_TURTLE_STRING_BUILDER_ERROR_CHUNK_IS_MALFORMED;
+            }
+            memcpy(object->partial, symbol, pending + taken);
+            object->pending += taken;
+            return 0;
+        }
+        if (sea_turtle_utf8_validate_scalar(symbol, n, &c)) {
+            return SEA_TURTLE_STRING_BUILDER_ERROR_CHUNK_IS_MALFORMED;
+        }
+        completed = n;
+        begin += need;
+        length -= need;
+    }
+    /* hold on to the symbol this chunk ends in the middle of */
+    const size_t tail = sea_turtle_utf8_incomplete(begin, length);
+    const size_t body = length - tail;
+    uintmax_t count = 0;
+    if (body) {
+        size_t validated;
+        int error;
+        if ((error = sea_turtle_utf8_validate(begin, body, &validated,
+                                              &count))) {
+            seagrass_required_true(
+                    SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_MALFORMED == error);
+            return SEA_TURTLE_STRING_BUILDER_ERROR_CHUNK_IS_MALFORMED;
+        }
+        if (validated != body) {
+            /* strings cannot hold the NULL char */
+            return SEA_TURTLE_STRING_BUILDER_ERROR_CHUNK_IS_MALFORMED;
+        }
+    }
+    int error;
+    if ((error = sea_turtle_string_builder_reserve(object,
+                                                   completed + body))) {
+        return error;
+    }
+    uint8_t *const at = object->data + object->size;
+    memcpy(at, symbol, completed);
+    memcpy(at + completed, begin, body);
+    object->size += completed + body;
+    object->count += count + (completed ? 1 : 0);
+    memcpy(object->partial, begin + body, tail);
+    object->pending = tail;
+    return 0;
+}
+
+int sea_turtle_string_builder_finish(
+        struct sea_turtle_string_builder *const object,
+        struct sea_turtle_string *const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_BUILDER_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_BUILDER_ERROR_OUT_IS_NULL;
+    }
+    if (object->pending) {
+        return SEA_TURTLE_STRING_BUILDER_ERROR_SEQUENCE_IS_INCOMPLETE;
+    }
+    *out = (struct sea_turtle_string) {0};
+    if (!object->size) {
+        return 0;
+    }
+    out->size = 1 + object->size;
+    if (out->size <= SEA_TURTLE_STRING_LOCAL_SIZE) {
+        /* keep the buffer of the string builder for reuse */
+        memcpy(out->local, object->data, object->size);
+        out->local[object->size] = 0;
+        sea_turtle_string_set_count(out, object->count);
+        object->size = 0;
+        object->count = 0;
+        return 0;
+    }
+    object->data[object->size] = 0;
+    out->data = object->data;
+    sea_turtle_string_set_count(out, object->count);
+    *object = (struct sea_turtle_string_builder) {0};
+    return 0;
+}
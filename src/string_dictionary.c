@@ -0,0 +1,609 @@
+#include <string.h>
+#include <sea-turtle.h>
+#include <seagrass.h>
+
+#include "private/allocator.h"
+#include "private/string.h"
+#include "private/utf8.h"
+
+#ifdef TEST
+#include <test/cmocka.h>
+#endif
+
+/* "STDF" in the byte order of the process which serialized the data */
+#define SEA_TURTLE_STRING_DICTIONARY_MAGIC 0x46445453
+
+/*
+ * The data of a dictionary is laid out as the header, followed by the
+ * offset of every bucket from the start of the data, followed by the terms.
+ * Every term is encoded as the length of the prefix it shares with the term
+ * before it, zero for the first term of a bucket, the number of bytes that
+ * follow, its count of code points and then those bytes, the three numbers
+ * being encoded as LEB128 varints.
+ */
+struct sea_turtle_string_dictionary_header {
+    uint32_t magic;
+    uint32_t bucket_size;
+    uint64_t count;
+    uint64_t size;
+};
+
+struct sea_turtle_string_dictionary_term {
+    size_t shared;
+    size_t length;
+    uintmax_t count;
+    const uint8_t *bytes;
+};
+
+static uintmax_t sea_turtle_string_dictionary_buckets(const uintmax_t count) {
+    return count / SEA_TURTLE_STRING_DICTIONARY_BUCKET_SIZE
+           + (0 != count % SEA_TURTLE_STRING_DICTIONARY_BUCKET_SIZE);
+}
+
+static const uint64_t *sea_turtle_string_dictionary_offsets(
+        const struct sea_turtle_string_dictionary *const object) {
+    return (const uint64_t *) (object->data
+                               + sizeof(struct
+                                       sea_turtle_string_dictionary_header));
+}
+
+static size_t sea_turtle_string_dictionary_varint_size(uintmax_t value) {
+    size_t size = 1;
+    for (; value >= 0x80; value >>= 7, size++);
+    return size;
+}
+
+static uint8_t *sea_turtle_string_dictionary_put(uint8_t *at,
+                                                 uintmax_t value) {
+    for (; value >= 0x80; value >>= 7) {
+        *at++ = 0x80 | (value & 0x7F);
+    }
+    *at++ = value;
+    return at;
+}
+
+/* returns NULL if the varint is truncated or too large */
+static const uint8_t *sea_turtle_string_dictionary_get_varint(
+        const uint8_t *at,
+        const uint8_t *const end,
+        uintmax_t *const out) {
+    uintmax_t value = 0;
+    for (unsigned shift = 0; at < end && shift < 64; shift += 7) {
+        const uint8_t byte = *at++;
+        value |= (uintmax_t) (byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *out = value;
+            return at;
+        }
+    }
+    return NULL;
+}
+
+/* returns the end of the term or NULL if it does not fit before end */
+static const uint8_t *sea_turtle_string_dictionary_term(
+        const uint8_t *at,
+        const uint8_t *const end,
+        struct sea_turtle_string_dictionary_term *const out) {
+    uintmax_t shared;
+    uintmax_t length;
+    if (!(at = sea_turtle_string_dictionary_get_varint(at, end, &shared))
+        || !(at = sea_turtle_string_dictionary_get_varint(at, end, &length))
+        || !(at = sea_turtle_string_dictionary_get_varint(at, end,
+                                                          &out->count))
+        || shared > SIZE_MAX
+        || length > (uintmax_t) (end - at)) {
+        return NULL;
+    }
+    out->shared = shared;
+    out->length = length;
+    out->bytes = at;
+    return at + length;
+}
+
+/* length of the common prefix, compared 8 bytes at a time */
+static size_t sea_turtle_string_dictionary_common(const uint8_t *const a,
+                                                  const size_t a_length,
+                                                  const uint8_t *const b,
+                                                  const size_t b_length) {
+    const size_t length = a_length < b_length ? a_length : b_length;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+        uint64_t x;
+        uint64_t y;
+        memcpy(&x, a + i, sizeof(x));
+        memcpy(&y, b + i, sizeof(y));
+        if (x != y) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+            return i + __builtin_ctzll(x ^ y) / 8;
+#else
+            return i + __builtin_clzll(x ^ y) / 8;
+#endif
+        }
+    }
+    for (; i < length && a[i] == b[i]; i++);
+    return i;
+}
+
+/* compare byte by byte, receiving the length of the common prefix */
+static int sea_turtle_string_dictionary_compare(const uint8_t *const a,
+                                                const size_t a_length,
+                                                const uint8_t *const b,
+                                                const size_t b_length,
+                                                size_t *const out) {
+    const size_t common = sea_turtle_string_dictionary_common(
+            a, a_length, b, b_length);
+    *out = common;
+    if (common < a_length && common < b_length) {
+        return a[common] < b[common] ? -1 : 1;
+    }
+    return (a_length > b_length) - (a_length < b_length);
+}
+
+int sea_turtle_string_dictionary_init(
+        struct sea_turtle_string_dictionary *const object,
+        const struct sea_turtle_string *const strings,
+        const size_t count) {
+    if (!object) {
+        return SEA_TURTLE_STRING_DICTIONARY_ERROR_OBJECT_IS_NULL;
+    }
+    if (!strings) {
+        return SEA_TURTLE_STRING_DICTIONARY_ERROR_STRINGS_IS_NULL;
+    }
+    const uintmax_t buckets = sea_turtle_string_dictionary_buckets(count);
+    uintmax_t total = sizeof(struct sea_turtle_string_dictionary_header)
+                      + buckets * sizeof(uint64_t);
+    const uint8_t *previous = NULL;
+    size_t previous_length = 0;
+    for (size_t i = 0; i < count; i++) {
+        const struct sea_turtle_string *const string = &strings[i];
+        const uint8_t *const bytes = sea_turtle_string_bytes(string);
+        const size_t length = string->size ? string->size - 1 : 0;
+        size_t shared = 0;
+        if (i && sea_turtle_string_dictionary_compare(
+                bytes, length, previous, previous_length, &shared) <= 0) {
+            return SEA_TURTLE_STRING_DICTIONARY_ERROR_STRINGS_ARE_UNSORTED;
+        }
+        if (!(i % SEA_TURTLE_STRING_DICTIONARY_BUCKET_SIZE)) {
+            shared = 0;
+        }
+        const size_t suffix = length - shared;
+        if (seagrass_uintmax_t_add(
+                total,
+                sea_turtle_string_dictionary_varint_size(shared)
+                + sea_turtle_string_dictionary_varint_size(suffix)
+                + sea_turtle_string_dictionary_varint_size(
+                        sea_turtle_string_count_of(string)),
+                &total)
+            || seagrass_uintmax_t_add(total, suffix, &total)) {
+            return SEA_TURTLE_STRING_DICTIONARY_ERROR_MEMORY_ALLOCATION_FAILED;
+        }
+        previous = bytes;
+        previous_length = length;
+    }
+    const struct sea_turtle_allocator *const allocator
+            = sea_turtle_allocator_current();
+    uint8_t *data;
+    if (total > SIZE_MAX
+        || !(data = sea_turtle_allocator_allocate(allocator, total))) {
+        return SEA_TURTLE_STRING_DICTIONARY_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    const struct sea_turtle_string_dictionary_header header = {
+            .magic = SEA_TURTLE_STRING_DICTIONARY_MAGIC,
+            .bucket_size = SEA_TURTLE_STRING_DICTIONARY_BUCKET_SIZE,
+            .count = count,
+            .size = total
+    };
+    memcpy(data, &header, sizeof(header));
+    uint64_t *const offsets = (uint64_t *) (data + sizeof(header));
+    uint8_t *at = (uint8_t *) (offsets + buckets);
+    for (size_t i = 0; i < count; i++) {
+        const struct sea_turtle_string *const string = &strings[i];
+        const uint8_t *const bytes = sea_turtle_string_bytes(string);
+        const size_t length = string->size ? string->size - 1 : 0;
+        size_t shared = 0;
+        if (i % SEA_TURTLE_STRING_DICTIONARY_BUCKET_SIZE) {
+            shared = sea_turtle_string_dictionary_common(
+                    bytes, length, previous, previous_length);
+        } else {
+            offsets[i / SEA_TURTLE_STRING_DICTIONARY_BUCKET_SIZE] = at - data;
+        }
+        at = sea_turtle_string_dictionary_put(at, shared);
+        at = sea_turtle_string_dictionary_put(at, length - shared);
+        at = sea_turtle_string_dictionary_put(
+                at, sea_turtle_string_count_of(string));
+        if (length > shared) {
+            memcpy(at, bytes + shared, length - shared);
+            at += length - shared;
+        }
+        previous = bytes;
+        previous_length = length;
+    }
+    seagrass_required_true(at == data + total);
+    *object = (struct sea_turtle_string_dictionary) {
+            .data = data,
+            .size = total,
+            .count = count,
+            .allocator = allocator
+    };
+    return 0;
+}
+
+/*
+ * Every term is valid UTF-8 of its count and greater than the one before,
+ * sharing with it their whole common prefix as lookups rely on it.
+ */
+static int sea_turtle_string_dictionary_validate(
+        const struct sea_turtle_string_dictionary *const object) {
+    const uint64_t *const offsets
+            = sea_turtle_string_dictionary_offsets(object);
+    const uint8_t *const end = object->data + object->size;
+    const uint8_t *at = (const uint8_t *) (
+            offsets + sea_turtle_string_dictionary_buckets(object->count));
+    uint8_t *term = NULL;
+    size_t capacity = 0;
+    size_t length = 0;
+    int error = 0;
+    for (uintmax_t i = 0; !error && i < object->count; i++) {
+        const bool first = !(i % SEA_TURTLE_STRING_DICTIONARY_BUCKET_SIZE);
+        struct sea_turtle_string_dictionary_term t;
+        size_t common;
+        if ((first && offsets[i / SEA_TURTLE_STRING_DICTIONARY_BUCKET_SIZE]
+                      != (uintmax_t) (at - object->data))
+            || !(at = sea_turtle_string_dictionary_term(at, end, &t))
+            || (first ? t.shared : t.shared > length)
+            || (!first && t.length && t.shared < length
+                && t.bytes[0] == term[t.shared])
+            || (i && sea_turtle_string_dictionary_compare(
+                    t.bytes, t.length, term + t.shared, length - t.shared,
+                    &common) <= 0)) {
+            error = SEA_TURTLE_STRING_DICTIONARY_ERROR_BUFFER_IS_MALFORMED;
+            break;
+        }
+        length = t.shared + t.length;
+        uint8_t *const resized = length > capacity
+                ? sea_turtle_reallocate(term, capacity, length)
+                : term;
+        if (length > capacity && !resized) {
+            sea_turtle_deallocate(term, capacity);
+            return SEA_TURTLE_STRING_DICTIONARY_ERROR_MEMORY_ALLOCATION_FAILED;
+        }
+        term = resized;
+        capacity = length > capacity ? length : capacity;
+        if (t.length) {
+            memcpy(term + t.shared, t.bytes, t.length);
+        }
+        size_t read = 0;
+        uintmax_t count = 0;
+        if (length
+            ? sea_turtle_utf8_validate(term, length, &read, &count)
+              || read != length
+              || count != t.count
+            : t.count) {
+            error = SEA_TURTLE_STRING_DICTIONARY_ERROR_BUFFER_IS_MALFORMED;
+        }
+    }
+    sea_turtle_deallocate(term, capacity);
+    if (!error && at != end) {
+        error = SEA_TURTLE_STRING_DICTIONARY_ERROR_BUFFER_IS_MALFORMED;
+    }
+    return error;
+}
+
+int sea_turtle_string_dictionary_init_buffer(
+        struct sea_turtle_string_dictionary *const object,
+        const void *const buffer,
+        const size_t size) {
+    if (!object) {
+        return SEA_TURTLE_STRING_DICTIONARY_ERROR_OBJECT_IS_NULL;
+    }
+    if (!buffer) {
+        return SEA_TURTLE_STRING_DICTIONARY_ERROR_BUFFER_IS_NULL;
+    }
+    struct sea_turtle_string_dictionary_header header;
+    if (size < sizeof(header)) {
+        return SEA_TURTLE_STRING_DICTIONARY_ERROR_BUFFER_IS_MALFORMED;
+    }
+    memcpy(&header, buffer, sizeof(header));
+    if (SEA_TURTLE_STRING_DICTIONARY_MAGIC != header.magic
+        || SEA_TURTLE_STRING_DICTIONARY_BUCKET_SIZE != header.bucket_size
+        || size != header.size
+        || sea_turtle_string_dictionary_buckets(header.count)
+           > (size - sizeof(header)) / sizeof(uint64_t)) {
+        return SEA_TURTLE_STRING_DICTIONARY_ERROR_BUFFER_IS_MALFORMED;
+    }
+    const struct sea_turtle_allocator *const allocator
+            = sea_turtle_allocator_current();
+    uint8_t *const data = sea_turtle_allocator_allocate(allocator, size);
+    if (!data) {
+        return SEA_TURTLE_STRING_DICTIONARY_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    memcpy(data, buffer, size);
+    const struct sea_turtle_string_dictionary dictionary = {
+            .data = data,
+            .size = size,
+            .count = header.count,
+            .allocator = allocator
+    };
+    const int error = sea_turtle_string_dictionary_validate(&dictionary);
+    if (error) {
+        sea_turtle_allocator_deallocate(allocator, data, size);
+        return error;
+    }
+    *object = dictionary;
+    return 0;
+}
+
+int sea_turtle_string_dictionary_invalidate(
+        struct sea_turtle_string_dictionary *const object) {
+    if (!object) {
+        return SEA_TURTLE_STRING_DICTIONARY_ERROR_OBJECT_IS_NULL;
+    }
+    sea_turtle_allocator_deallocate(object->allocator, object->data,
+                                    object->size);
+    *object = (struct sea_turtle_string_dictionary) {0};
+    return 0;
+}
+
+int sea_turtle_string_dictionary_count(
+        const struct sea_turtle_string_dictionary *const object,
+        uintmax_t *const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_DICTIONARY_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_DICTIONARY_ERROR_OUT_IS_NULL;
+    }
+    *out = object->count;
+    return 0;
+}
+
+/*
+ * A term past the key starts with a different byte than the key somewhere
+ * before the key ends, so unlike the terms that are merely greater than
+ * the key, it does not start with the key.
+ */
+static bool sea_turtle_string_dictionary_is_past(const int result,
+                                                 const size_t common,
+                                                 const size_t size,
+                                                 const bool past_prefix) {
+    return past_prefix
+           ? result > 0 && common < size
+           : result >= 0;
+}
+
+/* compare the first term of the bucket with the key */
+static int sea_turtle_string_dictionary_compare_first(
+        const struct sea_turtle_string_dictionary *const object,
+        const uintmax_t bucket,
+        const uint8_t *const key,
+        const size_t size,
+        size_t *const out) {
+    const uint64_t *const offsets
+            = sea_turtle_string_dictionary_offsets(object);
+    struct sea_turtle_string_dictionary_term t;
+    seagrass_required_true(NULL != sea_turtle_string_dictionary_term(
+            object->data + offsets[bucket], object->data + object->size,
+            &t));
+    return sea_turtle_string_dictionary_compare(t.bytes, t.length, key, size,
+                                                out);
+}
+
+/*
+ * Index of the first term not less than the key, or with past_prefix, of
+ * the first term past the key. Buckets are binary searched on their first
+ * term and the terms of the bucket that precedes the first bucket past the
+ * key are compared in order, relying on each term sharing its prefix with
+ * the one before it to avoid comparing the shared bytes again.
+ */
+static uintmax_t sea_turtle_string_dictionary_bound(
+        const struct sea_turtle_string_dictionary *const object,
+        const uint8_t *const key,
+        const size_t size,
+        const bool past_prefix,
+        bool *const found) {
+    const uintmax_t buckets = sea_turtle_string_dictionary_buckets(
+            object->count);
+    uintmax_t low = 0;
+    uintmax_t high = buckets;
+    size_t common;
+    int result = 0;
+    *found = false;
+    while (low < high) {
+        const uintmax_t middle = low + (high - low) / 2;
+        result = sea_turtle_string_dictionary_compare_first(
+                object, middle, key, size, &common);
+        if (sea_turtle_string_dictionary_is_past(result, common, size,
+                                                 past_prefix)) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+    if (!low) {
+        if (buckets) {
+            result = sea_turtle_string_dictionary_compare_first(
+                    object, 0, key, size, &common);
+            *found = !result;
+        }
+        return 0;
+    }
+    const uint64_t *const offsets
+            = sea_turtle_string_dictionary_offsets(object);
+    const uint8_t *const end = object->data + object->size;
+    const uint8_t *at = object->data + offsets[low - 1];
+    uintmax_t index = (low - 1) * SEA_TURTLE_STRING_DICTIONARY_BUCKET_SIZE;
+    uintmax_t last = index + SEA_TURTLE_STRING_DICTIONARY_BUCKET_SIZE;
+    if (last > object->count) {
+        last = object->count;
+    }
+    common = 0;
+    for (; index < last; index++) {
+        struct sea_turtle_string_dictionary_term t;
+        at = sea_turtle_string_dictionary_term(at, end, &t);
+        seagrass_required_true(NULL != at);
+        if (t.shared < common) {
+            /* the term is greater than the term before it from there on */
+            common = t.shared;
+            result = 1;
+        } else if (t.shared == common) {
+            size_t more;
+            result = sea_turtle_string_dictionary_compare(
+                    t.bytes, t.length, key + common, size - common, &more);
+            common += more;
+        }
+        if (sea_turtle_string_dictionary_is_past(result, common, size,
+                                                 past_prefix)) {
+            *found = !result;
+            return index;
+        }
+    }
+    if (index < object->count) {
+        result = sea_turtle_string_dictionary_compare_first(
+                object, low, key, size, &common);
+        *found = !result;
+    }
+    return index;
+}
+
+int sea_turtle_string_dictionary_find(
+        const struct sea_turtle_string_dictionary *const object,
+        const struct sea_turtle_string *const key,
+        uintmax_t *const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_DICTIONARY_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return SEA_TURTLE_STRING_DICTIONARY_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_DICTIONARY_ERROR_OUT_IS_NULL;
+    }
+    bool found;
+    const uintmax_t index = sea_turtle_string_dictionary_bound(
+            object, sea_turtle_string_bytes(key),
+            key->size ? key->size - 1 : 0, false, &found);
+    if (!found) {
+        return SEA_TURTLE_STRING_DICTIONARY_ERROR_KEY_NOT_FOUND;
+    }
+    *out = index;
+    return 0;
+}
+
+/* position the iterator at the bucket which holds the term at index */
+static void sea_turtle_string_dictionary_seek(
+        const struct sea_turtle_string_dictionary *const object,
+        const uintmax_t index,
+        const uintmax_t end,
+        struct sea_turtle_string_dictionary_iterator *const out) {
+    const uintmax_t bucket = index / SEA_TURTLE_STRING_DICTIONARY_BUCKET_SIZE;
+    *out = (struct sea_turtle_string_dictionary_iterator) {
+            .decoded = bucket * SEA_TURTLE_STRING_DICTIONARY_BUCKET_SIZE,
+            .index = index,
+            .end = end
+    };
+    if (index < end) {
+        out->at = object->data
+                  + sea_turtle_string_dictionary_offsets(object)[bucket];
+    }
+}
+
+int sea_turtle_string_dictionary_get(
+        const struct sea_turtle_string_dictionary *const object,
+        const uintmax_t index,
+        struct sea_turtle_string *const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_DICTIONARY_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_DICTIONARY_ERROR_OUT_IS_NULL;
+    }
+    if (index >= object->count) {
+        return SEA_TURTLE_STRING_DICTIONARY_ERROR_INDEX_IS_OUT_OF_BOUNDS;
+    }
+    struct sea_turtle_string_dictionary_iterator at;
+    sea_turtle_string_dictionary_seek(object, index, 1 + index, &at);
+    *out = (struct sea_turtle_string) {0};
+    return sea_turtle_string_dictionary_next(object, &at, out);
+}
+
+int sea_turtle_string_dictionary_prefix(
+        const struct sea_turtle_string_dictionary *const object,
+        const struct sea_turtle_string *const prefix,
+        struct sea_turtle_string_dictionary_iterator *const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_DICTIONARY_ERROR_OBJECT_IS_NULL;
+    }
+    if (!prefix) {
+        return SEA_TURTLE_STRING_DICTIONARY_ERROR_PREFIX_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_DICTIONARY_ERROR_OUT_IS_NULL;
+    }
+    const uint8_t *const key = sea_turtle_string_bytes(prefix);
+    const size_t size = prefix->size ? prefix->size - 1 : 0;
+    bool found;
+    const uintmax_t first = sea_turtle_string_dictionary_bound(
+            object, key, size, false, &found);
+    const uintmax_t end = sea_turtle_string_dictionary_bound(
+            object, key, size, true, &found);
+    sea_turtle_string_dictionary_seek(object, first, end, out);
+    return 0;
+}
+
+int sea_turtle_string_dictionary_next(
+        const struct sea_turtle_string_dictionary *const object,
+        struct sea_turtle_string_dictionary_iterator *const at,
+        struct sea_turtle_string *const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_DICTIONARY_ERROR_OBJECT_IS_NULL;
+    }
+    if (!at) {
+        return SEA_TURTLE_STRING_DICTIONARY_ERROR_AT_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_DICTIONARY_ERROR_OUT_IS_NULL;
+    }
+    if (at->index >= at->end) {
+        return SEA_TURTLE_STRING_DICTIONARY_ERROR_END_OF_SEQUENCE;
+    }
+    const uint8_t *const end = object->data + object->size;
+    struct sea_turtle_string_dictionary_term t;
+    /* find the length of the term before writing any of the terms */
+    const uint8_t *next = at->at;
+    for (uintmax_t i = at->decoded; i <= at->index; i++) {
+        next = sea_turtle_string_dictionary_term(next, end, &t);
+        seagrass_required_true(NULL != next);
+    }
+    const size_t length = t.shared + t.length;
+    const uintmax_t count = t.count;
+    if (!length) {
+        seagrass_required_true(!sea_turtle_string_invalidate(out));
+    } else {
+        int error;
+        /* the bytes that the term shares with the one before it are kept */
+        if ((error = sea_turtle_string_set_size(out, 1 + length))) {
+            seagrass_required_true(
+                    SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED
+                    == error);
+            return SEA_TURTLE_STRING_DICTIONARY_ERROR_MEMORY_ALLOCATION_FAILED;
+        }
+        /*
+         * When seeking within a bucket, the terms before the one at index are
+         * written too, none of them past the length of the term at index.
+         */
+        const uint8_t *from = at->at;
+        for (uintmax_t i = at->decoded; i <= at->index; i++) {
+            from = sea_turtle_string_dictionary_term(from, end, &t);
+            if (t.shared < length && t.length) {
+                const size_t left = length - t.shared;
+                memcpy(sea_turtle_string_bytes(out) + t.shared, t.bytes,
+                       t.length < left ? t.length : left);
+            }
+        }
+        sea_turtle_string_set_count(out, count);
+    }
+    at->at = next;
+    at->index += 1;
+    at->decoded = at->index;
+    return 0;
+}
@@ -0,0 +1,411 @@
+#include <stdlib.h>
+#include <string.h>
+#include <sea-turtle.h>
+#include <seagrass.h>
+
+#include "private/allocator.h"
+#include "private/hash.h"
+#include "private/string.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define SEA_TURTLE_STRING_MAP_SSE2 1
+#endif
+
+#ifdef TEST
+#include <test/cmocka.h>
+#endif
+
+struct sea_turtle_string_map_entry {
+    struct sea_turtle_string key;
+    void *value;
+};
+
+/* number of control bytes compared at a time */
+#define SEA_TURTLE_STRING_MAP_GROUP 16
+#define SEA_TURTLE_STRING_MAP_MINIMUM_CAPACITY 16
+
+/* full slots hold the low 7 bits of the hash code of their key */
+#define SEA_TURTLE_STRING_MAP_EMPTY ((int8_t) -128)
+#define SEA_TURTLE_STRING_MAP_DELETED ((int8_t) -2)
+
+/* keep the load factor at or below seven eighths */
+static size_t sea_turtle_string_map_growth(const size_t capacity) {
+    return capacity - capacity / 8;
+}
+
+/*
+ * The probe sequence is quadratic over groups of control bytes that start at
+ * any slot, the first control bytes being mirrored past the last one so that
+ * a group never wraps around.
+ */
+static uint32_t sea_turtle_string_map_match(const int8_t *const group,
+                                            const int8_t control) {
+#if defined(SEA_TURTLE_STRING_MAP_SSE2)
+    const __m128i controls = _mm_loadu_si128((const __m128i *) group);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(controls,
+                                            _mm_set1_epi8(control)));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < SEA_TURTLE_STRING_MAP_GROUP; i++) {
+        mask |= (uint32_t) (group[i] == control) << i;
+    }
+    return mask;
+#endif
+}
+
+/* empty and deleted slots are the only ones with the sign bit set */
+static uint32_t sea_turtle_string_map_match_free(const int8_t *const group) {
+#if defined(SEA_TURTLE_STRING_MAP_SSE2)
+    return _mm_movemask_epi8(_mm_loadu_si128((const __m128i *) group));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < SEA_TURTLE_STRING_MAP_GROUP; i++) {
+        mask |= (uint32_t) (group[i] < 0) << i;
+    }
+    return mask;
+#endif
+}
+
+static void sea_turtle_string_map_set_control(
+        struct sea_turtle_string_map *const object,
+        const size_t i,
+        const int8_t control) {
+    object->controls[i] = control;
+    if (i < SEA_TURTLE_STRING_MAP_GROUP) {
+        object->controls[object->capacity + i] = control;
+    }
+}
+
+static uintmax_t sea_turtle_string_map_hash(const uint8_t *const bytes,
+                                            const size_t length) {
+    /* must agree with sea_turtle_string_hash() */
+    return length ? sea_turtle_hash(bytes, length) : 0;
+}
+
+static size_t sea_turtle_string_map_key_length(
+        const struct sea_turtle_string *const key) {
+    return key->size ? key->size - 1 : 0;
+}
+
+static struct sea_turtle_string_map_entry *sea_turtle_string_map_find(
+        const struct sea_turtle_string_map *const object,
+        const uint8_t *const bytes,
+        const size_t length,
+        const uintmax_t hash) {
+    if (!object->capacity) {
+        return NULL;
+    }
+    const int8_t control = hash & 0x7F;
+    const size_t mask = object->capacity - 1;
+    size_t i = (hash >> 7) & mask;
+    for (size_t step = SEA_TURTLE_STRING_MAP_GROUP;;
+         step += SEA_TURTLE_STRING_MAP_GROUP) {
+        const int8_t *const group = object->controls + i;
+        for (uint32_t bits = sea_turtle_string_map_match(group, control);
+             bits; bits &= bits - 1) {
+            struct sea_turtle_string_map_entry *const entry
+                    = &object->entries[(i + __builtin_ctz(bits)) & mask];
+            if (sea_turtle_string_map_key_length(&entry->key) == length
+                && (!length
+                    || !memcmp(sea_turtle_string_bytes(&entry->key), bytes,
+                               length))) {
+                return entry;
+            }
+        }
+        if (sea_turtle_string_map_match(group, SEA_TURTLE_STRING_MAP_EMPTY)) {
+            return NULL;
+        }
+        i = (i + step) & mask;
+    }
+}
+
+/* first empty or deleted slot on the probe sequence of hash */
+static size_t sea_turtle_string_map_free_slot(
+        const struct sea_turtle_string_map *const object,
+        const uintmax_t hash) {
+    const size_t mask = object->capacity - 1;
+    size_t i = (hash >> 7) & mask;
+    for (size_t step = SEA_TURTLE_STRING_MAP_GROUP;;
+         step += SEA_TURTLE_STRING_MAP_GROUP) {
+        const uint32_t bits = sea_turtle_string_map_match_free(
+                object->controls + i);
+        if (bits) {
+            return (i + __builtin_ctz(bits)) & mask;
+        }
+        i = (i + step) & mask;
+    }
+}
+
+/* release the table without touching the keys */
+static void sea_turtle_string_map_release(
+        const struct sea_turtle_string_map *const object) {
+    if (!object->capacity) {
+        return;
+    }
+    sea_turtle_allocator_deallocate(
+            object->allocator, object->controls,
+            object->capacity + SEA_TURTLE_STRING_MAP_GROUP);
+    sea_turtle_allocator_deallocate(
+            object->allocator, object->entries,
+            object->capacity * sizeof(*object->entries));
+}
+
+/* move the entries to a table of the given capacity dropping deleted ones */
+static int sea_turtle_string_map_rebuild(
+        struct sea_turtle_string_map *const object,
+        const size_t capacity) {
+    int8_t *const controls = sea_turtle_allocator_allocate(
+            object->allocator, capacity + SEA_TURTLE_STRING_MAP_GROUP);
+    struct sea_turtle_string_map_entry *const entries
+            = sea_turtle_allocator_allocate(
+                    object->allocator, capacity * sizeof(*entries));
+    if (!controls || !entries) {
+        sea_turtle_allocator_deallocate(
+                object->allocator, controls,
+                capacity + SEA_TURTLE_STRING_MAP_GROUP);
+        sea_turtle_allocator_deallocate(
+                object->allocator, entries, capacity * sizeof(*entries));
+        return SEA_TURTLE_STRING_MAP_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    memset(controls, SEA_TURTLE_STRING_MAP_EMPTY,
+           capacity + SEA_TURTLE_STRING_MAP_GROUP);
+    struct sea_turtle_string_map old = *object;
+    object->controls = controls;
+    object->entries = entries;
+    object->capacity = capacity;
+    object->growth = sea_turtle_string_map_growth(capacity) - object->count;
+    for (size_t i = 0; i < old.capacity; i++) {
+        if (old.controls[i] < 0) {
+            continue;
+        }
+        /* the hash code was cached when the key was inserted unless the
+         * key is stored locally */
+        uintmax_t hash;
+        seagrass_required_true(!sea_turtle_string_hash(
+                &old.entries[i].key, &hash));
+        const size_t slot = sea_turtle_string_map_free_slot(object, hash);
+        sea_turtle_string_map_set_control(object, slot, hash & 0x7F);
+        /* strings hold no pointer into themselves so a plain move is safe */
+        entries[slot] = old.entries[i];
+    }
+    sea_turtle_string_map_release(&old);
+    return 0;
+}
+
+int sea_turtle_string_map_init(struct sea_turtle_string_map *const object) {
+    if (!object) {
+        return SEA_TURTLE_STRING_MAP_ERROR_OBJECT_IS_NULL;
+    }
+    *object = (struct sea_turtle_string_map) {
+            .allocator = sea_turtle_allocator_current()
+    };
+    return 0;
+}
+
+int sea_turtle_string_map_invalidate(
+        struct sea_turtle_string_map *const object) {
+    if (!object) {
+        return SEA_TURTLE_STRING_MAP_ERROR_OBJECT_IS_NULL;
+    }
+    for (size_t i = 0; i < object->capacity; i++) {
+        if (object->controls[i] >= 0) {
+            seagrass_required_true(!sea_turtle_string_invalidate(
+                    &object->entries[i].key));
+        }
+    }
+    sea_turtle_string_map_release(object);
+    *object = (struct sea_turtle_string_map) {0};
+    return 0;
+}
+
+int sea_turtle_string_map_reserve(struct sea_turtle_string_map *const object,
+                                  const size_t count) {
+    if (!object) {
+        return SEA_TURTLE_STRING_MAP_ERROR_OBJECT_IS_NULL;
+    }
+    if (object->capacity && count <= object->count + object->growth) {
+        return 0;
+    }
+    size_t capacity = object->capacity
+                      ? object->capacity
+                      : SEA_TURTLE_STRING_MAP_MINIMUM_CAPACITY;
+    for (; sea_turtle_string_map_growth(capacity) < count; capacity *= 2);
+    return sea_turtle_string_map_rebuild(object, capacity);
+}
+
+/* make room for one more entry in an empty slot */
+static int sea_turtle_string_map_grow(
+        struct sea_turtle_string_map *const object) {
+    if (object->growth) {
+        return 0;
+    }
+    /* reclaim the deleted slots if they make up much of the table */
+    size_t capacity = object->capacity
+                      ? object->capacity
+                      : SEA_TURTLE_STRING_MAP_MINIMUM_CAPACITY;
+    if (2 * object->count >= sea_turtle_string_map_growth(capacity)) {
+        capacity *= 2;
+    }
+    return sea_turtle_string_map_rebuild(object, capacity);
+}
+
+int sea_turtle_string_map_set(struct sea_turtle_string_map *const object,
+                              const struct sea_turtle_string *const key,
+                              void *const value) {
+    if (!object) {
+        return SEA_TURTLE_STRING_MAP_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return SEA_TURTLE_STRING_MAP_ERROR_KEY_IS_NULL;
+    }
+    uintmax_t hash;
+    seagrass_required_true(!sea_turtle_string_hash(key, &hash));
+    struct sea_turtle_string_map_entry *entry = sea_turtle_string_map_find(
+            object, sea_turtle_string_bytes(key),
+            sea_turtle_string_map_key_length(key), hash);
+    if (entry) {
+        entry->value = value;
+        return 0;
+    }
+    int error;
+    if ((error = sea_turtle_string_map_grow(object))) {
+        return error;
+    }
+    const size_t slot = sea_turtle_string_map_free_slot(object, hash);
+    entry = &object->entries[slot];
+    if ((error = sea_turtle_string_init_string(&entry->key, key))) {
+        seagrass_required_true(
+                SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED
+                == error);
+        return SEA_TURTLE_STRING_MAP_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    /* rebuilding the table rehashes keys without reading their bytes,
+     * keys stored locally being cheap to hash again */
+    if (!sea_turtle_string_is_local(&entry->key)) {
+        entry->key.hash = hash;
+    }
+    entry->value = value;
+    if (SEA_TURTLE_STRING_MAP_EMPTY == object->controls[slot]) {
+        object->growth -= 1;
+    }
+    sea_turtle_string_map_set_control(object, slot, hash & 0x7F);
+    object->count += 1;
+    return 0;
+}
+
+int sea_turtle_string_map_set_all(struct sea_turtle_string_map *const object,
+                                  const struct sea_turtle_string *const keys,
+                                  void *const *const values,
+                                  const size_t count) {
+    if (!object) {
+        return SEA_TURTLE_STRING_MAP_ERROR_OBJECT_IS_NULL;
+    }
+    if (!keys) {
+        return SEA_TURTLE_STRING_MAP_ERROR_KEYS_IS_NULL;
+    }
+    if (!values) {
+        return SEA_TURTLE_STRING_MAP_ERROR_VALUES_IS_NULL;
+    }
+    int error;
+    if ((error = sea_turtle_string_map_reserve(object,
+                                               object->count + count))) {
+        return error;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if ((error = sea_turtle_string_map_set(object, &keys[i],
+                                               values[i]))) {
+            return error;
+        }
+    }
+    return 0;
+}
+
+int sea_turtle_string_map_get(const struct sea_turtle_string_map *const object,
+                              const struct sea_turtle_string *const key,
+                              void **const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_MAP_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return SEA_TURTLE_STRING_MAP_ERROR_KEY_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_MAP_ERROR_OUT_IS_NULL;
+    }
+    uintmax_t hash;
+    seagrass_required_true(!sea_turtle_string_hash(key, &hash));
+    const struct sea_turtle_string_map_entry *const entry
+            = sea_turtle_string_map_find(
+                    object, sea_turtle_string_bytes(key),
+                    sea_turtle_string_map_key_length(key), hash);
+    if (!entry) {
+        return SEA_TURTLE_STRING_MAP_ERROR_KEY_NOT_FOUND;
+    }
+    *out = entry->value;
+    return 0;
+}
+
+int sea_turtle_string_map_get_chars(
+        const struct sea_turtle_string_map *const object,
+        const char *const char_ptr,
+        const size_t size,
+        void **const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_MAP_ERROR_OBJECT_IS_NULL;
+    }
+    if (!char_ptr) {
+        return SEA_TURTLE_STRING_MAP_ERROR_CHAR_PTR_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_MAP_ERROR_OUT_IS_NULL;
+    }
+    const uint8_t *const bytes = (const uint8_t *) char_ptr;
+    const struct sea_turtle_string_map_entry *const entry
+            = sea_turtle_string_map_find(
+                    object, bytes, size,
+                    sea_turtle_string_map_hash(bytes, size));
+    if (!entry) {
+        return SEA_TURTLE_STRING_MAP_ERROR_KEY_NOT_FOUND;
+    }
+    *out = entry->value;
+    return 0;
+}
+
+int sea_turtle_string_map_remove(struct sea_turtle_string_map *const object,
+                                 const struct sea_turtle_string *const key) {
+    if (!object) {
+        return SEA_TURTLE_STRING_MAP_ERROR_OBJECT_IS_NULL;
+    }
+    if (!key) {
+        return SEA_TURTLE_STRING_MAP_ERROR_KEY_IS_NULL;
+    }
+    uintmax_t hash;
+    seagrass_required_true(!sea_turtle_string_hash(key, &hash));
+    struct sea_turtle_string_map_entry *const entry
+            = sea_turtle_string_map_find(
+                    object, sea_turtle_string_bytes(key),
+                    sea_turtle_string_map_key_length(key), hash);
+    if (!entry) {
+        return SEA_TURTLE_STRING_MAP_ERROR_KEY_NOT_FOUND;
+    }
+    seagrass_required_true(!sea_turtle_string_invalidate(&entry->key));
+    /* probe sequences going through the slot must carry on past it */
+    sea_turtle_string_map_set_control(object, entry - object->entries,
+                                      SEA_TURTLE_STRING_MAP_DELETED);
+    object->count -= 1;
+    return 0;
+}
+
+int sea_turtle_string_map_count(
+        const struct sea_turtle_string_map *const object,
+        uintmax_t *const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_MAP_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_MAP_ERROR_OUT_IS_NULL;
+    }
+    *out = object->count;
+    return 0;
+}
@@ -0,0 +1,246 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include <sea-turtle.h>
+#include <seagrass.h>
+
+#include "private/allocator.h"
+#include "private/string.h"
+
+#ifdef TEST
+#include <test/cmocka.h>
+#endif
+
+struct sea_turtle_string_pool_slot {
+    uintmax_t hash;
+    struct sea_turtle_string *string;
+};
+
+struct sea_turtle_string_pool_shard {
+    pthread_rwlock_t lock;
+    struct sea_turtle_string_pool_slot *slots;
+    size_t capacity;
+    size_t count;
+};
+
+#define SEA_TURTLE_STRING_POOL_SHARD_BITS 6
+#define SEA_TURTLE_STRING_POOL_MINIMUM_CAPACITY 16
+
+static_assert((1 << SEA_TURTLE_STRING_POOL_SHARD_BITS)
+              == SEA_TURTLE_STRING_POOL_SHARDS,
+              "shard bits must match the number of shards");
+
+/* spread the bits of the hash code so that both shard and slot vary */
+static uintmax_t sea_turtle_string_pool_mix(uintmax_t hash) {
+    hash ^= hash >> 33;
+    hash *= UINTMAX_C(0xFF51AFD7ED558CCD);
+    hash ^= hash >> 33;
+    hash *= UINTMAX_C(0xC4CEB9FE1A85EC53);
+    hash ^= hash >> 33;
+    return hash;
+}
+
+int sea_turtle_string_pool_init(struct sea_turtle_string_pool *const object) {
+    if (!object) {
+        return SEA_TURTLE_STRING_POOL_ERROR_OBJECT_IS_NULL;
+    }
+    *object = (struct sea_turtle_string_pool) {
+            .allocator = sea_turtle_allocator_current()
+    };
+    object->shards = sea_turtle_allocator_allocate(
+            object->allocator,
+            SEA_TURTLE_STRING_POOL_SHARDS * sizeof(*object->shards));
+    if (!object->shards) {
+        return SEA_TURTLE_STRING_POOL_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    memset(object->shards, 0,
+           SEA_TURTLE_STRING_POOL_SHARDS * sizeof(*object->shards));
+    for (size_t i = 0; i < SEA_TURTLE_STRING_POOL_SHARDS; i++) {
+        seagrass_required_true(!pthread_rwlock_init(
+                &object->shards[i].lock, NULL));
+    }
+    return 0;
+}
+
+int sea_turtle_string_pool_invalidate(
+        struct sea_turtle_string_pool *const object) {
+    if (!object) {
+        return SEA_TURTLE_STRING_POOL_ERROR_OBJECT_IS_NULL;
+    }
+    if (object->shards) {
+        for (size_t i = 0; i < SEA_TURTLE_STRING_POOL_SHARDS; i++) {
+            struct sea_turtle_string_pool_shard *const shard
+                    = &object->shards[i];
+            for (size_t o = 0; o < shard->capacity; o++) {
+                struct sea_turtle_string *const string
+                        = shard->slots[o].string;
+                if (string) {
+                    seagrass_required_true(
+                            !sea_turtle_string_invalidate(string));
+                    sea_turtle_allocator_deallocate(
+                            object->allocator, string, sizeof(*string));
+                }
+            }
+            sea_turtle_allocator_deallocate(
+                    object->allocator, shard->slots,
+                    shard->capacity * sizeof(*shard->slots));
+            seagrass_required_true(!pthread_rwlock_destroy(&shard->lock));
+        }
+        sea_turtle_allocator_deallocate(
+                object->allocator, object->shards,
+                SEA_TURTLE_STRING_POOL_SHARDS * sizeof(*object->shards));
+    }
+    *object = (struct sea_turtle_string_pool) {0};
+    return 0;
+}
+
+static struct sea_turtle_string *sea_turtle_string_pool_find(
+        const struct sea_turtle_string_pool_shard *const shard,
+        const uintmax_t hash,
+        const struct sea_turtle_string *const value) {
+    if (!shard->capacity) {
+        return NULL;
+    }
+    const size_t mask = shard->capacity - 1;
+    for (size_t i = hash & mask; shard->slots[i].string; i = (1 + i) & mask) {
+        bool equal;
+        if (shard->slots[i].hash == hash
+            && !sea_turtle_string_equals(shard->slots[i].string, value,
+                                         &equal)
+            && equal) {
+            return shard->slots[i].string;
+        }
+    }
+    return NULL;
+}
+
+static void sea_turtle_string_pool_place(
+        struct sea_turtle_string_pool_slot *const slots,
+        const size_t capacity,
+        const struct sea_turtle_string_pool_slot slot) {
+    const size_t mask = capacity - 1;
+    size_t i = slot.hash & mask;
+    for (; slots[i].string; i = (1 + i) & mask);
+    slots[i] = slot;
+}
+
+/* keep the load factor at or below one half */
+static int sea_turtle_string_pool_reserve(
+        const struct sea_turtle_string_pool *const object,
+        struct sea_turtle_string_pool_shard *const shard) {
+    if (2 * (1 + shard->count) <= shard->capacity) {
+        return 0;
+    }
+    const size_t capacity = shard->capacity
+                            ? 2 * shard->capacity
+                            : SEA_TURTLE_STRING_POOL_MINIMUM_CAPACITY;
+    struct sea_turtle_string_pool_slot *slots;
+    if (capacity > SIZE_MAX / sizeof(*slots)
+        || !(slots = sea_turtle_allocator_allocate(
+                object->allocator, capacity * sizeof(*slots)))) {
+        return SEA_TURTLE_STRING_POOL_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    memset(slots, 0, capacity * sizeof(*slots));
+    for (size_t i = 0; i < shard->capacity; i++) {
+        if (shard->slots[i].string) {
+            sea_turtle_string_pool_place(slots, capacity, shard->slots[i]);
+        }
+    }
+    sea_turtle_allocator_deallocate(object->allocator, shard->slots,
+                                    shard->capacity * sizeof(*slots));
+    shard->slots = slots;
+    shard->capacity = capacity;
+    return 0;
+}
+
+int sea_turtle_string_pool_intern(
+        struct sea_turtle_string_pool *const object,
+        const struct sea_turtle_string *const value,
+        const struct sea_turtle_string **const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_POOL_ERROR_OBJECT_IS_NULL;
+    }
+    if (!object->shards) {
+        return SEA_TURTLE_STRING_POOL_ERROR_OBJECT_IS_INVALID;
+    }
+    if (!value) {
+        return SEA_TURTLE_STRING_POOL_ERROR_VALUE_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_POOL_ERROR_OUT_IS_NULL;
+    }
+    uintmax_t hash;
+    seagrass_required_true(!sea_turtle_string_hash(value, &hash));
+    hash = sea_turtle_string_pool_mix(hash);
+    struct sea_turtle_string_pool_shard *const shard = &object->shards[
+            hash >> (8 * sizeof(hash) - SEA_TURTLE_STRING_POOL_SHARD_BITS)];
+    /* most values are already interned so look them up under a read lock */
+    seagrass_required_true(!pthread_rwlock_rdlock(&shard->lock));
+    struct sea_turtle_string *string = sea_turtle_string_pool_find(
+            shard, hash, value);
+    seagrass_required_true(!pthread_rwlock_unlock(&shard->lock));
+    if (string) {
+        *out = string;
+        return 0;
+    }
+    int error;
+    seagrass_required_true(!pthread_rwlock_wrlock(&shard->lock));
+    /* another thread may have interned the value in the meantime */
+    if ((string = sea_turtle_string_pool_find(shard, hash, value))) {
+        seagrass_required_true(!pthread_rwlock_unlock(&shard->lock));
+        *out = string;
+        return 0;
+    }
+    if ((error = sea_turtle_string_pool_reserve(object, shard))) {
+        seagrass_required_true(!pthread_rwlock_unlock(&shard->lock));
+        return error;
+    }
+    if (!(string = sea_turtle_allocator_allocate(object->allocator,
+                                                 sizeof(*string)))) {
+        seagrass_required_true(!pthread_rwlock_unlock(&shard->lock));
+        return SEA_TURTLE_STRING_POOL_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    /* interned strings outlive any scope so use the default allocator */
+    if ((error = sea_turtle_string_init_shared(string, value, NULL))) {
+        seagrass_required_true(
+                SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED
+                == error);
+        sea_turtle_allocator_deallocate(object->allocator, string,
+                                        sizeof(*string));
+        seagrass_required_true(!pthread_rwlock_unlock(&shard->lock));
+        return SEA_TURTLE_STRING_POOL_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    sea_turtle_string_pool_place(
+            shard->slots, shard->capacity,
+            (struct sea_turtle_string_pool_slot) {
+                    .hash = hash,
+                    .string = string
+            });
+    shard->count += 1;
+    seagrass_required_true(!pthread_rwlock_unlock(&shard->lock));
+    *out = string;
+    return 0;
+}
+
+int sea_turtle_string_pool_count(struct sea_turtle_string_pool *const object,
+                                 uintmax_t *const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_POOL_ERROR_OBJECT_IS_NULL;
+    }
+    if (!object->shards) {
+        return SEA_TURTLE_STRING_POOL_ERROR_OBJECT_IS_INVALID;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_POOL_ERROR_OUT_IS_NULL;
+    }
+    uintmax_t count = 0;
+    for (size_t i = 0; i < SEA_TURTLE_STRING_POOL_SHARDS; i++) {
+        struct sea_turtle_string_pool_shard *const shard = &object->shards[i];
+        seagrass_required_true(!pthread_rwlock_rdlock(&shard->lock));
+        count += shard->count;
+        seagrass_required_true(!pthread_rwlock_unlock(&shard->lock));
+    }
+    *out = count;
+    return 0;
+}
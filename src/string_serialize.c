@@ -0,0 +1,312 @@
+#include <string.h>
+#include <pthread.h>
+#include <sea-turtle.h>
+#include <seagrass.h>
+
+#include "private/allocator.h"
+#include "private/hash.h"
+#include "private/string.h"
+#include "private/utf8.h"
+
+#ifdef TEST
+#include <test/cmocka.h>
+#endif
+
+/* "STSS" in the byte order of the process which serialized the strings */
+#define SEA_TURTLE_STRING_SERIALIZE_MAGIC 0x53535453
+#define SEA_TURTLE_STRING_SERIALIZE_VERSION 1
+/* the checksum must not depend on the seed of the process */
+#define SEA_TURTLE_STRING_SERIALIZE_CHECKSUM_SEED 0x5EA7E7715EA7E771
+
+/*
+ * The header is followed by every string encoded as a LEB128 varint
+ * holding its length, a LEB128 varint holding its count of code points,
+ * then its bytes followed by a NULL char unless it is empty. Hash codes are
+ * not stored as they are keyed by a secret seed of the process.
+ */
+struct sea_turtle_string_serialize_header {
+    uint32_t magic;
+    uint32_t version;
+    /* covers everything that follows it */
+    uint64_t checksum;
+    uint64_t count;
+    uint64_t size;
+};
+
+/* offset of the first byte covered by the checksum */
+#define SEA_TURTLE_STRING_SERIALIZE_COVERED \
+    (offsetof(struct sea_turtle_string_serialize_header, checksum) \
+     + sizeof(uint64_t))
+
+static pthread_once_t sea_turtle_string_serialize_once = PTHREAD_ONCE_INIT;
+static struct sea_turtle_hash_secret sea_turtle_string_serialize_secret;
+
+static void sea_turtle_string_serialize_init(void) {
+    sea_turtle_hash_secret_init(&sea_turtle_string_serialize_secret,
+                                SEA_TURTLE_STRING_SERIALIZE_CHECKSUM_SEED);
+}
+
+static uint64_t sea_turtle_string_serialize_checksum(
+        const uint8_t *const begin,
+        const size_t length) {
+    seagrass_required_true(!pthread_once(&sea_turtle_string_serialize_once,
+                                         sea_turtle_string_serialize_init));
+    return sea_turtle_hash_with_secret(&sea_turtle_string_serialize_secret,
+                                       begin, length, NULL);
+}
+
+static size_t sea_turtle_string_serialize_varint_size(uintmax_t value) {
+    size_t size = 1;
+    for (; value >= 0x80; value >>= 7, size++);
+    return size;
+}
+
+static uint8_t *sea_turtle_string_serialize_put(uint8_t *at,
+                                                uintmax_t value) {
+    for (; value >= 0x80; value >>= 7) {
+        *at++ = 0x80 | (value & 0x7F);
+    }
+    *at++ = value;
+    return at;
+}
+
+/* returns NULL if the varint is truncated or too large */
+static const uint8_t *sea_turtle_string_serialize_get(
+        const uint8_t *at,
+        const uint8_t *const end,
+        uintmax_t *const out) {
+    uintmax_t value = 0;
+    for (unsigned shift = 0; at < end && shift < 64; shift += 7) {
+        const uint8_t byte = *at++;
+        value |= (uintmax_t) (byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *out = value;
+            return at;
+        }
+    }
+    return NULL;
+}
+
+int sea_turtle_string_serialized_size(
+        const struct sea_turtle_string *const objects,
+        const size_t count,
+        size_t *const out) {
+    if (!objects) {
+        return SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_ERROR_OUT_IS_NULL;
+    }
+    uintmax_t total = sizeof(struct sea_turtle_string_serialize_header);
+    for (size_t i = 0; i < count; i++) {
+        const struct sea_turtle_string *const object = &objects[i];
+        const uintmax_t length = object->size ? object->size - 1 : 0;
+        const uintmax_t size
+                = sea_turtle_string_serialize_varint_size(length)
+                  + sea_turtle_string_serialize_varint_size(
+                          sea_turtle_string_count_of(object));
+        if (seagrass_uintmax_t_add(total, size, &total)
+            || seagrass_uintmax_t_add(total, object->size, &total)) {
+            return SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED;
+        }
+    }
+    if (total > SIZE_MAX) {
+        return SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    *out = total;
+    return 0;
+}
+
+int sea_turtle_string_serialize(const struct sea_turtle_string *const objects,
+                                const size_t count,
+                                void *const out,
+                                const size_t size) {
+    if (!objects) {
+        return SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_ERROR_OUT_IS_NULL;
+    }
+    size_t total;
+    int error;
+    if ((error = sea_turtle_string_serialized_size(objects, count, &total))) {
+        seagrass_required_true(
+                SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED == error);
+        return SEA_TURTLE_STRING_ERROR_SIZE_IS_TOO_SMALL;
+    }
+    if (size < total) {
+        return SEA_TURTLE_STRING_ERROR_SIZE_IS_TOO_SMALL;
+    }
+    struct sea_turtle_string_serialize_header header = {
+            .magic = SEA_TURTLE_STRING_SERIALIZE_MAGIC,
+            .version = SEA_TURTLE_STRING_SERIALIZE_VERSION,
+            .count = count,
+            .size = total
+    };
+    uint8_t *const begin = (uint8_t *) out + sizeof(header);
+    uint8_t *at = begin;
+    for (size_t i = 0; i < count; i++) {
+        const struct sea_turtle_string *const object = &objects[i];
+        const uintmax_t length = object->size ? object->size - 1 : 0;
+        at = sea_turtle_string_serialize_put(at, length);
+        at = sea_turtle_string_serialize_put(
+                at, sea_turtle_string_count_of(object));
+        if (object->size) {
+            memcpy(at, sea_turtle_string_bytes(object), object->size);
+            at += object->size;
+        }
+    }
+    seagrass_required_true(at == (uint8_t *) out + total);
+    memcpy(out, &header, sizeof(header));
+    header.checksum = sea_turtle_string_serialize_checksum(
+            (uint8_t *) out + SEA_TURTLE_STRING_SERIALIZE_COVERED,
+            total - SEA_TURTLE_STRING_SERIALIZE_COVERED);
+    memcpy(out, &header, sizeof(header));
+    return 0;
+}
+
+static bool sea_turtle_string_serialize_header(
+        const void *const buffer,
+        const size_t size,
+        struct sea_turtle_string_serialize_header *const out) {
+    if (size < sizeof(*out)) {
+        return false;
+    }
+    memcpy(out, buffer, sizeof(*out));
+    return SEA_TURTLE_STRING_SERIALIZE_MAGIC == out->magic
+           && SEA_TURTLE_STRING_SERIALIZE_VERSION == out->version
+           && size == out->size;
+}
+
+int sea_turtle_string_serialized_count(const void *const buffer,
+                                       const size_t size,
+                                       uintmax_t *const out) {
+    if (!buffer) {
+        return SEA_TURTLE_STRING_ERROR_BUFFER_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_ERROR_OUT_IS_NULL;
+    }
+    struct sea_turtle_string_serialize_header header;
+    if (!sea_turtle_string_serialize_header(buffer, size, &header)) {
+        return SEA_TURTLE_STRING_ERROR_BUFFER_IS_MALFORMED;
+    }
+    *out = header.count;
+    return 0;
+}
+
+/* decode the string at at into object, returning NULL on error */
+static const uint8_t *sea_turtle_string_serialize_load(
+        struct sea_turtle_string *const object,
+        const uint8_t *at,
+        const uint8_t *const end,
+        const enum sea_turtle_string_load load,
+        int *const error) {
+    uintmax_t length;
+    uintmax_t count;
+    *error = SEA_TURTLE_STRING_ERROR_BUFFER_IS_MALFORMED;
+    if (!(at = sea_turtle_string_serialize_get(at, end, &length))
+        || !(at = sea_turtle_string_serialize_get(at, end, &count))) {
+        return NULL;
+    }
+    if (!length) {
+        if (count) {
+            return NULL;
+        }
+        *object = (struct sea_turtle_string) {0};
+        *error = 0;
+        return at;
+    }
+    /* every code point takes at least one byte */
+    if (count > length) {
+        return NULL;
+    }
+    /* the bytes are followed by the NULL termination char */
+    if (length >= (uintmax_t) (end - at) || at[length]) {
+        return NULL;
+    }
+    if (SEA_TURTLE_STRING_LOAD_VALIDATE == load) {
+        size_t read;
+        uintmax_t c;
+        if (sea_turtle_utf8_validate(at, length, &read, &c)
+            || read != length
+            || c != count) {
+            return NULL;
+        }
+    }
+    *object = (struct sea_turtle_string) {0};
+    /* add 1 to accommodate the NULL termination char */
+    const size_t size = 1 + length;
+    if (SEA_TURTLE_STRING_LOAD_IN_PLACE == load
+        && size > SEA_TURTLE_STRING_LOCAL_SIZE) {
+        object->data = (uint8_t *) at;
+        object->size = size;
+        sea_turtle_string_set_storage(object,
+                                      SEA_TURTLE_STRING_STORAGE_ARENA);
+    } else {
+        if ((*error = sea_turtle_string_set_size(object, size))) {
+            seagrass_required_true(
+                    SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED
+                    == *error);
+            return NULL;
+        }
+        memcpy(sea_turtle_string_bytes(object), at, length);
+    }
+    sea_turtle_string_set_count(object, count);
+    *error = 0;
+    return at + size;
+}
+
+int sea_turtle_string_deserialize(struct sea_turtle_string *const objects,
+                                  const size_t count,
+                                  const void *const buffer,
+                                  const size_t size,
+                                  const enum sea_turtle_string_load load) {
+    if (!objects) {
+        return SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL;
+    }
+    if (!buffer) {
+        return SEA_TURTLE_STRING_ERROR_BUFFER_IS_NULL;
+    }
+    if (SEA_TURTLE_STRING_LOAD_VALIDATE != load
+        && SEA_TURTLE_STRING_LOAD_TRUSTED != load
+        && SEA_TURTLE_STRING_LOAD_IN_PLACE != load) {
+        return SEA_TURTLE_STRING_ERROR_LOAD_IS_INVALID;
+    }
+    struct sea_turtle_string_serialize_header header;
+    if (!sea_turtle_string_serialize_header(buffer, size, &header)) {
+        return SEA_TURTLE_STRING_ERROR_BUFFER_IS_MALFORMED;
+    }
+    if (count != header.count) {
+        return SEA_TURTLE_STRING_ERROR_COUNT_IS_INVALID;
+    }
+    const uint8_t *const begin = (const uint8_t *) buffer + sizeof(header);
+    const uint8_t *const end = (const uint8_t *) buffer + size;
+    if (header.checksum != sea_turtle_string_serialize_checksum(
+            (const uint8_t *) buffer + SEA_TURTLE_STRING_SERIALIZE_COVERED,
+            size - SEA_TURTLE_STRING_SERIALIZE_COVERED)) {
+        return SEA_TURTLE_STRING_ERROR_BUFFER_IS_MALFORMED;
+    }
+    const uint8_t *at = begin;
+    int error = 0;
+    size_t i = 0;
+    for (; i < count; i++) {
+        at = sea_turtle_string_serialize_load(&objects[i], at, end, load,
+                                              &error);
+        if (!at) {
+            break;
+        }
+    }
+    if (!error && at != end) {
+        error = SEA_TURTLE_STRING_ERROR_BUFFER_IS_MALFORMED;
+    }
+    if (error) {
+        for (size_t o = 0; o < i; o++) {
+            seagrass_required_true(
+                    !sea_turtle_string_invalidate(&objects[o]));
+        }
+        memset(objects, 0, count * sizeof(*objects));
+        return error;
+    }
+    return 0;
+}
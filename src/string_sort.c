@@ -0,0 +1,425 @@
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sea-turtle.h>
+#include <seagrass.h>
+
+#include "private/allocator.h"
+#include "private/string.h"
+
+#ifdef TEST
+#include <test/cmocka.h>
+#endif
+
+/* subarrays this small are sorted by insertion */
+#define SEA_TURTLE_STRING_SORT_SMALL 16
+/* fewest strings worth sorting on a thread of their own */
+#define SEA_TURTLE_STRING_SORT_PER_THREAD 16384
+#define SEA_TURTLE_STRING_SORT_MAXIMUM_THREADS 64
+
+struct sea_turtle_string_sort_item {
+    /* bytes of the string at the current depth as a big endian integer */
+    uint64_t key;
+    const uint8_t *bytes;
+    size_t length;
+    size_t index;
+};
+
+/*
+ * Depth d refers to the bytes [8d, 8d + 8) of the strings, or when ordering
+ * by size first, depth 0 refers to the size and depth d to the bytes
+ * [8(d - 1), 8(d - 1) + 8). Valid strings do not contain NULL chars so
+ * padding the bytes past the end of a string with zeros keeps their order.
+ */
+static uint64_t sea_turtle_string_sort_key(
+        const struct sea_turtle_string_sort_item *const item,
+        size_t depth,
+        const bool by_size) {
+    if (by_size) {
+        if (!depth) {
+            return item->length;
+        }
+        depth -= 1;
+    }
+    const size_t offset = 8 * depth;
+    if (offset >= item->length) {
+        return 0;
+    }
+    const uint8_t *const bytes = item->bytes + offset;
+    const size_t left = item->length - offset;
+    uint64_t key = 0;
+    if (left >= 8) {
+        memcpy(&key, bytes, sizeof(key));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        key = __builtin_bswap64(key);
+#endif
+    } else {
+        for (size_t i = 0; i < left; i++) {
+            key |= (uint64_t) bytes[i] << (56 - 8 * i);
+        }
+    }
+    return key;
+}
+
+/* strings sharing a key end at the depth if they end within its bytes */
+static bool sea_turtle_string_sort_ends(const uint64_t key,
+                                        const size_t depth,
+                                        const bool by_size) {
+    return by_size && !depth ? !key : !(key & 0xFF);
+}
+
+static int sea_turtle_string_sort_compare(
+        const struct sea_turtle_string_sort_item *const a,
+        const struct sea_turtle_string_sort_item *const b,
+        const bool by_size) {
+    if (by_size && a->length != b->length) {
+        return a->length < b->length ? -1 : 1;
+    }
+    const size_t length = a->length < b->length ? a->length : b->length;
+    const int result = length ? memcmp(a->bytes, b->bytes, length) : 0;
+    if (result) {
+        return result;
+    }
+    return (a->length > b->length) - (a->length < b->length);
+}
+
+static void sea_turtle_string_sort_insertion(
+        struct sea_turtle_string_sort_item *const items,
+        const size_t count,
+        const bool by_size) {
+    for (size_t i = 1; i < count; i++) {
+        const struct sea_turtle_string_sort_item item = items[i];
+        size_t o = i;
+        for (; o && sea_turtle_string_sort_compare(&item, &items[o - 1],
+                                                   by_size) < 0; o--) {
+            items[o] = items[o - 1];
+        }
+        items[o] = item;
+    }
+}
+
+static void sea_turtle_string_sort_swap(
+        struct sea_turtle_string_sort_item *const a,
+        struct sea_turtle_string_sort_item *const b) {
+    const struct sea_turtle_string_sort_item item = *a;
+    *a = *b;
+    *b = item;
+}
+
+static void sea_turtle_string_sort_sift(
+        struct sea_turtle_string_sort_item *const items,
+        size_t root,
+        const size_t count,
+        const bool by_size) {
+    for (size_t child; (child = 2 * root + 1) < count; root = child) {
+        if (child + 1 < count
+            && sea_turtle_string_sort_compare(&items[child],
+                                              &items[child + 1],
+                                              by_size) < 0) {
+            child += 1;
+        }
+        if (sea_turtle_string_sort_compare(&items[root], &items[child],
+                                           by_size) >= 0) {
+            return;
+        }
+        sea_turtle_string_sort_swap(&items[root], &items[child]);
+    }
+}
+
+/* heap sort comparing whole strings, for when partitioning goes badly */
+static void sea_turtle_string_sort_heap(
+        struct sea_turtle_string_sort_item *const items,
+        const size_t count,
+        const bool by_size) {
+    for (size_t i = count / 2; i--;) {
+        sea_turtle_string_sort_sift(items, i, count, by_size);
+    }
+    for (size_t i = count; --i;) {
+        sea_turtle_string_sort_swap(&items[0], &items[i]);
+        sea_turtle_string_sort_sift(items, 0, i, by_size);
+    }
+}
+
+/* rounds of partitioning on the same keys before falling back to heap sort */
+static size_t sea_turtle_string_sort_limit(size_t count) {
+    size_t limit = 0;
+    for (; count > 1; count >>= 1) {
+        limit += 2;
+    }
+    return limit;
+}
+
+struct sea_turtle_string_sort_range {
+    struct sea_turtle_string_sort_item *items;
+    size_t count;
+    size_t depth;
+    size_t limit;
+};
+
+/*
+ * Multikey quicksort, partitioning three ways on 8 bytes at a time, the keys
+ * of the items being those at depth. Only the two smaller parts are sorted
+ * recursively, each holding at most half of the items, so that the stack
+ * stays logarithmic. Once limit rounds have been spent on the same keys the
+ * items are heap sorted instead.
+ */
+static void sea_turtle_string_sort_items(
+        struct sea_turtle_string_sort_item *items,
+        size_t count,
+        size_t depth,
+        size_t limit,
+        const bool by_size) {
+    while (count > 1) {
+        if (count < SEA_TURTLE_STRING_SORT_SMALL) {
+            sea_turtle_string_sort_insertion(items, count, by_size);
+            return;
+        }
+        if (!limit) {
+            sea_turtle_string_sort_heap(items, count, by_size);
+            return;
+        }
+        limit -= 1;
+        const uint64_t a = items[0].key;
+        const uint64_t b = items[count / 2].key;
+        const uint64_t c = items[count - 1].key;
+        const uint64_t pivot = a < b
+                               ? (b < c ? b : a < c ? c : a)
+                               : (a < c ? a : b < c ? c : b);
+        size_t lt = 0;
+        size_t gt = count;
+        for (size_t i = 0; i < gt;) {
+            if (items[i].key < pivot) {
+                sea_turtle_string_sort_swap(&items[lt++], &items[i++]);
+            } else if (items[i].key > pivot) {
+                sea_turtle_string_sort_swap(&items[i], &items[--gt]);
+            } else {
+                i += 1;
+            }
+        }
+        /* strings equal to the pivot that end within its bytes are sorted */
+        const size_t equal = sea_turtle_string_sort_ends(pivot, depth,
+                                                         by_size)
+                             ? 0
+                             : gt - lt;
+        for (size_t i = lt; i < lt + equal; i++) {
+            items[i].key = sea_turtle_string_sort_key(&items[i], depth + 1,
+                                                      by_size);
+        }
+        const struct sea_turtle_string_sort_range ranges[] = {
+                {items, lt, depth, limit},
+                {items + gt, count - gt, depth, limit},
+                {items + lt, equal, depth + 1,
+                 sea_turtle_string_sort_limit(equal)}
+        };
+        size_t largest = 0;
+        for (size_t i = 1; i < 3; i++) {
+            if (ranges[i].count > ranges[largest].count) {
+                largest = i;
+            }
+        }
+        for (size_t i = 0; i < 3; i++) {
+            if (i != largest) {
+                sea_turtle_string_sort_items(ranges[i].items,
+                                             ranges[i].count,
+                                             ranges[i].depth,
+                                             ranges[i].limit,
+                                             by_size);
+            }
+        }
+        items = ranges[largest].items;
+        count = ranges[largest].count;
+        depth = ranges[largest].depth;
+        limit = ranges[largest].limit;
+    }
+}
+
+struct sea_turtle_string_sort_task {
+    struct sea_turtle_string_sort_item *items;
+    size_t count;
+    /* second run to merge with the first, if any */
+    const struct sea_turtle_string_sort_item *other;
+    size_t other_count;
+    struct sea_turtle_string_sort_item *out;
+    bool by_size;
+};
+
+static void *sea_turtle_string_sort_run(void *const argument) {
+    const struct sea_turtle_string_sort_task *const task = argument;
+    sea_turtle_string_sort_items(task->items, task->count, 0,
+                                 sea_turtle_string_sort_limit(task->count),
+                                 task->by_size);
+    return NULL;
+}
+
+static void *sea_turtle_string_sort_merge(void *const argument) {
+    const struct sea_turtle_string_sort_task *const task = argument;
+    const struct sea_turtle_string_sort_item *a = task->items;
+    const struct sea_turtle_string_sort_item *const a_end = a + task->count;
+    const struct sea_turtle_string_sort_item *b = task->other;
+    const struct sea_turtle_string_sort_item *const b_end
+            = b + task->other_count;
+    struct sea_turtle_string_sort_item *out = task->out;
+    while (a < a_end && b < b_end) {
+        /* take from the first run on ties */
+        *out++ = sea_turtle_string_sort_compare(b, a, task->by_size) < 0
+                 ? *b++
+                 : *a++;
+    }
+    for (; a < a_end; *out++ = *a++);
+    for (; b < b_end; *out++ = *b++);
+    return NULL;
+}
+
+/* run the tasks on as many threads, the first one on the calling thread */
+static void sea_turtle_string_sort_parallel(
+        void *(*const function)(void *),
+        struct sea_turtle_string_sort_task *const tasks,
+        const size_t count) {
+    pthread_t threads[SEA_TURTLE_STRING_SORT_MAXIMUM_THREADS];
+    bool started[SEA_TURTLE_STRING_SORT_MAXIMUM_THREADS];
+    for (size_t i = 1; i < count; i++) {
+        /* tasks whose thread cannot be started are run in place */
+        started[i] = !pthread_create(&threads[i], NULL, function, &tasks[i]);
+        if (!started[i]) {
+            function(&tasks[i]);
+        }
+    }
+    function(&tasks[0]);
+    for (size_t i = 1; i < count; i++) {
+        if (started[i]) {
+            seagrass_required_true(!pthread_join(threads[i], NULL));
+        }
+    }
+}
+
+/*
+ * Sort runs of the items on their own threads then merge pairs of runs, the
+ * merges of a round also running on their own threads, returning the array
+ * that holds the sorted items.
+ */
+static struct sea_turtle_string_sort_item *sea_turtle_string_sort_runs(
+        struct sea_turtle_string_sort_item *items,
+        struct sea_turtle_string_sort_item *buffer,
+        const size_t count,
+        size_t runs,
+        const bool by_size) {
+    struct sea_turtle_string_sort_task tasks[
+            SEA_TURTLE_STRING_SORT_MAXIMUM_THREADS];
+    size_t bounds[SEA_TURTLE_STRING_SORT_MAXIMUM_THREADS + 1];
+    for (size_t i = 0; i <= runs; i++) {
+        bounds[i] = count / runs * i + (i < count % runs ? i : count % runs);
+    }
+    for (size_t i = 0; i < runs; i++) {
+        tasks[i] = (struct sea_turtle_string_sort_task) {
+                .items = items + bounds[i],
+                .count = bounds[i + 1] - bounds[i],
+                .by_size = by_size
+        };
+    }
+    sea_turtle_string_sort_parallel(sea_turtle_string_sort_run, tasks, runs);
+    while (runs > 1) {
+        const size_t merges = (runs + 1) / 2;
+        for (size_t i = 0; i < merges; i++) {
+            const size_t begin = bounds[2 * i];
+            const size_t middle = bounds[2 * i + 1];
+            /* an odd run out is merged with nothing, so copied over */
+            const size_t end = 2 * i + 2 <= runs ? bounds[2 * i + 2] : middle;
+            tasks[i] = (struct sea_turtle_string_sort_task) {
+                    .items = items + begin,
+                    .count = middle - begin,
+                    .other = items + middle,
+                    .other_count = end - middle,
+                    .out = buffer + begin,
+                    .by_size = by_size
+            };
+        }
+        sea_turtle_string_sort_parallel(sea_turtle_string_sort_merge, tasks,
+                                        merges);
+        for (size_t i = 0; i <= merges; i++) {
+            bounds[i] = bounds[2 * i <= runs ? 2 * i : runs];
+        }
+        runs = merges;
+        struct sea_turtle_string_sort_item *const sorted = buffer;
+        buffer = items;
+        items = sorted;
+    }
+    return items;
+}
+
+int sea_turtle_string_sort(struct sea_turtle_string *const objects,
+                           const size_t count,
+                           const enum sea_turtle_string_order order,
+                           size_t threads) {
+    if (!objects) {
+        return SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL;
+    }
+    if (SEA_TURTLE_STRING_ORDER_SIZE != order
+        && SEA_TURTLE_STRING_ORDER_BYTES != order) {
+        return SEA_TURTLE_STRING_ERROR_ORDER_IS_INVALID;
+    }
+    if (count < 2) {
+        return 0;
+    }
+    if (!threads) {
+        const long processors = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = processors > 0 ? processors : 1;
+    }
+    if (threads > count / SEA_TURTLE_STRING_SORT_PER_THREAD) {
+        threads = count / SEA_TURTLE_STRING_SORT_PER_THREAD;
+    }
+    if (threads > SEA_TURTLE_STRING_SORT_MAXIMUM_THREADS) {
+        threads = SEA_TURTLE_STRING_SORT_MAXIMUM_THREADS;
+    }
+    if (!threads) {
+        threads = 1;
+    }
+    const bool by_size = SEA_TURTLE_STRING_ORDER_SIZE == order;
+    if (count > SIZE_MAX / sizeof(struct sea_turtle_string_sort_item)
+        || count > SIZE_MAX / sizeof(struct sea_turtle_string)) {
+        return SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    const size_t items_size
+            = count * sizeof(struct sea_turtle_string_sort_item);
+    const size_t buffer_size = threads > 1 ? items_size : 0;
+    const size_t strings_size = count * sizeof(struct sea_turtle_string);
+    struct sea_turtle_string_sort_item *const items
+            = sea_turtle_allocate(items_size);
+    struct sea_turtle_string_sort_item *const buffer = buffer_size
+            ? sea_turtle_allocate(buffer_size)
+            : NULL;
+    struct sea_turtle_string *const strings
+            = sea_turtle_allocate(strings_size);
+    if (!items || (buffer_size && !buffer) || !strings) {
+        sea_turtle_deallocate(items, items_size);
+        sea_turtle_deallocate(buffer, buffer_size);
+        sea_turtle_deallocate(strings, strings_size);
+        return SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    for (size_t i = 0; i < count; i++) {
+        const struct sea_turtle_string *const object = &objects[i];
+        items[i] = (struct sea_turtle_string_sort_item) {
+                .bytes = sea_turtle_string_bytes(object),
+                .length = object->size ? object->size - 1 : 0,
+                .index = i
+        };
+        items[i].key = sea_turtle_string_sort_key(&items[i], 0, by_size);
+    }
+    const struct sea_turtle_string_sort_item *sorted = items;
+    if (threads > 1) {
+        sorted = sea_turtle_string_sort_runs(items, buffer, count, threads,
+                                             by_size);
+    } else {
+        sea_turtle_string_sort_items(items, count, 0,
+                                     sea_turtle_string_sort_limit(count),
+                                     by_size);
+    }
+    for (size_t i = 0; i < count; i++) {
+        strings[i] = objects[sorted[i].index];
+    }
+    memcpy(objects, strings, strings_size);
+    sea_turtle_deallocate(items, items_size);
+    sea_turtle_deallocate(buffer, buffer_size);
+    sea_turtle_deallocate(strings, strings_size);
+    return 0;
+}
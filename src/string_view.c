@@ -0,0 +1,335 @@
+#include <stdlib.h>
+#include <string.h>
+#include <sea-turtle.h>
+#include <seagrass.h>
+
+#include "private/hash.h"
+#include "private/string.h"
+#include "private/utf8.h"
+
+#ifdef TEST
+#include <test/cmocka.h>
+#endif
+
+int sea_turtle_string_view_init(struct sea_turtle_string_view *const object,
+                                const char *const char_ptr,
+                                const size_t size,
+                                size_t *const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL;
+    }
+    if (!char_ptr) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_CHAR_PTR_IS_NULL;
+    }
+    if (!size) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_SIZE_IS_ZERO;
+    }
+    size_t length;
+    uintmax_t count;
+    int error;
+    if ((error = sea_turtle_utf8_validate((const uint8_t *) char_ptr, size,
+                                          &length, &count))) {
+        seagrass_required_true(
+                SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_MALFORMED == error);
+        return SEA_TURTLE_STRING_VIEW_ERROR_CHAR_PTR_IS_MALFORMED;
+    }
+    *object = (struct sea_turtle_string_view) {
+            .data = (const uint8_t *) char_ptr,
+            .size = length,
+            .count = count
+    };
+    if (out) {
+        *out = length;
+    }
+    return 0;
+}
+
+int sea_turtle_string_view_init_string(
+        struct sea_turtle_string_view *const object,
+        const struct sea_turtle_string *const string) {
+    if (!object) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL;
+    }
+    if (!string) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_STRING_IS_NULL;
+    }
+    *object = (struct sea_turtle_string_view) {
+            .data = sea_turtle_string_bytes(string),
+            .size = string->size ? string->size - 1 : 0,
+            .count = sea_turtle_string_count_of(string)
+    };
+    return 0;
+}
+
+/* byte offset of the code point at index */
+static size_t sea_turtle_string_view_offset(
+        const struct sea_turtle_string_view *const object,
+        const uintmax_t index) {
+    if (object->size == object->count) {
+        return index;
+    }
+    size_t i = 0;
+    for (uintmax_t c = 0; c < index; c++) {
+        const uint8_t byte = object->data[i];
+        i += byte < 0x80 ? 1 : byte >= 0xF0 ? 4 : byte >= 0xE0 ? 3 : 2;
+    }
+    return i;
+}
+
+int sea_turtle_string_view_substring(
+        const struct sea_turtle_string_view *const object,
+        const uintmax_t index,
+        const uintmax_t count,
+        struct sea_turtle_string_view *const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_OUT_IS_NULL;
+    }
+    if (index > object->count) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_INDEX_IS_OUT_OF_BOUNDS;
+    }
+    if (count > object->count - index) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_COUNT_IS_OUT_OF_BOUNDS;
+    }
+    const size_t begin = sea_turtle_string_view_offset(object, index);
+    const struct sea_turtle_string_view rest = {
+            .data = object->data + begin,
+            .size = object->size - begin,
+            .count = object->count - index
+    };
+    *out = (struct sea_turtle_string_view) {
+            .data = rest.data,
+            .size = sea_turtle_string_view_offset(&rest, count),
+            .count = count
+    };
+    return 0;
+}
+
+int sea_turtle_string_view_to_string(
+        const struct sea_turtle_string_view *const object,
+        struct sea_turtle_string *const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_OUT_IS_NULL;
+    }
+    *out = (struct sea_turtle_string) {0};
+    if (!object->size) {
+        return 0;
+    }
+    /* add 1 to accommodate the NULL termination char */
+    if (SIZE_MAX == object->size
+        || sea_turtle_string_set_size(out, 1 + object->size)) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_MEMORY_ALLOCATION_FAILED;
+    }
+    uint8_t *const bytes = sea_turtle_string_bytes(out);
+    memcpy(bytes, object->data, object->size);
+    sea_turtle_string_set_count(out, object->count);
+    return 0;
+}
+
+int sea_turtle_string_view_count(
+        const struct sea_turtle_string_view *const object,
+        uintmax_t *const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_OUT_IS_NULL;
+    }
+    *out = object->count;
+    return 0;
+}
+
+int sea_turtle_string_view_compare(
+        const struct sea_turtle_string_view *const object,
+        const struct sea_turtle_string_view *const other) {
+    seagrass_required_true(object || other);
+    if (!other) {
+        return (-1);
+    }
+    if (!object) {
+        return 1;
+    }
+    int result = seagrass_uintmax_t_compare(object->size, other->size);
+    if (result) {
+        return result;
+    }
+    if (!object->size || object->data == other->data) {
+        return 0;
+    }
+    result = memcmp(object->data, other->data, object->size);
+    if (result < 0) {
+        return (-1);
+    } else if (result > 0) {
+        return 1;
+    }
+    return 0;
+}
+
+int sea_turtle_string_view_hash(
+        const struct sea_turtle_string_view *const object,
+        uintmax_t *const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_OUT_IS_NULL;
+    }
+    *out = sea_turtle_hash(object->data, object->size);
+    return 0;
+}
+
+int sea_turtle_string_view_first(
+        const struct sea_turtle_string_view *const object,
+        const uint8_t **const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_OUT_IS_NULL;
+    }
+    if (!object->count) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_VIEW_IS_EMPTY;
+    }
+    *out = object->data;
+    return 0;
+}
+
+int sea_turtle_string_view_last(
+        const struct sea_turtle_string_view *const object,
+        const uint8_t **const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_OUT_IS_NULL;
+    }
+    if (!object->count) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_VIEW_IS_EMPTY;
+    }
+    const uint8_t *at = object->data + object->size - 1;
+    for (; (*at & 0xC0) == 0x80; at--);
+    *out = at;
+    return 0;
+}
+
+int sea_turtle_string_view_next(
+        const struct sea_turtle_string_view *const object,
+        const uint8_t *const at,
+        const uint8_t **const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL;
+    }
+    if (!at) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_OUT_IS_NULL;
+    }
+    /* the byte past the end may not be readable */
+    const uint8_t *const end = object->data + object->size;
+    if (at < object->data || end <= at) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_OUT_OF_BOUNDS;
+    }
+    const uint8_t byte = *at;
+    if ((byte & 0xF8) == 0xF0) {
+        *out = 4 + at;
+    } else if ((byte & 0xF0) == 0xE0) {
+        *out = 3 + at;
+    } else if ((byte & 0xC0) == 0xC0) {
+        *out = 2 + at;
+    } else if (!(byte & 0x80)) {
+        *out = 1 + at;
+    } else {
+        return SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_INVALID;
+    }
+    return end <= *out
+           ? SEA_TURTLE_STRING_VIEW_ERROR_END_OF_SEQUENCE
+           : 0;
+}
+
+int sea_turtle_string_view_prev(
+        const struct sea_turtle_string_view *const object,
+        const uint8_t *const at,
+        const uint8_t **const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL;
+    }
+    if (!at) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_OUT_IS_NULL;
+    }
+    const uint8_t *const data = object->data;
+    if (at < data || data + object->size <= at) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_OUT_OF_BOUNDS;
+    }
+    if ((*at & 0xC0) == 0x80) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_INVALID;
+    }
+    if (at == data) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_END_OF_SEQUENCE;
+    }
+    const uint8_t *prev = at - 1;
+    size_t i = 4;
+    for (; prev > data && i && (*prev & 0xC0) == 0x80; i--, prev--);
+    if (!i || (*prev & 0xC0) == 0x80) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_INVALID;
+    }
+    *out = prev;
+    return 0;
+}
+
+int sea_turtle_string_view_code_point(
+        const struct sea_turtle_string_view *const object,
+        const uint8_t *const at,
+        uint32_t *const out) {
+    if (!object) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL;
+    }
+    if (!at) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_NULL;
+    }
+    if (!out) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_OUT_IS_NULL;
+    }
+    const uint8_t *const end = object->data + object->size;
+    if (at < object->data || end <= at) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_OUT_OF_BOUNDS;
+    }
+    size_t i;
+    uint8_t byte = *at;
+    uint32_t code_point;
+    if ((byte & 0xF8) == 0xF0) {
+        i = 3;
+        code_point = byte & 0x07;
+    } else if ((byte & 0xF0) == 0xE0) {
+        i = 2;
+        code_point = byte & 0x0F;
+    } else if ((byte & 0xE0) == 0xC0) {
+        i = 1;
+        code_point = byte & 0x1F;
+    } else if (!(byte & 0x80)) {
+        i = 0;
+        code_point = byte;
+    } else {
+        return SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_INVALID;
+    }
+    if ((size_t) (end - at) <= i) {
+        return SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_INVALID;
+    }
+    for (size_t o = 1; o <= i; o++) {
+        byte = at[o];
+        if ((byte & 0xC0) != 0x80) {
+            return SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_INVALID;
+        }
+        code_point = (code_point << 6) | (byte & 0x3F);
+    }
+    *out = code_point;
+    return 0;
+}
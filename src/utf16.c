@@ -0,0 +1,384 @@
+#include <string.h>
+#include <pthread.h>
+#include <sea-turtle.h>
+#include <seagrass.h>
+
+#include "private/utf16.h"
+
+#if defined(SEA_TURTLE_UTF16_X86)
+#include <immintrin.h>
+#endif
+
+#ifdef TEST
+#include <test/cmocka.h>
+#endif
+
+static inline uint16_t sea_turtle_utf16_unit(const uint8_t *const at,
+                                             const bool big) {
+    return big ? at[0] << 8 | at[1] : at[1] << 8 | at[0];
+}
+
+static inline void sea_turtle_utf16_put(uint8_t *const at,
+                                        const uint16_t unit,
+                                        const bool big) {
+    at[big ? 0 : 1] = unit >> 8;
+    at[big ? 1 : 0] = unit & 0xFF;
+}
+
+/* mask of the bits, in memory order, that are clear for 4 ASCII units */
+static inline uint64_t sea_turtle_utf16_ascii_mask(const bool big) {
+    static const uint8_t little_endian[8] = {
+            0x80, 0xFF, 0x80, 0xFF, 0x80, 0xFF, 0x80, 0xFF
+    };
+    static const uint8_t big_endian[8] = {
+            0xFF, 0x80, 0xFF, 0x80, 0xFF, 0x80, 0xFF, 0x80
+    };
+    uint64_t mask;
+    memcpy(&mask, big ? big_endian : little_endian, sizeof(mask));
+    return mask;
+}
+
+int sea_turtle_utf16_measure(const uint8_t *const begin,
+                             const size_t count,
+                             const bool big,
+                             size_t *const size,
+                             uintmax_t *const code_points) {
+    const uint64_t mask = sea_turtle_utf16_ascii_mask(big);
+    /* low 7 bits of every unit and the bit set when adding them to a
+     * non-zero unit */
+    const uint64_t low = ~mask;
+    const uint64_t carry = low << 1 & UINT64_C(0x8080808080808080);
+    size_t s = 0;
+    uintmax_t c = 0;
+    size_t i = 0;
+    while (i < count) {
+        /* four non-NULL ASCII units at a time */
+        for (; count - i >= 4; i += 4, s += 4, c += 4) {
+            uint64_t word;
+            memcpy(&word, begin + 2 * i, sizeof(word));
+            if ((word & mask) || (((word & low) + low) & carry) != carry) {
+                break;
+            }
+        }
+        if (i == count) {
+            break;
+        }
+        const uint16_t unit = sea_turtle_utf16_unit(begin + 2 * i, big);
+        i += 1;
+        c += 1;
+        if (!unit) {
+            return SEA_TURTLE_STRING_ERROR_UTF16_IS_MALFORMED;
+        } else if (unit < 0x80) {
+            s += 1;
+        } else if (unit < 0x800) {
+            s += 2;
+        } else if ((unit & 0xF800) != 0xD800) {
+            s += 3;
+        } else if (unit >= 0xDC00 || i == count
+                   || (sea_turtle_utf16_unit(begin + 2 * i, big) & 0xFC00)
+                      != 0xDC00) {
+            return SEA_TURTLE_STRING_ERROR_UTF16_IS_MALFORMED;
+        } else {
+            i += 1;
+            s += 4;
+        }
+    }
+    *size = s;
+    *code_points = c;
+    return 0;
+}
+
+/* transcode the code point starting at unit i returning the next unit */
+static inline size_t sea_turtle_utf16_to_utf8_symbol(
+        const uint8_t *const begin,
+        size_t i,
+        const bool big,
+        uint8_t **const out) {
+    uint8_t *const o = *out;
+    const uint32_t unit = sea_turtle_utf16_unit(begin + 2 * i, big);
+    if (unit < 0x80) {
+        o[0] = unit;
+        *out = o + 1;
+    } else if (unit < 0x800) {
+        o[0] = 0xC0 | unit >> 6;
+        o[1] = 0x80 | (unit & 0x3F);
+        *out = o + 2;
+    } else if ((unit & 0xF800) != 0xD800) {
+        o[0] = 0xE0 | unit >> 12;
+        o[1] = 0x80 | (unit >> 6 & 0x3F);
+        o[2] = 0x80 | (unit & 0x3F);
+        *out = o + 3;
+    } else {
+        i += 1;
+        const uint32_t c = 0x10000 + ((unit - 0xD800) << 10)
+                           + (sea_turtle_utf16_unit(begin + 2 * i, big)
+                              - 0xDC00);
+        o[0] = 0xF0 | c >> 18;
+        o[1] = 0x80 | (c >> 12 & 0x3F);
+        o[2] = 0x80 | (c >> 6 & 0x3F);
+        o[3] = 0x80 | (c & 0x3F);
+        *out = o + 4;
+    }
+    return i + 1;
+}
+
+/* transcode the UTF-8 encoded symbol at i returning the next byte */
+static inline size_t sea_turtle_utf16_from_utf8_symbol(
+        const uint8_t *const begin,
+        const size_t i,
+        const bool big,
+        uint8_t **const out) {
+    const uint8_t *const p = begin + i;
+    const uint8_t byte = p[0];
+    uint8_t *const o = *out;
+    if (byte < 0x80) {
+        sea_turtle_utf16_put(o, byte, big);
+        *out = o + 2;
+        return i + 1;
+    }
+    if (byte < 0xE0) {
+        sea_turtle_utf16_put(o, (byte & 0x1F) << 6 | (p[1] & 0x3F), big);
+        *out = o + 2;
+        return i + 2;
+    }
+    if (byte < 0xF0) {
+        sea_turtle_utf16_put(o, (byte & 0x0F) << 12 | (p[1] & 0x3F) << 6
+                                | (p[2] & 0x3F), big);
+        *out = o + 2;
+        return i + 3;
+    }
+    const uint32_t c = (uint32_t) (byte & 0x07) << 18 | (p[1] & 0x3F) << 12
+                       | (p[2] & 0x3F) << 6 | (p[3] & 0x3F);
+    sea_turtle_utf16_put(o, 0xD800 + ((c - 0x10000) >> 10), big);
+    sea_turtle_utf16_put(o + 2, 0xDC00 + ((c - 0x10000) & 0x3FF), big);
+    *out = o + 4;
+    return i + 4;
+}
+
+void sea_turtle_utf16_to_utf8_scalar(const uint8_t *const begin,
+                                     const size_t count,
+                                     const bool big,
+                                     uint8_t *out) {
+    for (size_t i = 0; i < count;) {
+        i = sea_turtle_utf16_to_utf8_symbol(begin, i, big, &out);
+    }
+}
+
+void sea_turtle_utf16_from_utf8_scalar(const uint8_t *const begin,
+                                       const size_t length,
+                                       const bool big,
+                                       uint8_t *out,
+                                       const size_t count) {
+    const uint8_t *const end = out + 2 * count;
+    for (size_t i = 0; i < length;) {
+        i = sea_turtle_utf16_from_utf8_symbol(begin, i, big, &out);
+    }
+    /* the caller sized the output by the count of code units */
+    seagrass_required_true(out == end);
+}
+
+#if defined(SEA_TURTLE_UTF16_X86)
+/*
+ * Runs of ASCII are transcoded a block at a time. Every code unit or byte
+ * of the block is narrowed or widened before knowing whether the whole
+ * block is ASCII, and only the leading ASCII part is kept, the output being
+ * overwritten from there on by the next symbol. Narrowing always has room
+ * as every code unit left transcodes to at least one byte, widening only
+ * stores a block if as many code units are left to be written.
+ */
+#define SEA_TURTLE_UTF16_SWAP \
+    1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14
+
+__attribute__((target("sse4.2")))
+void sea_turtle_utf16_to_utf8_sse42(const uint8_t *const begin,
+                                    const size_t count,
+                                    const bool big,
+                                    uint8_t *out) {
+    const __m128i swap = _mm_setr_epi8(SEA_TURTLE_UTF16_SWAP);
+    const __m128i ascii = _mm_set1_epi16((short) 0xFF80);
+    const __m128i zero = _mm_setzero_si128();
+    for (size_t i = 0; i < count;) {
+        if (count - i >= 16) {
+            __m128i a = _mm_loadu_si128((const __m128i *) (begin + 2 * i));
+            __m128i b = _mm_loadu_si128(
+                    (const __m128i *) (begin + 2 * i + 16));
+            if (big) {
+                a = _mm_shuffle_epi8(a, swap);
+                b = _mm_shuffle_epi8(b, swap);
+            }
+            _mm_storeu_si128((__m128i *) out, _mm_packus_epi16(a, b));
+            const uint32_t mask = 0xFFFF & ~_mm_movemask_epi8(
+                    _mm_packs_epi16(
+                            _mm_cmpeq_epi16(_mm_and_si128(a, ascii), zero),
+                            _mm_cmpeq_epi16(_mm_and_si128(b, ascii),
+                                            zero)));
+            const size_t n = mask ? __builtin_ctz(mask) : 16;
+            out += n;
+            i += n;
+            if (16 == n) {
+                continue;
+            }
+        }
+        i = sea_turtle_utf16_to_utf8_symbol(begin, i, big, &out);
+    }
+}
+
+__attribute__((target("sse4.2")))
+void sea_turtle_utf16_from_utf8_sse42(const uint8_t *const begin,
+                                      const size_t length,
+                                      const bool big,
+                                      uint8_t *out,
+                                      const size_t count) {
+    const __m128i swap = _mm_setr_epi8(SEA_TURTLE_UTF16_SWAP);
+    /* code units left to be written */
+    size_t left = count;
+    for (size_t i = 0; i < length;) {
+        if (length - i >= 16 && left >= 16) {
+            const __m128i bytes = _mm_loadu_si128(
+                    (const __m128i *) (begin + i));
+            __m128i a = _mm_cvtepu8_epi16(bytes);
+            __m128i b = _mm_cvtepu8_epi16(_mm_srli_si128(bytes, 8));
+            if (big) {
+                a = _mm_shuffle_epi8(a, swap);
+                b = _mm_shuffle_epi8(b, swap);
+            }
+            _mm_storeu_si128((__m128i *) out, a);
+            _mm_storeu_si128((__m128i *) (out + 16), b);
+            const uint32_t mask = _mm_movemask_epi8(bytes);
+            const size_t n = mask ? __builtin_ctz(mask) : 16;
+            out += 2 * n;
+            left -= n;
+            i += n;
+            if (16 == n) {
+                continue;
+            }
+        }
+        uint8_t *const at = out;
+        i = sea_turtle_utf16_from_utf8_symbol(begin, i, big, &out);
+        left -= (out - at) / 2;
+    }
+}
+
+__attribute__((target("avx2")))
+void sea_turtle_utf16_to_utf8_avx2(const uint8_t *const begin,
+                                   const size_t count,
+                                   const bool big,
+                                   uint8_t *out) {
+    const __m256i swap = _mm256_setr_epi8(SEA_TURTLE_UTF16_SWAP,
+                                          SEA_TURTLE_UTF16_SWAP);
+    const __m256i ascii = _mm256_set1_epi16((short) 0xFF80);
+    const __m256i zero = _mm256_setzero_si256();
+    for (size_t i = 0; i < count;) {
+        if (count - i >= 32) {
+            __m256i a = _mm256_loadu_si256(
+                    (const __m256i *) (begin + 2 * i));
+            __m256i b = _mm256_loadu_si256(
+                    (const __m256i *) (begin + 2 * i + 32));
+            if (big) {
+                a = _mm256_shuffle_epi8(a, swap);
+                b = _mm256_shuffle_epi8(b, swap);
+            }
+            /* packing works within each half so the quadwords must be
+             * reordered */
+            _mm256_storeu_si256((__m256i *) out, _mm256_permute4x64_epi64(
+                    _mm256_packus_epi16(a, b), 0xD8));
+            const uint32_t mask = ~(uint32_t) _mm256_movemask_epi8(
+                    _mm256_permute4x64_epi64(_mm256_packs_epi16(
+                            _mm256_cmpeq_epi16(
+                                    _mm256_and_si256(a, ascii), zero),
+                            _mm256_cmpeq_epi16(
+                                    _mm256_and_si256(b, ascii), zero)),
+                                             0xD8));
+            const size_t n = mask ? __builtin_ctz(mask) : 32;
+            out += n;
+            i += n;
+            if (32 == n) {
+                continue;
+            }
+        }
+        i = sea_turtle_utf16_to_utf8_symbol(begin, i, big, &out);
+    }
+}
+
+__attribute__((target("avx2")))
+void sea_turtle_utf16_from_utf8_avx2(const uint8_t *const begin,
+                                     const size_t length,
+                                     const bool big,
+                                     uint8_t *out,
+                                     const size_t count) {
+    const __m256i swap = _mm256_setr_epi8(SEA_TURTLE_UTF16_SWAP,
+                                          SEA_TURTLE_UTF16_SWAP);
+    size_t left = count;
+    for (size_t i = 0; i < length;) {
+        if (length - i >= 32 && left >= 32) {
+            const __m256i bytes = _mm256_loadu_si256(
+                    (const __m256i *) (begin + i));
+            __m256i a = _mm256_cvtepu8_epi16(
+                    _mm256_castsi256_si128(bytes));
+            __m256i b = _mm256_cvtepu8_epi16(
+                    _mm256_extracti128_si256(bytes, 1));
+            if (big) {
+                a = _mm256_shuffle_epi8(a, swap);
+                b = _mm256_shuffle_epi8(b, swap);
+            }
+            _mm256_storeu_si256((__m256i *) out, a);
+            _mm256_storeu_si256((__m256i *) (out + 32), b);
+            const uint32_t mask = (uint32_t) _mm256_movemask_epi8(bytes);
+            const size_t n = mask ? __builtin_ctz(mask) : 32;
+            out += 2 * n;
+            left -= n;
+            i += n;
+            if (32 == n) {
+                continue;
+            }
+        }
+        uint8_t *const at = out;
+        i = sea_turtle_utf16_from_utf8_symbol(begin, i, big, &out);
+        left -= (out - at) / 2;
+    }
+}
+#endif /* defined(SEA_TURTLE_UTF16_X86) */
+
+static void (*sea_turtle_utf16_to_utf8_implementation)(
+        const uint8_t *, size_t, bool, uint8_t *)
+        = sea_turtle_utf16_to_utf8_scalar;
+static void (*sea_turtle_utf16_from_utf8_implementation)(
+        const uint8_t *, size_t, bool, uint8_t *, size_t)
+        = sea_turtle_utf16_from_utf8_scalar;
+static pthread_once_t sea_turtle_utf16_once = PTHREAD_ONCE_INIT;
+
+static void sea_turtle_utf16_select(void) {
+#if defined(SEA_TURTLE_UTF16_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        sea_turtle_utf16_to_utf8_implementation =
+                sea_turtle_utf16_to_utf8_avx2;
+        sea_turtle_utf16_from_utf8_implementation =
+                sea_turtle_utf16_from_utf8_avx2;
+    } else if (__builtin_cpu_supports("sse4.2")) {
+        sea_turtle_utf16_to_utf8_implementation =
+                sea_turtle_utf16_to_utf8_sse42;
+        sea_turtle_utf16_from_utf8_implementation =
+                sea_turtle_utf16_from_utf8_sse42;
+    }
+#endif
+}
+
+void sea_turtle_utf16_to_utf8(const uint8_t *const begin,
+                              const size_t count,
+                              const bool big,
+                              uint8_t *const out) {
+    seagrass_required_true(!pthread_once(&sea_turtle_utf16_once,
+                                         sea_turtle_utf16_select));
+    sea_turtle_utf16_to_utf8_implementation(begin, count, big, out);
+}
+
+void sea_turtle_utf16_from_utf8(const uint8_t *const begin,
+                                const size_t length,
+                                const bool big,
+                                uint8_t *const out,
+                                const size_t count) {
+    seagrass_required_true(!pthread_once(&sea_turtle_utf16_once,
+                                         sea_turtle_utf16_select));
+    sea_turtle_utf16_from_utf8_implementation(begin, length, big, out, count);
+}
@@ -0,0 +1,745 @@
+#include <string.h>
+#include <pthread.h>
+#include <sea-turtle.h>
+#include <seagrass.h>
+
+#include "private/utf8.h"
+
+#if defined(SEA_TURTLE_UTF8_X86)
+#include <immintrin.h>
+#endif
+
+#ifdef TEST
+#include <test/cmocka.h>
+#endif
+
+#define SEA_TURTLE_UTF8_HIGH_BITS UINT64_C(0x8080808080808080)
+
+/* true if all eight bytes are ASCII */
+static inline bool sea_turtle_utf8_is_ascii_word(const uint8_t *const at) {
+    uint64_t word;
+    memcpy(&word, at, sizeof(word));
+    return !(word & SEA_TURTLE_UTF8_HIGH_BITS);
+}
+
+/*
+ * length that the UTF-8 encoded symbol at <b>at</b> announces or 0 if any of
+ * its first <b>remaining</b> bytes is malformed
+ */
+static inline size_t sea_turtle_utf8_symbol_expected(const uint8_t *const at,
+                                                     const size_t remaining) {
+    /* https://www.rfc-editor.org/rfc/rfc3629#section-4 */
+    const uint8_t byte = *at;
+    size_t n;
+    uint8_t lower = 0x80;
+    uint8_t upper = 0xBF;
+    if (byte <= 0x7F) {
+        /* UTF8-1 */
+        return 1;
+    } else if (byte >= 0xC2 && byte <= 0xDF) {
+        /* UTF8-2 */
+        n = 2;
+    } else if (byte == 0xE0) {
+        /* UTF8-3 */
+        n = 3;
+        lower = 0xA0;
+    } else if ((byte >= 0xE1 && byte <= 0xEC)
+               || (byte >= 0xEE && byte <= 0xEF)) {
+        n = 3;
+    } else if (byte == 0xED) {
+        n = 3;
+        upper = 0x9F;
+    } else if (byte == 0xF0) {
+        /* UTF8-4 */
+        n = 4;
+        lower = 0x90;
+    } else if (byte >= 0xF1 && byte <= 0xF3) {
+        n = 4;
+    } else if (byte == 0xF4) {
+        n = 4;
+        upper = 0x8F;
+    } else {
+        return 0;
+    }
+    if (remaining >= 2 && (at[1] < lower || at[1] > upper)) {
+        return 0;
+    }
+    for (size_t o = 2; o < n && o < remaining; o++) {
+        if ((at[o] & 0xC0) != 0x80) {
+            return 0;
+        }
+    }
+    return n;
+}
+
+/* length of the UTF-8 encoded symbol at <b>at</b> or 0 if it is malformed */
+static inline size_t sea_turtle_utf8_symbol_length(const uint8_t *const at,
+                                                   const size_t remaining) {
+    const size_t n = sea_turtle_utf8_symbol_expected(at, remaining);
+    return n <= remaining ? n : 0;
+}
+
+size_t sea_turtle_utf8_incomplete(const uint8_t *const begin,
+                                  const size_t length) {
+    for (size_t t = 1; t < 4 && t <= length; t++) {
+        const uint8_t *const at = begin + length - t;
+        if ((*at & 0xC0) == 0x80) {
+            continue;
+        }
+        return sea_turtle_utf8_symbol_expected(at, t) > t ? t : 0;
+    }
+    return 0;
+}
+
+int sea_turtle_utf8_validate_scalar(const uint8_t *const begin,
+                                    const size_t length,
+                                    uintmax_t *const count) {
+    size_t i = 0;
+    uintmax_t c = 0;
+    while (i < length) {
+        for (; length - i >= sizeof(uint64_t)
+               && sea_turtle_utf8_is_ascii_word(begin + i);
+               i += sizeof(uint64_t), c += sizeof(uint64_t));
+        if (i == length) {
+            break;
+        }
+        const size_t n = sea_turtle_utf8_symbol_length(begin + i, length - i);
+        if (!n) {
+            return SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_MALFORMED;
+        }
+        i += n;
+        c += 1;
+    }
+    *count = c;
+    return 0;
+}
+
+/* decode the UTF-8 encoded symbol at <b>at</b> of a valid sequence */
+static inline uint32_t sea_turtle_utf8_decode_symbol(const uint8_t **const at) {
+    const uint8_t *const p = *at;
+    const uint8_t byte = p[0];
+    if (byte < 0x80) {
+        *at = p + 1;
+        return byte;
+    }
+    if (byte < 0xE0) {
+        *at = p + 2;
+        return (byte & 0x1F) << 6 | (p[1] & 0x3F);
+    }
+    if (byte < 0xF0) {
+        *at = p + 3;
+        return (byte & 0x0F) << 12 | (p[1] & 0x3F) << 6 | (p[2] & 0x3F);
+    }
+    *at = p + 4;
+    return (uint32_t) (byte & 0x07) << 18 | (p[1] & 0x3F) << 12
+           | (p[2] & 0x3F) << 6 | (p[3] & 0x3F);
+}
+
+/* encode a valid code point returning the address past its last byte */
+static inline uint8_t *sea_turtle_utf8_encode_symbol(uint8_t *const out,
+                                                     const uint32_t c) {
+    if (c < 0x80) {
+        out[0] = c;
+        return out + 1;
+    }
+    if (c < 0x800) {
+        out[0] = 0xC0 | c >> 6;
+        out[1] = 0x80 | (c & 0x3F);
+        return out + 2;
+    }
+    if (c < 0x10000) {
+        out[0] = 0xE0 | c >> 12;
+        out[1] = 0x80 | (c >> 6 & 0x3F);
+        out[2] = 0x80 | (c & 0x3F);
+        return out + 3;
+    }
+    out[0] = 0xF0 | c >> 18;
+    out[1] = 0x80 | (c >> 12 & 0x3F);
+    out[2] = 0x80 | (c >> 6 & 0x3F);
+    out[3] = 0x80 | (c & 0x3F);
+    return out + 4;
+}
+
+const uint8_t *sea_turtle_utf8_decode_scalar(const uint8_t *at,
+                                             const uint8_t *const end,
+                                             const size_t count,
+                                             uint32_t *const out) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = sea_turtle_utf8_decode_symbol(&at);
+    }
+    return at;
+}
+
+int sea_turtle_utf8_encoded_size(const uint32_t *const begin,
+                                 const size_t count,
+                                 size_t *const out) {
+    size_t size = 0;
+    bool invalid = false;
+    /* branch free so that it compiles down to vector instructions */
+    for (size_t i = 0; i < count; i++) {
+        const uint32_t c = begin[i];
+        invalid |= !c | (c > 0x10FFFF) | ((c & 0xFFFFF800) == 0xD800);
+        size += 1 + (c >= 0x80) + (c >= 0x800) + (c >= 0x10000);
+    }
+    if (invalid) {
+        return SEA_TURTLE_STRING_ERROR_CODE_POINT_IS_INVALID;
+    }
+    *out = size;
+    return 0;
+}
+
+uint8_t *sea_turtle_utf8_encode_scalar(const uint32_t *const begin,
+                                       const size_t count,
+                                       uint8_t *out) {
+    for (size_t i = 0; i < count; i++) {
+        out = sea_turtle_utf8_encode_symbol(out, begin[i]);
+    }
+    return out;
+}
+
+#if defined(SEA_TURTLE_UTF8_X86)
+/*
+ * Block validation using nibble lookup tables as described by John Keiser and
+ * Daniel Lemire in "Validating UTF-8 In Less Than One Instruction Per Byte".
+ * Every byte is classified by the high nibble of the previous byte, the low
+ * nibble of the previous byte and the high nibble of the byte itself, the
+ * three classifications AND-ed together are non-zero only for an invalid
+ * two byte combination. Third and fourth continuation bytes are checked
+ * separately from the lead byte two and three positions back.
+ */
+#define TOO_SHORT           (1 << 0)
+#define TOO_LONG            (1 << 1)
+#define OVERLONG_3          (1 << 2)
+#define TOO_LARGE           (1 << 3)
+#define SURROGATE           (1 << 4)
+#define OVERLONG_2          (1 << 5)
+#define TOO_LARGE_1000      (1 << 6)
+#define OVERLONG_4          (1 << 6)
+#define TWO_CONTS           (1 << 7)
+#define CARRY               (TOO_SHORT | TOO_LONG | TWO_CONTS)
+
+#define SEA_TURTLE_UTF8_BYTE_1_HIGH \
+    TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, \
+    TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, \
+    TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS, \
+    TOO_SHORT | OVERLONG_2, \
+    TOO_SHORT, \
+    TOO_SHORT | OVERLONG_3 | SURROGATE, \
+    TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4
+
+#define SEA_TURTLE_UTF8_BYTE_1_LOW \
+    CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4, \
+    CARRY | OVERLONG_2, \
+    CARRY, \
+    CARRY, \
+    CARRY | TOO_LARGE, \
+    CARRY | TOO_LARGE | TOO_LARGE_1000, \
+    CARRY | TOO_LARGE | TOO_LARGE_1000, \
+    CARRY | TOO_LARGE | TOO_LARGE_1000, \
+    CARRY | TOO_LARGE | TOO_LARGE_1000, \
+    CARRY | TOO_LARGE | TOO_LARGE_1000, \
+    CARRY | TOO_LARGE | TOO_LARGE_1000, \
+    CARRY | TOO_LARGE | TOO_LARGE_1000, \
+    CARRY | TOO_LARGE | TOO_LARGE_1000, \
+    CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE, \
+    CARRY | TOO_LARGE | TOO_LARGE_1000, \
+    CARRY | TOO_LARGE | TOO_LARGE_1000
+
+#define SEA_TURTLE_UTF8_BYTE_2_HIGH \
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, \
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, \
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 \
+        | OVERLONG_4, \
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE, \
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE, \
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE, \
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT
+
+/* largest byte values that do not start a sequence running past the end */
+#define SEA_TURTLE_UTF8_MAX_VALUE_TAIL \
+    (char) 0xEF, (char) 0xDF, (char) 0xBF
+
+/* bytes greater than this, interpreted as signed, are not continuations */
+#define SEA_TURTLE_UTF8_LAST_CONTINUATION ((char) 0xBF)
+
+__attribute__((target("sse4.2")))
+static inline __m128i sea_turtle_utf8_check_sse42(const __m128i input,
+                                                  const __m128i prev) {
+    const __m128i byte_1_high_table = _mm_setr_epi8(
+            SEA_TURTLE_UTF8_BYTE_1_HIGH);
+    const __m128i byte_1_low_table = _mm_setr_epi8(
+            SEA_TURTLE_UTF8_BYTE_1_LOW);
+    const __m128i byte_2_high_table = _mm_setr_epi8(
+            SEA_TURTLE_UTF8_BYTE_2_HIGH);
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    const __m128i prev1 = _mm_alignr_epi8(input, prev, 15);
+    const __m128i prev2 = _mm_alignr_epi8(input, prev, 14);
+    const __m128i prev3 = _mm_alignr_epi8(input, prev, 13);
+    const __m128i byte_1_high = _mm_shuffle_epi8(
+            byte_1_high_table,
+            _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+    const __m128i byte_1_low = _mm_shuffle_epi8(
+            byte_1_low_table,
+            _mm_and_si128(prev1, nibble));
+    const __m128i byte_2_high = _mm_shuffle_epi8(
+            byte_2_high_table,
+            _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+    const __m128i special = _mm_and_si128(
+            _mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+    const __m128i must_be_continuation = _mm_and_si128(
+            _mm_or_si128(
+                    _mm_subs_epu8(prev2, _mm_set1_epi8(0xE0 - 0x80)),
+                    _mm_subs_epu8(prev3, _mm_set1_epi8(0xF0 - 0x80))),
+            _mm_set1_epi8((char) 0x80));
+    return _mm_xor_si128(must_be_continuation, special);
+}
+
+__attribute__((target("sse4.2")))
+int sea_turtle_utf8_validate_sse42(const uint8_t *const begin,
+                                   const size_t length,
+                                   uintmax_t *const count) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i last_continuation = _mm_set1_epi8(
+            SEA_TURTLE_UTF8_LAST_CONTINUATION);
+    const __m128i max_value = _mm_setr_epi8(
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            SEA_TURTLE_UTF8_MAX_VALUE_TAIL);
+    __m128i prev = zero;
+    __m128i prev_incomplete = zero;
+    __m128i error = zero;
+    size_t i = 0;
+    uintmax_t c = 0;
+    for (; length - i >= sizeof(__m128i); i += sizeof(__m128i)) {
+        const __m128i input = _mm_loadu_si128((const __m128i *) (begin + i));
+        if (!_mm_movemask_epi8(input)) {
+            error = _mm_or_si128(error, prev_incomplete);
+            prev_incomplete = zero;
+            c += sizeof(__m128i);
+        } else {
+            error = _mm_or_si128(error,
+                                 sea_turtle_utf8_check_sse42(input, prev));
+            prev_incomplete = _mm_subs_epu8(input, max_value);
+            c += __builtin_popcount(_mm_movemask_epi8(
+                    _mm_cmpgt_epi8(input, last_continuation)));
+        }
+        prev = input;
+    }
+    if (i < length) {
+        /* last block is padded with NULL bytes */
+        uint8_t block[sizeof(__m128i)] = {0};
+        const size_t n = length - i;
+        memcpy(block, begin + i, n);
+        const __m128i input = _mm_loadu_si128((const __m128i *) block);
+        error = _mm_or_si128(error,
+                             sea_turtle_utf8_check_sse42(input, prev));
+        prev_incomplete = zero;
+        c += __builtin_popcount(_mm_movemask_epi8(
+                _mm_cmpgt_epi8(input, last_continuation))
+                                & ((1u << n) - 1));
+    }
+    error = _mm_or_si128(error, prev_incomplete);
+    if (!_mm_testz_si128(error, error)) {
+        return SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_MALFORMED;
+    }
+    *count = c;
+    return 0;
+}
+
+__attribute__((target("avx2")))
+static inline __m256i sea_turtle_utf8_prev_avx2(const __m256i input,
+                                                const __m256i prev,
+                                                const int n) {
+    const __m256i shifted = _mm256_permute2x128_si256(prev, input, 0x21);
+    switch (n) {
+        case 1:
+            return _mm256_alignr_epi8(input, shifted, 15);
+        case 2:
+            return _mm256_alignr_epi8(input, shifted, 14);
+        default:
+            return _mm256_alignr_epi8(input, shifted, 13);
+    }
+}
+
+__attribute__((target("avx2")))
+static inline __m256i sea_turtle_utf8_check_avx2(const __m256i input,
+                                                 const __m256i prev) {
+    const __m256i byte_1_high_table = _mm256_setr_epi8(
+            SEA_TURTLE_UTF8_BYTE_1_HIGH,
+            SEA_TURTLE_UTF8_BYTE_1_HIGH);
+    const __m256i byte_1_low_table = _mm256_setr_epi8(
+            SEA_TURTLE_UTF8_BYTE_1_LOW,
+            SEA_TURTLE_UTF8_BYTE_1_LOW);
+    const __m256i byte_2_high_table = _mm256_setr_epi8(
+            SEA_TURTLE_UTF8_BYTE_2_HIGH,
+            SEA_TURTLE_UTF8_BYTE_2_HIGH);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i prev1 = sea_turtle_utf8_prev_avx2(input, prev, 1);
+    const __m256i prev2 = sea_turtle_utf8_prev_avx2(input, prev, 2);
+    const __m256i prev3 = sea_turtle_utf8_prev_avx2(input, prev, 3);
+    const __m256i byte_1_high = _mm256_shuffle_epi8(
+            byte_1_high_table,
+            _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+    const __m256i byte_1_low = _mm256_shuffle_epi8(
+            byte_1_low_table,
+            _mm256_and_si256(prev1, nibble));
+    const __m256i byte_2_high = _mm256_shuffle_epi8(
+            byte_2_high_table,
+            _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+    const __m256i special = _mm256_and_si256(
+            _mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+    const __m256i must_be_continuation = _mm256_and_si256(
+            _mm256_or_si256(
+                    _mm256_subs_epu8(prev2, _mm256_set1_epi8(0xE0 - 0x80)),
+                    _mm256_subs_epu8(prev3, _mm256_set1_epi8(0xF0 - 0x80))),
+            _mm256_set1_epi8((char) 0x80));
+    return _mm256_xor_si256(must_be_continuation, special);
+}
+
+__attribute__((target("avx2")))
+int sea_turtle_utf8_validate_avx2(const uint8_t *const begin,
+                                  const size_t length,
+                                  uintmax_t *const count) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i last_continuation = _mm256_set1_epi8(
+            SEA_TURTLE_UTF8_LAST_CONTINUATION);
+    const __m256i max_value = _mm256_setr_epi8(
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            SEA_TURTLE_UTF8_MAX_VALUE_TAIL);
+    __m256i prev = zero;
+    __m256i prev_incomplete = zero;
+    __m256i error = zero;
+    size_t i = 0;
+    uintmax_t c = 0;
+    for (; length - i >= sizeof(__m256i); i += sizeof(__m256i)) {
+        const __m256i input = _mm256_loadu_si256(
+                (const __m256i *) (begin + i));
+        if (!_mm256_movemask_epi8(input)) {
+            error = _mm256_or_si256(error, prev_incomplete);
+            prev_incomplete = zero;
+            c += sizeof(__m256i);
+        } else {
+            error = _mm256_or_si256(error,
+                                    sea_turtle_utf8_check_avx2(input, prev));
+            prev_incomplete = _mm256_subs_epu8(input, max_value);
+            c += __builtin_popcount((unsigned) _mm256_movemask_epi8(
+                    _mm256_cmpgt_epi8(input, last_continuation)));
+        }
+        prev = input;
+    }
+    if (i < length) {
+        /* last block is padded with NULL bytes */
+        uint8_t block[sizeof(__m256i)] = {0};
+        const size_t n = length - i;
+        memcpy(block, begin + i, n);
+        const __m256i input = _mm256_loadu_si256((const __m256i *) block);
+        error = _mm256_or_si256(error,
+                                sea_turtle_utf8_check_avx2(input, prev));
+        prev_incomplete = zero;
+        c += __builtin_popcount((unsigned) _mm256_movemask_epi8(
+                _mm256_cmpgt_epi8(input, last_continuation))
+                                & ((1u << n) - 1));
+    }
+    error = _mm256_or_si256(error, prev_incomplete);
+    if (!_mm256_testz_si256(error, error)) {
+        return SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_MALFORMED;
+    }
+    *count = c;
+    return 0;
+}
+
+static const uint8_t sea_turtle_utf8_max_value_avx512[64] = {
+        [0 ... 60] = 0xFF, SEA_TURTLE_UTF8_MAX_VALUE_TAIL
+};
+
+__attribute__((target("avx512f,avx512bw")))
+static inline __m512i sea_turtle_utf8_check_avx512(const __m512i input,
+                                                   const __m512i prev) {
+    const __m512i byte_1_high_table = _mm512_broadcast_i32x4(_mm_setr_epi8(
+            SEA_TURTLE_UTF8_BYTE_1_HIGH));
+    const __m512i byte_1_low_table = _mm512_broadcast_i32x4(_mm_setr_epi8(
+            SEA_TURTLE_UTF8_BYTE_1_LOW));
+    const __m512i byte_2_high_table = _mm512_broadcast_i32x4(_mm_setr_epi8(
+            SEA_TURTLE_UTF8_BYTE_2_HIGH));
+    const __m512i nibble = _mm512_set1_epi8(0x0F);
+    /* previous 128-bit lane of each lane */
+    const __m512i shifted = _mm512_alignr_epi64(input, prev, 6);
+    const __m512i prev1 = _mm512_alignr_epi8(input, shifted, 15);
+    const __m512i prev2 = _mm512_alignr_epi8(input, shifted, 14);
+    const __m512i prev3 = _mm512_alignr_epi8(input, shifted, 13);
+    const __m512i byte_1_high = _mm512_shuffle_epi8(
+            byte_1_high_table,
+            _mm512_and_si512(_mm512_srli_epi16(prev1, 4), nibble));
+    const __m512i byte_1_low = _mm512_shuffle_epi8(
+            byte_1_low_table,
+            _mm512_and_si512(prev1, nibble));
+    const __m512i byte_2_high = _mm512_shuffle_epi8(
+            byte_2_high_table,
+            _mm512_and_si512(_mm512_srli_epi16(input, 4), nibble));
+    const __m512i special = _mm512_and_si512(
+            _mm512_and_si512(byte_1_high, byte_1_low), byte_2_high);
+    const __m512i must_be_continuation = _mm512_and_si512(
+            _mm512_or_si512(
+                    _mm512_subs_epu8(prev2, _mm512_set1_epi8(0xE0 - 0x80)),
+                    _mm512_subs_epu8(prev3, _mm512_set1_epi8(0xF0 - 0x80))),
+            _mm512_set1_epi8((char) 0x80));
+    return _mm512_xor_si512(must_be_continuation, special);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+int sea_turtle_utf8_validate_avx512(const uint8_t *const begin,
+                                    const size_t length,
+                                    uintmax_t *const count) {
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i last_continuation = _mm512_set1_epi8(
+            SEA_TURTLE_UTF8_LAST_CONTINUATION);
+    const __m512i max_value = _mm512_loadu_si512(
+            sea_turtle_utf8_max_value_avx512);
+    __m512i prev = zero;
+    __m512i prev_incomplete = zero;
+    __m512i error = zero;
+    size_t i = 0;
+    uintmax_t c = 0;
+    for (; length - i >= sizeof(__m512i); i += sizeof(__m512i)) {
+        const __m512i input = _mm512_loadu_si512(begin + i);
+        if (!_mm512_movepi8_mask(input)) {
+            error = _mm512_or_si512(error, prev_incomplete);
+            prev_incomplete = zero;
+            c += sizeof(__m512i);
+        } else {
+            error = _mm512_or_si512(error,
+                                    sea_turtle_utf8_check_avx512(input, prev));
+            prev_incomplete = _mm512_subs_epu8(input, max_value);
+            c += __builtin_popcountll(_mm512_cmpgt_epi8_mask(
+                    input, last_continuation));
+        }
+        prev = input;
+    }
+    if (i < length) {
+        /* masked load pads the last block with NULL bytes */
+        const __mmask64 loaded = (UINT64_C(1) << (length - i)) - 1;
+        const __m512i input = _mm512_maskz_loadu_epi8(loaded, begin + i);
+        error = _mm512_or_si512(error,
+                                sea_turtle_utf8_check_avx512(input, prev));
+        prev_incomplete = zero;
+        c += __builtin_popcountll(_mm512_cmpgt_epi8_mask(
+                input, last_continuation) & loaded);
+    }
+    error = _mm512_or_si512(error, prev_incomplete);
+    if (_mm512_test_epi8_mask(error, error)) {
+        return SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_MALFORMED;
+    }
+    *count = c;
+    return 0;
+}
+/*
+ * Transcoding runs of ASCII a block at a time. Every byte of the block is
+ * widened, or every code point narrowed, before knowing whether the whole
+ * block is ASCII, and only the leading ASCII part is kept, the output being
+ * overwritten from there on by the next symbol. There is always room as
+ * every code point of the block has both an element and at least one byte
+ * left in the output.
+ */
+__attribute__((target("sse4.2")))
+const uint8_t *sea_turtle_utf8_decode_sse42(const uint8_t *at,
+                                            const uint8_t *const end,
+                                            const size_t count,
+                                            uint32_t *const out) {
+    for (size_t i = 0; i < count;) {
+        if (count - i >= 16 && end - at >= 16) {
+            const __m128i bytes = _mm_loadu_si128((const __m128i *) at);
+            __m128i *const to = (__m128i *) (out + i);
+            _mm_storeu_si128(to, _mm_cvtepu8_epi32(bytes));
+            _mm_storeu_si128(to + 1, _mm_cvtepu8_epi32(
+                    _mm_srli_si128(bytes, 4)));
+            _mm_storeu_si128(to + 2, _mm_cvtepu8_epi32(
+                    _mm_srli_si128(bytes, 8)));
+            _mm_storeu_si128(to + 3, _mm_cvtepu8_epi32(
+                    _mm_srli_si128(bytes, 12)));
+            const uint32_t mask = _mm_movemask_epi8(bytes);
+            const size_t ascii = mask ? __builtin_ctz(mask) : 16;
+            at += ascii;
+            i += ascii;
+            if (16 == ascii) {
+                continue;
+            }
+        }
+        out[i++] = sea_turtle_utf8_decode_symbol(&at);
+    }
+    return at;
+}
+
+__attribute__((target("sse4.2")))
+uint8_t *sea_turtle_utf8_encode_sse42(const uint32_t *const begin,
+                                      const size_t count,
+                                      uint8_t *out) {
+    const __m128i limit = _mm_set1_epi32(0x7F);
+    for (size_t i = 0; i < count;) {
+        if (count - i >= 16) {
+            const __m128i *const from = (const __m128i *) (begin + i);
+            const __m128i a = _mm_loadu_si128(from);
+            const __m128i b = _mm_loadu_si128(from + 1);
+            const __m128i c = _mm_loadu_si128(from + 2);
+            const __m128i d = _mm_loadu_si128(from + 3);
+            _mm_storeu_si128((__m128i *) out, _mm_packus_epi16(
+                    _mm_packus_epi32(a, b), _mm_packus_epi32(c, d)));
+            const __m128i wide = _mm_packs_epi16(
+                    _mm_packs_epi32(_mm_cmpgt_epi32(a, limit),
+                                    _mm_cmpgt_epi32(b, limit)),
+                    _mm_packs_epi32(_mm_cmpgt_epi32(c, limit),
+                                    _mm_cmpgt_epi32(d, limit)));
+            const uint32_t mask = _mm_movemask_epi8(wide);
+            const size_t ascii = mask ? __builtin_ctz(mask) : 16;
+            out += ascii;
+            i += ascii;
+            if (16 == ascii) {
+                continue;
+            }
+        }
+        out = sea_turtle_utf8_encode_symbol(out, begin[i++]);
+    }
+    return out;
+}
+
+__attribute__((target("avx2")))
+const uint8_t *sea_turtle_utf8_decode_avx2(const uint8_t *at,
+                                           const uint8_t *const end,
+                                           const size_t count,
+                                           uint32_t *const out) {
+    for (size_t i = 0; i < count;) {
+        if (count - i >= 32 && end - at >= 32) {
+            const __m256i bytes = _mm256_loadu_si256((const __m256i *) at);
+            const __m128i low = _mm256_castsi256_si128(bytes);
+            const __m128i high = _mm256_extracti128_si256(bytes, 1);
+            __m256i *const to = (__m256i *) (out + i);
+            _mm256_storeu_si256(to, _mm256_cvtepu8_epi32(low));
+            _mm256_storeu_si256(to + 1, _mm256_cvtepu8_epi32(
+                    _mm_srli_si128(low, 8)));
+            _mm256_storeu_si256(to + 2, _mm256_cvtepu8_epi32(high));
+            _mm256_storeu_si256(to + 3, _mm256_cvtepu8_epi32(
+                    _mm_srli_si128(high, 8)));
+            const uint32_t mask = (uint32_t) _mm256_movemask_epi8(bytes);
+            const size_t ascii = mask ? __builtin_ctz(mask) : 32;
+            at += ascii;
+            i += ascii;
+            if (32 == ascii) {
+                continue;
+            }
+        }
+        out[i++] = sea_turtle_utf8_decode_symbol(&at);
+    }
+    return at;
+}
+
+__attribute__((target("avx2")))
+uint8_t *sea_turtle_utf8_encode_avx2(const uint32_t *const begin,
+                                     const size_t count,
+                                     uint8_t *out) {
+    const __m256i limit = _mm256_set1_epi32(0x7F);
+    /* packing works within each half so the dwords must be reordered */
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    for (size_t i = 0; i < count;) {
+        if (count - i >= 32) {
+            const __m256i *const from = (const __m256i *) (begin + i);
+            const __m256i a = _mm256_loadu_si256(from);
+            const __m256i b = _mm256_loadu_si256(from + 1);
+            const __m256i c = _mm256_loadu_si256(from + 2);
+            const __m256i d = _mm256_loadu_si256(from + 3);
+            _mm256_storeu_si256((__m256i *) out, _mm256_permutevar8x32_epi32(
+                    _mm256_packus_epi16(_mm256_packus_epi32(a, b),
+                                        _mm256_packus_epi32(c, d)),
+                    order));
+            const __m256i wide = _mm256_permutevar8x32_epi32(
+                    _mm256_packs_epi16(
+                            _mm256_packs_epi32(
+                                    _mm256_cmpgt_epi32(a, limit),
+                                    _mm256_cmpgt_epi32(b, limit)),
+                            _mm256_packs_epi32(
+                                    _mm256_cmpgt_epi32(c, limit),
+                                    _mm256_cmpgt_epi32(d, limit))),
+                    order);
+            const uint32_t mask = (uint32_t) _mm256_movemask_epi8(wide);
+            const size_t ascii = mask ? __builtin_ctz(mask) : 32;
+            out += ascii;
+            i += ascii;
+            if (32 == ascii) {
+                continue;
+            }
+        }
+        out = sea_turtle_utf8_encode_symbol(out, begin[i++]);
+    }
+    return out;
+}
+#endif /* defined(SEA_TURTLE_UTF8_X86) */
+
+static int (*sea_turtle_utf8_validate_implementation)(
+        const uint8_t *, size_t, uintmax_t *)
+        = sea_turtle_utf8_validate_scalar;
+static const uint8_t *(*sea_turtle_utf8_decode_implementation)(
+        const uint8_t *, const uint8_t *, size_t, uint32_t *)
+        = sea_turtle_utf8_decode_scalar;
+static uint8_t *(*sea_turtle_utf8_encode_implementation)(
+        const uint32_t *, size_t, uint8_t *)
+        = sea_turtle_utf8_encode_scalar;
+static pthread_once_t sea_turtle_utf8_once = PTHREAD_ONCE_INIT;
+
+static void sea_turtle_utf8_select(void) {
+#if defined(SEA_TURTLE_UTF8_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512bw")) {
+        sea_turtle_utf8_validate_implementation =
+                sea_turtle_utf8_validate_avx512;
+    } else if (__builtin_cpu_supports("avx2")) {
+        sea_turtle_utf8_validate_implementation =
+                sea_turtle_utf8_validate_avx2;
+    } else if (__builtin_cpu_supports("sse4.2")) {
+        sea_turtle_utf8_validate_implementation =
+                sea_turtle_utf8_validate_sse42;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        sea_turtle_utf8_decode_implementation = sea_turtle_utf8_decode_avx2;
+        sea_turtle_utf8_encode_implementation = sea_turtle_utf8_encode_avx2;
+    } else if (__builtin_cpu_supports("sse4.2")) {
+        sea_turtle_utf8_decode_implementation = sea_turtle_utf8_decode_sse42;
+        sea_turtle_utf8_encode_implementation = sea_turtle_utf8_encode_sse42;
+    }
+#endif
+}
+
+int sea_turtle_utf8_validate(const uint8_t *const begin,
+                             const size_t size,
+                             size_t *const out,
+                             uintmax_t *const count) {
+    seagrass_required_true(!pthread_once(&sea_turtle_utf8_once,
+                                         sea_turtle_utf8_select));
+    /* never read past the NULL byte as what follows may not be readable */
+    const size_t length = strnlen((const char *) begin, size);
+    uintmax_t c;
+    const int error = sea_turtle_utf8_validate_implementation(
+            begin, length, &c);
+    if (error) {
+        return error;
+    }
+    *out = length;
+    if (count) {
+        *count = c;
+    }
+    return 0;
+}
+
+const uint8_t *sea_turtle_utf8_decode(const uint8_t *const begin,
+                                      const uint8_t *const end,
+                                      const size_t count,
+                                      uint32_t *const out) {
+    seagrass_required_true(!pthread_once(&sea_turtle_utf8_once,
+                                         sea_turtle_utf8_select));
+    return sea_turtle_utf8_decode_implementation(begin, end, count, out);
+}
+
+uint8_t *sea_turtle_utf8_encode(const uint32_t *const begin,
+                                const size_t count,
+                                uint8_t *const out) {
+    seagrass_required_true(!pthread_once(&sea_turtle_utf8_once,
+                                         sea_turtle_utf8_select));
+    return sea_turtle_utf8_encode_implementation(begin, count, out);
+}
@@ -0,0 +1,340 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sea-turtle.h>
+
+#include <test/cmocka.h>
+
+#include "private/string.h"
+
+/* allocator that checks the size it is given back for every block */
+struct counting {
+    size_t allocations;
+    size_t deallocations;
+    size_t live;
+    bool fail;
+};
+
+#define HEADER 16
+
+static void *counting_allocate(void *context, const size_t size) {
+    struct counting *const counting = context;
+    if (counting->fail) {
+        return NULL;
+    }
+    uint8_t *const block = malloc(HEADER + size);
+    assert_non_null(block);
+    memcpy(block, &size, sizeof(size));
+    counting->allocations += 1;
+    counting->live += size;
+    return block + HEADER;
+}
+
+static void *counting_reallocate(void *context, void *ptr, const size_t size,
+                                 const size_t new_size) {
+    struct counting *const counting = context;
+    if (counting->fail) {
+        return NULL;
+    }
+    uint8_t *block = (uint8_t *) ptr - HEADER;
+    size_t actual;
+    memcpy(&actual, block, sizeof(actual));
+    assert_int_equal(actual, size);
+    block = realloc(block, HEADER + new_size);
+    assert_non_null(block);
+    memcpy(block, &new_size, sizeof(new_size));
+    counting->live += new_size;
+    counting->live -= size;
+    return block + HEADER;
+}
+
+static void counting_deallocate(void *context, void *ptr, const size_t size) {
+    struct counting *const counting = context;
+    uint8_t *const block = (uint8_t *) ptr - HEADER;
+    size_t actual;
+    memcpy(&actual, block, sizeof(actual));
+    assert_int_equal(actual, size);
+    free(block);
+    counting->deallocations += 1;
+    counting->live -= size;
+}
+
+static struct counting counting;
+
+static const struct sea_turtle_allocator allocator = {
+        .allocate = counting_allocate,
+        .reallocate = counting_reallocate,
+        .deallocate = counting_deallocate,
+        .context = &counting
+};
+
+static const char long_chars[] = u8"a string too long to be stored locally £ह€";
+
+static void begin(void) {
+    counting = (struct counting) {0};
+    assert_int_equal(sea_turtle_allocator_set(&allocator), 0);
+}
+
+/* every block was given back with the size it was allocated with */
+static void end(void) {
+    assert_int_equal(sea_turtle_allocator_set(NULL), 0);
+    assert_int_equal(counting.live, 0);
+    assert_int_equal(counting.allocations, counting.deallocations);
+}
+
+static void check_set_error_on_object_is_invalid(void **state) {
+    struct sea_turtle_allocator invalid = allocator;
+    invalid.reallocate = NULL;
+    assert_int_equal(sea_turtle_allocator_set(&invalid),
+                     SEA_TURTLE_ALLOCATOR_ERROR_OBJECT_IS_INVALID);
+}
+
+static void check_get_error_on_out_is_null(void **state) {
+    assert_int_equal(sea_turtle_allocator_get(NULL),
+                     SEA_TURTLE_ALLOCATOR_ERROR_OUT_IS_NULL);
+}
+
+static void check_set(void **state) {
+    const struct sea_turtle_allocator *out;
+    assert_int_equal(sea_turtle_allocator_get(&out), 0);
+    assert_null(out);
+    assert_int_equal(sea_turtle_allocator_set(&allocator), 0);
+    assert_int_equal(sea_turtle_allocator_get(&out), 0);
+    assert_ptr_equal(out, &allocator);
+    assert_int_equal(sea_turtle_allocator_set(NULL), 0);
+    assert_int_equal(sea_turtle_allocator_get(&out), 0);
+    assert_null(out);
+}
+
+static void *get_allocator(void *arg) {
+    const struct sea_turtle_allocator **const out = arg;
+    assert_int_equal(sea_turtle_allocator_get(out), 0);
+    return NULL;
+}
+
+static void check_set_is_per_thread(void **state) {
+    assert_int_equal(sea_turtle_allocator_set(&allocator), 0);
+    const struct sea_turtle_allocator *out = &allocator;
+    pthread_t thread;
+    assert_int_equal(pthread_create(&thread, NULL, get_allocator, &out), 0);
+    assert_int_equal(pthread_join(thread, NULL), 0);
+    assert_null(out);
+    assert_int_equal(sea_turtle_allocator_set(NULL), 0);
+}
+
+static void check_string(void **state) {
+    begin();
+    struct sea_turtle_string object;
+    assert_int_equal(sea_turtle_string_init(&object, long_chars, SIZE_MAX,
+                                            NULL), 0);
+    assert_int_equal(counting.allocations, 1);
+    assert_int_equal(counting.live,
+                     sizeof(struct sea_turtle_string_buffer) + object.size);
+    struct sea_turtle_string copy;
+    assert_int_equal(sea_turtle_string_init_string(&copy, &object), 0);
+    assert_int_equal(counting.allocations, 2);
+    assert_int_equal(sea_turtle_string_set_size(&object, 100), 0);
+    assert_int_equal(sea_turtle_string_set_size(&object, 30), 0);
+    assert_int_equal(sea_turtle_string_set_size(&object, 3), 0);
+    assert_int_equal(counting.live,
+                     sizeof(struct sea_turtle_string_buffer) + copy.size);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&copy), 0);
+    end();
+}
+
+static void check_string_error_on_memory_allocation_failed(void **state) {
+    begin();
+    counting.fail = true;
+    struct sea_turtle_string object;
+    assert_int_equal(sea_turtle_string_init(&object, long_chars, SIZE_MAX,
+                                            NULL),
+                     SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED);
+    counting.fail = false;
+    end();
+}
+
+static void check_string_shared(void **state) {
+    begin();
+    struct sea_turtle_string object;
+    assert_int_equal(sea_turtle_string_init(&object, long_chars, SIZE_MAX,
+                                            NULL), 0);
+    assert_int_equal(sea_turtle_string_share(&object), 0);
+    struct sea_turtle_string other;
+    assert_int_equal(sea_turtle_string_init_shared(&other, &object,
+                                                   &allocator), 0);
+    /* shared buffers are released to the allocator they came from */
+    assert_int_equal(sea_turtle_allocator_set(NULL), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&other), 0);
+    assert_int_equal(counting.live, 0);
+    end();
+}
+
+static void check_string_index(void **state) {
+    begin();
+    struct sea_turtle_string object;
+    assert_int_equal(sea_turtle_string_init(&object, long_chars, SIZE_MAX,
+                                            NULL), 0);
+    const uint8_t *out;
+    assert_int_equal(sea_turtle_string_at(
+            &object, sea_turtle_string_count_of(&object) - 1, &out), 0);
+    /* the code point index always uses the default allocator */
+    assert_int_equal(counting.allocations, 1);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+    end();
+}
+
+static void check_string_builder(void **state) {
+    begin();
+    struct sea_turtle_string_builder object;
+    assert_int_equal(sea_turtle_string_builder_init(&object), 0);
+    for (size_t i = 0; i < 10; i++) {
+        assert_int_equal(sea_turtle_string_builder_append_char_ptr(
+                &object, long_chars, sizeof(long_chars), NULL), 0);
+    }
+    struct sea_turtle_string out;
+    assert_int_equal(sea_turtle_string_builder_finish(&object, &out), 0);
+    /* the buffer is handed over along with its capacity */
+    assert_int_equal(counting.live,
+                     sizeof(struct sea_turtle_string_buffer)
+                     + sea_turtle_string_buffer_of(&out)->capacity);
+    /* and keeps being resized by the allocator it came from */
+    assert_int_equal(sea_turtle_allocator_set(NULL), 0);
+    assert_int_equal(sea_turtle_string_set_size(&out, 1000), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&out), 0);
+    assert_int_equal(sea_turtle_string_builder_invalidate(&object), 0);
+    end();
+}
+
+static void check_string_arena(void **state) {
+    begin();
+    struct sea_turtle_string_arena object;
+    assert_int_equal(sea_turtle_string_arena_init(&object), 0);
+    const size_t offsets[] = {0, 0};
+    const size_t sizes[] = {sizeof(long_chars), 5};
+    struct sea_turtle_string out[2];
+    assert_int_equal(sea_turtle_string_arena_init_strings(
+            &object, long_chars, offsets, sizes, 2, out), 0);
+    assert_int_equal(counting.allocations, 1);
+    /* blocks are released to the allocator they came from */
+    assert_int_equal(sea_turtle_allocator_set(NULL), 0);
+    assert_int_equal(sea_turtle_string_arena_invalidate(&object), 0);
+    end();
+}
+
+static void check_rope(void **state) {
+    begin();
+    struct sea_turtle_string string;
+    assert_int_equal(sea_turtle_string_init(&string, long_chars, SIZE_MAX,
+                                            NULL), 0);
+    struct sea_turtle_rope object;
+    assert_int_equal(sea_turtle_rope_init_string(&object, &string), 0);
+    for (size_t i = 0; i < 10; i++) {
+        assert_int_equal(sea_turtle_rope_insert(&object, 5, &string), 0);
+    }
+    assert_int_equal(sea_turtle_rope_remove(&object, 3, 100), 0);
+    /* nodes are released to the allocator they came from */
+    assert_int_equal(sea_turtle_allocator_set(NULL), 0);
+    assert_int_equal(sea_turtle_rope_invalidate(&object), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&string), 0);
+    end();
+}
+
+static void check_string_released_to_its_allocator(void **state) {
+    begin();
+    struct sea_turtle_string object;
+    assert_int_equal(sea_turtle_string_init(&object, long_chars, SIZE_MAX,
+                                            NULL), 0);
+    struct sea_turtle_string_dictionary dictionary;
+    assert_int_equal(sea_turtle_string_dictionary_init(&dictionary, &object,
+                                                       1), 0);
+    /* heap buffers remember the allocator they were allocated from */
+    assert_int_equal(sea_turtle_allocator_set(NULL), 0);
+    assert_int_equal(sea_turtle_string_set_size(&object, 1000), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+    assert_int_equal(sea_turtle_string_dictionary_invalidate(&dictionary),
+                     0);
+    end();
+}
+
+static void check_string_pool(void **state) {
+    begin();
+    struct sea_turtle_string_pool object;
+    assert_int_equal(sea_turtle_string_pool_init(&object), 0);
+    struct sea_turtle_string string;
+    assert_int_equal(sea_turtle_string_init(&string, long_chars, SIZE_MAX,
+                                            NULL), 0);
+    const struct sea_turtle_string *out;
+    assert_int_equal(sea_turtle_string_pool_intern(&object, &string, &out),
+                     0);
+    /* interned strings use the default allocator */
+    assert_null(sea_turtle_string_buffer_of(out)->allocator);
+    const struct sea_turtle_allocator *current;
+    assert_int_equal(sea_turtle_allocator_get(&current), 0);
+    assert_ptr_equal(current, &allocator);
+    assert_int_equal(sea_turtle_string_invalidate(&string), 0);
+    /* while the pool itself is released to the allocator it came from */
+    assert_int_equal(sea_turtle_allocator_set(NULL), 0);
+    assert_int_equal(sea_turtle_string_pool_invalidate(&object), 0);
+    end();
+}
+
+static void check_string_map(void **state) {
+    begin();
+    struct sea_turtle_string_map object;
+    assert_int_equal(sea_turtle_string_map_init(&object), 0);
+    struct sea_turtle_string key;
+    assert_int_equal(sea_turtle_string_init(&key, long_chars, SIZE_MAX,
+                                            NULL), 0);
+    assert_int_equal(sea_turtle_string_map_set(&object, &key, NULL), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&key), 0);
+    /* the table is released to the allocator it came from */
+    assert_int_equal(sea_turtle_allocator_set(NULL), 0);
+    assert_int_equal(sea_turtle_string_map_invalidate(&object), 0);
+    end();
+}
+
+static void check_integer(void **state) {
+    begin();
+    struct sea_turtle_integer object;
+    assert_int_equal(sea_turtle_integer_init_char_ptr(
+            &object, "0x123456789abcdef0123456789abcdef"), 0);
+    assert_true(counting.allocations > 0);
+    struct sea_turtle_integer other;
+    assert_int_equal(sea_turtle_integer_init_integer(&other, &object), 0);
+    for (size_t i = 0; i < 10; i++) {
+        assert_int_equal(sea_turtle_integer_multiply(&object, &other), 0);
+    }
+    assert_int_equal(sea_turtle_integer_invalidate(&object), 0);
+    assert_int_equal(sea_turtle_integer_invalidate(&other), 0);
+    end();
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_set_error_on_object_is_invalid),
+            cmocka_unit_test(check_get_error_on_out_is_null),
+            cmocka_unit_test(check_set),
+            cmocka_unit_test(check_set_is_per_thread),
+            cmocka_unit_test(check_string),
+            cmocka_unit_test(
+                    check_string_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_string_shared),
+            cmocka_unit_test(check_string_index),
+            cmocka_unit_test(check_string_builder),
+            cmocka_unit_test(check_string_arena),
+            cmocka_unit_test(check_rope),
+            cmocka_unit_test(check_string_released_to_its_allocator),
+            cmocka_unit_test(check_string_pool),
+            cmocka_unit_test(check_string_map),
+            cmocka_unit_test(check_integer),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
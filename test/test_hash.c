@@ -0,0 +1,167 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <string.h>
+#include <sea-turtle.h>
+
+#include <test/cmocka.h>
+
+#include "private/hash.h"
+
+typedef void (*accumulate_fn)(uint64_t *, const uint8_t *, const uint64_t *,
+                              size_t);
+typedef void (*scramble_fn)(uint64_t *, const uint64_t *);
+
+static void fill(uint8_t *const bytes, const size_t size) {
+    uint64_t state = 0x2545F4914F6CDD1D;
+    for (size_t i = 0; i < size; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        bytes[i] = (uint8_t) state;
+    }
+}
+
+static void check_kernels(void **state) {
+    /* kernels of every implementation the CPU supports */
+    accumulate_fn accumulate[3] = {sea_turtle_hash_accumulate_scalar};
+    scramble_fn scramble[3] = {sea_turtle_hash_scramble_scalar};
+    size_t count = 1;
+#if defined(SEA_TURTLE_HASH_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2")) {
+        accumulate[count] = sea_turtle_hash_accumulate_sse2;
+        scramble[count++] = sea_turtle_hash_scramble_sse2;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        accumulate[count] = sea_turtle_hash_accumulate_avx2;
+        scramble[count++] = sea_turtle_hash_scramble_avx2;
+    }
+#endif
+    uint8_t bytes[SEA_TURTLE_HASH_STRIPES * 8 * SEA_TURTLE_HASH_LANES];
+    fill(bytes, sizeof(bytes));
+    struct sea_turtle_hash_secret secret;
+    sea_turtle_hash_secret_init(&secret, 42);
+    for (size_t stripes = 0; stripes <= SEA_TURTLE_HASH_STRIPES; stripes++) {
+        uint64_t expected[SEA_TURTLE_HASH_LANES];
+        for (size_t i = 0; i < SEA_TURTLE_HASH_LANES; i++) {
+            expected[i] = i * UINT64_C(0x9E3779B97F4A7C15);
+        }
+        sea_turtle_hash_accumulate_scalar(expected, bytes, secret.keys,
+                                          stripes);
+        sea_turtle_hash_scramble_scalar(
+                expected, secret.keys + SEA_TURTLE_HASH_STRIPES);
+        for (size_t k = 1; k < count; k++) {
+            uint64_t acc[SEA_TURTLE_HASH_LANES];
+            for (size_t i = 0; i < SEA_TURTLE_HASH_LANES; i++) {
+                acc[i] = i * UINT64_C(0x9E3779B97F4A7C15);
+            }
+            accumulate[k](acc, bytes, secret.keys, stripes);
+            scramble[k](acc, secret.keys + SEA_TURTLE_HASH_STRIPES);
+            assert_memory_equal(acc, expected, sizeof(acc));
+        }
+    }
+}
+
+static void check_hash_empty(void **state) {
+    assert_int_equal(sea_turtle_hash((const uint8_t *) "", 0), 0);
+    uint64_t out[2] = {1, 1};
+    sea_turtle_hash_128((const uint8_t *) "", 0, out);
+    assert_int_equal(out[0], 0);
+    assert_int_equal(out[1], 0);
+}
+
+static void check_hash_is_deterministic(void **state) {
+    static uint8_t bytes[5000];
+    fill(bytes, sizeof(bytes));
+    static uint8_t copy[sizeof(bytes) + 1];
+    for (size_t length = 1; length <= sizeof(bytes); length += 1 + length / 8) {
+        /* the hash code does not depend on alignment */
+        memcpy(copy + 1, bytes, length);
+        assert_int_equal(sea_turtle_hash(bytes, length),
+                         sea_turtle_hash(copy + 1, length));
+    }
+}
+
+static void check_hash_128(void **state) {
+    static uint8_t bytes[3000];
+    fill(bytes, sizeof(bytes));
+    for (size_t length = 1; length <= sizeof(bytes); length += 1 + length / 8) {
+        uint64_t out[2];
+        sea_turtle_hash_128(bytes, length, out);
+        assert_int_equal(out[0], sea_turtle_hash(bytes, length));
+        assert_int_not_equal(out[0], out[1]);
+    }
+}
+
+static void check_hash_every_byte_matters(void **state) {
+    static uint8_t bytes[2100];
+    fill(bytes, sizeof(bytes));
+    const size_t lengths[] = {
+            1, 3, 4, 8, 15, 16, 17, 31, 32, 33, 64, 255, 256, 257, 1023,
+            1024, 1025, 2048, 2100
+    };
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+        const size_t length = lengths[l];
+        const uint64_t hash = sea_turtle_hash(bytes, length);
+        for (size_t i = 0; i < length; i++) {
+            bytes[i] ^= 1;
+            assert_int_not_equal(sea_turtle_hash(bytes, length), hash);
+            bytes[i] ^= 1;
+        }
+        /* prefixes differ from the whole */
+        assert_int_not_equal(sea_turtle_hash(bytes, length - 1), hash);
+    }
+}
+
+static void check_hash_depends_on_seed(void **state) {
+    static uint8_t bytes[2000];
+    fill(bytes, sizeof(bytes));
+    struct sea_turtle_hash_secret secrets[2];
+    sea_turtle_hash_secret_init(&secrets[0], 1);
+    sea_turtle_hash_secret_init(&secrets[1], 2);
+    for (size_t length = 1; length <= sizeof(bytes); length += 1 + length / 4) {
+        uint64_t high[2];
+        const uint64_t low[2] = {
+                sea_turtle_hash_with_secret(&secrets[0], bytes, length,
+                                            &high[0]),
+                sea_turtle_hash_with_secret(&secrets[1], bytes, length,
+                                            &high[1])
+        };
+        assert_int_not_equal(low[0], low[1]);
+        assert_int_not_equal(high[0], high[1]);
+        /* the same seed gives the same hash code */
+        struct sea_turtle_hash_secret again;
+        sea_turtle_hash_secret_init(&again, 1);
+        assert_int_equal(sea_turtle_hash_with_secret(&again, bytes, length,
+                                                     NULL), low[0]);
+    }
+}
+
+static void check_hash_seed(void **state) {
+    const uint64_t seed = sea_turtle_hash_seed();
+    assert_int_equal(sea_turtle_hash_seed(), seed);
+    struct sea_turtle_hash_secret secret;
+    sea_turtle_hash_secret_init(&secret, seed);
+    const char chars[] = "the process hash is keyed by the seed";
+    assert_int_equal(sea_turtle_hash_with_secret(
+            &secret, (const uint8_t *) chars, sizeof(chars) - 1, NULL),
+                     sea_turtle_hash((const uint8_t *) chars,
+                                     sizeof(chars) - 1));
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_kernels),
+            cmocka_unit_test(check_hash_empty),
+            cmocka_unit_test(check_hash_is_deterministic),
+            cmocka_unit_test(check_hash_128),
+            cmocka_unit_test(check_hash_every_byte_matters),
+            cmocka_unit_test(check_hash_depends_on_seed),
+            cmocka_unit_test(check_hash_seed),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
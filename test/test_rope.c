@@ -0,0 +1,490 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sea-turtle.h>
+#include <seagrass.h>
+
+#include <test/cmocka.h>
+
+#include "private/string.h"
+
+static void assert_rope_equal(const struct sea_turtle_rope *object,
+                              const char *expected) {
+    struct sea_turtle_string string;
+    assert_int_equal(sea_turtle_rope_to_string(object, &string), 0);
+    struct sea_turtle_string other;
+    assert_int_equal(sea_turtle_string_init(&other, expected, SIZE_MAX,
+                                            NULL), 0);
+    assert_int_equal(sea_turtle_string_compare(&string, &other), 0);
+    assert_int_equal(sea_turtle_string_count_of(&string),
+                     sea_turtle_string_count_of(&other));
+    uintmax_t hashes[2];
+    assert_int_equal(sea_turtle_string_hash(&string, &hashes[0]), 0);
+    assert_int_equal(sea_turtle_string_hash(&other, &hashes[1]), 0);
+    assert_int_equal(hashes[0], hashes[1]);
+    uintmax_t count;
+    assert_int_equal(sea_turtle_rope_count(object, &count), 0);
+    assert_int_equal(count, sea_turtle_string_count_of(&other));
+    assert_int_equal(sea_turtle_string_invalidate(&string), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&other), 0);
+}
+
+static void init_rope(struct sea_turtle_rope *object, const char *chars) {
+    struct sea_turtle_string string;
+    assert_int_equal(sea_turtle_string_init(&string, chars, SIZE_MAX,
+                                            NULL), 0);
+    assert_int_equal(sea_turtle_rope_init_string(object, &string), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&string), 0);
+}
+
+static void check_invalidate_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_rope_invalidate(NULL),
+            SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_invalidate(void **state) {
+    struct sea_turtle_rope object = {};
+    assert_int_equal(sea_turtle_rope_invalidate(&object), 0);
+}
+
+static void check_init_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_rope_init(NULL),
+            SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init(void **state) {
+    struct sea_turtle_rope object;
+    assert_int_equal(sea_turtle_rope_init(&object), 0);
+    uintmax_t count;
+    assert_int_equal(sea_turtle_rope_count(&object, &count), 0);
+    assert_int_equal(count, 0);
+    struct sea_turtle_rope_iterator at;
+    assert_int_equal(sea_turtle_rope_first(&object, &at),
+                     SEA_TURTLE_ROPE_ERROR_ROPE_IS_EMPTY);
+    assert_int_equal(sea_turtle_rope_invalidate(&object), 0);
+}
+
+static void check_init_string_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_rope_init_string(NULL, (void *) 1),
+            SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init_string_error_on_string_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_rope_init_string((void *) 1, NULL),
+            SEA_TURTLE_ROPE_ERROR_STRING_IS_NULL);
+}
+
+static void check_init_string_error_on_memory_allocation_failed(
+        void **state) {
+    struct sea_turtle_string string;
+    assert_int_equal(sea_turtle_string_init(&string, u8"🐢🐢", SIZE_MAX,
+                                            NULL), 0);
+    struct sea_turtle_rope object;
+    malloc_is_overridden = true;
+    assert_int_equal(
+            sea_turtle_rope_init_string(&object, &string),
+            SEA_TURTLE_ROPE_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = false;
+    assert_int_equal(sea_turtle_string_invalidate(&string), 0);
+}
+
+static void check_init_string(void **state) {
+    struct sea_turtle_rope object;
+    init_rope(&object, u8"hello 🐢");
+    assert_rope_equal(&object, u8"hello 🐢");
+    assert_int_equal(sea_turtle_rope_invalidate(&object), 0);
+    init_rope(&object, "");
+    assert_rope_equal(&object, "");
+    assert_int_equal(sea_turtle_rope_invalidate(&object), 0);
+}
+
+static char *make_text(const size_t count) {
+    static const char *const symbols[] = {"a", u8"é", u8"€", u8"🐢"};
+    char *const text = malloc(4 * count + 1);
+    assert_non_null(text);
+    char *at = text;
+    for (size_t i = 0; i < count; i++) {
+        const char *const symbol = symbols[(i * 7 + i / 3) % 4];
+        const size_t n = strlen(symbol);
+        memcpy(at, symbol, n);
+        at += n;
+    }
+    *at = 0;
+    return text;
+}
+
+static void check_init_string_large(void **state) {
+    char *const text = make_text(100000);
+    struct sea_turtle_rope object;
+    init_rope(&object, text);
+    assert_rope_equal(&object, text);
+    assert_int_equal(sea_turtle_rope_invalidate(&object), 0);
+    free(text);
+}
+
+static void check_init_string_shared(void **state) {
+    char *const text = make_text(10000);
+    struct sea_turtle_string string;
+    assert_int_equal(sea_turtle_string_init(&string, text, SIZE_MAX,
+                                            NULL), 0);
+    assert_int_equal(sea_turtle_string_share(&string), 0);
+    struct sea_turtle_rope object;
+    /* a shared buffer is referred to rather than copied */
+    malloc_is_overridden = true;
+    assert_int_equal(sea_turtle_rope_init_string(&object, &string),
+                     SEA_TURTLE_ROPE_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = false;
+    assert_int_equal(sea_turtle_rope_init_string(&object, &string), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&string), 0);
+    assert_rope_equal(&object, text);
+    assert_int_equal(sea_turtle_rope_invalidate(&object), 0);
+    free(text);
+}
+
+static void check_to_string_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_rope_to_string(NULL, (void *) 1),
+            SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_to_string_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_rope_to_string((void *) 1, NULL),
+            SEA_TURTLE_ROPE_ERROR_OUT_IS_NULL);
+}
+
+static void check_to_string_error_on_memory_allocation_failed(void **state) {
+    char *const text = make_text(1000);
+    struct sea_turtle_rope object;
+    init_rope(&object, text);
+    struct sea_turtle_string string;
+    malloc_is_overridden = true;
+    assert_int_equal(sea_turtle_rope_to_string(&object, &string),
+                     SEA_TURTLE_ROPE_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = false;
+    assert_int_equal(sea_turtle_rope_invalidate(&object), 0);
+    free(text);
+}
+
+static void check_to_string_without_copy(void **state) {
+    struct sea_turtle_rope object;
+    init_rope(&object, u8"a single leaf spanning a whole buffer 🐢");
+    struct sea_turtle_string string;
+    malloc_is_overridden = true;
+    assert_int_equal(sea_turtle_rope_to_string(&object, &string), 0);
+    malloc_is_overridden = false;
+    assert_int_equal(sea_turtle_string_storage_of(&string),
+                     SEA_TURTLE_STRING_STORAGE_SHARED);
+    assert_int_equal(sea_turtle_string_invalidate(&string), 0);
+    assert_int_equal(sea_turtle_rope_invalidate(&object), 0);
+}
+
+static void check_count_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_rope_count(NULL, (void *) 1),
+            SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_count_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_rope_count((void *) 1, NULL),
+            SEA_TURTLE_ROPE_ERROR_OUT_IS_NULL);
+}
+
+static void check_insert_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_rope_insert(NULL, 0, (void *) 1),
+            SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_insert_error_on_string_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_rope_insert((void *) 1, 0, NULL),
+            SEA_TURTLE_ROPE_ERROR_STRING_IS_NULL);
+}
+
+static void check_insert_error_on_index_is_out_of_bounds(void **state) {
+    struct sea_turtle_rope object;
+    init_rope(&object, u8"🐢");
+    struct sea_turtle_string string = {0};
+    assert_int_equal(sea_turtle_rope_insert(&object, 2, &string),
+                     SEA_TURTLE_ROPE_ERROR_INDEX_IS_OUT_OF_BOUNDS);
+    assert_int_equal(sea_turtle_rope_invalidate(&object), 0);
+}
+
+static void check_insert_error_on_memory_allocation_failed(void **state) {
+    struct sea_turtle_rope object;
+    init_rope(&object, u8"🐢🐢");
+    struct sea_turtle_string string;
+    assert_int_equal(sea_turtle_string_init(&string, "x", SIZE_MAX, NULL),
+                     0);
+    malloc_is_overridden = true;
+    assert_int_equal(sea_turtle_rope_insert(&object, 1, &string),
+                     SEA_TURTLE_ROPE_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = false;
+    assert_rope_equal(&object, u8"🐢🐢");
+    assert_int_equal(sea_turtle_string_invalidate(&string), 0);
+    assert_int_equal(sea_turtle_rope_invalidate(&object), 0);
+}
+
+static void check_insert(void **state) {
+    struct sea_turtle_rope object;
+    assert_int_equal(sea_turtle_rope_init(&object), 0);
+    struct sea_turtle_string string;
+    assert_int_equal(sea_turtle_string_init(&string, u8"🐢", SIZE_MAX,
+                                            NULL), 0);
+    assert_int_equal(sea_turtle_rope_insert(&object, 0, &string), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&string), 0);
+    assert_int_equal(sea_turtle_string_init(&string, u8"ab", SIZE_MAX,
+                                            NULL), 0);
+    assert_int_equal(sea_turtle_rope_insert(&object, 0, &string), 0);
+    assert_int_equal(sea_turtle_rope_insert(&object, 3, &string), 0);
+    assert_int_equal(sea_turtle_rope_insert(&object, 1, &string), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&string), 0);
+    assert_rope_equal(&object, u8"aabb🐢ab");
+    assert_int_equal(sea_turtle_rope_invalidate(&object), 0);
+}
+
+static void check_remove_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_rope_remove(NULL, 0, 0),
+            SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_remove_error_on_index_is_out_of_bounds(void **state) {
+    struct sea_turtle_rope object;
+    init_rope(&object, u8"🐢");
+    assert_int_equal(sea_turtle_rope_remove(&object, 2, 0),
+                     SEA_TURTLE_ROPE_ERROR_INDEX_IS_OUT_OF_BOUNDS);
+    assert_int_equal(sea_turtle_rope_invalidate(&object), 0);
+}
+
+static void check_remove_error_on_count_is_out_of_bounds(void **state) {
+    struct sea_turtle_rope object;
+    init_rope(&object, u8"🐢");
+    assert_int_equal(sea_turtle_rope_remove(&object, 0, 2),
+                     SEA_TURTLE_ROPE_ERROR_COUNT_IS_OUT_OF_BOUNDS);
+    assert_int_equal(sea_turtle_rope_invalidate(&object), 0);
+}
+
+static void check_remove(void **state) {
+    struct sea_turtle_rope object;
+    init_rope(&object, u8"ab🐢cd€");
+    assert_int_equal(sea_turtle_rope_remove(&object, 1, 2), 0);
+    assert_rope_equal(&object, u8"acd€");
+    assert_int_equal(sea_turtle_rope_remove(&object, 3, 1), 0);
+    assert_rope_equal(&object, u8"acd");
+    assert_int_equal(sea_turtle_rope_remove(&object, 0, 3), 0);
+    assert_rope_equal(&object, "");
+    assert_int_equal(sea_turtle_rope_invalidate(&object), 0);
+}
+
+static void check_concat_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_rope_concat(NULL, (void *) 1),
+            SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_concat_error_on_other_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_rope_concat((void *) 1, NULL),
+            SEA_TURTLE_ROPE_ERROR_OTHER_IS_NULL);
+}
+
+static void check_concat(void **state) {
+    char *const text = make_text(5000);
+    struct sea_turtle_rope object;
+    init_rope(&object, text);
+    struct sea_turtle_rope other;
+    init_rope(&other, u8"🐢 tail");
+    assert_int_equal(sea_turtle_rope_concat(&object, &other), 0);
+    uintmax_t count;
+    assert_int_equal(sea_turtle_rope_count(&other, &count), 0);
+    assert_int_equal(count, 0);
+    const size_t length = strlen(text);
+    char *const expected = malloc(length + 16);
+    assert_non_null(expected);
+    memcpy(expected, text, length);
+    strcpy(expected + length, u8"🐢 tail");
+    assert_rope_equal(&object, expected);
+    assert_int_equal(sea_turtle_rope_concat(&object, &object), 0);
+    const size_t size = strlen(expected);
+    char *const twice = malloc(2 * size + 1);
+    assert_non_null(twice);
+    memcpy(twice, expected, size);
+    memcpy(twice + size, expected, size + 1);
+    assert_rope_equal(&object, twice);
+    assert_int_equal(sea_turtle_rope_invalidate(&other), 0);
+    assert_int_equal(sea_turtle_rope_invalidate(&object), 0);
+    free(twice);
+    free(expected);
+    free(text);
+}
+
+static void check_split_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_rope_split(NULL, 0, (void *) 1),
+            SEA_TURTLE_ROPE_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_split_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_rope_split((void *) 1, 0, NULL),
+            SEA_TURTLE_ROPE_ERROR_OUT_IS_NULL);
+}
+
+static void check_split_error_on_index_is_out_of_bounds(void **state) {
+    struct sea_turtle_rope object;
+    init_rope(&object, u8"🐢");
+    struct sea_turtle_rope out;
+    assert_int_equal(sea_turtle_rope_split(&object, 2, &out),
+                     SEA_TURTLE_ROPE_ERROR_INDEX_IS_OUT_OF_BOUNDS);
+    assert_int_equal(sea_turtle_rope_invalidate(&object), 0);
+}
+
+static void check_split(void **state) {
+    struct sea_turtle_rope object;
+    init_rope(&object, u8"sea 🐢 turtle");
+    struct sea_turtle_rope out;
+    assert_int_equal(sea_turtle_rope_split(&object, 5, &out), 0);
+    assert_rope_equal(&object, u8"sea 🐢");
+    assert_rope_equal(&out, u8" turtle");
+    assert_int_equal(sea_turtle_rope_invalidate(&out), 0);
+    assert_int_equal(sea_turtle_rope_invalidate(&object), 0);
+}
+
+static void check_iterate(void **state) {
+    char *const text = make_text(20000);
+    struct sea_turtle_string string;
+    assert_int_equal(sea_turtle_string_init(&string, text, SIZE_MAX,
+                                            NULL), 0);
+    struct sea_turtle_rope object;
+    assert_int_equal(sea_turtle_rope_init_string(&object, &string), 0);
+    struct sea_turtle_rope_iterator at;
+    assert_int_equal(sea_turtle_rope_first(&object, &at), 0);
+    const uint8_t *symbol;
+    assert_int_equal(sea_turtle_string_first(&string, &symbol), 0);
+    uintmax_t index = 0;
+    int error;
+    do {
+        assert_int_equal(at.index, index++);
+        uint32_t expected;
+        uint32_t actual;
+        assert_int_equal(sea_turtle_string_code_point(&string, symbol,
+                                                      &expected), 0);
+        assert_int_equal(sea_turtle_rope_code_point(&object, &at, &actual),
+                         0);
+        assert_int_equal(actual, expected);
+        error = sea_turtle_string_next(&string, symbol, &symbol);
+        assert_int_equal(sea_turtle_rope_next(&object, &at), error);
+    } while (!error);
+    assert_int_equal(index, sea_turtle_string_count_of(&string));
+    assert_int_equal(sea_turtle_rope_at(&object, 12345, &at), 0);
+    assert_int_equal(at.index, 12345);
+    assert_int_equal(sea_turtle_rope_at(
+            &object, sea_turtle_string_count_of(&string), &at),
+                     SEA_TURTLE_ROPE_ERROR_INDEX_IS_OUT_OF_BOUNDS);
+    assert_int_equal(sea_turtle_rope_invalidate(&object), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&string), 0);
+    free(text);
+}
+
+/* byte offset of the code point with index in a valid UTF-8 sequence */
+static size_t offset_of(const char *text, size_t index) {
+    size_t i = 0;
+    for (; index; index -= ((uint8_t) text[++i] & 0xC0) != 0x80);
+    return i;
+}
+
+static void check_edits(void **state) {
+    char *const text = make_text(30000);
+    size_t capacity = 8 * strlen(text);
+    char *const expected = malloc(capacity);
+    assert_non_null(expected);
+    strcpy(expected, text);
+    uintmax_t count = 30000;
+    struct sea_turtle_rope object;
+    init_rope(&object, text);
+    srand(42);
+    for (size_t i = 0; i < 2000; i++) {
+        const uintmax_t index = rand() % (count + 1);
+        const size_t offset = offset_of(expected, index);
+        if (rand() % 2) {
+            char *const value = make_text(1 + rand() % 40);
+            struct sea_turtle_string string;
+            assert_int_equal(sea_turtle_string_init(&string, value,
+                                                    SIZE_MAX, NULL), 0);
+            assert_int_equal(sea_turtle_rope_insert(&object, index, &string),
+                             0);
+            const size_t n = strlen(value);
+            memmove(expected + offset + n, expected + offset,
+                    strlen(expected + offset) + 1);
+            memcpy(expected + offset, value, n);
+            count += sea_turtle_string_count_of(&string);
+            assert_int_equal(sea_turtle_string_invalidate(&string), 0);
+            free(value);
+        } else {
+            const uintmax_t n = rand() % (1 + (count - index) / 64);
+            assert_int_equal(sea_turtle_rope_remove(&object, index, n), 0);
+            const size_t end = offset_of(expected, index + n);
+            memmove(expected + offset, expected + end,
+                    strlen(expected + end) + 1);
+            count -= n;
+        }
+    }
+    assert_rope_equal(&object, expected);
+    assert_int_equal(sea_turtle_rope_invalidate(&object), 0);
+    free(expected);
+    free(text);
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_invalidate_error_on_object_is_null),
+            cmocka_unit_test(check_invalidate),
+            cmocka_unit_test(check_init_error_on_object_is_null),
+            cmocka_unit_test(check_init),
+            cmocka_unit_test(check_init_string_error_on_object_is_null),
+            cmocka_unit_test(check_init_string_error_on_string_is_null),
+            cmocka_unit_test(
+                    check_init_string_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_init_string),
+            cmocka_unit_test(check_init_string_large),
+            cmocka_unit_test(check_init_string_shared),
+            cmocka_unit_test(check_to_string_error_on_object_is_null),
+            cmocka_unit_test(check_to_string_error_on_out_is_null),
+            cmocka_unit_test(
+                    check_to_string_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_to_string_without_copy),
+            cmocka_unit_test(check_count_error_on_object_is_null),
+            cmocka_unit_test(check_count_error_on_out_is_null),
+            cmocka_unit_test(check_insert_error_on_object_is_null),
+            cmocka_unit_test(check_insert_error_on_string_is_null),
+            cmocka_unit_test(check_insert_error_on_index_is_out_of_bounds),
+            cmocka_unit_test(check_insert_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_insert),
+            cmocka_unit_test(check_remove_error_on_object_is_null),
+            cmocka_unit_test(check_remove_error_on_index_is_out_of_bounds),
+            cmocka_unit_test(check_remove_error_on_count_is_out_of_bounds),
+            cmocka_unit_test(check_remove),
+            cmocka_unit_test(check_concat_error_on_object_is_null),
+            cmocka_unit_test(check_concat_error_on_other_is_null),
+            cmocka_unit_test(check_concat),
+            cmocka_unit_test(check_split_error_on_object_is_null),
+            cmocka_unit_test(check_split_error_on_out_is_null),
+            cmocka_unit_test(check_split_error_on_index_is_out_of_bounds),
+            cmocka_unit_test(check_split),
+            cmocka_unit_test(check_iterate),
+            cmocka_unit_test(check_edits),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,164 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <string.h>
+#include <sea-turtle.h>
+
+#include <test/cmocka.h>
+
+#include "private/search.h"
+
+typedef const uint8_t *(*search_fn)(const uint8_t *, size_t,
+                                    const uint8_t *, size_t);
+
+/* forward and backward search of every implementation the CPU supports */
+static size_t implementations(search_fn forward[5], search_fn backward[5]) {
+    size_t i = 0;
+    forward[i] = sea_turtle_search_forward;
+    backward[i++] = sea_turtle_search_backward;
+    forward[i] = sea_turtle_search_forward_scalar;
+    backward[i++] = sea_turtle_search_backward_scalar;
+    forward[i] = sea_turtle_search_forward_two_way;
+    backward[i++] = sea_turtle_search_backward_two_way;
+#if defined(SEA_TURTLE_SEARCH_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.2")) {
+        forward[i] = sea_turtle_search_forward_sse42;
+        backward[i++] = sea_turtle_search_backward_sse42;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        forward[i] = sea_turtle_search_forward_avx2;
+        backward[i++] = sea_turtle_search_backward_avx2;
+    }
+#endif
+    return i;
+}
+
+static const uint8_t *naive(const uint8_t *haystack, const size_t length,
+                            const uint8_t *needle, const size_t size,
+                            const bool reverse) {
+    const uint8_t *found = NULL;
+    for (size_t i = 0; size <= length && i <= length - size; i++) {
+        if (!memcmp(haystack + i, needle, size)) {
+            found = haystack + i;
+            if (!reverse) {
+                break;
+            }
+        }
+    }
+    return found;
+}
+
+static void check_search(void **state) {
+    search_fn forward[5];
+    search_fn backward[5];
+    const size_t count = implementations(forward, backward);
+    const uint8_t *const haystack = (const uint8_t *)
+            u8"the quick 🐢 jumps over the lazy 🐢, the end";
+    const size_t length = strlen((const char *) haystack);
+    const uint8_t *const turtle = (const uint8_t *) u8"🐢";
+    const uint8_t *const the = (const uint8_t *) "the";
+    const uint8_t *const end = (const uint8_t *) "end";
+    const uint8_t *const then = (const uint8_t *) "then";
+    for (size_t i = 0; i < count; i++) {
+        assert_ptr_equal(forward[i](haystack, length, turtle, 4),
+                         haystack + 10);
+        assert_ptr_equal(backward[i](haystack, length, turtle, 4),
+                         haystack + 35);
+        assert_ptr_equal(forward[i](haystack, length, the, 3), haystack);
+        assert_ptr_equal(backward[i](haystack, length, the, 3),
+                         haystack + length - 7);
+        assert_ptr_equal(forward[i](haystack, length, end, 3),
+                         haystack + length - 3);
+        assert_null(forward[i](haystack, length, then, 4));
+        assert_null(backward[i](haystack, length, then, 4));
+        /* needle longer than the haystack */
+        assert_null(forward[i](haystack, 2, haystack, 3));
+        assert_null(backward[i](haystack, 2, haystack, 3));
+        assert_ptr_equal(forward[i](haystack, length, haystack, length),
+                         haystack);
+        assert_ptr_equal(backward[i](haystack, length, haystack, length),
+                         haystack);
+    }
+}
+
+static void check_search_matches_naive(void **state) {
+    search_fn forward[5];
+    search_fn backward[5];
+    const size_t count = implementations(forward, backward);
+    uint8_t haystack[300];
+    uint8_t needle[80];
+    uint32_t seed = 42;
+    for (size_t round = 0; round < 3000; round++) {
+        /* small alphabets produce many partial and periodic matches */
+        const uint8_t letters = 2 + round % 3;
+        const size_t length = (seed = seed * 1103515245 + 12345) % 300;
+        for (size_t i = 0; i < length; i++) {
+            seed = seed * 1103515245 + 12345;
+            haystack[i] = 'a' + (seed >> 16) % letters;
+        }
+        const size_t size = 1 + (seed = seed * 1103515245 + 12345) % 80;
+        const size_t start = length ? (seed >> 16) % length : 0;
+        for (size_t i = 0; i < size; i++) {
+            seed = seed * 1103515245 + 12345;
+            /* mostly needles taken from the haystack so that they occur */
+            needle[i] = start + i < length && (seed >> 8) % 64
+                        ? haystack[start + i]
+                        : 'a' + (seed >> 16) % letters;
+        }
+        const uint8_t *const first = naive(haystack, length, needle, size,
+                                           false);
+        const uint8_t *const last = naive(haystack, length, needle, size,
+                                          true);
+        for (size_t i = 0; i < count; i++) {
+            assert_ptr_equal(forward[i](haystack, length, needle, size),
+                             first);
+            assert_ptr_equal(backward[i](haystack, length, needle, size),
+                             last);
+        }
+    }
+}
+
+static void check_search_periodic(void **state) {
+    search_fn forward[5];
+    search_fn backward[5];
+    const size_t count = implementations(forward, backward);
+    uint8_t haystack[1000];
+    memset(haystack, 'a', sizeof(haystack));
+    uint8_t needle[100];
+    memset(needle, 'a', sizeof(needle));
+    needle[50] = 'b';
+    for (size_t i = 0; i < count; i++) {
+        assert_null(forward[i](haystack, sizeof(haystack), needle,
+                               sizeof(needle)));
+        assert_null(backward[i](haystack, sizeof(haystack), needle,
+                                sizeof(needle)));
+    }
+    haystack[700] = 'b';
+    for (size_t i = 0; i < count; i++) {
+        assert_ptr_equal(forward[i](haystack, sizeof(haystack), needle,
+                                    sizeof(needle)),
+                         haystack + 650);
+        assert_ptr_equal(backward[i](haystack, sizeof(haystack), needle,
+                                     sizeof(needle)),
+                         haystack + 650);
+        assert_ptr_equal(forward[i](haystack, sizeof(haystack), needle,
+                                    50),
+                         haystack);
+        assert_ptr_equal(backward[i](haystack, sizeof(haystack), needle,
+                                     50),
+                         haystack + sizeof(haystack) - 50);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_search),
+            cmocka_unit_test(check_search_matches_naive),
+            cmocka_unit_test(check_search_periodic),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -3,11 +3,19 @@
 #include <stdint.h>
 #include <setjmp.h>
 #include <cmocka.h>
+#include <stdlib.h>
 #include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include <unistd.h>
 #include <sea-turtle.h>
+#include <seagrass.h>
 
 #include <test/cmocka.h>
 
+#include "private/hash.h"
+#include "private/string.h"
+
 static void check_invalidate_error_on_object_is_null(void **state) {
     assert_int_equal(
             sea_turtle_string_invalidate(NULL),
@@ -70,7 +78,7 @@ static void check_init_error_on_char_ptr_is_malformed(void **state) {
 static void check_init_error_on_memory_allocation_failed(void **state) {
     struct sea_turtle_string object;
     size_t out;
-    const char chars[] = u8"hold my beer!🍺";
+    const char chars[] = u8"hold my beer! this one is too long to be local 🍺";
     malloc_is_overridden = calloc_is_overridden = realloc_is_overridden =
             posix_memalign_is_overridden = true;
     assert_int_equal(sea_turtle_string_init(&object,
@@ -89,13 +97,127 @@ static void check_init(void **state) {
                                             chars,
                                             sizeof(chars),
                                             NULL), 0);
-    assert_non_null(object.data);
-    assert_memory_equal(object.data, chars, sizeof(chars));
+    assert_non_null(sea_turtle_string_bytes(&object));
+    assert_memory_equal(sea_turtle_string_bytes(&object), chars, sizeof(chars));
+    assert_int_equal(object.size, sizeof(chars));
+    assert_int_equal(sea_turtle_string_count_of(&object), 13);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_init_local(void **state) {
+    struct sea_turtle_string object;
+    const char chars[] = u8"short 🐢";
+    static_assert(sizeof(chars) <= SEA_TURTLE_STRING_LOCAL_SIZE,
+                  "must fit into the local buffer");
+    malloc_is_overridden = calloc_is_overridden = realloc_is_overridden =
+            posix_memalign_is_overridden = true;
+    assert_int_equal(sea_turtle_string_init(&object,
+                                            chars,
+                                            sizeof(chars),
+                                            NULL), 0);
+    malloc_is_overridden = calloc_is_overridden = realloc_is_overridden =
+            posix_memalign_is_overridden = false;
+    assert_int_equal(sea_turtle_string_storage_of(&object),
+                     SEA_TURTLE_STRING_STORAGE_LOCAL);
+    assert_memory_equal(object.local, chars, sizeof(chars));
     assert_int_equal(object.size, sizeof(chars));
-    assert_int_equal(object.count, 13);
+    assert_int_equal(sea_turtle_string_count_of(&object), 7);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_init_heap(void **state) {
+    struct sea_turtle_string object;
+    const char chars[] = u8"this string is too long to be stored locally";
+    static_assert(sizeof(chars) > SEA_TURTLE_STRING_LOCAL_SIZE,
+                  "must not fit into the local buffer");
+    assert_int_equal(sea_turtle_string_init(&object,
+                                            chars,
+                                            sizeof(chars),
+                                            NULL), 0);
+    assert_int_equal(sea_turtle_string_storage_of(&object),
+                     SEA_TURTLE_STRING_STORAGE_HEAP);
+    assert_memory_equal(sea_turtle_string_bytes(&object), chars, sizeof(chars));
+    struct sea_turtle_string copy;
+    assert_int_equal(sea_turtle_string_init_string(&copy, &object), 0);
+    assert_int_equal(sea_turtle_string_storage_of(&copy),
+                     SEA_TURTLE_STRING_STORAGE_HEAP);
+    assert_ptr_not_equal(sea_turtle_string_bytes(&copy), sea_turtle_string_bytes(&object));
+    assert_memory_equal(sea_turtle_string_bytes(&copy), chars, sizeof(chars));
+    assert_int_equal(sea_turtle_string_invalidate(&copy), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_set_size(void **state) {
+    struct sea_turtle_string object = {0};
+    assert_int_equal(sea_turtle_string_set_size(&object, 4), 0);
+    assert_int_equal(sea_turtle_string_storage_of(&object),
+                     SEA_TURTLE_STRING_STORAGE_LOCAL);
+    memcpy(sea_turtle_string_bytes(&object), "abc", 3);
+    assert_int_equal(sea_turtle_string_set_size(
+            &object, 1 + SEA_TURTLE_STRING_LOCAL_SIZE), 0);
+    assert_int_equal(sea_turtle_string_storage_of(&object),
+                     SEA_TURTLE_STRING_STORAGE_HEAP);
+    assert_memory_equal(sea_turtle_string_bytes(&object), "abc", 4);
+    assert_int_equal(sea_turtle_string_bytes(&object)[SEA_TURTLE_STRING_LOCAL_SIZE], 0);
+    assert_int_equal(sea_turtle_string_set_size(&object, 3), 0);
+    assert_int_equal(sea_turtle_string_storage_of(&object),
+                     SEA_TURTLE_STRING_STORAGE_LOCAL);
+    assert_memory_equal(sea_turtle_string_bytes(&object), "ab", 3);
     assert_int_equal(sea_turtle_string_invalidate(&object), 0);
 }
 
+static void check_local_after_copy(void **state) {
+    struct sea_turtle_string objects[2];
+    const char chars[] = u8"_😇=";
+    assert_int_equal(sea_turtle_string_init(&objects[0],
+                                            chars,
+                                            sizeof(chars),
+                                            NULL), 0);
+    /* the copy holds its own bytes and no pointer into objects[0] */
+    objects[1] = objects[0];
+    const uint8_t *at;
+    assert_int_equal(sea_turtle_string_first(&objects[1], &at), 0);
+    assert_ptr_equal(objects[1].local, at);
+    assert_int_equal(sea_turtle_string_next(&objects[1], at, &at), 0);
+    uint32_t code_point;
+    assert_int_equal(sea_turtle_string_code_point(&objects[1], at,
+                                                  &code_point), 0);
+    assert_int_equal(code_point, 0x1F607);
+    assert_int_equal(sea_turtle_string_last(&objects[1], &at), 0);
+    assert_int_equal('=', *at);
+    assert_int_equal(sea_turtle_string_prev(&objects[1], at, &at), 0);
+    assert_ptr_equal(objects[1].local + 1, at);
+    assert_int_equal(sea_turtle_string_compare(&objects[0], &objects[1]), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&objects[1]), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&objects[0]), 0);
+}
+
+static void check_init_hash(void **state) {
+    const char *chars[] = {
+            u8"a",
+            u8"🦖 t-rex",
+            u8"a rather long string of ASCII chars to cover whole words",
+            u8"$£ह€한🐉 mixed with ASCII $£ह€한🐉 and more ASCII after it",
+    };
+    for (size_t i = 0; i < sizeof(chars) / sizeof(chars[0]); i++) {
+        struct sea_turtle_string object;
+        assert_int_equal(sea_turtle_string_init(&object,
+                                                chars[i],
+                                                SIZE_MAX,
+                                                NULL), 0);
+        /* the hash code is only computed when asked for */
+        assert_int_equal(sea_turtle_string_cached_hash(&object), 0);
+        uintmax_t hash;
+        assert_int_equal(sea_turtle_string_hash(&object, &hash), 0);
+        assert_int_equal(hash, sea_turtle_hash((const uint8_t *) chars[i],
+                                               strlen(chars[i])));
+        /* local strings have no room to keep the hash code */
+        assert_int_equal(sea_turtle_string_cached_hash(&object),
+                         sea_turtle_string_is_local(&object) ? 0 : hash);
+        assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+    }
+}
+
 static void check_init_empty_char_sequence(void **state) {
     const char chars[] = u8"";
     struct sea_turtle_string object;
@@ -106,8 +228,191 @@ static void check_init_empty_char_sequence(void **state) {
                                             &out), 0);
     assert_null(object.data);
     assert_int_equal(object.size, 0);
-    assert_int_equal(object.count, 0);
+    assert_int_equal(sea_turtle_string_count_of(&object), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+/* anonymous temporary file holding size bytes */
+static int make_file(const void *const bytes, const size_t size) {
+    char path[] = "/tmp/sea-turtle-XXXXXX";
+    const int fd = mkstemp(path);
+    assert_true(fd >= 0);
+    assert_int_equal(unlink(path), 0);
+    assert_int_equal(write(fd, bytes, size), size);
+    return fd;
+}
+
+static void check_init_file_error_on_object_is_null(void **state) {
+    assert_int_equal(sea_turtle_string_init_file(NULL, 0, 0, 1, NULL),
+                     SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init_file_error_on_size_is_zero(void **state) {
+    assert_int_equal(sea_turtle_string_init_file((void *) 1, 0, 0, 0, NULL),
+                     SEA_TURTLE_STRING_ERROR_SIZE_IS_ZERO);
+}
+
+static void check_init_file_error_on_fd_is_invalid(void **state) {
+    struct sea_turtle_string object;
+    assert_int_equal(sea_turtle_string_init_file(&object, -1, 0, 1, NULL),
+                     SEA_TURTLE_STRING_ERROR_FD_IS_INVALID);
+    int fds[2];
+    assert_int_equal(pipe(fds), 0);
+    assert_int_equal(sea_turtle_string_init_file(&object, fds[0], 0, 1,
+                                                 NULL),
+                     SEA_TURTLE_STRING_ERROR_FD_IS_INVALID);
+    assert_int_equal(close(fds[0]), 0);
+    assert_int_equal(close(fds[1]), 0);
+}
+
+static void check_init_file_error_on_offset_is_out_of_bounds(void **state) {
+    const int fd = make_file("abc", 3);
+    struct sea_turtle_string object;
+    assert_int_equal(sea_turtle_string_init_file(&object, fd, 4, 1, NULL),
+                     SEA_TURTLE_STRING_ERROR_OFFSET_IS_OUT_OF_BOUNDS);
+    assert_int_equal(close(fd), 0);
+}
+
+static void check_init_file_error_on_char_ptr_is_malformed(void **state) {
+    char chars[5000];
+    memset(chars, 'a', sizeof(chars));
+    chars[4500] = (char) 0xC0;
+    const int fd = make_file(chars, sizeof(chars));
+    struct sea_turtle_string object;
+    assert_int_equal(sea_turtle_string_init_file(&object, fd, 0, SIZE_MAX,
+                                                 NULL),
+                     SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_MALFORMED);
+    assert_null(object.data);
+    /* the malformed byte is outside of the region */
+    size_t out;
+    assert_int_equal(sea_turtle_string_init_file(&object, fd, 0, 4500,
+                                                 &out), 0);
+    assert_int_equal(out, 4500);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+    assert_int_equal(close(fd), 0);
+}
+
+static void check_init_file(void **state) {
+    const char chars[] = u8"a file long enough to be mapped 🐢 £ह€";
+    const int fd = make_file(chars, sizeof(chars) - 1);
+    struct sea_turtle_string object;
+    size_t out;
+    assert_int_equal(sea_turtle_string_init_file(&object, fd, 0, SIZE_MAX,
+                                                 &out), 0);
+    /* the file descriptor is no longer needed */
+    assert_int_equal(close(fd), 0);
+    assert_int_equal(out, sizeof(chars) - 1);
+    assert_int_equal(sea_turtle_string_storage_of(&object),
+                     SEA_TURTLE_STRING_STORAGE_MAPPED);
+    assert_int_equal(object.size, sizeof(chars));
+    assert_string_equal((const char *) sea_turtle_string_bytes(&object), chars);
+    struct sea_turtle_string other;
+    assert_int_equal(sea_turtle_string_init(&other, chars, sizeof(chars),
+                                            NULL), 0);
+    assert_int_equal(sea_turtle_string_count_of(&object),
+                     sea_turtle_string_count_of(&other));
+    assert_int_equal(sea_turtle_string_compare(&object, &other), 0);
+    uintmax_t hash[2];
+    assert_int_equal(sea_turtle_string_hash(&object, &hash[0]), 0);
+    assert_int_equal(sea_turtle_string_hash(&other, &hash[1]), 0);
+    assert_int_equal(hash[0], hash[1]);
+    const uint8_t *at;
+    assert_int_equal(sea_turtle_string_at(&object, 32, &at), 0);
+    assert_memory_equal(at, u8"🐢", 4);
+    assert_int_equal(sea_turtle_string_invalidate(&other), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_init_file_region(void **state) {
+    static char chars[3 * 4096];
+    for (size_t i = 0; i < sizeof(chars); i++) {
+        chars[i] = (char) ('a' + i % 26);
+    }
+    const int fd = make_file(chars, sizeof(chars));
+    /* regions ending at a page boundary or at the end of the file */
+    const size_t regions[][2] = {
+            {0, 4096}, {0, sizeof(chars)}, {5000, 3000},
+            {4095, 4097}, {7000, SIZE_MAX}, {sizeof(chars) - 30, 30}
+    };
+    for (size_t i = 0; i < sizeof(regions) / sizeof(regions[0]); i++) {
+        const size_t offset = regions[i][0];
+        const size_t length = regions[i][1] < sizeof(chars) - offset
+                              ? regions[i][1]
+                              : sizeof(chars) - offset;
+        struct sea_turtle_string object;
+        assert_int_equal(sea_turtle_string_init_file(
+                &object, fd, offset, regions[i][1], NULL), 0);
+        assert_int_equal(object.size, 1 + length);
+        assert_int_equal(sea_turtle_string_count_of(&object), length);
+        assert_memory_equal(sea_turtle_string_bytes(&object), chars + offset, length);
+        assert_int_equal(sea_turtle_string_bytes(&object)[length], 0);
+        assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+    }
+    /* the file is left as is */
+    char read[sizeof(chars)];
+    assert_int_equal(pread(fd, read, sizeof(read), 0), sizeof(read));
+    assert_memory_equal(read, chars, sizeof(chars));
+    assert_int_equal(close(fd), 0);
+}
+
+static void check_init_file_local(void **state) {
+    const char chars[] = u8"short\0and after the NULL char";
+    const int fd = make_file(chars, sizeof(chars) - 1);
+    struct sea_turtle_string object;
+    size_t out;
+    assert_int_equal(sea_turtle_string_init_file(&object, fd, 0, SIZE_MAX,
+                                                 &out), 0);
+    assert_int_equal(out, 5);
+    assert_int_equal(sea_turtle_string_storage_of(&object),
+                     SEA_TURTLE_STRING_STORAGE_LOCAL);
+    assert_string_equal((const char *) object.local, "short");
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+    /* regions that are empty or start with the NULL char */
+    assert_int_equal(sea_turtle_string_init_file(&object, fd, 5, SIZE_MAX,
+                                                 &out), 0);
+    assert_int_equal(out, 0);
+    assert_null(object.data);
+    assert_int_equal(sea_turtle_string_init_file(&object, fd,
+                                                 sizeof(chars) - 1, SIZE_MAX,
+                                                 &out), 0);
+    assert_int_equal(out, 0);
+    assert_null(object.data);
+    assert_int_equal(close(fd), 0);
+}
+
+static void check_init_file_copy(void **state) {
+    const char chars[] = u8"a file long enough to be mapped 🐢 £ह€";
+    const int fd = make_file(chars, sizeof(chars) - 1);
+    struct sea_turtle_string object;
+    assert_int_equal(sea_turtle_string_init_file(&object, fd, 0, SIZE_MAX,
+                                                 NULL), 0);
+    struct sea_turtle_string copy;
+    assert_int_equal(sea_turtle_string_init_string(&copy, &object), 0);
+    assert_int_equal(sea_turtle_string_storage_of(&copy),
+                     SEA_TURTLE_STRING_STORAGE_HEAP);
+    struct sea_turtle_string shared;
+    assert_int_equal(sea_turtle_string_init_file(&shared, fd, 0, SIZE_MAX,
+                                                 NULL), 0);
+    assert_int_equal(sea_turtle_string_share(&shared), 0);
+    assert_int_equal(sea_turtle_string_storage_of(&shared),
+                     SEA_TURTLE_STRING_STORAGE_SHARED);
+    /* modifying the string copies it out of the mapping */
+    assert_int_equal(sea_turtle_string_set_size(&object, 7), 0);
+    assert_int_equal(sea_turtle_string_storage_of(&object),
+                     SEA_TURTLE_STRING_STORAGE_LOCAL);
+    assert_string_equal((const char *) sea_turtle_string_bytes(&object), "a file");
+    assert_int_equal(sea_turtle_string_init_file(&object, fd, 0, SIZE_MAX,
+                                                 NULL), 0);
+    assert_int_equal(sea_turtle_string_set_size(&object, 100), 0);
+    assert_int_equal(sea_turtle_string_storage_of(&object),
+                     SEA_TURTLE_STRING_STORAGE_HEAP);
+    assert_string_equal((const char *) sea_turtle_string_bytes(&object), chars);
+    assert_string_equal((const char *) sea_turtle_string_bytes(&copy), chars);
+    assert_string_equal((const char *) sea_turtle_string_bytes(&shared), chars);
     assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&copy), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&shared), 0);
+    assert_int_equal(close(fd), 0);
 }
 
 static void check_init_string_error_on_object_is_null(void **state) {
@@ -133,15 +438,186 @@ static void check_init_string(void **state) {
     assert_true(out > 0);
     struct sea_turtle_string object;
     assert_int_equal(sea_turtle_string_init_string(&object, &other), 0);
-    assert_ptr_not_equal(other.data, object.data);
-    assert_memory_equal(other.data, object.data, other.size);
+    assert_int_equal(sea_turtle_string_storage_of(&object),
+                     SEA_TURTLE_STRING_STORAGE_LOCAL);
+    assert_memory_equal(other.local, object.local, other.size);
     assert_int_equal(other.size, object.size);
-    assert_int_equal(other.count, object.count);
-    assert_int_equal(other.hash, object.hash);
+    assert_int_equal(sea_turtle_string_count_of(&other),
+                     sea_turtle_string_count_of(&object));
     assert_int_equal(sea_turtle_string_invalidate(&object), 0);
     assert_int_equal(sea_turtle_string_invalidate(&other), 0);
 }
 
+static void check_is_utf8_sequence_error_on_char_ptr_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_is_utf8_sequence(NULL, 1, (void *) 1, NULL),
+            SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_NULL);
+}
+
+static void check_is_utf8_sequence_error_on_size_is_zero(void **state) {
+    assert_int_equal(
+            sea_turtle_string_is_utf8_sequence((void *) 1, 0, (void *) 1,
+                                               NULL),
+            SEA_TURTLE_STRING_ERROR_SIZE_IS_ZERO);
+}
+
+static void check_is_utf8_sequence_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_is_utf8_sequence((void *) 1, 1, NULL, NULL),
+            SEA_TURTLE_STRING_ERROR_OUT_IS_NULL);
+}
+
+static void check_is_utf8_sequence_error_on_char_ptr_is_malformed(
+        void **state) {
+    const char chars[] = "a long run of ASCII before the bad byte \xC0\xAF";
+    size_t out;
+    assert_int_equal(
+            sea_turtle_string_is_utf8_sequence(chars, sizeof(chars), &out,
+                                               NULL),
+            SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_MALFORMED);
+}
+
+static void check_is_utf8_sequence(void **state) {
+    const char chars[] = u8"sea turtles 🐢🐢🐢 swim in the ocean 🌊 all day";
+    size_t out;
+    uintmax_t count;
+    assert_int_equal(
+            sea_turtle_string_is_utf8_sequence(chars, SIZE_MAX, &out,
+                                               &count), 0);
+    assert_int_equal(out, sizeof(chars) - 1);
+    assert_int_equal(count, 43);
+    assert_int_equal(
+            sea_turtle_string_is_utf8_sequence(chars, 12, &out, &count), 0);
+    assert_int_equal(out, 12);
+    assert_int_equal(count, 12);
+}
+
+static void check_share_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_share(NULL),
+            SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_share_error_on_memory_allocation_failed(void **state) {
+    /* a buffer owned by someone else must be copied to be shared */
+    const char chars[] = u8"this string lives in a buffer owned by an arena";
+    struct sea_turtle_string object = {
+            .data = (uint8_t *) chars,
+            .size = sizeof(chars)
+    };
+    sea_turtle_string_set_storage(&object, SEA_TURTLE_STRING_STORAGE_ARENA);
+    sea_turtle_string_set_count(&object, sizeof(chars) - 1);
+    malloc_is_overridden = true;
+    assert_int_equal(sea_turtle_string_share(&object),
+                     SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = false;
+    assert_int_equal(sea_turtle_string_storage_of(&object),
+                     SEA_TURTLE_STRING_STORAGE_ARENA);
+    assert_ptr_equal(object.data, chars);
+}
+
+static void check_share_heap(void **state) {
+    struct sea_turtle_string object;
+    const char chars[] = u8"this string is long enough to live on the heap";
+    assert_int_equal(sea_turtle_string_init(&object,
+                                            chars,
+                                            sizeof(chars),
+                                            NULL), 0);
+    uint8_t *const data = object.data;
+    /* heap buffers are shared in place */
+    malloc_is_overridden = true;
+    assert_int_equal(sea_turtle_string_share(&object), 0);
+    malloc_is_overridden = false;
+    assert_int_equal(sea_turtle_string_storage_of(&object),
+                     SEA_TURTLE_STRING_STORAGE_SHARED);
+    assert_ptr_equal(object.data, data);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_share_local(void **state) {
+    struct sea_turtle_string object;
+    const char chars[] = u8"local 🐢";
+    assert_int_equal(sea_turtle_string_init(&object,
+                                            chars,
+                                            sizeof(chars),
+                                            NULL), 0);
+    assert_int_equal(sea_turtle_string_share(&object), 0);
+    assert_int_equal(sea_turtle_string_storage_of(&object),
+                     SEA_TURTLE_STRING_STORAGE_LOCAL);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_share(void **state) {
+    struct sea_turtle_string object;
+    const char chars[] = u8"a shared 🐢 string that lives on the heap";
+    assert_int_equal(sea_turtle_string_init(&object,
+                                            chars,
+                                            sizeof(chars),
+                                            NULL), 0);
+    assert_int_equal(sea_turtle_string_share(&object), 0);
+    assert_int_equal(sea_turtle_string_storage_of(&object),
+                     SEA_TURTLE_STRING_STORAGE_SHARED);
+    assert_memory_equal(sea_turtle_string_bytes(&object), chars, sizeof(chars));
+    struct sea_turtle_string copies[3];
+    malloc_is_overridden = true;
+    for (size_t i = 0; i < 3; i++) {
+        assert_int_equal(sea_turtle_string_init_string(&copies[i], &object),
+                         0);
+        assert_ptr_equal(sea_turtle_string_bytes(&copies[i]), sea_turtle_string_bytes(&object));
+        assert_int_equal(sea_turtle_string_count_of(&copies[i]),
+                         sea_turtle_string_count_of(&object));
+        assert_int_equal(copies[i].hash, object.hash);
+    }
+    malloc_is_overridden = false;
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+    assert_memory_equal(sea_turtle_string_bytes(&copies[0]), chars, sizeof(chars));
+    /* copy on write */
+    assert_int_equal(sea_turtle_string_set_size(&copies[1],
+                                                sizeof(chars) + 1), 0);
+    assert_int_equal(sea_turtle_string_storage_of(&copies[1]),
+                     SEA_TURTLE_STRING_STORAGE_HEAP);
+    assert_ptr_not_equal(sea_turtle_string_bytes(&copies[1]), sea_turtle_string_bytes(&copies[0]));
+    assert_memory_equal(sea_turtle_string_bytes(&copies[1]), chars, sizeof(chars));
+    assert_int_equal(sea_turtle_string_set_size(&copies[2], 6), 0);
+    assert_int_equal(sea_turtle_string_storage_of(&copies[2]),
+                     SEA_TURTLE_STRING_STORAGE_LOCAL);
+    assert_memory_equal(sea_turtle_string_bytes(&copies[2]), "a sha", 6);
+    assert_memory_equal(sea_turtle_string_bytes(&copies[0]), chars, sizeof(chars));
+    for (size_t i = 0; i < 3; i++) {
+        assert_int_equal(sea_turtle_string_invalidate(&copies[i]), 0);
+    }
+}
+
+static void *share_concurrently(void *arg) {
+    const struct sea_turtle_string *const object = arg;
+    for (size_t i = 0; i < 10000; i++) {
+        struct sea_turtle_string copy;
+        seagrass_required_true(!sea_turtle_string_init_string(&copy, object));
+        seagrass_required_true(copy.data == object->data);
+        seagrass_required_true(!sea_turtle_string_invalidate(&copy));
+    }
+    return NULL;
+}
+
+static void check_share_concurrently(void **state) {
+    struct sea_turtle_string object;
+    const char chars[] = u8"a shared 🐢 string copied by many threads";
+    assert_int_equal(sea_turtle_string_init(&object,
+                                            chars,
+                                            sizeof(chars),
+                                            NULL), 0);
+    assert_int_equal(sea_turtle_string_share(&object), 0);
+    pthread_t threads[4];
+    for (size_t i = 0; i < 4; i++) {
+        assert_int_equal(pthread_create(&threads[i], NULL,
+                                        share_concurrently, &object), 0);
+    }
+    for (size_t i = 0; i < 4; i++) {
+        assert_int_equal(pthread_join(threads[i], NULL), 0);
+    }
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
 static void check_count_error_on_object_is_null(void **state) {
     assert_int_equal(
             sea_turtle_string_count(NULL, (void *) 1),
@@ -162,7 +638,7 @@ static void check_count(void **state) {
                                             chars,
                                             sizeof(chars),
                                             &out), 0);
-    assert_int_equal(object.count, 1);
+    assert_int_equal(sea_turtle_string_count_of(&object), 1);
     assert_int_equal(sea_turtle_string_invalidate(&object), 0);
 }
 
@@ -196,15 +672,98 @@ static void check_compare(void **state) {
     abort_is_overridden = false;
 }
 
+static void check_hash_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_hash(NULL, (void *) 1),
+            SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_hash_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_hash((void *) 1, NULL),
+            SEA_TURTLE_STRING_ERROR_OUT_IS_NULL);
+}
+
 static void check_hash(void **state) {
+    struct sea_turtle_string object;
+    const char chars[] = u8"🦖 t-rex, the tyrant lizard king";
+    assert_int_equal(sea_turtle_string_init(&object,
+                                            chars,
+                                            sizeof(chars),
+                                            NULL), 0);
+    uintmax_t hash;
+    assert_int_equal(sea_turtle_string_hash(&object, &hash), 0);
+    assert_int_not_equal(hash, 0);
+    /* copies keep the hash code that was already computed */
+    struct sea_turtle_string copy;
+    assert_int_equal(sea_turtle_string_init_string(&copy, &object), 0);
+    assert_int_equal(sea_turtle_string_cached_hash(&copy), hash);
+    assert_int_equal(sea_turtle_string_invalidate(&copy), 0);
+    /* and resizing discards it */
+    assert_int_equal(sea_turtle_string_set_size(&object, 20), 0);
+    assert_int_equal(sea_turtle_string_cached_hash(&object), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+    assert_int_equal(sea_turtle_string_hash(&object, &hash), 0);
+    assert_int_equal(hash, 0);
+}
+
+static void *hash_concurrently(void *string) {
+    uintmax_t *const hash = malloc(sizeof(*hash));
+    assert_non_null(hash);
+    assert_int_equal(sea_turtle_string_hash(string, hash), 0);
+    return hash;
+}
+
+static void check_hash_concurrently(void **state) {
+    struct sea_turtle_string object;
+    const char chars[] = u8"a string hashed by many threads at the same time";
+    assert_int_equal(sea_turtle_string_init(&object,
+                                            chars,
+                                            sizeof(chars),
+                                            NULL), 0);
+    pthread_t threads[8];
+    for (size_t i = 0; i < sizeof(threads) / sizeof(threads[0]); i++) {
+        assert_int_equal(pthread_create(&threads[i], NULL,
+                                        hash_concurrently, &object), 0);
+    }
+    for (size_t i = 0; i < sizeof(threads) / sizeof(threads[0]); i++) {
+        uintmax_t *hash;
+        assert_int_equal(pthread_join(threads[i], (void **) &hash), 0);
+        assert_int_equal(*hash, object.hash);
+        free(hash);
+    }
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_hash_128_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_hash_128(NULL, (void *) 1),
+            SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_hash_128_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_hash_128((void *) 1, NULL),
+            SEA_TURTLE_STRING_ERROR_OUT_IS_NULL);
+}
+
+static void check_hash_128(void **state) {
     struct sea_turtle_string object;
     const char chars[] = u8"🦖 t-rex";
     assert_int_equal(sea_turtle_string_init(&object,
                                             chars,
                                             sizeof(chars),
                                             NULL), 0);
-    assert_int_not_equal(object.hash, 0);
+    uint64_t out[2];
+    assert_int_equal(sea_turtle_string_hash_128(&object, out), 0);
+    uintmax_t hash;
+    assert_int_equal(sea_turtle_string_hash(&object, &hash), 0);
+    assert_int_equal(out[0], hash);
+    assert_int_not_equal(out[1], 0);
     assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+    assert_int_equal(sea_turtle_string_hash_128(&object, out), 0);
+    assert_int_equal(out[0], 0);
+    assert_int_equal(out[1], 0);
 }
 
 static void check_first_error_on_object_is_null(void **state) {
@@ -228,7 +787,7 @@ static void check_first(void **state) {
                                             NULL), 0);
     const uint8_t *at;
     assert_int_equal(sea_turtle_string_first(&object, &at), 0);
-    assert_ptr_equal(object.data, at);
+    assert_ptr_equal(sea_turtle_string_bytes(&object), at);
     assert_int_equal(sea_turtle_string_invalidate(&object), 0);
     const char input1[] = u8"hello";
     assert_int_equal(sea_turtle_string_init(&object,
@@ -236,7 +795,7 @@ static void check_first(void **state) {
                                             sizeof(input1),
                                             NULL), 0);
     assert_int_equal(sea_turtle_string_first(&object, &at), 0);
-    assert_ptr_equal(object.data, at);
+    assert_ptr_equal(sea_turtle_string_bytes(&object), at);
     assert_int_equal(sea_turtle_string_invalidate(&object), 0);
 }
 
@@ -270,7 +829,7 @@ static void check_last(void **state) {
                                             &out), 0);
     const uint8_t *at;
     assert_int_equal(sea_turtle_string_last(&object, &at), 0);
-    assert_ptr_equal(object.data, at);
+    assert_ptr_equal(sea_turtle_string_bytes(&object), at);
     assert_int_equal(sea_turtle_string_invalidate(&object), 0);
     const char input1[] = u8"world";
     assert_int_equal(sea_turtle_string_init(&object,
@@ -278,7 +837,7 @@ static void check_last(void **state) {
                                             sizeof(input1),
                                             &out), 0);
     assert_int_equal(sea_turtle_string_last(&object, &at), 0);
-    assert_ptr_equal(object.data + out - 1, at);
+    assert_ptr_equal(sea_turtle_string_bytes(&object) + out - 1, at);
     assert_int_equal(sea_turtle_string_invalidate(&object), 0);
 }
 
@@ -309,36 +868,33 @@ static void check_next_error_on_out_is_null(void **state) {
 }
 
 static void check_next_error_on_at_is_out_of_bounds(void **state) {
-    const uint8_t chars[] = {0x00};
     struct sea_turtle_string object = {
-            .data = (uint8_t*) &chars,
+            .local = {0x00},
             .size = 1
     };
-    const uint8_t *at = &chars[object.size];
+    const uint8_t *at = &object.local[object.size];
     assert_int_equal(
             sea_turtle_string_next(&object, at, &at),
             SEA_TURTLE_STRING_ERROR_AT_IS_OUT_OF_BOUNDS);
 }
 
 static void check_next_error_on_at_is_invalid(void **state) {
-    const uint8_t chars[] = {0x80, 0x00};
     struct sea_turtle_string object = {
-            .data = (uint8_t*) &chars,
+            .local = {0x80, 0x00},
             .size = 1
     };
-    const uint8_t *at = &chars[0];
+    const uint8_t *at = &object.local[0];
     assert_int_equal(
             sea_turtle_string_next(&object, at, &at),
             SEA_TURTLE_STRING_ERROR_AT_IS_INVALID);
 }
 
 static void check_next_error_on_end_of_sequence(void **state) {
-    const uint8_t chars[] = {0x43, 0x00};
     struct sea_turtle_string object = {
-            .data = (uint8_t*) &chars,
+            .local = {0x43, 0x00},
             .size = 1
     };
-    const uint8_t *at = &chars[0];
+    const uint8_t *at = &object.local[0];
     assert_int_equal(
             sea_turtle_string_next(&object, at, &at),
             SEA_TURTLE_STRING_ERROR_END_OF_SEQUENCE);
@@ -353,10 +909,10 @@ static void check_next(void **state) {
                                             NULL), 0);
     const uint8_t *at;
     assert_int_equal(sea_turtle_string_first(&object, &at), 0);
-    assert_ptr_equal(object.data, at);
+    assert_ptr_equal(sea_turtle_string_bytes(&object), at);
     assert_int_equal('_', *at);
     assert_int_equal(sea_turtle_string_next(&object, at, &at), 0);
-    assert_ptr_equal(object.data + 1, at);
+    assert_ptr_equal(sea_turtle_string_bytes(&object) + 1, at);
     assert_int_equal(sea_turtle_string_next(&object, at, &at), 0);
     assert_int_equal('=', *at);
     assert_int_equal(
@@ -384,36 +940,33 @@ static void check_prev_error_on_out_is_null(void **state) {
 }
 
 static void check_prev_error_on_at_is_out_of_bounds(void **state) {
-    const uint8_t chars[] = {0x00};
     struct sea_turtle_string object = {
-            .data = (uint8_t*) &chars,
+            .local = {0x00},
             .size = 1
     };
-    const uint8_t *at = &chars[object.size];
+    const uint8_t *at = &object.local[object.size];
     assert_int_equal(
             sea_turtle_string_prev(&object, at, &at),
             SEA_TURTLE_STRING_ERROR_AT_IS_OUT_OF_BOUNDS);
 }
 
 static void check_prev_error_on_at_is_invalid(void **state) {
-    const uint8_t chars[] = {0x80, 0x00};
     struct sea_turtle_string object = {
-            .data = (uint8_t*) &chars,
+            .local = {0x80, 0x00},
             .size = 1
     };
-    const uint8_t *at = &chars[0];
+    const uint8_t *at = &object.local[0];
     assert_int_equal(
             sea_turtle_string_prev(&object, at, &at),
             SEA_TURTLE_STRING_ERROR_AT_IS_INVALID);
 }
 
 static void check_prev_error_on_end_of_sequence(void **state) {
-    const uint8_t chars[] = {0x43, 0x00};
     struct sea_turtle_string object = {
-            .data = (uint8_t*) &chars,
+            .local = {0x43, 0x00},
             .size = 1
     };
-    const uint8_t *at = &chars[0];
+    const uint8_t *at = &object.local[0];
     assert_int_equal(
             sea_turtle_string_prev(&object, at, &at),
             SEA_TURTLE_STRING_ERROR_END_OF_SEQUENCE);
@@ -430,7 +983,7 @@ static void check_prev(void **state) {
     assert_int_equal(sea_turtle_string_last(&object, &at), 0);
     assert_int_equal('=', *at);
     assert_int_equal(sea_turtle_string_prev(&object, at, &at), 0);
-    assert_ptr_equal(object.data + 1, at);
+    assert_ptr_equal(sea_turtle_string_bytes(&object) + 1, at);
     assert_int_equal(sea_turtle_string_prev(&object, at, &at), 0);
     assert_int_equal('_', *at);
     assert_int_equal(
@@ -458,24 +1011,22 @@ static void check_code_point_error_on_out_is_null(void **state) {
 }
 
 static void check_code_point_error_on_at_is_out_of_bounds(void **state) {
-    const uint8_t chars[] = {0x00};
     struct sea_turtle_string object = {
-            .data = (uint8_t*) &chars,
+            .local = {0x00},
             .size = 1
     };
-    const uint8_t *at = &chars[object.size];
+    const uint8_t *at = &object.local[object.size];
     assert_int_equal(
             sea_turtle_string_code_point(&object, at, (void *) 1),
             SEA_TURTLE_STRING_ERROR_AT_IS_OUT_OF_BOUNDS);
 }
 
 static void check_code_point_error_on_at_is_invalid(void **state) {
-    const uint8_t chars[] = {0x80, 0x00};
     struct sea_turtle_string object = {
-            .data = (uint8_t*) &chars,
+            .local = {0x80, 0x00},
             .size = 1
     };
-    const uint8_t *at = &chars[0];
+    const uint8_t *at = &object.local[0];
     assert_int_equal(
             sea_turtle_string_code_point(&object, at, (void *) 1),
             SEA_TURTLE_STRING_ERROR_AT_IS_INVALID);
@@ -511,6 +1062,1097 @@ static void check_code_point(void **state) {
     assert_int_equal(sea_turtle_string_invalidate(&object), 0);
 }
 
+static void check_at_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_at(NULL, 0, (void *) 1),
+            SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_at_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_at((void *) 1, 0, NULL),
+            SEA_TURTLE_STRING_ERROR_OUT_IS_NULL);
+}
+
+static void check_at_error_on_index_is_out_of_bounds(void **state) {
+    struct sea_turtle_string object;
+    const char chars[] = u8"$£";
+    assert_int_equal(sea_turtle_string_init(&object,
+                                            chars,
+                                            sizeof(chars),
+                                            NULL), 0);
+    const uint8_t *at;
+    assert_int_equal(
+            sea_turtle_string_at(&object, 2, &at),
+            SEA_TURTLE_STRING_ERROR_INDEX_IS_OUT_OF_BOUNDS);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+    object = (struct sea_turtle_string) {0};
+    assert_int_equal(
+            sea_turtle_string_at(&object, 0, &at),
+            SEA_TURTLE_STRING_ERROR_INDEX_IS_OUT_OF_BOUNDS);
+}
+
+static void check_at_ascii(void **state) {
+    struct sea_turtle_string object;
+    const char chars[] = u8"a rather long string made up of ASCII chars only "
+                         u8"so that every code point is a single byte";
+    assert_int_equal(sea_turtle_string_init(&object,
+                                            chars,
+                                            sizeof(chars),
+                                            NULL), 0);
+    for (uintmax_t i = 0; i < sea_turtle_string_count_of(&object); i++) {
+        const uint8_t *at;
+        assert_int_equal(sea_turtle_string_at(&object, i, &at), 0);
+        assert_ptr_equal(sea_turtle_string_bytes(&object) + i, at);
+    }
+    /* no index is needed */
+    assert_null(sea_turtle_string_buffer_of(&object)->index);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_at_local(void **state) {
+    struct sea_turtle_string object;
+    const char chars[] = u8"$£ह€🐉";
+    assert_int_equal(sea_turtle_string_init(&object,
+                                            chars,
+                                            sizeof(chars),
+                                            NULL), 0);
+    assert_int_equal(sea_turtle_string_storage_of(&object),
+                     SEA_TURTLE_STRING_STORAGE_LOCAL);
+    const uint8_t *at;
+    assert_int_equal(sea_turtle_string_at(&object, 4, &at), 0);
+    uint32_t code_point;
+    assert_int_equal(sea_turtle_string_code_point(&object, at, &code_point), 0);
+    assert_int_equal(code_point, 0x1F409);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+/* build a long string of mixed width code points */
+static void long_string(struct sea_turtle_string *const object) {
+    const char chars[] = u8"$£ह€한🐉 ";
+    const size_t repeat = 97;
+    char *const char_ptr = malloc(repeat * (sizeof(chars) - 1) + 1);
+    assert_non_null(char_ptr);
+    for (size_t i = 0; i < repeat; i++) {
+        memcpy(char_ptr + i * (sizeof(chars) - 1), chars, sizeof(chars) - 1);
+    }
+    char_ptr[repeat * (sizeof(chars) - 1)] = 0;
+    assert_int_equal(sea_turtle_string_init(object,
+                                            char_ptr,
+                                            SIZE_MAX,
+                                            NULL), 0);
+    free(char_ptr);
+    assert_int_equal(sea_turtle_string_count_of(object), 7 * repeat);
+}
+
+static void check_at(void **state) {
+    struct sea_turtle_string object;
+    long_string(&object);
+    assert_int_equal(sea_turtle_string_storage_of(&object),
+                     SEA_TURTLE_STRING_STORAGE_HEAP);
+    assert_null(sea_turtle_string_buffer_of(&object)->index);
+    const uint8_t *expected;
+    assert_int_equal(sea_turtle_string_first(&object, &expected), 0);
+    for (uintmax_t i = 0; i < sea_turtle_string_count_of(&object); i++) {
+        const uint8_t *at;
+        assert_int_equal(sea_turtle_string_at(&object, i, &at), 0);
+        assert_ptr_equal(expected, at);
+        sea_turtle_string_next(&object, expected, &expected);
+    }
+    assert_non_null(sea_turtle_string_buffer_of(&object)->index);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_at_after_copy(void **state) {
+    struct sea_turtle_string object;
+    long_string(&object);
+    assert_int_equal(sea_turtle_string_share(&object), 0);
+    const uint8_t *at;
+    assert_int_equal(sea_turtle_string_at(&object, 100, &at), 0);
+    assert_non_null(sea_turtle_string_buffer_of(&object)->index);
+    struct sea_turtle_string copies[2];
+    assert_int_equal(sea_turtle_string_init_string(&copies[0], &object), 0);
+    /* copies of a shared string share the index kept with the buffer */
+    assert_ptr_equal(sea_turtle_string_buffer_of(&copies[0])->index,
+                     sea_turtle_string_buffer_of(&object)->index);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+    const uint8_t *other;
+    assert_int_equal(sea_turtle_string_at(&copies[0], 100, &other), 0);
+    assert_ptr_equal(at, other);
+    assert_int_equal(sea_turtle_string_set_size(&copies[0],
+                                                copies[0].size), 0);
+    assert_int_equal(sea_turtle_string_storage_of(&copies[0]),
+                     SEA_TURTLE_STRING_STORAGE_HEAP);
+    assert_null(sea_turtle_string_buffer_of(&copies[0])->index);
+    assert_int_equal(sea_turtle_string_at(&copies[0], 100, &at), 0);
+    assert_non_null(sea_turtle_string_buffer_of(&copies[0])->index);
+    assert_int_equal(sea_turtle_string_init_string(&copies[1], &copies[0]),
+                     0);
+    assert_null(sea_turtle_string_buffer_of(&copies[1])->index);
+    assert_int_equal(sea_turtle_string_at(&copies[1], 100, &other), 0);
+    assert_int_equal(sea_turtle_string_code_point(&copies[1], other,
+                                                  &(uint32_t) {0}), 0);
+    assert_memory_equal(at, other, 4);
+    assert_int_equal(sea_turtle_string_invalidate(&copies[1]), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&copies[0]), 0);
+}
+
+static void check_at_memory_allocation_failed(void **state) {
+    struct sea_turtle_string object;
+    long_string(&object);
+    malloc_is_overridden = true;
+    const uint8_t *at;
+    assert_int_equal(sea_turtle_string_at(
+            &object, sea_turtle_string_count_of(&object) - 1, &at), 0);
+    malloc_is_overridden = false;
+    assert_null(sea_turtle_string_buffer_of(&object)->index);
+    uint32_t code_point;
+    assert_int_equal(sea_turtle_string_code_point(&object, at, &code_point), 0);
+    assert_int_equal(code_point, ' ');
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_at_set_size(void **state) {
+    struct sea_turtle_string object;
+    long_string(&object);
+    const uint8_t *at;
+    assert_int_equal(sea_turtle_string_at(&object, 200, &at), 0);
+    assert_non_null(sea_turtle_string_buffer_of(&object)->index);
+    assert_int_equal(sea_turtle_string_set_size(&object, 2 * object.size), 0);
+    assert_null(sea_turtle_string_buffer_of(&object)->index);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_substring_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_substring(NULL, 0, 0, (void *) 1),
+            SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_substring_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_substring((void *) 1, 0, 0, NULL),
+            SEA_TURTLE_STRING_ERROR_OUT_IS_NULL);
+}
+
+static void check_substring_error_on_index_is_out_of_bounds(void **state) {
+    struct sea_turtle_string object;
+    const char chars[] = u8"$£";
+    assert_int_equal(sea_turtle_string_init(&object,
+                                            chars,
+                                            sizeof(chars),
+                                            NULL), 0);
+    struct sea_turtle_string_view view;
+    assert_int_equal(
+            sea_turtle_string_substring(&object, 3, 0, &view),
+            SEA_TURTLE_STRING_ERROR_INDEX_IS_OUT_OF_BOUNDS);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_substring_error_on_count_is_out_of_bounds(void **state) {
+    struct sea_turtle_string object;
+    const char chars[] = u8"$£";
+    assert_int_equal(sea_turtle_string_init(&object,
+                                            chars,
+                                            sizeof(chars),
+                                            NULL), 0);
+    struct sea_turtle_string_view view;
+    assert_int_equal(
+            sea_turtle_string_substring(&object, 1, 2, &view),
+            SEA_TURTLE_STRING_ERROR_COUNT_IS_OUT_OF_BOUNDS);
+    assert_int_equal(
+            sea_turtle_string_substring(&object, 0, UINTMAX_MAX, &view),
+            SEA_TURTLE_STRING_ERROR_COUNT_IS_OUT_OF_BOUNDS);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_substring(void **state) {
+    struct sea_turtle_string object;
+    const char chars[] = u8"$£ह€한🐉";
+    assert_int_equal(sea_turtle_string_init(&object,
+                                            chars,
+                                            sizeof(chars),
+                                            NULL), 0);
+    struct sea_turtle_string_view view;
+    assert_int_equal(sea_turtle_string_substring(&object, 2, 3, &view), 0);
+    assert_int_equal(view.count, 3);
+    assert_int_equal(view.size, strlen(u8"ह€한"));
+    assert_memory_equal(view.data, u8"ह€한", view.size);
+    assert_int_equal(sea_turtle_string_substring(&object, 6, 0, &view), 0);
+    assert_int_equal(view.count, 0);
+    assert_int_equal(view.size, 0);
+    assert_int_equal(sea_turtle_string_substring(&object, 0, 6, &view), 0);
+    assert_int_equal(view.size, sizeof(chars) - 1);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+    object = (struct sea_turtle_string) {0};
+    assert_int_equal(sea_turtle_string_substring(&object, 0, 0, &view), 0);
+    assert_int_equal(view.count, 0);
+    assert_int_equal(view.size, 0);
+}
+
+static void check_substring_long(void **state) {
+    struct sea_turtle_string object;
+    long_string(&object);
+    struct sea_turtle_string_view view;
+    assert_int_equal(sea_turtle_string_substring(&object, 7 * 50, 7, &view),
+                     0);
+    assert_int_equal(view.size, strlen(u8"$£ह€한🐉 "));
+    assert_memory_equal(view.data, u8"$£ह€한🐉 ", view.size);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_init_code_points_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_init_code_points(NULL, (void *) 1, 0),
+            SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init_code_points_error_on_code_points_is_null(
+        void **state) {
+    assert_int_equal(
+            sea_turtle_string_init_code_points((void *) 1, NULL, 0),
+            SEA_TURTLE_STRING_ERROR_CODE_POINTS_IS_NULL);
+}
+
+static void check_init_code_points_error_on_code_point_is_invalid(
+        void **state) {
+    struct sea_turtle_string object;
+    const uint32_t code_points[] = {0x24, 0xD800};
+    assert_int_equal(
+            sea_turtle_string_init_code_points(&object, code_points, 2),
+            SEA_TURTLE_STRING_ERROR_CODE_POINT_IS_INVALID);
+}
+
+static void check_init_code_points_error_on_memory_allocation_failed(
+        void **state) {
+    struct sea_turtle_string object;
+    uint32_t code_points[SEA_TURTLE_STRING_LOCAL_SIZE];
+    for (size_t i = 0; i < SEA_TURTLE_STRING_LOCAL_SIZE; i++) {
+        code_points[i] = 'a';
+    }
+    malloc_is_overridden = true;
+    assert_int_equal(
+            sea_turtle_string_init_code_points(
+                    &object, code_points, SEA_TURTLE_STRING_LOCAL_SIZE),
+            SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = false;
+}
+
+static void check_init_code_points(void **state) {
+    struct sea_turtle_string object;
+    const uint32_t code_points[] = {0x24, 0xA3, 0x939, 0x20AC, 0xD55C,
+                                    0x1F409};
+    assert_int_equal(
+            sea_turtle_string_init_code_points(&object, code_points, 6), 0);
+    const char chars[] = u8"$£ह€한🐉";
+    assert_int_equal(object.size, sizeof(chars));
+    assert_int_equal(sea_turtle_string_count_of(&object), 6);
+    assert_string_equal((const char *) sea_turtle_string_bytes(&object), chars);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+    assert_int_equal(
+            sea_turtle_string_init_code_points(&object, code_points, 0), 0);
+    assert_int_equal(object.size, 0);
+    assert_int_equal(sea_turtle_string_count_of(&object), 0);
+}
+
+static void check_code_points_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_code_points(NULL, 0, 0, (void *) 1, NULL),
+            SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_code_points_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_code_points((void *) 1, 0, 0, NULL, NULL),
+            SEA_TURTLE_STRING_ERROR_OUT_IS_NULL);
+}
+
+static void check_code_points_error_on_index_is_out_of_bounds(void **state) {
+    struct sea_turtle_string object;
+    assert_int_equal(sea_turtle_string_init(&object, u8"$£", SIZE_MAX,
+                                            NULL), 0);
+    uint32_t out[2];
+    assert_int_equal(
+            sea_turtle_string_code_points(&object, 3, 2, out, NULL),
+            SEA_TURTLE_STRING_ERROR_INDEX_IS_OUT_OF_BOUNDS);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_code_points(void **state) {
+    struct sea_turtle_string object;
+    long_string(&object);
+    const uint32_t expected[] = {0x24, 0xA3, 0x939, 0x20AC, 0xD55C, 0x1F409,
+                                 0x20};
+    /* decoded a chunk at a time */
+    uint32_t out[100];
+    uintmax_t index = 0;
+    size_t count;
+    do {
+        assert_int_equal(sea_turtle_string_code_points(
+                &object, index, 100, out, &count), 0);
+        for (size_t i = 0; i < count; i++) {
+            assert_int_equal(out[i], expected[(index + i) % 7]);
+        }
+        index += count;
+    } while (count);
+    assert_int_equal(index, sea_turtle_string_count_of(&object));
+    struct sea_turtle_string other;
+    assert_int_equal(sea_turtle_string_init_code_points(&other, expected, 7),
+                     0);
+    assert_int_equal(sea_turtle_string_code_points(&other, 5, 100, out,
+                                                   &count), 0);
+    assert_int_equal(count, 2);
+    assert_int_equal(out[0], 0x1F409);
+    assert_int_equal(out[1], 0x20);
+    assert_int_equal(sea_turtle_string_invalidate(&other), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_init_utf16_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_init_utf16(
+                    NULL, (void *) 1, 0,
+                    SEA_TURTLE_STRING_BYTE_ORDER_LITTLE_ENDIAN),
+            SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init_utf16_error_on_utf16_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_init_utf16(
+                    (void *) 1, NULL, 0,
+                    SEA_TURTLE_STRING_BYTE_ORDER_LITTLE_ENDIAN),
+            SEA_TURTLE_STRING_ERROR_UTF16_IS_NULL);
+}
+
+static void check_init_utf16_error_on_order_is_invalid(void **state) {
+    assert_int_equal(
+            sea_turtle_string_init_utf16((void *) 1, (void *) 1, 0, 2),
+            SEA_TURTLE_STRING_ERROR_ORDER_IS_INVALID);
+}
+
+static void check_init_utf16_error_on_utf16_is_malformed(void **state) {
+    struct sea_turtle_string object;
+    /* lone high surrogate, lone low surrogate and NULL code unit */
+    const uint8_t high[] = {'a', 0, 0x3D, 0xD8, 'b', 0};
+    const uint8_t low[] = {0x09, 0xDC, 'a', 0};
+    const uint8_t null[] = {'a', 0, 0, 0};
+    assert_int_equal(
+            sea_turtle_string_init_utf16(
+                    &object, high, 3,
+                    SEA_TURTLE_STRING_BYTE_ORDER_LITTLE_ENDIAN),
+            SEA_TURTLE_STRING_ERROR_UTF16_IS_MALFORMED);
+    assert_int_equal(
+            sea_turtle_string_init_utf16(
+                    &object, high, 2,
+                    SEA_TURTLE_STRING_BYTE_ORDER_LITTLE_ENDIAN),
+            SEA_TURTLE_STRING_ERROR_UTF16_IS_MALFORMED);
+    assert_int_equal(
+            sea_turtle_string_init_utf16(
+                    &object, low, 2,
+                    SEA_TURTLE_STRING_BYTE_ORDER_LITTLE_ENDIAN),
+            SEA_TURTLE_STRING_ERROR_UTF16_IS_MALFORMED);
+    assert_int_equal(
+            sea_turtle_string_init_utf16(
+                    &object, null, 2,
+                    SEA_TURTLE_STRING_BYTE_ORDER_LITTLE_ENDIAN),
+            SEA_TURTLE_STRING_ERROR_UTF16_IS_MALFORMED);
+}
+
+static void check_init_utf16_error_on_memory_allocation_failed(
+        void **state) {
+    struct sea_turtle_string object;
+    uint8_t utf16[2 * SEA_TURTLE_STRING_LOCAL_SIZE];
+    for (size_t i = 0; i < SEA_TURTLE_STRING_LOCAL_SIZE; i++) {
+        utf16[2 * i] = 'a';
+        utf16[2 * i + 1] = 0;
+    }
+    malloc_is_overridden = true;
+    assert_int_equal(
+            sea_turtle_string_init_utf16(
+                    &object, utf16, SEA_TURTLE_STRING_LOCAL_SIZE,
+                    SEA_TURTLE_STRING_BYTE_ORDER_LITTLE_ENDIAN),
+            SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = false;
+}
+
+static void check_init_utf16(void **state) {
+    struct sea_turtle_string object;
+    const uint8_t little[] = {0x24, 0, 0xA3, 0, 0x39, 0x09, 0xAC, 0x20,
+                              0x5C, 0xD5, 0x3D, 0xD8, 0x09, 0xDC};
+    const uint8_t big[] = {0, 0x24, 0, 0xA3, 0x09, 0x39, 0x20, 0xAC,
+                           0xD5, 0x5C, 0xD8, 0x3D, 0xDC, 0x09};
+    const char chars[] = u8"$£ह€한🐉";
+    assert_int_equal(
+            sea_turtle_string_init_utf16(
+                    &object, little, 7,
+                    SEA_TURTLE_STRING_BYTE_ORDER_LITTLE_ENDIAN), 0);
+    assert_int_equal(object.size, sizeof(chars));
+    assert_int_equal(sea_turtle_string_count_of(&object), 6);
+    assert_string_equal((const char *) sea_turtle_string_bytes(&object), chars);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+    /* the code units do not need to be aligned */
+    uint8_t unaligned[1 + sizeof(big)];
+    memcpy(unaligned + 1, big, sizeof(big));
+    assert_int_equal(
+            sea_turtle_string_init_utf16(
+                    &object, unaligned + 1, 7,
+                    SEA_TURTLE_STRING_BYTE_ORDER_BIG_ENDIAN), 0);
+    assert_int_equal(object.size, sizeof(chars));
+    assert_int_equal(sea_turtle_string_count_of(&object), 6);
+    assert_string_equal((const char *) sea_turtle_string_bytes(&object), chars);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+    assert_int_equal(
+            sea_turtle_string_init_utf16(
+                    &object, little, 0,
+                    SEA_TURTLE_STRING_BYTE_ORDER_LITTLE_ENDIAN), 0);
+    assert_int_equal(object.size, 0);
+    assert_int_equal(sea_turtle_string_count_of(&object), 0);
+}
+
+static void check_utf16_count_error_on_object_is_null(void **state) {
+    assert_int_equal(sea_turtle_string_utf16_count(NULL, (void *) 1),
+                     SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_utf16_count_error_on_out_is_null(void **state) {
+    assert_int_equal(sea_turtle_string_utf16_count((void *) 1, NULL),
+                     SEA_TURTLE_STRING_ERROR_OUT_IS_NULL);
+}
+
+static void check_utf16_count(void **state) {
+    struct sea_turtle_string object;
+    long_string(&object);
+    size_t out;
+    assert_int_equal(sea_turtle_string_utf16_count(&object, &out), 0);
+    /* the dragon is encoded with a surrogate pair */
+    const uintmax_t count = sea_turtle_string_count_of(&object);
+    assert_int_equal(out, count + count / 7);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+    assert_int_equal(sea_turtle_string_init(&object, "turtle", SIZE_MAX,
+                                            NULL), 0);
+    assert_int_equal(sea_turtle_string_utf16_count(&object, &out), 0);
+    assert_int_equal(out, 6);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+    assert_int_equal(sea_turtle_string_utf16_count(&object, &out), 0);
+    assert_int_equal(out, 0);
+}
+
+static void check_to_utf16_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_to_utf16(
+                    NULL, SEA_TURTLE_STRING_BYTE_ORDER_LITTLE_ENDIAN,
+                    (void *) 1, 0),
+            SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_to_utf16_error_on_order_is_invalid(void **state) {
+    assert_int_equal(
+            sea_turtle_string_to_utf16((void *) 1, 2, (void *) 1, 0),
+            SEA_TURTLE_STRING_ERROR_ORDER_IS_INVALID);
+}
+
+static void check_to_utf16_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_to_utf16(
+                    (void *) 1, SEA_TURTLE_STRING_BYTE_ORDER_LITTLE_ENDIAN,
+                    NULL, 0),
+            SEA_TURTLE_STRING_ERROR_OUT_IS_NULL);
+}
+
+static void check_to_utf16_error_on_size_is_too_small(void **state) {
+    struct sea_turtle_string object;
+    assert_int_equal(sea_turtle_string_init(&object, u8"🐉", SIZE_MAX,
+                                            NULL), 0);
+    uint8_t out[2];
+    assert_int_equal(
+            sea_turtle_string_to_utf16(
+                    &object, SEA_TURTLE_STRING_BYTE_ORDER_LITTLE_ENDIAN,
+                    out, 1),
+            SEA_TURTLE_STRING_ERROR_SIZE_IS_TOO_SMALL);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_to_utf16(void **state) {
+    struct sea_turtle_string object;
+    long_string(&object);
+    size_t count;
+    assert_int_equal(sea_turtle_string_utf16_count(&object, &count), 0);
+    uint8_t *const out = malloc(2 * count);
+    assert_non_null(out);
+    const enum sea_turtle_string_byte_order orders[] = {
+            SEA_TURTLE_STRING_BYTE_ORDER_LITTLE_ENDIAN,
+            SEA_TURTLE_STRING_BYTE_ORDER_BIG_ENDIAN
+    };
+    for (size_t i = 0; i < 2; i++) {
+        assert_int_equal(sea_turtle_string_to_utf16(&object, orders[i], out,
+                                                     count), 0);
+        const uint8_t dragon[] = {0x3D, 0xD8, 0x09, 0xDC};
+        for (size_t k = 0; k < 4; k++) {
+            assert_int_equal(out[10 + k], dragon[k ^ i]);
+        }
+        struct sea_turtle_string other;
+        assert_int_equal(sea_turtle_string_init_utf16(&other, out, count,
+                                                      orders[i]), 0);
+        bool equals;
+        assert_int_equal(sea_turtle_string_equals(&object, &other, &equals),
+                         0);
+        assert_true(equals);
+        assert_int_equal(sea_turtle_string_count_of(&other),
+                         sea_turtle_string_count_of(&object));
+        assert_int_equal(sea_turtle_string_invalidate(&other), 0);
+    }
+    free(out);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_equals_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_equals(NULL, (void *) 1, (void *) 1),
+            SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_equals_error_on_other_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_equals((void *) 1, NULL, (void *) 1),
+            SEA_TURTLE_STRING_ERROR_OTHER_IS_NULL);
+}
+
+static void check_equals_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_equals((void *) 1, (void *) 1, NULL),
+            SEA_TURTLE_STRING_ERROR_OUT_IS_NULL);
+}
+
+static void check_equals(void **state) {
+    struct sea_turtle_string object;
+    long_string(&object);
+    struct sea_turtle_string other;
+    assert_int_equal(sea_turtle_string_init_string(&other, &object), 0);
+    bool out;
+    assert_int_equal(sea_turtle_string_equals(&object, &other, &out), 0);
+    assert_true(out);
+    /* a difference past the first blocks */
+    sea_turtle_string_bytes(&other)[object.size - 3] = '!';
+    assert_int_equal(sea_turtle_string_equals(&object, &other, &out), 0);
+    assert_false(out);
+    assert_int_equal(sea_turtle_string_set_size(&other, 10), 0);
+    assert_int_equal(sea_turtle_string_equals(&object, &other, &out), 0);
+    assert_false(out);
+    assert_int_equal(sea_turtle_string_invalidate(&other), 0);
+    /* empty strings are equal */
+    assert_int_equal(sea_turtle_string_equals(&other, &other, &out), 0);
+    assert_true(out);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+    assert_int_equal(sea_turtle_string_equals(&object, &other, &out), 0);
+    assert_true(out);
+}
+
+static void check_equals_rejects_on_hash(void **state) {
+    struct sea_turtle_string object;
+    assert_int_equal(sea_turtle_string_init(&object, u8"$£ह€ $£ह€ $£ह€",
+                                            SIZE_MAX, NULL), 0);
+    struct sea_turtle_string other;
+    assert_int_equal(sea_turtle_string_init_string(&other, &object), 0);
+    /* the bytes are not read once both hash codes are known to differ */
+    object.hash = 1;
+    other.hash = 2;
+    bool out;
+    assert_int_equal(sea_turtle_string_equals(&object, &other, &out), 0);
+    assert_false(out);
+    other.hash = 0;
+    assert_int_equal(sea_turtle_string_equals(&object, &other, &out), 0);
+    assert_true(out);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&other), 0);
+}
+
+static void check_equals_any_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_equals_any(NULL, (void *) 1, 0, (void *) 1),
+            SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_equals_any_error_on_others_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_equals_any((void *) 1, NULL, 0, (void *) 1),
+            SEA_TURTLE_STRING_ERROR_OTHERS_IS_NULL);
+}
+
+static void check_equals_any_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_equals_any((void *) 1, (void *) 1, 0, NULL),
+            SEA_TURTLE_STRING_ERROR_OUT_IS_NULL);
+}
+
+static void check_equals_any_error_on_other_not_found(void **state) {
+    struct sea_turtle_string object;
+    assert_int_equal(sea_turtle_string_init(&object, u8"$£ह€", SIZE_MAX,
+                                            NULL), 0);
+    struct sea_turtle_string other;
+    assert_int_equal(sea_turtle_string_init(&other, u8"$£ह!", SIZE_MAX,
+                                            NULL), 0);
+    const struct sea_turtle_string *others[] = {NULL, &other};
+    size_t out;
+    assert_int_equal(sea_turtle_string_equals_any(&object, others, 2, &out),
+                     SEA_TURTLE_STRING_ERROR_OTHER_NOT_FOUND);
+    assert_int_equal(sea_turtle_string_equals_any(&object, others, 0, &out),
+                     SEA_TURTLE_STRING_ERROR_OTHER_NOT_FOUND);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&other), 0);
+}
+
+static void check_equals_any(void **state) {
+    const char *chars[] = {u8"$", u8"$£ह!", u8"$£ह€", u8"£ह€", u8"$£ह€"};
+    struct sea_turtle_string strings[5];
+    const struct sea_turtle_string *others[5];
+    for (size_t i = 0; i < 5; i++) {
+        assert_int_equal(sea_turtle_string_init(&strings[i], chars[i],
+                                                SIZE_MAX, NULL), 0);
+        uintmax_t hash;
+        assert_int_equal(sea_turtle_string_hash(&strings[i], &hash), 0);
+        others[i] = &strings[i];
+    }
+    struct sea_turtle_string object;
+    assert_int_equal(sea_turtle_string_init(&object, u8"$£ह€", SIZE_MAX,
+                                            NULL), 0);
+    size_t out;
+    assert_int_equal(sea_turtle_string_equals_any(&object, others, 5, &out),
+                     0);
+    assert_int_equal(out, 2);
+    /* the hash code was computed to reject candidates */
+    assert_int_not_equal(object.hash, 0);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+    for (size_t i = 0; i < 5; i++) {
+        assert_int_equal(sea_turtle_string_invalidate(&strings[i]), 0);
+    }
+}
+
+static void check_find_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_find(NULL, (void *) 1, (void *) 1, NULL),
+            SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_find_error_on_needle_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_find((void *) 1, NULL, (void *) 1, NULL),
+            SEA_TURTLE_STRING_ERROR_NEEDLE_IS_NULL);
+}
+
+static void check_find_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_find((void *) 1, (void *) 1, NULL, NULL),
+            SEA_TURTLE_STRING_ERROR_OUT_IS_NULL);
+}
+
+static void check_find_error_on_needle_not_found(void **state) {
+    struct sea_turtle_string object;
+    assert_int_equal(sea_turtle_string_init(&object, u8"$£ह€", SIZE_MAX,
+                                            NULL), 0);
+    struct sea_turtle_string needle;
+    assert_int_equal(sea_turtle_string_init(&needle, u8"€£", SIZE_MAX,
+                                            NULL), 0);
+    const uint8_t *out;
+    assert_int_equal(sea_turtle_string_find(&object, &needle, &out, NULL),
+                     SEA_TURTLE_STRING_ERROR_NEEDLE_NOT_FOUND);
+    assert_int_equal(sea_turtle_string_find(&needle, &object, &out, NULL),
+                     SEA_TURTLE_STRING_ERROR_NEEDLE_NOT_FOUND);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&needle), 0);
+}
+
+static void check_find(void **state) {
+    struct sea_turtle_string object;
+    assert_int_equal(sea_turtle_string_init(&object, u8"$£ह€한🐉 $£",
+                                            SIZE_MAX, NULL), 0);
+    struct sea_turtle_string needle;
+    assert_int_equal(sea_turtle_string_init(&needle, u8"£", SIZE_MAX,
+                                            NULL), 0);
+    const uint8_t *out;
+    uintmax_t index;
+    assert_int_equal(sea_turtle_string_find(&object, &needle, &out, &index),
+                     0);
+    assert_ptr_equal(out, sea_turtle_string_bytes(&object) + 1);
+    assert_int_equal(index, 1);
+    /* the occurrence can be walked from */
+    assert_int_equal(sea_turtle_string_next(&object, out, &out), 0);
+    assert_memory_equal(out, u8"ह", strlen(u8"ह"));
+    assert_int_equal(sea_turtle_string_invalidate(&needle), 0);
+    /* the empty needle is found at the start */
+    needle = (struct sea_turtle_string) {0};
+    assert_int_equal(sea_turtle_string_find(&object, &needle, &out, &index),
+                     0);
+    assert_ptr_equal(out, sea_turtle_string_bytes(&object));
+    assert_int_equal(index, 0);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+/* a needle short enough to be filtered and one long enough for Two-Way */
+static void check_find_long(void **state) {
+    struct sea_turtle_string object;
+    long_string(&object);
+    const char *chars[] = {
+            u8"🐉 $",
+            u8"€한🐉 $£ह€한🐉 $£ह€한🐉 $"
+    };
+    const uintmax_t expected[] = {5, 3};
+    for (size_t i = 0; i < 2; i++) {
+        struct sea_turtle_string needle;
+        assert_int_equal(sea_turtle_string_init(&needle, chars[i], SIZE_MAX,
+                                                NULL), 0);
+        const uint8_t *out;
+        uintmax_t index;
+        assert_int_equal(sea_turtle_string_find(&object, &needle, &out,
+                                                &index), 0);
+        assert_int_equal(index, expected[i]);
+        const uint8_t *at;
+        assert_int_equal(sea_turtle_string_at(&object, index, &at), 0);
+        assert_ptr_equal(out, at);
+        assert_int_equal(sea_turtle_string_invalidate(&needle), 0);
+    }
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_rfind_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_rfind(NULL, (void *) 1, (void *) 1, NULL),
+            SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_rfind_error_on_needle_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_rfind((void *) 1, NULL, (void *) 1, NULL),
+            SEA_TURTLE_STRING_ERROR_NEEDLE_IS_NULL);
+}
+
+static void check_rfind_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_rfind((void *) 1, (void *) 1, NULL, NULL),
+            SEA_TURTLE_STRING_ERROR_OUT_IS_NULL);
+}
+
+static void check_rfind_error_on_needle_not_found(void **state) {
+    struct sea_turtle_string object;
+    assert_int_equal(sea_turtle_string_init(&object, u8"$£ह€", SIZE_MAX,
+                                            NULL), 0);
+    struct sea_turtle_string needle;
+    assert_int_equal(sea_turtle_string_init(&needle, u8"€£", SIZE_MAX,
+                                            NULL), 0);
+    const uint8_t *out;
+    assert_int_equal(sea_turtle_string_rfind(&object, &needle, &out, NULL),
+                     SEA_TURTLE_STRING_ERROR_NEEDLE_NOT_FOUND);
+    assert_int_equal(sea_turtle_string_rfind(&needle, &object, &out, NULL),
+                     SEA_TURTLE_STRING_ERROR_NEEDLE_NOT_FOUND);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&needle), 0);
+}
+
+static void check_rfind(void **state) {
+    struct sea_turtle_string object;
+    assert_int_equal(sea_turtle_string_init(&object, u8"$£ह€한🐉 $£",
+                                            SIZE_MAX, NULL), 0);
+    struct sea_turtle_string needle;
+    assert_int_equal(sea_turtle_string_init(&needle, u8"£", SIZE_MAX,
+                                            NULL), 0);
+    const uint8_t *out;
+    uintmax_t index;
+    assert_int_equal(sea_turtle_string_rfind(&object, &needle, &out, &index),
+                     0);
+    assert_ptr_equal(out, sea_turtle_string_bytes(&object) + object.size - 3);
+    assert_int_equal(index, 8);
+    assert_int_equal(sea_turtle_string_prev(&object, out, &out), 0);
+    assert_int_equal(*out, '$');
+    assert_int_equal(sea_turtle_string_invalidate(&needle), 0);
+    /* the empty needle is found at the end */
+    needle = (struct sea_turtle_string) {0};
+    assert_int_equal(sea_turtle_string_rfind(&object, &needle, &out, &index),
+                     0);
+    assert_ptr_equal(out, sea_turtle_string_bytes(&object) + object.size - 1);
+    assert_int_equal(index, sea_turtle_string_count_of(&object));
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_rfind_long(void **state) {
+    struct sea_turtle_string object;
+    long_string(&object);
+    const char *chars[] = {
+            u8"🐉 $",
+            u8"€한🐉 $£ह€한🐉 $£ह€한🐉 $"
+    };
+    const uintmax_t expected[] = {7 * 95 + 5, 7 * 93 + 3};
+    for (size_t i = 0; i < 2; i++) {
+        struct sea_turtle_string needle;
+        assert_int_equal(sea_turtle_string_init(&needle, chars[i], SIZE_MAX,
+                                                NULL), 0);
+        const uint8_t *out;
+        uintmax_t index;
+        assert_int_equal(sea_turtle_string_rfind(&object, &needle, &out,
+                                                 &index), 0);
+        assert_int_equal(index, expected[i]);
+        const uint8_t *at;
+        assert_int_equal(sea_turtle_string_at(&object, index, &at), 0);
+        assert_ptr_equal(out, at);
+        assert_int_equal(sea_turtle_string_invalidate(&needle), 0);
+    }
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_contains_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_contains(NULL, (void *) 1, (void *) 1),
+            SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_contains_error_on_needle_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_contains((void *) 1, NULL, (void *) 1),
+            SEA_TURTLE_STRING_ERROR_NEEDLE_IS_NULL);
+}
+
+static void check_contains_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_contains((void *) 1, (void *) 1, NULL),
+            SEA_TURTLE_STRING_ERROR_OUT_IS_NULL);
+}
+
+static void check_contains(void **state) {
+    struct sea_turtle_string object;
+    assert_int_equal(sea_turtle_string_init(&object, u8"$£ह€한🐉",
+                                            SIZE_MAX, NULL), 0);
+    const char *chars[] = {u8"$£", u8"한🐉", u8"", u8"🐉🐉"};
+    const bool expected[] = {true, true, true, false};
+    for (size_t i = 0; i < 4; i++) {
+        struct sea_turtle_string needle;
+        assert_int_equal(sea_turtle_string_init(&needle, chars[i], SIZE_MAX,
+                                                NULL), 0);
+        bool out;
+        assert_int_equal(sea_turtle_string_contains(&object, &needle, &out), 0);
+        assert_int_equal(out, expected[i]);
+        /* a needle longer than the string is never found */
+        assert_int_equal(sea_turtle_string_contains(&needle, &object, &out), 0);
+        assert_false(out);
+        assert_int_equal(sea_turtle_string_invalidate(&needle), 0);
+    }
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_starts_with_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_starts_with(NULL, (void *) 1, (void *) 1),
+            SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_starts_with_error_on_needle_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_starts_with((void *) 1, NULL, (void *) 1),
+            SEA_TURTLE_STRING_ERROR_NEEDLE_IS_NULL);
+}
+
+static void check_starts_with_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_starts_with((void *) 1, (void *) 1, NULL),
+            SEA_TURTLE_STRING_ERROR_OUT_IS_NULL);
+}
+
+static void check_starts_with(void **state) {
+    struct sea_turtle_string object;
+    assert_int_equal(sea_turtle_string_init(&object, u8"$£ह€한🐉",
+                                            SIZE_MAX, NULL), 0);
+    const char *chars[] = {u8"$£", u8"한🐉", u8"", u8"🐉🐉"};
+    const bool expected[] = {true, false, true, false};
+    for (size_t i = 0; i < 4; i++) {
+        struct sea_turtle_string needle;
+        assert_int_equal(sea_turtle_string_init(&needle, chars[i], SIZE_MAX,
+                                                NULL), 0);
+        bool out;
+        assert_int_equal(sea_turtle_string_starts_with(&object, &needle, &out),
+                         0);
+        assert_int_equal(out, expected[i]);
+        /* a needle longer than the string is never found */
+        assert_int_equal(sea_turtle_string_starts_with(&needle, &object, &out),
+                         0);
+        assert_false(out);
+        assert_int_equal(sea_turtle_string_invalidate(&needle), 0);
+    }
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_ends_with_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_ends_with(NULL, (void *) 1, (void *) 1),
+            SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_ends_with_error_on_needle_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_ends_with((void *) 1, NULL, (void *) 1),
+            SEA_TURTLE_STRING_ERROR_NEEDLE_IS_NULL);
+}
+
+static void check_ends_with_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_ends_with((void *) 1, (void *) 1, NULL),
+            SEA_TURTLE_STRING_ERROR_OUT_IS_NULL);
+}
+
+static void check_ends_with(void **state) {
+    struct sea_turtle_string object;
+    assert_int_equal(sea_turtle_string_init(&object, u8"$£ह€한🐉",
+                                            SIZE_MAX, NULL), 0);
+    const char *chars[] = {u8"$£", u8"한🐉", u8"", u8"🐉🐉"};
+    const bool expected[] = {false, true, true, false};
+    for (size_t i = 0; i < 4; i++) {
+        struct sea_turtle_string needle;
+        assert_int_equal(sea_turtle_string_init(&needle, chars[i], SIZE_MAX,
+                                                NULL), 0);
+        bool out;
+        assert_int_equal(sea_turtle_string_ends_with(&object, &needle, &out),
+                         0);
+        assert_int_equal(out, expected[i]);
+        /* a needle longer than the string is never found */
+        assert_int_equal(sea_turtle_string_ends_with(&needle, &object, &out),
+                         0);
+        assert_false(out);
+        assert_int_equal(sea_turtle_string_invalidate(&needle), 0);
+    }
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_split_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_split(NULL, (void *) 1, 0, false, (void *) 1),
+            SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_split_error_on_delimiter_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_split((void *) 1, NULL, 0, false, (void *) 1),
+            SEA_TURTLE_STRING_ERROR_DELIMITER_IS_NULL);
+}
+
+static void check_split_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_split((void *) 1, (void *) 1, 0, false, NULL),
+            SEA_TURTLE_STRING_ERROR_OUT_IS_NULL);
+}
+
+static void check_split_error_on_delimiter_is_empty(void **state) {
+    struct sea_turtle_string object;
+    assert_int_equal(sea_turtle_string_init(&object, "a,b", SIZE_MAX, NULL),
+                     0);
+    struct sea_turtle_string delimiter;
+    assert_int_equal(sea_turtle_string_init(&delimiter, "", SIZE_MAX,
+                                            NULL), 0);
+    struct sea_turtle_string_split split;
+    assert_int_equal(
+            sea_turtle_string_split(&object, &delimiter, 0, false, &split),
+            SEA_TURTLE_STRING_ERROR_DELIMITER_IS_EMPTY);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_split_next_error_on_object_is_null(void **state) {
+    assert_int_equal(sea_turtle_string_split_next(NULL, (void *) 1),
+                     SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_split_next_error_on_out_is_null(void **state) {
+    assert_int_equal(sea_turtle_string_split_next((void *) 1, NULL),
+                     SEA_TURTLE_STRING_ERROR_OUT_IS_NULL);
+}
+
+/* split chars on delimiter expecting the given pieces */
+static void pieces(const char *const chars, const char *const delimiter,
+                   const size_t limit, const bool skip_empty,
+                   const char *const *const expected, const size_t count) {
+    struct sea_turtle_string object;
+    assert_int_equal(sea_turtle_string_init(&object, chars, SIZE_MAX, NULL),
+                     0);
+    struct sea_turtle_string other;
+    assert_int_equal(sea_turtle_string_init(&other, delimiter, SIZE_MAX,
+                                            NULL), 0);
+    struct sea_turtle_string_split split;
+    assert_int_equal(sea_turtle_string_split(&object, &other, limit,
+                                             skip_empty, &split), 0);
+    struct sea_turtle_string_view out;
+    for (size_t i = 0; i < count; i++) {
+        assert_int_equal(sea_turtle_string_split_next(&split, &out), 0);
+        assert_int_equal(out.size, strlen(expected[i]));
+        uintmax_t code_points;
+        size_t length;
+        if (out.size) {
+            assert_memory_equal(out.data, expected[i], out.size);
+            assert_int_equal(sea_turtle_string_is_utf8_sequence(
+                    expected[i], out.size, &length, &code_points), 0);
+            assert_int_equal(out.count, code_points);
+        } else {
+            assert_int_equal(out.count, 0);
+        }
+    }
+    assert_int_equal(sea_turtle_string_split_next(&split, &out),
+                     SEA_TURTLE_STRING_ERROR_END_OF_SEQUENCE);
+    assert_int_equal(sea_turtle_string_split_next(&split, &out),
+                     SEA_TURTLE_STRING_ERROR_END_OF_SEQUENCE);
+    assert_int_equal(sea_turtle_string_invalidate(&other), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_split(void **state) {
+    pieces("a,b,,c,", ",", 0, false,
+           (const char *[]) {"a", "b", "", "c", ""}, 5);
+    pieces("a,b,,c,", ",", 0, true,
+           (const char *[]) {"a", "b", "c"}, 3);
+    pieces(",", ",", 0, false, (const char *[]) {"", ""}, 2);
+    pieces(",", ",", 0, true, NULL, 0);
+    pieces("", ",", 0, false, (const char *[]) {""}, 1);
+    pieces("", ",", 0, true, NULL, 0);
+    pieces("abc", ",", 0, false, (const char *[]) {"abc"}, 1);
+    /* multi-byte delimiter in between multi-byte pieces */
+    pieces(u8"$£🐉ह€🐉🐉한", u8"🐉", 0, false,
+           (const char *[]) {u8"$£", u8"ह€", u8"", u8"한"}, 4);
+    pieces(u8"$£ -> ह€ -> 한", " -> ", 0, false,
+           (const char *[]) {u8"$£", u8"ह€", u8"한"}, 3);
+}
+
+static void check_split_limit(void **state) {
+    pieces("a,b,,c,", ",", 1, false, (const char *[]) {"a,b,,c,"}, 1);
+    pieces("a,b,,c,", ",", 2, false, (const char *[]) {"a", "b,,c,"}, 2);
+    pieces("a,b,,c,", ",", 4, false,
+           (const char *[]) {"a", "b", "", "c,"}, 4);
+    /* skipped pieces do not count towards the limit */
+    pieces("a,,b,c", ",", 3, true, (const char *[]) {"a", "b", "c"}, 3);
+    pieces("a,b,c", ",", 10, false, (const char *[]) {"a", "b", "c"}, 3);
+}
+
+static void check_split_code_point(void **state) {
+    struct sea_turtle_string object;
+    long_string(&object);
+    struct sea_turtle_string delimiter;
+    assert_int_equal(sea_turtle_string_init(&delimiter, " ", SIZE_MAX,
+                                            NULL), 0);
+    struct sea_turtle_string_split split;
+    assert_int_equal(sea_turtle_string_split(&object, &delimiter, 0, true,
+                                             &split), 0);
+    struct sea_turtle_string_view out;
+    size_t count = 0;
+    int error;
+    while (!(error = sea_turtle_string_split_next(&split, &out))) {
+        assert_int_equal(out.count, 6);
+        /* pieces refer to the UTF-8 encoded symbols of the string */
+        uint32_t code_point;
+        assert_int_equal(sea_turtle_string_code_point(&object, out.data,
+                                                      &code_point), 0);
+        assert_int_equal(code_point, '$');
+        const uint8_t *at;
+        assert_int_equal(sea_turtle_string_next(&object, out.data, &at), 0);
+        assert_ptr_equal(at, out.data + 1);
+        count += 1;
+    }
+    assert_int_equal(error, SEA_TURTLE_STRING_ERROR_END_OF_SEQUENCE);
+    assert_int_equal(count, 97);
+    assert_int_equal(sea_turtle_string_invalidate(&delimiter), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
 int main(int argc, char *argv[]) {
     const struct CMUnitTest tests[] = {
             cmocka_unit_test(check_invalidate_error_on_object_is_null),
@@ -521,15 +2163,58 @@ int main(int argc, char *argv[]) {
             cmocka_unit_test(check_init_error_on_char_ptr_is_malformed),
             cmocka_unit_test(check_init_error_on_memory_allocation_failed),
             cmocka_unit_test(check_init),
+            cmocka_unit_test(check_init_local),
+            cmocka_unit_test(check_init_heap),
+            cmocka_unit_test(check_local_after_copy),
+            cmocka_unit_test(check_set_size),
+            cmocka_unit_test(check_init_hash),
             cmocka_unit_test(check_init_empty_char_sequence),
+            cmocka_unit_test(check_init_file_error_on_object_is_null),
+            cmocka_unit_test(check_init_file_error_on_size_is_zero),
+            cmocka_unit_test(check_init_file_error_on_fd_is_invalid),
+            cmocka_unit_test(
+                    check_init_file_error_on_offset_is_out_of_bounds),
+            cmocka_unit_test(check_init_file_error_on_char_ptr_is_malformed),
+            cmocka_unit_test(check_init_file),
+            cmocka_unit_test(check_init_file_region),
+            cmocka_unit_test(check_init_file_local),
+            cmocka_unit_test(check_init_file_copy),
             cmocka_unit_test(check_init_string_error_on_object_is_null),
             cmocka_unit_test(check_init_string_error_no_other_is_null),
             cmocka_unit_test(check_init_string),
+            cmocka_unit_test(check_is_utf8_sequence_error_on_char_ptr_is_null),
+            cmocka_unit_test(check_is_utf8_sequence_error_on_size_is_zero),
+            cmocka_unit_test(check_is_utf8_sequence_error_on_out_is_null),
+            cmocka_unit_test(
+                    check_is_utf8_sequence_error_on_char_ptr_is_malformed),
+            cmocka_unit_test(check_is_utf8_sequence),
+            cmocka_unit_test(check_share_error_on_object_is_null),
+            cmocka_unit_test(check_share_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_share_heap),
+            cmocka_unit_test(check_share_local),
+            cmocka_unit_test(check_share),
+            cmocka_unit_test(check_share_concurrently),
             cmocka_unit_test(check_count_error_on_object_is_null),
             cmocka_unit_test(check_count_error_on_out_is_null),
             cmocka_unit_test(check_count),
             cmocka_unit_test(check_compare),
+            cmocka_unit_test(check_equals_error_on_object_is_null),
+            cmocka_unit_test(check_equals_error_on_other_is_null),
+            cmocka_unit_test(check_equals_error_on_out_is_null),
+            cmocka_unit_test(check_equals),
+            cmocka_unit_test(check_equals_rejects_on_hash),
+            cmocka_unit_test(check_equals_any_error_on_object_is_null),
+            cmocka_unit_test(check_equals_any_error_on_others_is_null),
+            cmocka_unit_test(check_equals_any_error_on_out_is_null),
+            cmocka_unit_test(check_equals_any_error_on_other_not_found),
+            cmocka_unit_test(check_equals_any),
+            cmocka_unit_test(check_hash_error_on_object_is_null),
+            cmocka_unit_test(check_hash_error_on_out_is_null),
             cmocka_unit_test(check_hash),
+            cmocka_unit_test(check_hash_concurrently),
+            cmocka_unit_test(check_hash_128_error_on_object_is_null),
+            cmocka_unit_test(check_hash_128_error_on_out_is_null),
+            cmocka_unit_test(check_hash_128),
             cmocka_unit_test(check_first_error_on_object_is_null),
             cmocka_unit_test(check_first_error_on_out_is_null),
             cmocka_unit_test(check_first),
@@ -558,6 +2243,81 @@ int main(int argc, char *argv[]) {
             cmocka_unit_test(check_code_point_error_on_at_is_out_of_bounds),
             cmocka_unit_test(check_code_point_error_on_at_is_invalid),
             cmocka_unit_test(check_code_point),
+            cmocka_unit_test(check_init_code_points_error_on_object_is_null),
+            cmocka_unit_test(
+                    check_init_code_points_error_on_code_points_is_null),
+            cmocka_unit_test(
+                    check_init_code_points_error_on_code_point_is_invalid),
+            cmocka_unit_test(
+                    check_init_code_points_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_init_code_points),
+            cmocka_unit_test(check_code_points_error_on_object_is_null),
+            cmocka_unit_test(check_code_points_error_on_out_is_null),
+            cmocka_unit_test(check_code_points_error_on_index_is_out_of_bounds),
+            cmocka_unit_test(check_code_points),
+            cmocka_unit_test(check_init_utf16_error_on_object_is_null),
+            cmocka_unit_test(check_init_utf16_error_on_utf16_is_null),
+            cmocka_unit_test(check_init_utf16_error_on_order_is_invalid),
+            cmocka_unit_test(check_init_utf16_error_on_utf16_is_malformed),
+            cmocka_unit_test(
+                    check_init_utf16_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_init_utf16),
+            cmocka_unit_test(check_utf16_count_error_on_object_is_null),
+            cmocka_unit_test(check_utf16_count_error_on_out_is_null),
+            cmocka_unit_test(check_utf16_count),
+            cmocka_unit_test(check_to_utf16_error_on_object_is_null),
+            cmocka_unit_test(check_to_utf16_error_on_order_is_invalid),
+            cmocka_unit_test(check_to_utf16_error_on_out_is_null),
+            cmocka_unit_test(check_to_utf16_error_on_size_is_too_small),
+            cmocka_unit_test(check_to_utf16),
+            cmocka_unit_test(check_at_error_on_object_is_null),
+            cmocka_unit_test(check_at_error_on_out_is_null),
+            cmocka_unit_test(check_at_error_on_index_is_out_of_bounds),
+            cmocka_unit_test(check_at_ascii),
+            cmocka_unit_test(check_at_local),
+            cmocka_unit_test(check_at),
+            cmocka_unit_test(check_at_after_copy),
+            cmocka_unit_test(check_at_memory_allocation_failed),
+            cmocka_unit_test(check_at_set_size),
+            cmocka_unit_test(check_substring_error_on_object_is_null),
+            cmocka_unit_test(check_substring_error_on_out_is_null),
+            cmocka_unit_test(check_substring_error_on_index_is_out_of_bounds),
+            cmocka_unit_test(check_substring_error_on_count_is_out_of_bounds),
+            cmocka_unit_test(check_substring),
+            cmocka_unit_test(check_substring_long),
+            cmocka_unit_test(check_find_error_on_object_is_null),
+            cmocka_unit_test(check_find_error_on_needle_is_null),
+            cmocka_unit_test(check_find_error_on_out_is_null),
+            cmocka_unit_test(check_find_error_on_needle_not_found),
+            cmocka_unit_test(check_find),
+            cmocka_unit_test(check_find_long),
+            cmocka_unit_test(check_rfind_error_on_object_is_null),
+            cmocka_unit_test(check_rfind_error_on_needle_is_null),
+            cmocka_unit_test(check_rfind_error_on_out_is_null),
+            cmocka_unit_test(check_rfind_error_on_needle_not_found),
+            cmocka_unit_test(check_rfind),
+            cmocka_unit_test(check_rfind_long),
+            cmocka_unit_test(check_contains_error_on_object_is_null),
+            cmocka_unit_test(check_contains_error_on_needle_is_null),
+            cmocka_unit_test(check_contains_error_on_out_is_null),
+            cmocka_unit_test(check_contains),
+            cmocka_unit_test(check_starts_with_error_on_object_is_null),
+            cmocka_unit_test(check_starts_with_error_on_needle_is_null),
+            cmocka_unit_test(check_starts_with_error_on_out_is_null),
+            cmocka_unit_test(check_starts_with),
+            cmocka_unit_test(check_ends_with_error_on_object_is_null),
+            cmocka_unit_test(check_ends_with_error_on_needle_is_null),
+            cmocka_unit_test(check_ends_with_error_on_out_is_null),
+            cmocka_unit_test(check_ends_with),
+            cmocka_unit_test(check_split_error_on_object_is_null),
+            cmocka_unit_test(check_split_error_on_delimiter_is_null),
+            cmocka_unit_test(check_split_error_on_out_is_null),
+            cmocka_unit_test(check_split_error_on_delimiter_is_empty),
+            cmocka_unit_test(check_split_next_error_on_object_is_null),
+            cmocka_unit_test(check_split_next_error_on_out_is_null),
+            cmocka_unit_test(check_split),
+            cmocka_unit_test(check_split_limit),
+            cmocka_unit_test(check_split_code_point),
     };
     //cmocka_set_message_output(CM_OUTPUT_XML);
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -0,0 +1,247 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sea-turtle.h>
+#include <seagrass.h>
+
+#include <test/cmocka.h>
+
+#include "private/string.h"
+#include "test_string_helpers.h"
+
+/* fields of a row, the long one does not fit in a local buffer */
+static const char row[] = u8"id,🐢,a rather long field of the row,,£ह€";
+static const size_t offsets[] = {0, 3, 8, 39, 40};
+static const size_t sizes[] = {2, 4, 30, 0, 16};
+#define FIELDS (sizeof(offsets) / sizeof(offsets[0]))
+
+static void check_invalidate_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_arena_invalidate(NULL),
+            SEA_TURTLE_STRING_ARENA_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_invalidate(void **state) {
+    struct sea_turtle_string_arena object = {};
+    assert_int_equal(sea_turtle_string_arena_invalidate(&object), 0);
+}
+
+static void check_init_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_arena_init(NULL),
+            SEA_TURTLE_STRING_ARENA_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init(void **state) {
+    struct sea_turtle_string_arena object;
+    assert_int_equal(sea_turtle_string_arena_init(&object), 0);
+    assert_null(object.blocks);
+    assert_int_equal(sea_turtle_string_arena_invalidate(&object), 0);
+}
+
+static void check_init_strings_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_arena_init_strings(NULL, (void *) 1,
+                                                 (void *) 1, (void *) 1, 0,
+                                                 (void *) 1),
+            SEA_TURTLE_STRING_ARENA_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init_strings_error_on_char_ptr_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_arena_init_strings((void *) 1, NULL,
+                                                 (void *) 1, (void *) 1, 0,
+                                                 (void *) 1),
+            SEA_TURTLE_STRING_ARENA_ERROR_CHAR_PTR_IS_NULL);
+}
+
+static void check_init_strings_error_on_offsets_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_arena_init_strings((void *) 1, (void *) 1,
+                                                 NULL, (void *) 1, 0,
+                                                 (void *) 1),
+            SEA_TURTLE_STRING_ARENA_ERROR_OFFSETS_IS_NULL);
+}
+
+static void check_init_strings_error_on_sizes_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_arena_init_strings((void *) 1, (void *) 1,
+                                                 (void *) 1, NULL, 0,
+                                                 (void *) 1),
+            SEA_TURTLE_STRING_ARENA_ERROR_SIZES_IS_NULL);
+}
+
+static void check_init_strings_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_arena_init_strings((void *) 1, (void *) 1,
+                                                 (void *) 1, (void *) 1, 0,
+                                                 NULL),
+            SEA_TURTLE_STRING_ARENA_ERROR_OUT_IS_NULL);
+}
+
+static void check_init_strings_error_on_char_ptr_is_malformed(void **state) {
+    struct sea_turtle_string_arena object;
+    assert_int_equal(sea_turtle_string_arena_init(&object), 0);
+    const char chars[] = "valid,a rather long valid field,\xE0\x80\x80";
+    const size_t o[] = {0, 6, 32};
+    const size_t s[] = {5, 25, 3};
+    struct sea_turtle_string out[3];
+    assert_int_equal(
+            sea_turtle_string_arena_init_strings(&object, chars, o, s, 3,
+                                                 out),
+            SEA_TURTLE_STRING_ARENA_ERROR_CHAR_PTR_IS_MALFORMED);
+    /* none of the strings were initialized */
+    for (size_t i = 0; i < 3; i++) {
+        assert_null(out[i].data);
+        assert_int_equal(out[i].size, 0);
+    }
+    assert_null(object.blocks);
+    /* malformed input is reported ahead of failed memory allocation */
+    malloc_is_overridden = true;
+    assert_int_equal(
+            sea_turtle_string_arena_init_strings(&object, chars, o, s, 3,
+                                                 out),
+            SEA_TURTLE_STRING_ARENA_ERROR_CHAR_PTR_IS_MALFORMED);
+    malloc_is_overridden = false;
+    assert_int_equal(sea_turtle_string_arena_invalidate(&object), 0);
+}
+
+static void check_init_strings_error_on_memory_allocation_failed(
+        void **state) {
+    struct sea_turtle_string_arena object;
+    assert_int_equal(sea_turtle_string_arena_init(&object), 0);
+    struct sea_turtle_string out[FIELDS];
+    malloc_is_overridden = true;
+    assert_int_equal(
+            sea_turtle_string_arena_init_strings(&object, row, offsets,
+                                                 sizes, FIELDS, out),
+            SEA_TURTLE_STRING_ARENA_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = false;
+    assert_null(object.blocks);
+    assert_int_equal(sea_turtle_string_arena_invalidate(&object), 0);
+}
+
+static void check_init_strings(void **state) {
+    struct sea_turtle_string_arena object;
+    assert_int_equal(sea_turtle_string_arena_init(&object), 0);
+    struct sea_turtle_string out[FIELDS];
+    assert_int_equal(
+            sea_turtle_string_arena_init_strings(&object, row, offsets,
+                                                 sizes, FIELDS, out), 0);
+    assert_non_null(object.blocks);
+    assert_string_equal_char_ptr(&out[0], u8"id");
+    assert_int_equal(sea_turtle_string_storage_of(&out[0]),
+                     SEA_TURTLE_STRING_STORAGE_LOCAL);
+    assert_string_equal((const char *) out[0].local, u8"id");
+    assert_string_equal_char_ptr(&out[1], u8"🐢");
+    assert_string_equal_char_ptr(&out[2], u8"a rather long field of the row");
+    assert_int_equal(sea_turtle_string_storage_of(&out[2]),
+                     SEA_TURTLE_STRING_STORAGE_ARENA);
+    assert_int_equal(out[2].data[out[2].size - 1], 0);
+    assert_int_equal(out[3].size, 0);
+    assert_int_equal(sea_turtle_string_count_of(&out[3]), 0);
+    /* the size is only an upper limit */
+    assert_string_equal_char_ptr(&out[4], u8"£ह€");
+    for (size_t i = 0; i < FIELDS; i++) {
+        assert_int_equal(sea_turtle_string_invalidate(&out[i]), 0);
+    }
+    assert_int_equal(sea_turtle_string_arena_invalidate(&object), 0);
+}
+
+static void check_init_strings_single_block(void **state) {
+    struct sea_turtle_string_arena object;
+    assert_int_equal(sea_turtle_string_arena_init(&object), 0);
+    const size_t count = 1000;
+    const size_t length = 40;
+    char *const chars = malloc(count * length);
+    size_t *const o = malloc(count * sizeof(*o));
+    size_t *const s = malloc(count * sizeof(*s));
+    struct sea_turtle_string *const out = malloc(count * sizeof(*out));
+    assert_non_null(chars);
+    assert_non_null(o);
+    assert_non_null(s);
+    assert_non_null(out);
+    for (size_t i = 0; i < count; i++) {
+        memset(chars + i * length, 'a' + (i % 26), length);
+        o[i] = i * length;
+        s[i] = length;
+    }
+    assert_int_equal(
+            sea_turtle_string_arena_init_strings(&object, chars, o, s, count,
+                                                 out), 0);
+    /* all the values were placed one after the other in the same block */
+    for (size_t i = 1; i < count; i++) {
+        assert_int_equal(sea_turtle_string_storage_of(&out[i]),
+                         SEA_TURTLE_STRING_STORAGE_ARENA);
+        assert_ptr_equal(out[i].data, out[i - 1].data + 1 + length);
+        assert_memory_equal(out[i].data, chars + i * length, length);
+    }
+    /* each call places its values into a block of its own */
+    struct sea_turtle_string_arena_block *const block = object.blocks;
+    assert_int_equal(
+            sea_turtle_string_arena_init_strings(&object, chars, o, s, 1,
+                                                 out), 0);
+    assert_ptr_not_equal(object.blocks, block);
+    free(chars);
+    free(o);
+    free(s);
+    free(out);
+    assert_int_equal(sea_turtle_string_arena_invalidate(&object), 0);
+}
+
+static void check_init_strings_copy(void **state) {
+    struct sea_turtle_string_arena object;
+    assert_int_equal(sea_turtle_string_arena_init(&object), 0);
+    struct sea_turtle_string out[FIELDS];
+    assert_int_equal(
+            sea_turtle_string_arena_init_strings(&object, row, offsets,
+                                                 sizes, FIELDS, out), 0);
+    struct sea_turtle_string copy;
+    assert_int_equal(sea_turtle_string_init_string(&copy, &out[2]), 0);
+    assert_int_equal(sea_turtle_string_storage_of(&copy),
+                     SEA_TURTLE_STRING_STORAGE_HEAP);
+    struct sea_turtle_string shared = out[2];
+    assert_int_equal(sea_turtle_string_share(&shared), 0);
+    assert_int_equal(sea_turtle_string_storage_of(&shared),
+                     SEA_TURTLE_STRING_STORAGE_SHARED);
+    struct sea_turtle_string resized = out[2];
+    assert_int_equal(sea_turtle_string_set_size(&resized, 5), 0);
+    assert_int_equal(sea_turtle_string_storage_of(&resized),
+                     SEA_TURTLE_STRING_STORAGE_LOCAL);
+    assert_memory_equal(resized.local, "a ra", 5);
+    /* copies outlive the arena */
+    assert_int_equal(sea_turtle_string_arena_invalidate(&object), 0);
+    assert_string_equal_char_ptr(&copy, u8"a rather long field of the row");
+    assert_string_equal_char_ptr(&shared,
+                                 u8"a rather long field of the row");
+    assert_int_equal(sea_turtle_string_invalidate(&copy), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&shared), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&resized), 0);
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_invalidate_error_on_object_is_null),
+            cmocka_unit_test(check_invalidate),
+            cmocka_unit_test(check_init_error_on_object_is_null),
+            cmocka_unit_test(check_init),
+            cmocka_unit_test(check_init_strings_error_on_object_is_null),
+            cmocka_unit_test(check_init_strings_error_on_char_ptr_is_null),
+            cmocka_unit_test(check_init_strings_error_on_offsets_is_null),
+            cmocka_unit_test(check_init_strings_error_on_sizes_is_null),
+            cmocka_unit_test(check_init_strings_error_on_out_is_null),
+            cmocka_unit_test(
+                    check_init_strings_error_on_char_ptr_is_malformed),
+            cmocka_unit_test(
+                    check_init_strings_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_init_strings),
+            cmocka_unit_test(check_init_strings_single_block),
+            cmocka_unit_test(check_init_strings_copy),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,471 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sea-turtle.h>
+#include <seagrass.h>
+
+#include <test/cmocka.h>
+
+#include "private/string.h"
+#include "test_string_helpers.h"
+
+static void check_invalidate_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_builder_invalidate(NULL),
+            SEA_TURTLE_STRING_BUILDER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_invalidate(void **state) {
+    struct sea_turtle_string_builder object = {};
+    assert_int_equal(sea_turtle_string_builder_invalidate(&object), 0);
+}
+
+static void check_init_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_builder_init(NULL),
+            SEA_TURTLE_STRING_BUILDER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init(void **state) {
+    struct sea_turtle_string_builder object;
+    assert_int_equal(sea_turtle_string_builder_init(&object), 0);
+    assert_int_equal(object.size, 0);
+    assert_int_equal(object.count, 0);
+    assert_int_equal(sea_turtle_string_builder_invalidate(&object), 0);
+}
+
+static void check_reserve_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_builder_reserve(NULL, 1),
+            SEA_TURTLE_STRING_BUILDER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_reserve_error_on_memory_allocation_failed(void **state) {
+    struct sea_turtle_string_builder object;
+    assert_int_equal(sea_turtle_string_builder_init(&object), 0);
+    assert_int_equal(sea_turtle_string_builder_reserve(&object, SIZE_MAX),
+                     SEA_TURTLE_STRING_BUILDER_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = realloc_is_overridden = true;
+    assert_int_equal(sea_turtle_string_builder_reserve(&object, 1),
+                     SEA_TURTLE_STRING_BUILDER_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = realloc_is_overridden = false;
+    assert_int_equal(sea_turtle_string_builder_invalidate(&object), 0);
+}
+
+static void check_reserve_error_on_size_exceeds_string_size_max(
+        void **state) {
+    struct sea_turtle_string_builder object;
+    assert_int_equal(sea_turtle_string_builder_init(&object), 0);
+    /* pretend to hold a string of the largest size there may be */
+    object.size = SEA_TURTLE_STRING_SIZE_MAX - 1;
+    object.capacity = SIZE_MAX;
+    assert_int_equal(sea_turtle_string_builder_reserve(&object, 0), 0);
+    assert_int_equal(sea_turtle_string_builder_reserve(&object, 1),
+                     SEA_TURTLE_STRING_BUILDER_ERROR_MEMORY_ALLOCATION_FAILED);
+    assert_int_equal(sea_turtle_string_builder_append_code_point(&object, 'a'),
+                     SEA_TURTLE_STRING_BUILDER_ERROR_MEMORY_ALLOCATION_FAILED);
+    object = (struct sea_turtle_string_builder) {0};
+    assert_int_equal(sea_turtle_string_builder_invalidate(&object), 0);
+}
+
+static void check_reserve(void **state) {
+    struct sea_turtle_string_builder object;
+    assert_int_equal(sea_turtle_string_builder_init(&object), 0);
+    assert_int_equal(sea_turtle_string_builder_reserve(&object, 1000), 0);
+    assert_true(object.capacity > 1000);
+    const size_t capacity = object.capacity;
+    assert_int_equal(sea_turtle_string_builder_reserve(&object, 10), 0);
+    assert_int_equal(object.capacity, capacity);
+    assert_int_equal(sea_turtle_string_builder_invalidate(&object), 0);
+}
+
+static void check_append_char_ptr_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_builder_append_char_ptr(NULL, (void *) 1, 1,
+                                                      NULL),
+            SEA_TURTLE_STRING_BUILDER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_append_char_ptr_error_on_char_ptr_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_builder_append_char_ptr((void *) 1, NULL, 1,
+                                                      NULL),
+            SEA_TURTLE_STRING_BUILDER_ERROR_CHAR_PTR_IS_NULL);
+}
+
+static void check_append_char_ptr_error_on_size_is_zero(void **state) {
+    assert_int_equal(
+            sea_turtle_string_builder_append_char_ptr((void *) 1, (void *) 1,
+                                                      0, NULL),
+            SEA_TURTLE_STRING_BUILDER_ERROR_SIZE_IS_ZERO);
+}
+
+static void check_append_char_ptr_error_on_char_ptr_is_malformed(
+        void **state) {
+    struct sea_turtle_string_builder object;
+    assert_int_equal(sea_turtle_string_builder_init(&object), 0);
+    assert_int_equal(sea_turtle_string_builder_append_char_ptr(
+            &object, "abc", SIZE_MAX, NULL), 0);
+    assert_int_equal(sea_turtle_string_builder_append_char_ptr(
+            &object, "d\xC0\xAF", SIZE_MAX, NULL),
+                     SEA_TURTLE_STRING_BUILDER_ERROR_CHAR_PTR_IS_MALFORMED);
+    realloc_is_overridden = true;
+    assert_int_equal(sea_turtle_string_builder_append_char_ptr(
+            &object, "\xFF and then enough chars to need a larger buffer"
+                     " than the one we have reserved so far",
+            SIZE_MAX, NULL),
+                     SEA_TURTLE_STRING_BUILDER_ERROR_CHAR_PTR_IS_MALFORMED);
+    realloc_is_overridden = false;
+    struct sea_turtle_string string;
+    assert_int_equal(sea_turtle_string_builder_finish(&object, &string), 0);
+    assert_string_equal_char_ptr(&string, "abc");
+    assert_int_equal(sea_turtle_string_invalidate(&string), 0);
+    assert_int_equal(sea_turtle_string_builder_invalidate(&object), 0);
+}
+
+static void check_append_char_ptr(void **state) {
+    struct sea_turtle_string_builder object;
+    assert_int_equal(sea_turtle_string_builder_init(&object), 0);
+    size_t out;
+    assert_int_equal(sea_turtle_string_builder_append_char_ptr(
+            &object, u8"sea 🐢", SIZE_MAX, &out), 0);
+    assert_int_equal(out, strlen(u8"sea 🐢"));
+    assert_int_equal(sea_turtle_string_builder_append_char_ptr(
+            &object, " turtle", 4, &out), 0);
+    assert_int_equal(out, 4);
+    assert_int_equal(sea_turtle_string_builder_append_char_ptr(
+            &object, "", SIZE_MAX, &out), 0);
+    assert_int_equal(out, 0);
+    struct sea_turtle_string string;
+    assert_int_equal(sea_turtle_string_builder_finish(&object, &string), 0);
+    assert_string_equal_char_ptr(&string, u8"sea 🐢 tur");
+    assert_int_equal(sea_turtle_string_invalidate(&string), 0);
+    assert_int_equal(sea_turtle_string_builder_invalidate(&object), 0);
+}
+
+static void check_append_code_point_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_builder_append_code_point(NULL, 'a'),
+            SEA_TURTLE_STRING_BUILDER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_append_code_point_error_on_code_point_is_invalid(
+        void **state) {
+    struct sea_turtle_string_builder object;
+    assert_int_equal(sea_turtle_string_builder_init(&object), 0);
+    assert_int_equal(
+            sea_turtle_string_builder_append_code_point(&object, 0xD800),
+            SEA_TURTLE_STRING_BUILDER_ERROR_CODE_POINT_IS_INVALID);
+    assert_int_equal(
+            sea_turtle_string_builder_append_code_point(&object, 0x110000),
+            SEA_TURTLE_STRING_BUILDER_ERROR_CODE_POINT_IS_INVALID);
+    assert_int_equal(sea_turtle_string_builder_invalidate(&object), 0);
+}
+
+static void check_append_code_point(void **state) {
+    struct sea_turtle_string_builder object;
+    assert_int_equal(sea_turtle_string_builder_init(&object), 0);
+    const uint32_t code_points[] = {'$', 0xA3, 0x20AC, 0x1F422};
+    for (size_t i = 0; i < 4; i++) {
+        assert_int_equal(sea_turtle_string_builder_append_code_point(
+                &object, code_points[i]), 0);
+    }
+    struct sea_turtle_string string;
+    assert_int_equal(sea_turtle_string_builder_finish(&object, &string), 0);
+    assert_string_equal_char_ptr(&string, u8"$£€🐢");
+    assert_int_equal(sea_turtle_string_invalidate(&string), 0);
+    assert_int_equal(sea_turtle_string_builder_invalidate(&object), 0);
+}
+
+static void check_append_string_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_builder_append_string(NULL, (void *) 1),
+            SEA_TURTLE_STRING_BUILDER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_append_string_error_on_string_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_builder_append_string((void *) 1, NULL),
+            SEA_TURTLE_STRING_BUILDER_ERROR_STRING_IS_NULL);
+}
+
+static void check_append_string(void **state) {
+    struct sea_turtle_string_builder object;
+    assert_int_equal(sea_turtle_string_builder_init(&object), 0);
+    struct sea_turtle_string string;
+    assert_int_equal(sea_turtle_string_init(&string, u8"🐢 and ", SIZE_MAX,
+                                            NULL), 0);
+    assert_int_equal(sea_turtle_string_builder_append_string(
+            &object, &string), 0);
+    assert_int_equal(sea_turtle_string_builder_append_string(
+            &object, &string), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&string), 0);
+    assert_int_equal(sea_turtle_string_builder_append_string(
+            &object, &string), 0);
+    assert_int_equal(sea_turtle_string_builder_finish(&object, &string), 0);
+    assert_string_equal_char_ptr(&string, u8"🐢 and 🐢 and ");
+    assert_int_equal(sea_turtle_string_invalidate(&string), 0);
+    assert_int_equal(sea_turtle_string_builder_invalidate(&object), 0);
+}
+
+static void check_append_chunk_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_builder_append_chunk(NULL, (void *) 1, 1),
+            SEA_TURTLE_STRING_BUILDER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_append_chunk_error_on_chunk_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_builder_append_chunk((void *) 1, NULL, 1),
+            SEA_TURTLE_STRING_BUILDER_ERROR_CHUNK_IS_NULL);
+}
+
+static void check_append_chunk_error_on_size_is_zero(void **state) {
+    assert_int_equal(
+            sea_turtle_string_builder_append_chunk((void *) 1, (void *) 1, 0),
+            SEA_TURTLE_STRING_BUILDER_ERROR_SIZE_IS_ZERO);
+}
+
+static void check_append_chunk_error_on_chunk_is_malformed(void **state) {
+    const char *const chunks[][2] = {
+            /* cut short and continued by something else */
+            {"ab\xE2\x82", "c"},
+            {"ab\xF0", "\x9F\xF0"},
+            /* announce a symbol that can never be valid */
+            {"ab\xF5", "\x80"},
+            {"ab\xE0", "\x80\x80"},
+            {"ab\xED", "\xA0"},
+            /* continuation without a symbol to continue */
+            {"ab", "\x80"},
+    };
+    for (size_t i = 0; i < sizeof(chunks) / sizeof(chunks[0]); i++) {
+        struct sea_turtle_string_builder object;
+        assert_int_equal(sea_turtle_string_builder_init(&object), 0);
+        int error = sea_turtle_string_builder_append_chunk(
+                &object, chunks[i][0], strlen(chunks[i][0]));
+        if (!error) {
+            const size_t size = object.size;
+            const uint8_t pending = object.pending;
+            error = sea_turtle_string_builder_append_chunk(
+                    &object, chunks[i][1], strlen(chunks[i][1]));
+            /* nothing is appended */
+            assert_int_equal(object.size, size);
+            assert_int_equal(object.pending, pending);
+        }
+        assert_int_equal(error,
+                         SEA_TURTLE_STRING_BUILDER_ERROR_CHUNK_IS_MALFORMED);
+        assert_int_equal(sea_turtle_string_builder_invalidate(&object), 0);
+    }
+    /* strings cannot hold the NULL char */
+    struct sea_turtle_string_builder object;
+    assert_int_equal(sea_turtle_string_builder_init(&object), 0);
+    assert_int_equal(sea_turtle_string_builder_append_chunk(
+            &object, "ab\0cd", 5),
+                     SEA_TURTLE_STRING_BUILDER_ERROR_CHUNK_IS_MALFORMED);
+    assert_int_equal(object.size, 0);
+    assert_int_equal(sea_turtle_string_builder_invalidate(&object), 0);
+}
+
+static void check_append_chunk_error_on_memory_allocation_failed(
+        void **state) {
+    struct sea_turtle_string_builder object;
+    assert_int_equal(sea_turtle_string_builder_init(&object), 0);
+    malloc_is_overridden = realloc_is_overridden = true;
+    assert_int_equal(sea_turtle_string_builder_append_chunk(
+            &object, u8"ab🐢", 4),
+                     SEA_TURTLE_STRING_BUILDER_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = realloc_is_overridden = false;
+    assert_int_equal(object.size, 0);
+    assert_int_equal(object.pending, 0);
+    assert_int_equal(sea_turtle_string_builder_invalidate(&object), 0);
+}
+
+static void check_append_chunk(void **state) {
+    const char chars[] = u8"$£ह€한🐉 split anywhere 🐢 even at the very end 🐉";
+    const size_t length = sizeof(chars) - 1;
+    /* every position at which the input can be split into two chunks */
+    for (size_t i = 1; i < length; i++) {
+        struct sea_turtle_string_builder object;
+        assert_int_equal(sea_turtle_string_builder_init(&object), 0);
+        assert_int_equal(sea_turtle_string_builder_append_chunk(
+                &object, chars, i), 0);
+        assert_int_equal(sea_turtle_string_builder_append_chunk(
+                &object, chars + i, length - i), 0);
+        struct sea_turtle_string string;
+        assert_int_equal(sea_turtle_string_builder_finish(&object, &string),
+                         0);
+        assert_string_equal_char_ptr(&string, chars);
+        assert_int_equal(sea_turtle_string_invalidate(&string), 0);
+        assert_int_equal(sea_turtle_string_builder_invalidate(&object), 0);
+    }
+    /* one byte at a time */
+    struct sea_turtle_string_builder object;
+    assert_int_equal(sea_turtle_string_builder_init(&object), 0);
+    for (size_t i = 0; i < length; i++) {
+        assert_int_equal(sea_turtle_string_builder_append_chunk(
+                &object, chars + i, 1), 0);
+    }
+    struct sea_turtle_string string;
+    assert_int_equal(sea_turtle_string_builder_finish(&object, &string), 0);
+    assert_string_equal_char_ptr(&string, chars);
+    assert_int_equal(sea_turtle_string_invalidate(&string), 0);
+    assert_int_equal(sea_turtle_string_builder_invalidate(&object), 0);
+}
+
+static void check_append_chunk_incomplete(void **state) {
+    struct sea_turtle_string_builder object;
+    assert_int_equal(sea_turtle_string_builder_init(&object), 0);
+    assert_int_equal(sea_turtle_string_builder_append_chunk(
+            &object, "turtle \xF0\x9F", 9), 0);
+    assert_int_equal(object.pending, 2);
+    assert_int_equal(object.count, 7);
+    /* the symbol must be completed before anything else is appended */
+    struct sea_turtle_string string;
+    assert_int_equal(sea_turtle_string_builder_finish(&object, &string),
+                     SEA_TURTLE_STRING_BUILDER_ERROR_SEQUENCE_IS_INCOMPLETE);
+    assert_int_equal(sea_turtle_string_builder_append_char_ptr(
+            &object, "a", 1, NULL),
+                     SEA_TURTLE_STRING_BUILDER_ERROR_SEQUENCE_IS_INCOMPLETE);
+    assert_int_equal(sea_turtle_string_builder_append_code_point(
+            &object, 'a'),
+                     SEA_TURTLE_STRING_BUILDER_ERROR_SEQUENCE_IS_INCOMPLETE);
+    assert_int_equal(sea_turtle_string_builder_append_string(
+            &object, &(struct sea_turtle_string) {0}),
+                     SEA_TURTLE_STRING_BUILDER_ERROR_SEQUENCE_IS_INCOMPLETE);
+    assert_int_equal(sea_turtle_string_builder_append_chunk(
+            &object, "\x90", 1), 0);
+    assert_int_equal(object.pending, 3);
+    assert_int_equal(sea_turtle_string_builder_append_chunk(
+            &object, "\xA2!", 2), 0);
+    assert_int_equal(object.pending, 0);
+    assert_int_equal(sea_turtle_string_builder_append_code_point(
+            &object, 'a'), 0);
+    assert_int_equal(sea_turtle_string_builder_finish(&object, &string), 0);
+    assert_string_equal_char_ptr(&string, u8"turtle 🐢!a");
+    assert_int_equal(sea_turtle_string_invalidate(&string), 0);
+    assert_int_equal(sea_turtle_string_builder_invalidate(&object), 0);
+}
+
+static void check_finish_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_builder_finish(NULL, (void *) 1),
+            SEA_TURTLE_STRING_BUILDER_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_finish_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_builder_finish((void *) 1, NULL),
+            SEA_TURTLE_STRING_BUILDER_ERROR_OUT_IS_NULL);
+}
+
+static void check_finish(void **state) {
+    struct sea_turtle_string_builder object;
+    assert_int_equal(sea_turtle_string_builder_init(&object), 0);
+    struct sea_turtle_string string;
+    assert_int_equal(sea_turtle_string_builder_finish(&object, &string), 0);
+    assert_string_equal_char_ptr(&string, "");
+    assert_int_equal(sea_turtle_string_invalidate(&string), 0);
+    /* the buffer is handed over without copying */
+    const char *chars = u8"long enough to be stored on the heap 🐢";
+    assert_int_equal(sea_turtle_string_builder_append_char_ptr(
+            &object, chars, SIZE_MAX, NULL), 0);
+    const uint8_t *const data = object.data;
+    malloc_is_overridden = realloc_is_overridden = true;
+    assert_int_equal(sea_turtle_string_builder_finish(&object, &string), 0);
+    malloc_is_overridden = realloc_is_overridden = false;
+    assert_ptr_equal(string.data, data);
+    assert_int_equal(sea_turtle_string_storage_of(&string),
+                     SEA_TURTLE_STRING_STORAGE_HEAP);
+    assert_null(object.data);
+    assert_string_equal_char_ptr(&string, chars);
+    assert_int_equal(sea_turtle_string_invalidate(&string), 0);
+    /* short strings are stored locally and the buffer is kept */
+    assert_int_equal(sea_turtle_string_builder_append_char_ptr(
+            &object, "short", SIZE_MAX, NULL), 0);
+    assert_int_equal(sea_turtle_string_builder_finish(&object, &string), 0);
+    assert_int_equal(sea_turtle_string_storage_of(&string),
+                     SEA_TURTLE_STRING_STORAGE_LOCAL);
+    assert_non_null(object.data);
+    assert_int_equal(object.size, 0);
+    assert_string_equal_char_ptr(&string, "short");
+    assert_int_equal(sea_turtle_string_invalidate(&string), 0);
+    assert_int_equal(sea_turtle_string_builder_invalidate(&object), 0);
+}
+
+static void check_build_large(void **state) {
+    struct sea_turtle_string_builder object;
+    assert_int_equal(sea_turtle_string_builder_init(&object), 0);
+    char chars[32];
+    size_t reallocations = 0;
+    size_t capacity = object.capacity;
+    for (size_t i = 0; i < 100000; i++) {
+        snprintf(chars, sizeof(chars), u8"%zu🐢", i);
+        assert_int_equal(sea_turtle_string_builder_append_char_ptr(
+                &object, chars, sizeof(chars), NULL), 0);
+        assert_int_equal(sea_turtle_string_builder_append_code_point(
+                &object, 0xE9), 0);
+        if (capacity != object.capacity) {
+            capacity = object.capacity;
+            reallocations += 1;
+        }
+    }
+    /* geometric growth */
+    assert_true(reallocations < 32);
+    const size_t size = object.size;
+    char *const expected = malloc(size + 1);
+    assert_non_null(expected);
+    memcpy(expected, object.data, size);
+    expected[size] = 0;
+    struct sea_turtle_string string;
+    assert_int_equal(sea_turtle_string_builder_finish(&object, &string), 0);
+    assert_string_equal_char_ptr(&string, expected);
+    assert_int_equal(sea_turtle_string_invalidate(&string), 0);
+    assert_int_equal(sea_turtle_string_builder_invalidate(&object), 0);
+    free(expected);
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_invalidate_error_on_object_is_null),
+            cmocka_unit_test(check_invalidate),
+            cmocka_unit_test(check_init_error_on_object_is_null),
+            cmocka_unit_test(check_init),
+            cmocka_unit_test(check_reserve_error_on_object_is_null),
+            cmocka_unit_test(check_reserve_error_on_memory_allocation_failed),
+            cmocka_unit_test(
+                    check_reserve_error_on_size_exceeds_string_size_max),
+            cmocka_unit_test(check_reserve),
+            cmocka_unit_test(check_append_char_ptr_error_on_object_is_null),
+            cmocka_unit_test(check_append_char_ptr_error_on_char_ptr_is_null),
+            cmocka_unit_test(check_append_char_ptr_error_on_size_is_zero),
+            cmocka_unit_test(
+                    check_append_char_ptr_error_on_char_ptr_is_malformed),
+            cmocka_unit_test(check_append_char_ptr),
+            cmocka_unit_test(check_append_code_point_error_on_object_is_null),
+            cmocka_unit_test(
+                    check_append_code_point_error_on_code_point_is_invalid),
+            cmocka_unit_test(check_append_code_point),
+            cmocka_unit_test(check_append_string_error_on_object_is_null),
+            cmocka_unit_test(check_append_string_error_on_string_is_null),
+            cmocka_unit_test(check_append_string),
+            cmocka_unit_test(check_append_chunk_error_on_object_is_null),
+            cmocka_unit_test(check_append_chunk_error_on_chunk_is_null),
+            cmocka_unit_test(check_append_chunk_error_on_size_is_zero),
+            cmocka_unit_test(check_append_chunk_error_on_chunk_is_malformed),
+            cmocka_unit_test(
+                    check_append_chunk_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_append_chunk),
+            cmocka_unit_test(check_append_chunk_incomplete),
+            cmocka_unit_test(check_finish_error_on_object_is_null),
+            cmocka_unit_test(check_finish_error_on_out_is_null),
+            cmocka_unit_test(check_finish),
+            cmocka_unit_test(check_build_large),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
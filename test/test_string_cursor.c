@@ -0,0 +1,144 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <string.h>
+#include <sea-turtle.h>
+#include <seagrass.h>
+
+#include <test/cmocka.h>
+
+#include "private/string.h"
+
+static const uint32_t expected[] = {0x24, 0xA3, 0x939, 0x20AC, 0xD55C,
+                                    0x1F409};
+
+static void check_next(void **state) {
+    struct sea_turtle_string object;
+    assert_int_equal(sea_turtle_string_init(&object, u8"$£ह€한🐉", SIZE_MAX,
+                                            NULL), 0);
+    /* the local buffer is found in a copy of the instance */
+    struct sea_turtle_string copy = object;
+    struct sea_turtle_string_cursor cursor;
+    sea_turtle_string_cursor_init(&cursor, &copy);
+    uint32_t out;
+    for (size_t i = 0; i < 6; i++) {
+        assert_true(sea_turtle_string_cursor_next(&cursor, &out));
+        assert_int_equal(out, expected[i]);
+    }
+    assert_false(sea_turtle_string_cursor_next(&cursor, &out));
+    assert_ptr_equal(cursor.at, cursor.end);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_prev(void **state) {
+    struct sea_turtle_string object;
+    assert_int_equal(sea_turtle_string_init(&object, u8"$£ह€한🐉", SIZE_MAX,
+                                            NULL), 0);
+    struct sea_turtle_string_cursor cursor;
+    sea_turtle_string_cursor_init(&cursor, &object);
+    sea_turtle_string_cursor_seek_end(&cursor);
+    uint32_t out;
+    for (size_t i = 6; i; i--) {
+        assert_true(sea_turtle_string_cursor_prev(&cursor, &out));
+        assert_int_equal(out, expected[i - 1]);
+    }
+    assert_false(sea_turtle_string_cursor_prev(&cursor, &out));
+    assert_ptr_equal(cursor.at, cursor.begin);
+    /* moving back and forth */
+    assert_true(sea_turtle_string_cursor_next(&cursor, &out));
+    assert_true(sea_turtle_string_cursor_next(&cursor, &out));
+    assert_true(sea_turtle_string_cursor_prev(&cursor, &out));
+    assert_int_equal(out, 0xA3);
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_empty(void **state) {
+    struct sea_turtle_string object;
+    assert_int_equal(sea_turtle_string_init(&object, "", SIZE_MAX, NULL), 0);
+    struct sea_turtle_string_cursor cursor;
+    uint32_t out;
+    size_t count = 0;
+    SEA_TURTLE_STRING_FOREACH(&cursor, &out, &object) {
+        count += 1;
+    }
+    SEA_TURTLE_STRING_FOREACH_REVERSE(&cursor, &out, &object) {
+        count += 1;
+    }
+    assert_int_equal(count, 0);
+    struct sea_turtle_string_view view = {0};
+    sea_turtle_string_cursor_init_view(&cursor, &view);
+    assert_false(sea_turtle_string_cursor_next(&cursor, &out));
+    assert_false(sea_turtle_string_cursor_prev(&cursor, &out));
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_foreach(void **state) {
+    struct sea_turtle_string object;
+    const char *const chars = u8"$£ह€한🐉 the turtle and the dragon $£ह€한🐉";
+    assert_int_equal(sea_turtle_string_init(&object, chars, SIZE_MAX, NULL),
+                     0);
+    /* matches the checked iteration */
+    const uint8_t *at;
+    assert_int_equal(sea_turtle_string_first(&object, &at), 0);
+    struct sea_turtle_string_cursor cursor;
+    uint32_t out;
+    uintmax_t count = 0;
+    SEA_TURTLE_STRING_FOREACH(&cursor, &out, &object) {
+        uint32_t code_point;
+        assert_int_equal(sea_turtle_string_code_point(&object, at,
+                                                      &code_point), 0);
+        assert_int_equal(out, code_point);
+        const int error = sea_turtle_string_next(&object, at, &at);
+        assert_true(!error || SEA_TURTLE_STRING_ERROR_END_OF_SEQUENCE
+                              == error);
+        assert_ptr_equal(cursor.at, at);
+        count += 1;
+    }
+    assert_int_equal(count, sea_turtle_string_count_of(&object));
+    assert_int_equal(sea_turtle_string_last(&object, &at), 0);
+    count = 0;
+    SEA_TURTLE_STRING_FOREACH_REVERSE(&cursor, &out, &object) {
+        assert_ptr_equal(cursor.at, at);
+        uint32_t code_point;
+        assert_int_equal(sea_turtle_string_code_point(&object, at,
+                                                      &code_point), 0);
+        assert_int_equal(out, code_point);
+        const int error = sea_turtle_string_prev(&object, at, &at);
+        assert_true(!error || SEA_TURTLE_STRING_ERROR_END_OF_SEQUENCE
+                              == error);
+        count += 1;
+    }
+    assert_int_equal(count, sea_turtle_string_count_of(&object));
+    assert_int_equal(sea_turtle_string_invalidate(&object), 0);
+}
+
+static void check_init_view(void **state) {
+    struct sea_turtle_string_view view;
+    /* views need not be NULL terminated */
+    assert_int_equal(sea_turtle_string_view_init(&view, u8"$£ह€한🐉", 9,
+                                                 NULL), 0);
+    struct sea_turtle_string_cursor cursor;
+    sea_turtle_string_cursor_init_view(&cursor, &view);
+    uint32_t out;
+    for (size_t i = 0; i < 4; i++) {
+        assert_true(sea_turtle_string_cursor_next(&cursor, &out));
+        assert_int_equal(out, expected[i]);
+    }
+    assert_false(sea_turtle_string_cursor_next(&cursor, &out));
+    assert_true(sea_turtle_string_cursor_prev(&cursor, &out));
+    assert_int_equal(out, 0x20AC);
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_next),
+            cmocka_unit_test(check_prev),
+            cmocka_unit_test(check_empty),
+            cmocka_unit_test(check_foreach),
+            cmocka_unit_test(check_init_view),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
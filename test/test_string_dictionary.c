@@ -0,0 +1,567 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sea-turtle.h>
+#include <seagrass.h>
+
+#include <test/cmocka.h>
+
+#include "private/string.h"
+#include "test_string_helpers.h"
+
+static const char *terms[] = {
+        "",
+        "a",
+        "ab",
+        "abc",
+        "abcdefghijklmnopqrstuvwxyz",
+        "abcdefghijklmnopqrstuvwxyz0123456789",
+        "abd",
+        "b",
+        "ba",
+        "banana",
+        "band",
+        "bandana",
+        "bandwidth",
+        "can",
+        "canal",
+        "candle",
+        "candy",
+        "cane",
+        "d",
+        u8"é",
+        u8"éa",
+        u8"한",
+        u8"한국",
+        u8"🐢",
+        u8"🐢🐢",
+};
+
+#define COUNT (sizeof(terms) / sizeof(terms[0]))
+
+static void dictionary_init(
+        struct sea_turtle_string_dictionary *const object) {
+    struct sea_turtle_string strings[COUNT];
+    strings_init(strings, terms, COUNT);
+    assert_int_equal(sea_turtle_string_dictionary_init(object, strings, COUNT),
+                     0);
+    strings_invalidate(strings, COUNT);
+}
+
+static void assert_term(const struct sea_turtle_string *const string,
+                        const char *const term) {
+    if (!*term) {
+        assert_int_equal(string->size, 0);
+        assert_int_equal(sea_turtle_string_count_of(string), 0);
+        return;
+    }
+    assert_int_equal(string->size, 1 + strlen(term));
+    assert_string_equal((const char *) sea_turtle_string_bytes(string),
+                        term);
+    uintmax_t count;
+    assert_int_equal(sea_turtle_string_count(string, &count), 0);
+    struct sea_turtle_string other;
+    assert_int_equal(sea_turtle_string_init(&other, term, SIZE_MAX, NULL), 0);
+    assert_int_equal(count, sea_turtle_string_count_of(&other));
+    assert_int_equal(sea_turtle_string_invalidate(&other), 0);
+}
+
+static void check_init_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_dictionary_init(NULL, (void *) 1, 0),
+            SEA_TURTLE_STRING_DICTIONARY_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init_error_on_strings_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_dictionary_init((void *) 1, NULL, 0),
+            SEA_TURTLE_STRING_DICTIONARY_ERROR_STRINGS_IS_NULL);
+}
+
+static void check_init_error_on_strings_are_unsorted(void **state) {
+    const char *cases[][2] = {
+            {"b", "a"},
+            {"ab", "a"},
+            {"a", "a"},
+            {"a", ""},
+    };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        struct sea_turtle_string strings[2];
+        for (size_t o = 0; o < 2; o++) {
+            assert_int_equal(sea_turtle_string_init(&strings[o], cases[i][o],
+                                                    SIZE_MAX, NULL), 0);
+        }
+        struct sea_turtle_string_dictionary object;
+        assert_int_equal(
+                sea_turtle_string_dictionary_init(&object, strings, 2),
+                SEA_TURTLE_STRING_DICTIONARY_ERROR_STRINGS_ARE_UNSORTED);
+        for (size_t o = 0; o < 2; o++) {
+            assert_int_equal(sea_turtle_string_invalidate(&strings[o]), 0);
+        }
+    }
+}
+
+static void check_init_error_on_memory_allocation_failed(void **state) {
+    struct sea_turtle_string strings[COUNT];
+    strings_init(strings, terms, COUNT);
+    struct sea_turtle_string_dictionary object;
+    malloc_is_overridden = true;
+    assert_int_equal(
+            sea_turtle_string_dictionary_init(&object, strings, COUNT),
+            SEA_TURTLE_STRING_DICTIONARY_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = false;
+    strings_invalidate(strings, COUNT);
+}
+
+static void check_init(void **state) {
+    struct sea_turtle_string_dictionary object;
+    dictionary_init(&object);
+    assert_non_null(object.data);
+    assert_int_equal(object.count, COUNT);
+    uintmax_t count;
+    assert_int_equal(sea_turtle_string_dictionary_count(&object, &count), 0);
+    assert_int_equal(count, COUNT);
+    assert_int_equal(sea_turtle_string_dictionary_invalidate(&object), 0);
+}
+
+static void check_init_empty(void **state) {
+    struct sea_turtle_string_dictionary object;
+    struct sea_turtle_string key;
+    assert_int_equal(sea_turtle_string_init(&key, "a", SIZE_MAX, NULL), 0);
+    assert_int_equal(
+            sea_turtle_string_dictionary_init(&object, &key, 0), 0);
+    uintmax_t index;
+    assert_int_equal(
+            sea_turtle_string_dictionary_find(&object, &key, &index),
+            SEA_TURTLE_STRING_DICTIONARY_ERROR_KEY_NOT_FOUND);
+    struct sea_turtle_string_dictionary_iterator at;
+    assert_int_equal(
+            sea_turtle_string_dictionary_prefix(&object, &key, &at), 0);
+    struct sea_turtle_string out = {0};
+    assert_int_equal(
+            sea_turtle_string_dictionary_next(&object, &at, &out),
+            SEA_TURTLE_STRING_DICTIONARY_ERROR_END_OF_SEQUENCE);
+    assert_int_equal(
+            sea_turtle_string_dictionary_get(&object, 0, &out),
+            SEA_TURTLE_STRING_DICTIONARY_ERROR_INDEX_IS_OUT_OF_BOUNDS);
+    assert_int_equal(sea_turtle_string_invalidate(&key), 0);
+    assert_int_equal(sea_turtle_string_dictionary_invalidate(&object), 0);
+}
+
+static void check_init_buffer_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_dictionary_init_buffer(NULL, (void *) 1, 0),
+            SEA_TURTLE_STRING_DICTIONARY_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init_buffer_error_on_buffer_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_dictionary_init_buffer((void *) 1, NULL, 0),
+            SEA_TURTLE_STRING_DICTIONARY_ERROR_BUFFER_IS_NULL);
+}
+
+static void check_init_buffer_error_on_buffer_is_malformed(void **state) {
+    struct sea_turtle_string_dictionary object;
+    dictionary_init(&object);
+    uint8_t *const buffer = malloc(object.size);
+    assert_non_null(buffer);
+    struct sea_turtle_string_dictionary other;
+    /* truncated */
+    for (size_t size = 0; size < object.size; size++) {
+        assert_int_equal(
+                sea_turtle_string_dictionary_init_buffer(&other, object.data,
+                                                         size),
+                SEA_TURTLE_STRING_DICTIONARY_ERROR_BUFFER_IS_MALFORMED);
+    }
+    /* any byte changed */
+    for (size_t i = 0; i < object.size; i++) {
+        memcpy(buffer, object.data, object.size);
+        buffer[i] ^= 0x80;
+        const int error = sea_turtle_string_dictionary_init_buffer(
+                &other, buffer, object.size);
+        if (!error) {
+            /* only changes that keep every term valid may be accepted */
+            uintmax_t count;
+            assert_int_equal(
+                    sea_turtle_string_dictionary_count(&other, &count), 0);
+            assert_int_equal(count, COUNT);
+            assert_int_equal(
+                    sea_turtle_string_dictionary_invalidate(&other), 0);
+            continue;
+        }
+        assert_int_equal(
+                error,
+                SEA_TURTLE_STRING_DICTIONARY_ERROR_BUFFER_IS_MALFORMED);
+    }
+    free(buffer);
+    assert_int_equal(sea_turtle_string_dictionary_invalidate(&object), 0);
+}
+
+static void check_init_buffer_error_on_prefix_is_not_shared(void **state) {
+    struct sea_turtle_string strings[2];
+    assert_int_equal(sea_turtle_string_init(&strings[0], "abc", SIZE_MAX,
+                                            NULL), 0);
+    assert_int_equal(sea_turtle_string_init(&strings[1], "abd", SIZE_MAX,
+                                            NULL), 0);
+    struct sea_turtle_string_dictionary object;
+    assert_int_equal(sea_turtle_string_dictionary_init(&object, strings, 2),
+                     0);
+    /* "abd" stored whole instead of sharing "ab" with "abc" */
+    const uint8_t term[] = {0, 3, 3, 'a', 'b', 'd'};
+    const uint8_t shared[] = {2, 1, 3, 'd'};
+    const size_t kept = object.size - sizeof(shared);
+    assert_memory_equal(object.data + kept, shared, sizeof(shared));
+    const uint64_t size = kept + sizeof(term);
+    uint8_t *const buffer = malloc(size);
+    assert_non_null(buffer);
+    memcpy(buffer, object.data, kept);
+    memcpy(buffer + kept, term, sizeof(term));
+    memcpy(buffer + 16, &size, sizeof(size));
+    struct sea_turtle_string_dictionary other;
+    assert_int_equal(
+            sea_turtle_string_dictionary_init_buffer(&other, buffer, size),
+            SEA_TURTLE_STRING_DICTIONARY_ERROR_BUFFER_IS_MALFORMED);
+    free(buffer);
+    assert_int_equal(sea_turtle_string_dictionary_invalidate(&object), 0);
+    for (size_t i = 0; i < 2; i++) {
+        assert_int_equal(sea_turtle_string_invalidate(&strings[i]), 0);
+    }
+}
+
+static void check_init_buffer_error_on_memory_allocation_failed(
+        void **state) {
+    struct sea_turtle_string_dictionary object;
+    dictionary_init(&object);
+    struct sea_turtle_string_dictionary other;
+    malloc_is_overridden = true;
+    assert_int_equal(
+            sea_turtle_string_dictionary_init_buffer(&other, object.data,
+                                                     object.size),
+            SEA_TURTLE_STRING_DICTIONARY_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = false;
+    assert_int_equal(sea_turtle_string_dictionary_invalidate(&object), 0);
+}
+
+static void check_init_buffer(void **state) {
+    struct sea_turtle_string_dictionary object;
+    dictionary_init(&object);
+    struct sea_turtle_string_dictionary other;
+    assert_int_equal(
+            sea_turtle_string_dictionary_init_buffer(&other, object.data,
+                                                     object.size), 0);
+    assert_int_equal(other.size, object.size);
+    assert_int_equal(other.count, COUNT);
+    assert_memory_equal(other.data, object.data, object.size);
+    assert_int_equal(sea_turtle_string_dictionary_invalidate(&object), 0);
+    for (size_t i = 0; i < COUNT; i++) {
+        struct sea_turtle_string out;
+        assert_int_equal(sea_turtle_string_dictionary_get(&other, i, &out), 0);
+        assert_term(&out, terms[i]);
+        assert_int_equal(sea_turtle_string_invalidate(&out), 0);
+    }
+    assert_int_equal(sea_turtle_string_dictionary_invalidate(&other), 0);
+}
+
+static void check_invalidate_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_dictionary_invalidate(NULL),
+            SEA_TURTLE_STRING_DICTIONARY_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_count_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_dictionary_count(NULL, (void *) 1),
+            SEA_TURTLE_STRING_DICTIONARY_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_count_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_dictionary_count((void *) 1, NULL),
+            SEA_TURTLE_STRING_DICTIONARY_ERROR_OUT_IS_NULL);
+}
+
+static void check_find_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_dictionary_find(NULL, (void *) 1, (void *) 1),
+            SEA_TURTLE_STRING_DICTIONARY_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_find_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_dictionary_find((void *) 1, NULL, (void *) 1),
+            SEA_TURTLE_STRING_DICTIONARY_ERROR_KEY_IS_NULL);
+}
+
+static void check_find_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_dictionary_find((void *) 1, (void *) 1, NULL),
+            SEA_TURTLE_STRING_DICTIONARY_ERROR_OUT_IS_NULL);
+}
+
+static void check_find_error_on_key_not_found(void **state) {
+    const char *keys[] = {
+            "0", "aa", "abcd", "abcdefghijklmnopqrstuvwxyz0", "bandanas",
+            "bane", "c", "zebra", u8"한국어", u8"🐢🐢🐢", u8"🐣"
+    };
+    struct sea_turtle_string_dictionary object;
+    dictionary_init(&object);
+    for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); i++) {
+        struct sea_turtle_string key;
+        assert_int_equal(sea_turtle_string_init(&key, keys[i], SIZE_MAX,
+                                                NULL), 0);
+        uintmax_t index;
+        assert_int_equal(
+                sea_turtle_string_dictionary_find(&object, &key, &index),
+                SEA_TURTLE_STRING_DICTIONARY_ERROR_KEY_NOT_FOUND);
+        assert_int_equal(sea_turtle_string_invalidate(&key), 0);
+    }
+    assert_int_equal(sea_turtle_string_dictionary_invalidate(&object), 0);
+}
+
+static void check_find(void **state) {
+    struct sea_turtle_string_dictionary object;
+    dictionary_init(&object);
+    for (size_t i = 0; i < COUNT; i++) {
+        struct sea_turtle_string key;
+        assert_int_equal(sea_turtle_string_init(&key, terms[i], SIZE_MAX,
+                                                NULL), 0);
+        uintmax_t index;
+        assert_int_equal(
+                sea_turtle_string_dictionary_find(&object, &key, &index), 0);
+        assert_int_equal(index, i);
+        assert_int_equal(sea_turtle_string_invalidate(&key), 0);
+    }
+    assert_int_equal(sea_turtle_string_dictionary_invalidate(&object), 0);
+}
+
+static void check_get_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_dictionary_get(NULL, 0, (void *) 1),
+            SEA_TURTLE_STRING_DICTIONARY_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_get_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_dictionary_get((void *) 1, 0, NULL),
+            SEA_TURTLE_STRING_DICTIONARY_ERROR_OUT_IS_NULL);
+}
+
+static void check_get_error_on_index_is_out_of_bounds(void **state) {
+    struct sea_turtle_string_dictionary object;
+    dictionary_init(&object);
+    struct sea_turtle_string out;
+    assert_int_equal(
+            sea_turtle_string_dictionary_get(&object, COUNT, &out),
+            SEA_TURTLE_STRING_DICTIONARY_ERROR_INDEX_IS_OUT_OF_BOUNDS);
+    assert_int_equal(sea_turtle_string_dictionary_invalidate(&object), 0);
+}
+
+static void check_get_error_on_memory_allocation_failed(void **state) {
+    struct sea_turtle_string_dictionary object;
+    dictionary_init(&object);
+    struct sea_turtle_string out;
+    malloc_is_overridden = true;
+    /* terms which do not fit in the local buffer */
+    assert_int_equal(
+            sea_turtle_string_dictionary_get(&object, 5, &out),
+            SEA_TURTLE_STRING_DICTIONARY_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = false;
+    assert_int_equal(sea_turtle_string_dictionary_invalidate(&object), 0);
+}
+
+static void check_get(void **state) {
+    struct sea_turtle_string_dictionary object;
+    dictionary_init(&object);
+    /* from last to first so that no term follows the one before it */
+    for (size_t i = COUNT; i--;) {
+        struct sea_turtle_string out;
+        assert_int_equal(sea_turtle_string_dictionary_get(&object, i, &out),
+                         0);
+        assert_term(&out, terms[i]);
+        assert_int_equal(sea_turtle_string_invalidate(&out), 0);
+    }
+    assert_int_equal(sea_turtle_string_dictionary_invalidate(&object), 0);
+}
+
+static void check_prefix_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_dictionary_prefix(NULL, (void *) 1, (void *) 1),
+            SEA_TURTLE_STRING_DICTIONARY_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_prefix_error_on_prefix_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_dictionary_prefix((void *) 1, NULL, (void *) 1),
+            SEA_TURTLE_STRING_DICTIONARY_ERROR_PREFIX_IS_NULL);
+}
+
+static void check_prefix_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_dictionary_prefix((void *) 1, (void *) 1, NULL),
+            SEA_TURTLE_STRING_DICTIONARY_ERROR_OUT_IS_NULL);
+}
+
+static void check_prefix(void **state) {
+    const struct {
+        const char *prefix;
+        size_t first;
+        size_t end;
+    } cases[] = {
+            {"", 0, COUNT},
+            {"a", 1, 7},
+            {"ab", 2, 7},
+            {"abc", 3, 6},
+            {"abcdefghijklmnopqrstuvwxyz", 4, 6},
+            {"abcdefghijklmnopqrstuvwxyz0", 5, 6},
+            {"ban", 9, 13},
+            {"band", 10, 13},
+            {"can", 13, 18},
+            {"cand", 15, 17},
+            {"c", 13, 18},
+            {"e", 19, 19},
+            {u8"é", 19, 21},
+            {u8"한", 21, 23},
+            {u8"🐢", 23, COUNT},
+            {"0", 1, 1},
+            {"z", 19, 19},
+    };
+    struct sea_turtle_string_dictionary object;
+    dictionary_init(&object);
+    struct sea_turtle_string out = {0};
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        struct sea_turtle_string prefix;
+        assert_int_equal(sea_turtle_string_init(&prefix, cases[i].prefix,
+                                                SIZE_MAX, NULL), 0);
+        struct sea_turtle_string_dictionary_iterator at;
+        assert_int_equal(
+                sea_turtle_string_dictionary_prefix(&object, &prefix, &at), 0);
+        /* the same string instance is reused across ranges */
+        for (size_t o = cases[i].first; o < cases[i].end; o++) {
+            assert_int_equal(
+                    sea_turtle_string_dictionary_next(&object, &at, &out), 0);
+            assert_term(&out, terms[o]);
+        }
+        assert_int_equal(
+                sea_turtle_string_dictionary_next(&object, &at, &out),
+                SEA_TURTLE_STRING_DICTIONARY_ERROR_END_OF_SEQUENCE);
+        assert_int_equal(sea_turtle_string_invalidate(&prefix), 0);
+    }
+    assert_int_equal(sea_turtle_string_invalidate(&out), 0);
+    assert_int_equal(sea_turtle_string_dictionary_invalidate(&object), 0);
+}
+
+static void check_next_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_dictionary_next(NULL, (void *) 1, (void *) 1),
+            SEA_TURTLE_STRING_DICTIONARY_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_next_error_on_at_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_dictionary_next((void *) 1, NULL, (void *) 1),
+            SEA_TURTLE_STRING_DICTIONARY_ERROR_AT_IS_NULL);
+}
+
+static void check_next_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_dictionary_next((void *) 1, (void *) 1, NULL),
+            SEA_TURTLE_STRING_DICTIONARY_ERROR_OUT_IS_NULL);
+}
+
+static void check_large(void **state) {
+    const size_t count = 10000;
+    struct sea_turtle_string *const strings = malloc(
+            count * sizeof(*strings));
+    assert_non_null(strings);
+    char chars[64];
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        snprintf(chars, sizeof(chars), "/aquarium/sea-turtle/%05zu/shell",
+                 i * 7);
+        assert_int_equal(sea_turtle_string_init(&strings[i], chars,
+                                                SIZE_MAX, NULL), 0);
+        total += sizeof(*strings) + strings[i].size;
+    }
+    struct sea_turtle_string_dictionary object;
+    assert_int_equal(
+            sea_turtle_string_dictionary_init(&object, strings, count), 0);
+    /* shared prefixes are stored once per bucket */
+    assert_true(5 * object.size < total);
+    struct sea_turtle_string out;
+    for (size_t i = 0; i < count; i++) {
+        uintmax_t index;
+        assert_int_equal(
+                sea_turtle_string_dictionary_find(&object, &strings[i],
+                                                  &index), 0);
+        assert_int_equal(index, i);
+        assert_int_equal(sea_turtle_string_dictionary_get(&object, i, &out),
+                         0);
+        assert_int_equal(sea_turtle_string_compare(&out, &strings[i]), 0);
+        assert_int_equal(sea_turtle_string_invalidate(&out), 0);
+    }
+    struct sea_turtle_string prefix;
+    assert_int_equal(sea_turtle_string_init(
+            &prefix, "/aquarium/sea-turtle/012", SIZE_MAX, NULL), 0);
+    struct sea_turtle_string_dictionary_iterator at;
+    assert_int_equal(
+            sea_turtle_string_dictionary_prefix(&object, &prefix, &at), 0);
+    out = (struct sea_turtle_string) {0};
+    size_t i = 1200 / 7 + 1;
+    for (; !sea_turtle_string_dictionary_next(&object, &at, &out); i++) {
+        assert_int_equal(sea_turtle_string_compare(&out, &strings[i]), 0);
+    }
+    assert_int_equal(i, 1299 / 7 + 1);
+    assert_int_equal(sea_turtle_string_invalidate(&out), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&prefix), 0);
+    assert_int_equal(sea_turtle_string_dictionary_invalidate(&object), 0);
+    for (size_t o = 0; o < count; o++) {
+        assert_int_equal(sea_turtle_string_invalidate(&strings[o]), 0);
+    }
+    free(strings);
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_init_error_on_object_is_null),
+            cmocka_unit_test(check_init_error_on_strings_is_null),
+            cmocka_unit_test(check_init_error_on_strings_are_unsorted),
+            cmocka_unit_test(check_init_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_init),
+            cmocka_unit_test(check_init_empty),
+            cmocka_unit_test(check_init_buffer_error_on_object_is_null),
+            cmocka_unit_test(check_init_buffer_error_on_buffer_is_null),
+            cmocka_unit_test(check_init_buffer_error_on_buffer_is_malformed),
+            cmocka_unit_test(check_init_buffer_error_on_prefix_is_not_shared),
+            cmocka_unit_test(
+                    check_init_buffer_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_init_buffer),
+            cmocka_unit_test(check_invalidate_error_on_object_is_null),
+            cmocka_unit_test(check_count_error_on_object_is_null),
+            cmocka_unit_test(check_count_error_on_out_is_null),
+            cmocka_unit_test(check_find_error_on_object_is_null),
+            cmocka_unit_test(check_find_error_on_key_is_null),
+            cmocka_unit_test(check_find_error_on_out_is_null),
+            cmocka_unit_test(check_find_error_on_key_not_found),
+            cmocka_unit_test(check_find),
+            cmocka_unit_test(check_get_error_on_object_is_null),
+            cmocka_unit_test(check_get_error_on_out_is_null),
+            cmocka_unit_test(check_get_error_on_index_is_out_of_bounds),
+            cmocka_unit_test(check_get_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_get),
+            cmocka_unit_test(check_prefix_error_on_object_is_null),
+            cmocka_unit_test(check_prefix_error_on_prefix_is_null),
+            cmocka_unit_test(check_prefix_error_on_out_is_null),
+            cmocka_unit_test(check_prefix),
+            cmocka_unit_test(check_next_error_on_object_is_null),
+            cmocka_unit_test(check_next_error_on_at_is_null),
+            cmocka_unit_test(check_next_error_on_out_is_null),
+            cmocka_unit_test(check_large),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
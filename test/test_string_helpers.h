@@ -0,0 +1,42 @@
+#ifndef _SEA_TURTLE_TEST_STRING_HELPERS_H_
+#define _SEA_TURTLE_TEST_STRING_HELPERS_H_
+
+/*
+ * Helpers shared by the unit tests of the string modules, to be included
+ * after cmocka.h and private/string.h.
+ */
+
+static inline void strings_init(struct sea_turtle_string *const strings,
+                                const char *const *const chars,
+                                const size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        assert_int_equal(sea_turtle_string_init(&strings[i], chars[i],
+                                                SIZE_MAX, NULL), 0);
+    }
+}
+
+static inline void strings_invalidate(struct sea_turtle_string *const strings,
+                                      const size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        assert_int_equal(sea_turtle_string_invalidate(&strings[i]), 0);
+    }
+}
+
+/* the string equals one initialized from chars, down to its hash code */
+static inline void assert_string_equal_char_ptr(
+        const struct sea_turtle_string *const object,
+        const char *const expected) {
+    struct sea_turtle_string other;
+    assert_int_equal(sea_turtle_string_init(&other, expected, SIZE_MAX,
+                                            NULL), 0);
+    assert_int_equal(sea_turtle_string_compare(object, &other), 0);
+    assert_int_equal(sea_turtle_string_count_of(object),
+                     sea_turtle_string_count_of(&other));
+    uintmax_t hashes[2];
+    assert_int_equal(sea_turtle_string_hash(object, &hashes[0]), 0);
+    assert_int_equal(sea_turtle_string_hash(&other, &hashes[1]), 0);
+    assert_int_equal(hashes[0], hashes[1]);
+    assert_int_equal(sea_turtle_string_invalidate(&other), 0);
+}
+
+#endif /* _SEA_TURTLE_TEST_STRING_HELPERS_H_ */
@@ -0,0 +1,396 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <string.h>
+#include <sea-turtle.h>
+#include <seagrass.h>
+
+#include <test/cmocka.h>
+
+static void check_invalidate_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_map_invalidate(NULL),
+            SEA_TURTLE_STRING_MAP_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_invalidate(void **state) {
+    struct sea_turtle_string_map object = {};
+    assert_int_equal(sea_turtle_string_map_invalidate(&object), 0);
+}
+
+static void check_init_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_map_init(NULL),
+            SEA_TURTLE_STRING_MAP_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init(void **state) {
+    struct sea_turtle_string_map object;
+    assert_int_equal(sea_turtle_string_map_init(&object), 0);
+    uintmax_t count;
+    assert_int_equal(sea_turtle_string_map_count(&object, &count), 0);
+    assert_int_equal(count, 0);
+    void *out;
+    assert_int_equal(sea_turtle_string_map_get_chars(&object, "a", 1, &out),
+                     SEA_TURTLE_STRING_MAP_ERROR_KEY_NOT_FOUND);
+    assert_int_equal(sea_turtle_string_map_invalidate(&object), 0);
+}
+
+static void check_reserve_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_map_reserve(NULL, 0),
+            SEA_TURTLE_STRING_MAP_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_reserve_error_on_memory_allocation_failed(void **state) {
+    struct sea_turtle_string_map object;
+    assert_int_equal(sea_turtle_string_map_init(&object), 0);
+    malloc_is_overridden = true;
+    assert_int_equal(
+            sea_turtle_string_map_reserve(&object, 100),
+            SEA_TURTLE_STRING_MAP_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = false;
+    assert_int_equal(sea_turtle_string_map_invalidate(&object), 0);
+}
+
+static void check_reserve(void **state) {
+    struct sea_turtle_string_map object;
+    assert_int_equal(sea_turtle_string_map_init(&object), 0);
+    assert_int_equal(sea_turtle_string_map_reserve(&object, 1000), 0);
+    const size_t capacity = object.capacity;
+    assert_true(capacity >= 1000);
+    char chars[16];
+    for (size_t i = 0; i < 1000; i++) {
+        struct sea_turtle_string key;
+        snprintf(chars, sizeof(chars), "key-%zu", i);
+        assert_int_equal(sea_turtle_string_init(&key, chars, SIZE_MAX,
+                                                NULL), 0);
+        assert_int_equal(sea_turtle_string_map_set(&object, &key, NULL), 0);
+        assert_int_equal(sea_turtle_string_invalidate(&key), 0);
+    }
+    /* the table was neither grown nor rebuilt */
+    assert_int_equal(object.capacity, capacity);
+    assert_int_equal(sea_turtle_string_map_reserve(&object, 10), 0);
+    assert_int_equal(object.capacity, capacity);
+    assert_int_equal(sea_turtle_string_map_invalidate(&object), 0);
+}
+
+static void check_set_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_map_set(NULL, (void *) 1, NULL),
+            SEA_TURTLE_STRING_MAP_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_set_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_map_set((void *) 1, NULL, NULL),
+            SEA_TURTLE_STRING_MAP_ERROR_KEY_IS_NULL);
+}
+
+static void check_set_error_on_memory_allocation_failed(void **state) {
+    struct sea_turtle_string_map object;
+    assert_int_equal(sea_turtle_string_map_init(&object), 0);
+    struct sea_turtle_string key;
+    assert_int_equal(sea_turtle_string_init(
+            &key, "a key too long to be stored locally", SIZE_MAX, NULL), 0);
+    malloc_is_overridden = true;
+    assert_int_equal(
+            sea_turtle_string_map_set(&object, &key, NULL),
+            SEA_TURTLE_STRING_MAP_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = false;
+    /* the key fails to be copied once the table has room */
+    assert_int_equal(sea_turtle_string_map_reserve(&object, 1), 0);
+    malloc_is_overridden = true;
+    assert_int_equal(
+            sea_turtle_string_map_set(&object, &key, NULL),
+            SEA_TURTLE_STRING_MAP_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = false;
+    uintmax_t count;
+    assert_int_equal(sea_turtle_string_map_count(&object, &count), 0);
+    assert_int_equal(count, 0);
+    assert_int_equal(sea_turtle_string_invalidate(&key), 0);
+    assert_int_equal(sea_turtle_string_map_invalidate(&object), 0);
+}
+
+static void check_set(void **state) {
+    struct sea_turtle_string_map object;
+    assert_int_equal(sea_turtle_string_map_init(&object), 0);
+    const char *chars[] = {u8"🐢", "a key too long to be stored locally", ""};
+    for (size_t i = 0; i < 3; i++) {
+        struct sea_turtle_string key;
+        assert_int_equal(sea_turtle_string_init(&key, chars[i], SIZE_MAX,
+                                                NULL), 0);
+        assert_int_equal(sea_turtle_string_map_set(&object, &key,
+                                                   (void *) chars[i]), 0);
+        /* the map holds a copy of the key */
+        assert_int_equal(sea_turtle_string_invalidate(&key), 0);
+    }
+    uintmax_t count;
+    assert_int_equal(sea_turtle_string_map_count(&object, &count), 0);
+    assert_int_equal(count, 3);
+    for (size_t i = 0; i < 3; i++) {
+        struct sea_turtle_string key;
+        assert_int_equal(sea_turtle_string_init(&key, chars[i], SIZE_MAX,
+                                                NULL), 0);
+        void *out;
+        assert_int_equal(sea_turtle_string_map_get(&object, &key, &out), 0);
+        assert_ptr_equal(out, chars[i]);
+        /* setting an existing key replaces its value */
+        assert_int_equal(sea_turtle_string_map_set(&object, &key, NULL), 0);
+        assert_int_equal(sea_turtle_string_map_get(&object, &key, &out), 0);
+        assert_null(out);
+        assert_int_equal(sea_turtle_string_invalidate(&key), 0);
+    }
+    assert_int_equal(sea_turtle_string_map_count(&object, &count), 0);
+    assert_int_equal(count, 3);
+    assert_int_equal(sea_turtle_string_map_invalidate(&object), 0);
+}
+
+static void check_set_grows(void **state) {
+    struct sea_turtle_string_map object;
+    assert_int_equal(sea_turtle_string_map_init(&object), 0);
+    char chars[32];
+    for (uintptr_t i = 0; i < 10000; i++) {
+        struct sea_turtle_string key;
+        /* alternate between local and heap allocated keys */
+        snprintf(chars, sizeof(chars), i % 2 ? "%zu" : "a longer key %zu",
+                 (size_t) i);
+        assert_int_equal(sea_turtle_string_init(&key, chars, SIZE_MAX,
+                                                NULL), 0);
+        assert_int_equal(sea_turtle_string_map_set(&object, &key,
+                                                   (void *) i), 0);
+        assert_int_equal(sea_turtle_string_invalidate(&key), 0);
+    }
+    uintmax_t count;
+    assert_int_equal(sea_turtle_string_map_count(&object, &count), 0);
+    assert_int_equal(count, 10000);
+    for (uintptr_t i = 0; i < 10000; i++) {
+        snprintf(chars, sizeof(chars), i % 2 ? "%zu" : "a longer key %zu",
+                 (size_t) i);
+        void *out;
+        assert_int_equal(sea_turtle_string_map_get_chars(
+                &object, chars, strlen(chars), &out), 0);
+        assert_ptr_equal(out, (void *) i);
+    }
+    assert_int_equal(sea_turtle_string_map_invalidate(&object), 0);
+}
+
+static void check_set_all_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_map_set_all(NULL, (void *) 1, (void *) 1, 0),
+            SEA_TURTLE_STRING_MAP_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_set_all_error_on_keys_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_map_set_all((void *) 1, NULL, (void *) 1, 0),
+            SEA_TURTLE_STRING_MAP_ERROR_KEYS_IS_NULL);
+}
+
+static void check_set_all_error_on_values_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_map_set_all((void *) 1, (void *) 1, NULL, 0),
+            SEA_TURTLE_STRING_MAP_ERROR_VALUES_IS_NULL);
+}
+
+static void check_set_all(void **state) {
+    struct sea_turtle_string_map object;
+    assert_int_equal(sea_turtle_string_map_init(&object), 0);
+    struct sea_turtle_string keys[100];
+    void *values[100];
+    char chars[16];
+    for (uintptr_t i = 0; i < 100; i++) {
+        snprintf(chars, sizeof(chars), "%zu", (size_t) i % 50);
+        assert_int_equal(sea_turtle_string_init(&keys[i], chars, SIZE_MAX,
+                                                NULL), 0);
+        values[i] = (void *) i;
+    }
+    assert_int_equal(sea_turtle_string_map_set_all(&object, keys, values,
+                                                   100), 0);
+    uintmax_t count;
+    assert_int_equal(sea_turtle_string_map_count(&object, &count), 0);
+    assert_int_equal(count, 50);
+    for (uintptr_t i = 0; i < 100; i++) {
+        void *out;
+        assert_int_equal(sea_turtle_string_map_get(&object, &keys[i], &out),
+                         0);
+        /* later keys replaced the values of earlier equal ones */
+        assert_ptr_equal(out, (void *) (i % 50 + 50));
+        assert_int_equal(sea_turtle_string_invalidate(&keys[i]), 0);
+    }
+    assert_int_equal(sea_turtle_string_map_invalidate(&object), 0);
+}
+
+static void check_get_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_map_get(NULL, (void *) 1, (void *) 1),
+            SEA_TURTLE_STRING_MAP_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_get_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_map_get((void *) 1, NULL, (void *) 1),
+            SEA_TURTLE_STRING_MAP_ERROR_KEY_IS_NULL);
+}
+
+static void check_get_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_map_get((void *) 1, (void *) 1, NULL),
+            SEA_TURTLE_STRING_MAP_ERROR_OUT_IS_NULL);
+}
+
+static void check_get_error_on_key_not_found(void **state) {
+    struct sea_turtle_string_map object;
+    assert_int_equal(sea_turtle_string_map_init(&object), 0);
+    struct sea_turtle_string key;
+    assert_int_equal(sea_turtle_string_init(&key, "key", SIZE_MAX, NULL), 0);
+    assert_int_equal(sea_turtle_string_map_set(&object, &key, NULL), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&key), 0);
+    assert_int_equal(sea_turtle_string_init(&key, "kez", SIZE_MAX, NULL), 0);
+    void *out;
+    assert_int_equal(sea_turtle_string_map_get(&object, &key, &out),
+                     SEA_TURTLE_STRING_MAP_ERROR_KEY_NOT_FOUND);
+    assert_int_equal(sea_turtle_string_invalidate(&key), 0);
+    assert_int_equal(sea_turtle_string_map_invalidate(&object), 0);
+}
+
+static void check_get_chars_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_map_get_chars(NULL, (void *) 1, 0, (void *) 1),
+            SEA_TURTLE_STRING_MAP_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_get_chars_error_on_char_ptr_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_map_get_chars((void *) 1, NULL, 0, (void *) 1),
+            SEA_TURTLE_STRING_MAP_ERROR_CHAR_PTR_IS_NULL);
+}
+
+static void check_get_chars_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_map_get_chars((void *) 1, (void *) 1, 0, NULL),
+            SEA_TURTLE_STRING_MAP_ERROR_OUT_IS_NULL);
+}
+
+static void check_get_chars(void **state) {
+    struct sea_turtle_string_map object;
+    assert_int_equal(sea_turtle_string_map_init(&object), 0);
+    const char *chars[] = {"/api/v1/users", u8"/🐢", ""};
+    for (size_t i = 0; i < 3; i++) {
+        struct sea_turtle_string key;
+        assert_int_equal(sea_turtle_string_init(&key, chars[i], SIZE_MAX,
+                                                NULL), 0);
+        assert_int_equal(sea_turtle_string_map_set(&object, &key,
+                                                   (void *) chars[i]), 0);
+        assert_int_equal(sea_turtle_string_invalidate(&key), 0);
+    }
+    void *out;
+    /* the char sequence need not be NULL terminated */
+    const char *const path = "/api/v1/users/42";
+    assert_int_equal(sea_turtle_string_map_get_chars(&object, path, 13,
+                                                     &out), 0);
+    assert_ptr_equal(out, chars[0]);
+    assert_int_equal(sea_turtle_string_map_get_chars(&object, path, 0,
+                                                     &out), 0);
+    assert_ptr_equal(out, chars[2]);
+    assert_int_equal(sea_turtle_string_map_get_chars(&object, path, 14,
+                                                     &out),
+                     SEA_TURTLE_STRING_MAP_ERROR_KEY_NOT_FOUND);
+    assert_int_equal(sea_turtle_string_map_get_chars(
+            &object, chars[1], strlen(chars[1]), &out), 0);
+    assert_ptr_equal(out, chars[1]);
+    assert_int_equal(sea_turtle_string_map_invalidate(&object), 0);
+}
+
+static void check_remove_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_map_remove(NULL, (void *) 1),
+            SEA_TURTLE_STRING_MAP_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_remove_error_on_key_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_map_remove((void *) 1, NULL),
+            SEA_TURTLE_STRING_MAP_ERROR_KEY_IS_NULL);
+}
+
+static void check_remove(void **state) {
+    struct sea_turtle_string_map object;
+    assert_int_equal(sea_turtle_string_map_init(&object), 0);
+    char chars[32];
+    /* removing and inserting reuses the deleted slots */
+    for (uintptr_t round = 0; round < 20; round++) {
+        for (uintptr_t i = 0; i < 1000; i++) {
+            struct sea_turtle_string key;
+            snprintf(chars, sizeof(chars), "key %zu", (size_t) i);
+            assert_int_equal(sea_turtle_string_init(&key, chars, SIZE_MAX,
+                                                    NULL), 0);
+            if (round % 2) {
+                assert_int_equal(sea_turtle_string_map_remove(&object, &key),
+                                 0);
+                assert_int_equal(sea_turtle_string_map_remove(&object, &key),
+                                 SEA_TURTLE_STRING_MAP_ERROR_KEY_NOT_FOUND);
+            } else {
+                assert_int_equal(sea_turtle_string_map_set(
+                        &object, &key, (void *) (round + i)), 0);
+            }
+            assert_int_equal(sea_turtle_string_invalidate(&key), 0);
+        }
+        uintmax_t count;
+        assert_int_equal(sea_turtle_string_map_count(&object, &count), 0);
+        assert_int_equal(count, round % 2 ? 0 : 1000);
+    }
+    assert_true(object.capacity <= 2048);
+    assert_int_equal(sea_turtle_string_map_invalidate(&object), 0);
+}
+
+static void check_count_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_map_count(NULL, (void *) 1),
+            SEA_TURTLE_STRING_MAP_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_count_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_map_count((void *) 1, NULL),
+            SEA_TURTLE_STRING_MAP_ERROR_OUT_IS_NULL);
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_invalidate_error_on_object_is_null),
+            cmocka_unit_test(check_invalidate),
+            cmocka_unit_test(check_init_error_on_object_is_null),
+            cmocka_unit_test(check_init),
+            cmocka_unit_test(check_reserve_error_on_object_is_null),
+            cmocka_unit_test(check_reserve_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_reserve),
+            cmocka_unit_test(check_set_error_on_object_is_null),
+            cmocka_unit_test(check_set_error_on_key_is_null),
+            cmocka_unit_test(check_set_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_set),
+            cmocka_unit_test(check_set_grows),
+            cmocka_unit_test(check_set_all_error_on_object_is_null),
+            cmocka_unit_test(check_set_all_error_on_keys_is_null),
+            cmocka_unit_test(check_set_all_error_on_values_is_null),
+            cmocka_unit_test(check_set_all),
+            cmocka_unit_test(check_get_error_on_object_is_null),
+            cmocka_unit_test(check_get_error_on_key_is_null),
+            cmocka_unit_test(check_get_error_on_out_is_null),
+            cmocka_unit_test(check_get_error_on_key_not_found),
+            cmocka_unit_test(check_get_chars_error_on_object_is_null),
+            cmocka_unit_test(check_get_chars_error_on_char_ptr_is_null),
+            cmocka_unit_test(check_get_chars_error_on_out_is_null),
+            cmocka_unit_test(check_get_chars),
+            cmocka_unit_test(check_remove_error_on_object_is_null),
+            cmocka_unit_test(check_remove_error_on_key_is_null),
+            cmocka_unit_test(check_remove),
+            cmocka_unit_test(check_count_error_on_object_is_null),
+            cmocka_unit_test(check_count_error_on_out_is_null),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
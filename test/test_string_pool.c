@@ -0,0 +1,270 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <sea-turtle.h>
+#include <seagrass.h>
+
+#include <test/cmocka.h>
+
+static void check_invalidate_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_pool_invalidate(NULL),
+            SEA_TURTLE_STRING_POOL_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_invalidate(void **state) {
+    struct sea_turtle_string_pool object = {};
+    assert_int_equal(sea_turtle_string_pool_invalidate(&object), 0);
+}
+
+static void check_init_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_pool_init(NULL),
+            SEA_TURTLE_STRING_POOL_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init_error_on_memory_allocation_failed(void **state) {
+    struct sea_turtle_string_pool object;
+    malloc_is_overridden = true;
+    assert_int_equal(
+            sea_turtle_string_pool_init(&object),
+            SEA_TURTLE_STRING_POOL_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = false;
+}
+
+static void check_init(void **state) {
+    struct sea_turtle_string_pool object;
+    assert_int_equal(sea_turtle_string_pool_init(&object), 0);
+    uintmax_t count;
+    assert_int_equal(sea_turtle_string_pool_count(&object, &count), 0);
+    assert_int_equal(count, 0);
+    assert_int_equal(sea_turtle_string_pool_invalidate(&object), 0);
+}
+
+static void check_intern_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_pool_intern(NULL, (void *) 1, (void *) 1),
+            SEA_TURTLE_STRING_POOL_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_intern_error_on_object_is_invalid(void **state) {
+    struct sea_turtle_string_pool object = {0};
+    assert_int_equal(
+            sea_turtle_string_pool_intern(&object, (void *) 1, (void *) 1),
+            SEA_TURTLE_STRING_POOL_ERROR_OBJECT_IS_INVALID);
+    assert_int_equal(sea_turtle_string_pool_init(&object), 0);
+    assert_int_equal(sea_turtle_string_pool_invalidate(&object), 0);
+    assert_int_equal(
+            sea_turtle_string_pool_intern(&object, (void *) 1, (void *) 1),
+            SEA_TURTLE_STRING_POOL_ERROR_OBJECT_IS_INVALID);
+}
+
+static void check_intern_error_on_value_is_null(void **state) {
+    struct sea_turtle_string_pool object = {.shards = (void *) 1};
+    assert_int_equal(
+            sea_turtle_string_pool_intern(&object, NULL, (void *) 1),
+            SEA_TURTLE_STRING_POOL_ERROR_VALUE_IS_NULL);
+}
+
+static void check_intern_error_on_out_is_null(void **state) {
+    struct sea_turtle_string_pool object = {.shards = (void *) 1};
+    assert_int_equal(
+            sea_turtle_string_pool_intern(&object, (void *) 1, NULL),
+            SEA_TURTLE_STRING_POOL_ERROR_OUT_IS_NULL);
+}
+
+static void check_intern_error_on_memory_allocation_failed(void **state) {
+    struct sea_turtle_string_pool object;
+    assert_int_equal(sea_turtle_string_pool_init(&object), 0);
+    struct sea_turtle_string value;
+    assert_int_equal(sea_turtle_string_init(&value,
+                                            u8"🐢",
+                                            SIZE_MAX,
+                                            NULL), 0);
+    const struct sea_turtle_string *out;
+    malloc_is_overridden = true;
+    assert_int_equal(
+            sea_turtle_string_pool_intern(&object, &value, &out),
+            SEA_TURTLE_STRING_POOL_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = false;
+    assert_int_equal(sea_turtle_string_invalidate(&value), 0);
+    assert_int_equal(sea_turtle_string_pool_invalidate(&object), 0);
+}
+
+static void check_intern(void **state) {
+    struct sea_turtle_string_pool object;
+    assert_int_equal(sea_turtle_string_pool_init(&object), 0);
+    const char *chars[] = {
+            u8"level",
+            u8"message",
+            u8"a field value long enough to be stored on the heap 🐢",
+    };
+    const struct sea_turtle_string *canonical[3];
+    for (size_t i = 0; i < 3; i++) {
+        struct sea_turtle_string value;
+        assert_int_equal(sea_turtle_string_init(&value,
+                                                chars[i],
+                                                SIZE_MAX,
+                                                NULL), 0);
+        assert_int_equal(sea_turtle_string_pool_intern(
+                &object, &value, &canonical[i]), 0);
+        assert_ptr_not_equal(canonical[i], &value);
+        assert_int_equal(sea_turtle_string_compare(canonical[i], &value), 0);
+        assert_int_equal(sea_turtle_string_invalidate(&value), 0);
+    }
+    for (size_t i = 0; i < 3; i++) {
+        struct sea_turtle_string value;
+        assert_int_equal(sea_turtle_string_init(&value,
+                                                chars[i],
+                                                SIZE_MAX,
+                                                NULL), 0);
+        const struct sea_turtle_string *out;
+        assert_int_equal(sea_turtle_string_pool_intern(
+                &object, &value, &out), 0);
+        assert_ptr_equal(out, canonical[i]);
+        assert_int_equal(sea_turtle_string_invalidate(&value), 0);
+    }
+    uintmax_t count;
+    assert_int_equal(sea_turtle_string_pool_count(&object, &count), 0);
+    assert_int_equal(count, 3);
+    /* copies of canonical instances do not allocate */
+    struct sea_turtle_string copy;
+    malloc_is_overridden = true;
+    assert_int_equal(sea_turtle_string_init_string(&copy, canonical[2]), 0);
+    malloc_is_overridden = false;
+    assert_ptr_equal(copy.data, canonical[2]->data);
+    assert_int_equal(sea_turtle_string_compare(&copy, canonical[2]), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&copy), 0);
+    assert_int_equal(sea_turtle_string_pool_invalidate(&object), 0);
+}
+
+static void check_intern_many(void **state) {
+    struct sea_turtle_string_pool object;
+    assert_int_equal(sea_turtle_string_pool_init(&object), 0);
+    for (size_t round = 0; round < 2; round++) {
+        for (size_t i = 0; i < 5000; i++) {
+            char chars[32];
+            snprintf(chars, sizeof(chars), "key-%zu", i);
+            struct sea_turtle_string value;
+            assert_int_equal(sea_turtle_string_init(&value,
+                                                    chars,
+                                                    sizeof(chars),
+                                                    NULL), 0);
+            const struct sea_turtle_string *out;
+            assert_int_equal(sea_turtle_string_pool_intern(
+                    &object, &value, &out), 0);
+            assert_int_equal(sea_turtle_string_compare(out, &value), 0);
+            assert_int_equal(sea_turtle_string_invalidate(&value), 0);
+        }
+    }
+    uintmax_t count;
+    assert_int_equal(sea_turtle_string_pool_count(&object, &count), 0);
+    assert_int_equal(count, 5000);
+    assert_int_equal(sea_turtle_string_pool_invalidate(&object), 0);
+}
+
+struct intern_concurrently_arg {
+    struct sea_turtle_string_pool *pool;
+    const struct sea_turtle_string **canonical;
+};
+
+static void *intern_concurrently(void *arg) {
+    const struct intern_concurrently_arg *const with = arg;
+    for (size_t i = 0; i < 1000; i++) {
+        char chars[32];
+        snprintf(chars, sizeof(chars), "shared-%zu", i);
+        struct sea_turtle_string value;
+        seagrass_required_true(!sea_turtle_string_init(&value,
+                                                       chars,
+                                                       sizeof(chars),
+                                                       NULL));
+        const struct sea_turtle_string *out;
+        seagrass_required_true(!sea_turtle_string_pool_intern(
+                with->pool, &value, &out));
+        seagrass_required_true(!sea_turtle_string_compare(out, &value));
+        with->canonical[i] = out;
+        seagrass_required_true(!sea_turtle_string_invalidate(&value));
+    }
+    return NULL;
+}
+
+static void check_intern_concurrently(void **state) {
+    struct sea_turtle_string_pool object;
+    assert_int_equal(sea_turtle_string_pool_init(&object), 0);
+    pthread_t threads[4];
+    const struct sea_turtle_string *canonical[4][1000];
+    struct intern_concurrently_arg args[4];
+    for (size_t i = 0; i < 4; i++) {
+        args[i] = (struct intern_concurrently_arg) {
+                .pool = &object,
+                .canonical = canonical[i]
+        };
+        assert_int_equal(pthread_create(&threads[i], NULL,
+                                        intern_concurrently, &args[i]), 0);
+    }
+    for (size_t i = 0; i < 4; i++) {
+        assert_int_equal(pthread_join(threads[i], NULL), 0);
+    }
+    for (size_t i = 0; i < 1000; i++) {
+        for (size_t o = 1; o < 4; o++) {
+            assert_ptr_equal(canonical[0][i], canonical[o][i]);
+        }
+    }
+    uintmax_t count;
+    assert_int_equal(sea_turtle_string_pool_count(&object, &count), 0);
+    assert_int_equal(count, 1000);
+    assert_int_equal(sea_turtle_string_pool_invalidate(&object), 0);
+}
+
+static void check_count_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_pool_count(NULL, (void *) 1),
+            SEA_TURTLE_STRING_POOL_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_count_error_on_object_is_invalid(void **state) {
+    struct sea_turtle_string_pool object = {0};
+    assert_int_equal(
+            sea_turtle_string_pool_count(&object, (void *) 1),
+            SEA_TURTLE_STRING_POOL_ERROR_OBJECT_IS_INVALID);
+    assert_int_equal(sea_turtle_string_pool_init(&object), 0);
+    assert_int_equal(sea_turtle_string_pool_invalidate(&object), 0);
+    assert_int_equal(
+            sea_turtle_string_pool_count(&object, (void *) 1),
+            SEA_TURTLE_STRING_POOL_ERROR_OBJECT_IS_INVALID);
+}
+
+static void check_count_error_on_out_is_null(void **state) {
+    struct sea_turtle_string_pool object = {.shards = (void *) 1};
+    assert_int_equal(
+            sea_turtle_string_pool_count(&object, NULL),
+            SEA_TURTLE_STRING_POOL_ERROR_OUT_IS_NULL);
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_invalidate_error_on_object_is_null),
+            cmocka_unit_test(check_invalidate),
+            cmocka_unit_test(check_init_error_on_object_is_null),
+            cmocka_unit_test(check_init_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_init),
+            cmocka_unit_test(check_intern_error_on_object_is_null),
+            cmocka_unit_test(check_intern_error_on_object_is_invalid),
+            cmocka_unit_test(check_intern_error_on_value_is_null),
+            cmocka_unit_test(check_intern_error_on_out_is_null),
+            cmocka_unit_test(check_intern_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_intern),
+            cmocka_unit_test(check_intern_many),
+            cmocka_unit_test(check_intern_concurrently),
+            cmocka_unit_test(check_count_error_on_object_is_null),
+            cmocka_unit_test(check_count_error_on_object_is_invalid),
+            cmocka_unit_test(check_count_error_on_out_is_null),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,362 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sea-turtle.h>
+#include <seagrass.h>
+
+#include <test/cmocka.h>
+
+#include "private/string.h"
+#include "test_string_helpers.h"
+
+static const char *chars[] = {
+        "",
+        "a",
+        "a string longer than the local buffer",
+        u8"🐢",
+        u8"한국어 문자열은 로컬 버퍼보다 깁니다",
+        "",
+};
+
+#define COUNT (sizeof(chars) / sizeof(chars[0]))
+
+/* some of the hash codes are computed, which are never serialized */
+static void strings_hash(const struct sea_turtle_string *const strings) {
+    uintmax_t hash;
+    assert_int_equal(sea_turtle_string_hash(&strings[2], &hash), 0);
+    assert_int_equal(sea_turtle_string_hash(&strings[4], &hash), 0);
+}
+
+static uint8_t *serialize(const struct sea_turtle_string *const strings,
+                          const size_t count,
+                          size_t *const size) {
+    assert_int_equal(sea_turtle_string_serialized_size(strings, count, size),
+                     0);
+    uint8_t *const buffer = malloc(*size);
+    assert_non_null(buffer);
+    assert_int_equal(sea_turtle_string_serialize(strings, count, buffer,
+                                                 *size), 0);
+    return buffer;
+}
+
+static void check_serialized_size_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_serialized_size(NULL, 0, (void *) 1),
+            SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_serialized_size_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_serialized_size((void *) 1, 0, NULL),
+            SEA_TURTLE_STRING_ERROR_OUT_IS_NULL);
+}
+
+static void check_serialized_size(void **state) {
+    struct sea_turtle_string strings[COUNT];
+    strings_init(strings, chars, COUNT);
+    strings_hash(strings);
+    size_t empty;
+    assert_int_equal(sea_turtle_string_serialized_size(strings, 0, &empty),
+                     0);
+    size_t size;
+    assert_int_equal(sea_turtle_string_serialized_size(strings, COUNT,
+                                                       &size), 0);
+    size_t bytes = 0;
+    for (size_t i = 0; i < COUNT; i++) {
+        bytes += strings[i].size;
+    }
+    /* two 1 byte varints for each string */
+    assert_int_equal(size, empty + bytes + 2 * COUNT);
+    strings_invalidate(strings, COUNT);
+}
+
+static void check_serialize_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_serialize(NULL, 0, (void *) 1, 0),
+            SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_serialize_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_serialize((void *) 1, 0, NULL, 0),
+            SEA_TURTLE_STRING_ERROR_OUT_IS_NULL);
+}
+
+static void check_serialize_error_on_size_is_too_small(void **state) {
+    struct sea_turtle_string strings[COUNT];
+    strings_init(strings, chars, COUNT);
+    strings_hash(strings);
+    size_t size;
+    assert_int_equal(sea_turtle_string_serialized_size(strings, COUNT,
+                                                       &size), 0);
+    uint8_t *const buffer = malloc(size);
+    assert_non_null(buffer);
+    assert_int_equal(
+            sea_turtle_string_serialize(strings, COUNT, buffer, size - 1),
+            SEA_TURTLE_STRING_ERROR_SIZE_IS_TOO_SMALL);
+    free(buffer);
+    strings_invalidate(strings, COUNT);
+}
+
+static void check_serialized_count_error_on_buffer_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_serialized_count(NULL, 0, (void *) 1),
+            SEA_TURTLE_STRING_ERROR_BUFFER_IS_NULL);
+}
+
+static void check_serialized_count_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_serialized_count((void *) 1, 0, NULL),
+            SEA_TURTLE_STRING_ERROR_OUT_IS_NULL);
+}
+
+static void check_serialized_count_error_on_buffer_is_malformed(
+        void **state) {
+    struct sea_turtle_string strings[COUNT];
+    strings_init(strings, chars, COUNT);
+    strings_hash(strings);
+    size_t size;
+    uint8_t *const buffer = serialize(strings, COUNT, &size);
+    uintmax_t count;
+    assert_int_equal(
+            sea_turtle_string_serialized_count(buffer, size - 1, &count),
+            SEA_TURTLE_STRING_ERROR_BUFFER_IS_MALFORMED);
+    buffer[0] ^= 1;
+    assert_int_equal(
+            sea_turtle_string_serialized_count(buffer, size, &count),
+            SEA_TURTLE_STRING_ERROR_BUFFER_IS_MALFORMED);
+    free(buffer);
+    strings_invalidate(strings, COUNT);
+}
+
+static void check_serialized_count(void **state) {
+    struct sea_turtle_string strings[COUNT];
+    strings_init(strings, chars, COUNT);
+    strings_hash(strings);
+    size_t size;
+    uint8_t *const buffer = serialize(strings, COUNT, &size);
+    uintmax_t count;
+    assert_int_equal(
+            sea_turtle_string_serialized_count(buffer, size, &count), 0);
+    assert_int_equal(count, COUNT);
+    free(buffer);
+    strings_invalidate(strings, COUNT);
+}
+
+static void check_deserialize_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_deserialize(NULL, 0, (void *) 1, 0,
+                                          SEA_TURTLE_STRING_LOAD_VALIDATE),
+            SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_deserialize_error_on_buffer_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_deserialize((void *) 1, 0, NULL, 0,
+                                          SEA_TURTLE_STRING_LOAD_VALIDATE),
+            SEA_TURTLE_STRING_ERROR_BUFFER_IS_NULL);
+}
+
+static void check_deserialize_error_on_load_is_invalid(void **state) {
+    assert_int_equal(
+            sea_turtle_string_deserialize((void *) 1, 0, (void *) 1, 0, 3),
+            SEA_TURTLE_STRING_ERROR_LOAD_IS_INVALID);
+}
+
+static void check_deserialize_error_on_count_is_invalid(void **state) {
+    struct sea_turtle_string strings[COUNT];
+    strings_init(strings, chars, COUNT);
+    strings_hash(strings);
+    size_t size;
+    uint8_t *const buffer = serialize(strings, COUNT, &size);
+    struct sea_turtle_string out[COUNT];
+    assert_int_equal(
+            sea_turtle_string_deserialize(out, COUNT - 1, buffer, size,
+                                          SEA_TURTLE_STRING_LOAD_TRUSTED),
+            SEA_TURTLE_STRING_ERROR_COUNT_IS_INVALID);
+    free(buffer);
+    strings_invalidate(strings, COUNT);
+}
+
+static void check_deserialize_error_on_buffer_is_malformed(void **state) {
+    struct sea_turtle_string strings[COUNT];
+    strings_init(strings, chars, COUNT);
+    strings_hash(strings);
+    size_t size;
+    uint8_t *const buffer = serialize(strings, COUNT, &size);
+    struct sea_turtle_string out[COUNT];
+    const enum sea_turtle_string_load loads[] = {
+            SEA_TURTLE_STRING_LOAD_VALIDATE,
+            SEA_TURTLE_STRING_LOAD_TRUSTED,
+            SEA_TURTLE_STRING_LOAD_IN_PLACE
+    };
+    for (size_t o = 0; o < sizeof(loads) / sizeof(loads[0]); o++) {
+        assert_int_equal(
+                sea_turtle_string_deserialize(out, COUNT, buffer, size - 1,
+                                              loads[o]),
+                SEA_TURTLE_STRING_ERROR_BUFFER_IS_MALFORMED);
+        /* any byte changed but the count fails the checksum */
+        for (size_t i = 0; i < size; i++) {
+            buffer[i] ^= 0x40;
+            assert_int_equal(
+                    sea_turtle_string_deserialize(out, COUNT, buffer, size,
+                                                  loads[o]),
+                    i >= 16 && i < 24
+                    ? SEA_TURTLE_STRING_ERROR_COUNT_IS_INVALID
+                    : SEA_TURTLE_STRING_ERROR_BUFFER_IS_MALFORMED);
+            buffer[i] ^= 0x40;
+        }
+    }
+    free(buffer);
+    strings_invalidate(strings, COUNT);
+}
+
+static void check_deserialize_error_on_memory_allocation_failed(
+        void **state) {
+    struct sea_turtle_string strings[COUNT];
+    strings_init(strings, chars, COUNT);
+    strings_hash(strings);
+    size_t size;
+    uint8_t *const buffer = serialize(strings, COUNT, &size);
+    struct sea_turtle_string out[COUNT];
+    malloc_is_overridden = true;
+    assert_int_equal(
+            sea_turtle_string_deserialize(out, COUNT, buffer, size,
+                                          SEA_TURTLE_STRING_LOAD_TRUSTED),
+            SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = false;
+    free(buffer);
+    strings_invalidate(strings, COUNT);
+}
+
+static void check_deserialize(void **state) {
+    struct sea_turtle_string strings[COUNT];
+    strings_init(strings, chars, COUNT);
+    strings_hash(strings);
+    size_t size;
+    uint8_t *const buffer = serialize(strings, COUNT, &size);
+    const enum sea_turtle_string_load loads[] = {
+            SEA_TURTLE_STRING_LOAD_VALIDATE,
+            SEA_TURTLE_STRING_LOAD_TRUSTED,
+            SEA_TURTLE_STRING_LOAD_IN_PLACE
+    };
+    for (size_t o = 0; o < sizeof(loads) / sizeof(loads[0]); o++) {
+        struct sea_turtle_string out[COUNT];
+        assert_int_equal(
+                sea_turtle_string_deserialize(out, COUNT, buffer, size,
+                                              loads[o]), 0);
+        for (size_t i = 0; i < COUNT; i++) {
+            assert_int_equal(out[i].size, strings[i].size);
+            assert_int_equal(sea_turtle_string_count_of(&out[i]),
+                             sea_turtle_string_count_of(&strings[i]));
+            assert_int_equal(sea_turtle_string_compare(&out[i], &strings[i]),
+                             0);
+            /* hash codes are computed again by the loading process */
+            assert_int_equal(sea_turtle_string_cached_hash(&out[i]), 0);
+            uintmax_t hash;
+            uintmax_t other;
+            assert_int_equal(sea_turtle_string_hash(&out[i], &hash), 0);
+            assert_int_equal(sea_turtle_string_hash(&strings[i], &other), 0);
+            assert_int_equal(hash, other);
+            const bool in_place = SEA_TURTLE_STRING_LOAD_IN_PLACE == loads[o]
+                                  && out[i].size
+                                     > SEA_TURTLE_STRING_LOCAL_SIZE;
+            const uint8_t *const bytes = sea_turtle_string_bytes(&out[i]);
+            assert_int_equal(bytes >= buffer && bytes < buffer + size,
+                             in_place);
+            assert_int_equal(sea_turtle_string_invalidate(&out[i]), 0);
+        }
+    }
+    free(buffer);
+    strings_invalidate(strings, COUNT);
+}
+
+static void check_deserialize_in_place_copy_on_write(void **state) {
+    struct sea_turtle_string strings[COUNT];
+    strings_init(strings, chars, COUNT);
+    strings_hash(strings);
+    size_t size;
+    uint8_t *const buffer = serialize(strings, COUNT, &size);
+    uint8_t *const copy = malloc(size);
+    assert_non_null(copy);
+    memcpy(copy, buffer, size);
+    struct sea_turtle_string out[COUNT];
+    assert_int_equal(
+            sea_turtle_string_deserialize(out, COUNT, buffer, size,
+                                          SEA_TURTLE_STRING_LOAD_IN_PLACE),
+            0);
+    assert_int_equal(sea_turtle_string_storage_of(&out[2]),
+                     SEA_TURTLE_STRING_STORAGE_ARENA);
+    assert_int_equal(sea_turtle_string_set_size(&out[2], out[2].size), 0);
+    assert_int_equal(sea_turtle_string_storage_of(&out[2]),
+                     SEA_TURTLE_STRING_STORAGE_HEAP);
+    out[2].data[0] = 'A';
+    assert_string_equal((const char *) out[2].data,
+                        "A string longer than the local buffer");
+    /* the buffer is left untouched */
+    assert_memory_equal(buffer, copy, size);
+    for (size_t i = 0; i < COUNT; i++) {
+        assert_int_equal(sea_turtle_string_invalidate(&out[i]), 0);
+    }
+    assert_memory_equal(buffer, copy, size);
+    free(copy);
+    free(buffer);
+    strings_invalidate(strings, COUNT);
+}
+
+static void check_deserialize_validate(void **state) {
+    struct sea_turtle_string string;
+    assert_int_equal(sea_turtle_string_init(&string, "abc", SIZE_MAX, NULL),
+                     0);
+    /* a stored count which does not match the bytes */
+    sea_turtle_string_set_count(&string, 2);
+    size_t size;
+    uint8_t *const buffer = serialize(&string, 1, &size);
+    struct sea_turtle_string out;
+    assert_int_equal(
+            sea_turtle_string_deserialize(&out, 1, buffer, size,
+                                          SEA_TURTLE_STRING_LOAD_VALIDATE),
+            SEA_TURTLE_STRING_ERROR_BUFFER_IS_MALFORMED);
+    /* while trusted loads take it as it is */
+    assert_int_equal(
+            sea_turtle_string_deserialize(&out, 1, buffer, size,
+                                          SEA_TURTLE_STRING_LOAD_TRUSTED),
+            0);
+    assert_int_equal(sea_turtle_string_count_of(&out), 2);
+    assert_int_equal(sea_turtle_string_invalidate(&out), 0);
+    free(buffer);
+    assert_int_equal(sea_turtle_string_invalidate(&string), 0);
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_serialized_size_error_on_object_is_null),
+            cmocka_unit_test(check_serialized_size_error_on_out_is_null),
+            cmocka_unit_test(check_serialized_size),
+            cmocka_unit_test(check_serialize_error_on_object_is_null),
+            cmocka_unit_test(check_serialize_error_on_out_is_null),
+            cmocka_unit_test(check_serialize_error_on_size_is_too_small),
+            cmocka_unit_test(check_serialized_count_error_on_buffer_is_null),
+            cmocka_unit_test(check_serialized_count_error_on_out_is_null),
+            cmocka_unit_test(
+                    check_serialized_count_error_on_buffer_is_malformed),
+            cmocka_unit_test(check_serialized_count),
+            cmocka_unit_test(check_deserialize_error_on_object_is_null),
+            cmocka_unit_test(check_deserialize_error_on_buffer_is_null),
+            cmocka_unit_test(check_deserialize_error_on_load_is_invalid),
+            cmocka_unit_test(check_deserialize_error_on_count_is_invalid),
+            cmocka_unit_test(check_deserialize_error_on_buffer_is_malformed),
+            cmocka_unit_test(
+                    check_deserialize_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_deserialize),
+            cmocka_unit_test(check_deserialize_in_place_copy_on_write),
+            cmocka_unit_test(check_deserialize_validate),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
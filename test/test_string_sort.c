@@ -0,0 +1,196 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sea-turtle.h>
+#include <seagrass.h>
+
+#include <test/cmocka.h>
+
+#include "private/string.h"
+
+static void check_sort_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_sort(NULL, 0, SEA_TURTLE_STRING_ORDER_SIZE, 1),
+            SEA_TURTLE_STRING_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_sort_error_on_order_is_invalid(void **state) {
+    assert_int_equal(
+            sea_turtle_string_sort((void *) 1, 0, 2, 1),
+            SEA_TURTLE_STRING_ERROR_ORDER_IS_INVALID);
+}
+
+static void check_sort_error_on_memory_allocation_failed(void **state) {
+    struct sea_turtle_string objects[2];
+    assert_int_equal(sea_turtle_string_init(&objects[0], "b", SIZE_MAX,
+                                            NULL), 0);
+    assert_int_equal(sea_turtle_string_init(&objects[1], "a", SIZE_MAX,
+                                            NULL), 0);
+    malloc_is_overridden = true;
+    assert_int_equal(
+            sea_turtle_string_sort(objects, 2, SEA_TURTLE_STRING_ORDER_SIZE,
+                                   1),
+            SEA_TURTLE_STRING_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = false;
+    /* the array is left untouched */
+    assert_string_equal((const char *) objects[0].local, "b");
+    assert_string_equal((const char *) objects[1].local, "a");
+    for (size_t i = 0; i < 2; i++) {
+        assert_int_equal(sea_turtle_string_invalidate(&objects[i]), 0);
+    }
+}
+
+static void check_sort(void **state) {
+    const char *chars[] = {
+            u8"🐢", "b", "", "a longer string than the local buffer", "ab",
+            u8"한", "a", "a longer string than the local buffer holds",
+            "b", "abcdefgh", "abcdefghi", "abcdefg"
+    };
+    const char *by_size[] = {
+            "", "a", "b", "b", "ab", u8"한", u8"🐢", "abcdefg", "abcdefgh",
+            "abcdefghi", "a longer string than the local buffer",
+            "a longer string than the local buffer holds"
+    };
+    const char *by_bytes[] = {
+            "", "a", "a longer string than the local buffer",
+            "a longer string than the local buffer holds", "ab", "abcdefg",
+            "abcdefgh", "abcdefghi", "b", "b", u8"한", u8"🐢"
+    };
+    const enum sea_turtle_string_order orders[] = {
+            SEA_TURTLE_STRING_ORDER_SIZE, SEA_TURTLE_STRING_ORDER_BYTES
+    };
+    const char **expected[] = {by_size, by_bytes};
+    for (size_t o = 0; o < 2; o++) {
+        struct sea_turtle_string objects[12];
+        for (size_t i = 0; i < 12; i++) {
+            assert_int_equal(sea_turtle_string_init(&objects[i], chars[i],
+                                                    SIZE_MAX, NULL), 0);
+        }
+        assert_int_equal(sea_turtle_string_sort(objects, 12, orders[o], 1),
+                         0);
+        for (size_t i = 0; i < 12; i++) {
+            /* strings stored locally carry their bytes along when moved */
+            if (objects[i].size) {
+                assert_string_equal(
+                        (const char *) sea_turtle_string_bytes(&objects[i]),
+                        expected[o][i]);
+            } else {
+                assert_int_equal(strlen(expected[o][i]), 0);
+            }
+            assert_int_equal(sea_turtle_string_invalidate(&objects[i]), 0);
+        }
+    }
+}
+
+static int compare_size(const void *a, const void *b) {
+    const struct sea_turtle_string *const *const x = a;
+    const struct sea_turtle_string *const *const y = b;
+    return sea_turtle_string_compare(*x, *y);
+}
+
+static int compare_bytes(const void *a, const void *b) {
+    const struct sea_turtle_string *const *const x = a;
+    const struct sea_turtle_string *const *const y = b;
+    return strcmp(
+            (*x)->size ? (const char *) sea_turtle_string_bytes(*x) : "",
+            (*y)->size ? (const char *) sea_turtle_string_bytes(*y) : "");
+}
+
+static void check_sort_parallel(void **state) {
+    const size_t count = 100000;
+    struct sea_turtle_string *const objects = malloc(
+            count * sizeof(*objects));
+    struct sea_turtle_string *const strings = malloc(
+            count * sizeof(*strings));
+    /* sorted by qsort through pointers as local strings cannot be moved */
+    struct sea_turtle_string **const expected = malloc(
+            count * sizeof(*expected));
+    assert_non_null(objects);
+    assert_non_null(strings);
+    assert_non_null(expected);
+    const enum sea_turtle_string_order orders[] = {
+            SEA_TURTLE_STRING_ORDER_SIZE, SEA_TURTLE_STRING_ORDER_BYTES
+    };
+    int (*const compare[])(const void *, const void *) = {
+            compare_size, compare_bytes
+    };
+    uint32_t seed = 42;
+    char chars[64];
+    for (size_t o = 0; o < 2; o++) {
+        for (size_t i = 0; i < count; i++) {
+            seed = seed * 1103515245 + 12345;
+            /* long shared prefixes and many duplicates */
+            snprintf(chars, sizeof(chars), "%.*s%u",
+                     (int) ((seed >> 8) % 40),
+                     "/routes/api/v1/users/index/turtle/shell/",
+                     (seed >> 16) % 5000);
+            assert_int_equal(sea_turtle_string_init(&objects[i], chars,
+                                                    SIZE_MAX, NULL), 0);
+            assert_int_equal(sea_turtle_string_init(&strings[i], chars,
+                                                    SIZE_MAX, NULL), 0);
+            expected[i] = &strings[i];
+        }
+        qsort(expected, count, sizeof(*expected), compare[o]);
+        assert_int_equal(sea_turtle_string_sort(objects, count, orders[o],
+                                                4), 0);
+        for (size_t i = 0; i < count; i++) {
+            const struct sea_turtle_string *const object = &objects[i];
+            assert_int_equal(compare[o](&object, &expected[i]), 0);
+        }
+        for (size_t i = 0; i < count; i++) {
+            assert_int_equal(sea_turtle_string_invalidate(&objects[i]), 0);
+            assert_int_equal(sea_turtle_string_invalidate(&strings[i]), 0);
+        }
+    }
+    free(objects);
+    free(strings);
+    free(expected);
+}
+
+static void check_sort_patterns(void **state) {
+    const size_t count = 5000;
+    struct sea_turtle_string *const objects = malloc(
+            count * sizeof(*objects));
+    assert_non_null(objects);
+    char chars[32];
+    /* presorted, reversed and organ pipe inputs with shared prefixes */
+    for (size_t p = 0; p < 3; p++) {
+        for (size_t i = 0; i < count; i++) {
+            const size_t value = 0 == p ? i
+                    : 1 == p ? count - i
+                    : i < count / 2 ? i : count - i;
+            snprintf(chars, sizeof(chars), "turtle-%08zu", value);
+            assert_int_equal(sea_turtle_string_init(&objects[i], chars,
+                                                    SIZE_MAX, NULL), 0);
+        }
+        assert_int_equal(sea_turtle_string_sort(
+                objects, count, SEA_TURTLE_STRING_ORDER_BYTES, 1), 0);
+        for (size_t i = 1; i < count; i++) {
+            const struct sea_turtle_string *const a = &objects[i - 1];
+            const struct sea_turtle_string *const b = &objects[i];
+            assert_true(compare_bytes(&a, &b) <= 0);
+        }
+        for (size_t i = 0; i < count; i++) {
+            assert_int_equal(sea_turtle_string_invalidate(&objects[i]), 0);
+        }
+    }
+    free(objects);
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_sort_error_on_object_is_null),
+            cmocka_unit_test(check_sort_error_on_order_is_invalid),
+            cmocka_unit_test(check_sort_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_sort),
+            cmocka_unit_test(check_sort_parallel),
+            cmocka_unit_test(check_sort_patterns),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,348 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <string.h>
+#include <sea-turtle.h>
+#include <seagrass.h>
+
+#include <test/cmocka.h>
+
+#include "private/string.h"
+
+static void check_init_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_view_init(NULL, (void *) 1, 1, NULL),
+            SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init_error_on_char_ptr_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_view_init((void *) 1, NULL, 1, NULL),
+            SEA_TURTLE_STRING_VIEW_ERROR_CHAR_PTR_IS_NULL);
+}
+
+static void check_init_error_on_size_is_zero(void **state) {
+    assert_int_equal(
+            sea_turtle_string_view_init((void *) 1, (void *) 1, 0, NULL),
+            SEA_TURTLE_STRING_VIEW_ERROR_SIZE_IS_ZERO);
+}
+
+static void check_init_error_on_char_ptr_is_malformed(void **state) {
+    struct sea_turtle_string_view object;
+    assert_int_equal(
+            sea_turtle_string_view_init(&object, "a\xED\xA0\x80", SIZE_MAX,
+                                        NULL),
+            SEA_TURTLE_STRING_VIEW_ERROR_CHAR_PTR_IS_MALFORMED);
+}
+
+static void check_init(void **state) {
+    /* fields of a wire format are not NULL terminated */
+    const char *const chars = u8"key=🐢;next";
+    struct sea_turtle_string_view object;
+    size_t out;
+    malloc_is_overridden = true;
+    assert_int_equal(sea_turtle_string_view_init(&object, chars + 4, 4,
+                                                 &out), 0);
+    malloc_is_overridden = false;
+    assert_int_equal(out, 4);
+    assert_ptr_equal(object.data, chars + 4);
+    assert_int_equal(object.size, 4);
+    assert_int_equal(object.count, 1);
+}
+
+static void check_init_string_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_view_init_string(NULL, (void *) 1),
+            SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_init_string_error_on_string_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_view_init_string((void *) 1, NULL),
+            SEA_TURTLE_STRING_VIEW_ERROR_STRING_IS_NULL);
+}
+
+static void check_init_string(void **state) {
+    struct sea_turtle_string string;
+    assert_int_equal(sea_turtle_string_init(&string, u8"sea 🐢", SIZE_MAX,
+                                            NULL), 0);
+    struct sea_turtle_string_view object;
+    assert_int_equal(sea_turtle_string_view_init_string(&object, &string), 0);
+    assert_ptr_equal(object.data, string.local);
+    assert_int_equal(object.size, string.size - 1);
+    assert_int_equal(object.count, sea_turtle_string_count_of(&string));
+    assert_int_equal(sea_turtle_string_invalidate(&string), 0);
+    assert_int_equal(sea_turtle_string_view_init_string(&object, &string), 0);
+    assert_int_equal(object.size, 0);
+    assert_int_equal(object.count, 0);
+}
+
+static void check_substring_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_view_substring(NULL, 0, 0, (void *) 1),
+            SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_substring_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_view_substring((void *) 1, 0, 0, NULL),
+            SEA_TURTLE_STRING_VIEW_ERROR_OUT_IS_NULL);
+}
+
+static void check_substring_error_on_index_is_out_of_bounds(void **state) {
+    struct sea_turtle_string_view object;
+    assert_int_equal(sea_turtle_string_view_init(&object, "ab", SIZE_MAX,
+                                                 NULL), 0);
+    struct sea_turtle_string_view out;
+    assert_int_equal(sea_turtle_string_view_substring(&object, 3, 0, &out),
+                     SEA_TURTLE_STRING_VIEW_ERROR_INDEX_IS_OUT_OF_BOUNDS);
+}
+
+static void check_substring_error_on_count_is_out_of_bounds(void **state) {
+    struct sea_turtle_string_view object;
+    assert_int_equal(sea_turtle_string_view_init(&object, "ab", SIZE_MAX,
+                                                 NULL), 0);
+    struct sea_turtle_string_view out;
+    assert_int_equal(sea_turtle_string_view_substring(&object, 1, 2, &out),
+                     SEA_TURTLE_STRING_VIEW_ERROR_COUNT_IS_OUT_OF_BOUNDS);
+}
+
+static void check_substring(void **state) {
+    const char *const chars = u8"a€🐢b£c";
+    struct sea_turtle_string_view object;
+    assert_int_equal(sea_turtle_string_view_init(&object, chars, SIZE_MAX,
+                                                 NULL), 0);
+    struct sea_turtle_string_view out;
+    assert_int_equal(sea_turtle_string_view_substring(&object, 1, 3, &out),
+                     0);
+    assert_ptr_equal(out.data, chars + 1);
+    assert_int_equal(out.size, strlen(u8"€🐢b"));
+    assert_int_equal(out.count, 3);
+    assert_int_equal(sea_turtle_string_view_substring(&out, 2, 1, &out), 0);
+    assert_ptr_equal(out.data, chars + 1 + strlen(u8"€🐢"));
+    assert_int_equal(out.size, 1);
+    assert_int_equal(sea_turtle_string_view_substring(&object, 6, 0, &out),
+                     0);
+    assert_int_equal(out.size, 0);
+    assert_int_equal(out.count, 0);
+}
+
+static void check_to_string_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_view_to_string(NULL, (void *) 1),
+            SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_to_string_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_view_to_string((void *) 1, NULL),
+            SEA_TURTLE_STRING_VIEW_ERROR_OUT_IS_NULL);
+}
+
+static void check_to_string_error_on_memory_allocation_failed(void **state) {
+    struct sea_turtle_string_view object;
+    assert_int_equal(sea_turtle_string_view_init(
+            &object, "long enough to be stored on the heap", SIZE_MAX, NULL),
+                     0);
+    struct sea_turtle_string out;
+    malloc_is_overridden = true;
+    assert_int_equal(sea_turtle_string_view_to_string(&object, &out),
+                     SEA_TURTLE_STRING_VIEW_ERROR_MEMORY_ALLOCATION_FAILED);
+    malloc_is_overridden = false;
+}
+
+static void check_to_string(void **state) {
+    const char *const chars = u8"key=🐢;next";
+    struct sea_turtle_string_view object;
+    assert_int_equal(sea_turtle_string_view_init(&object, chars + 4, 4,
+                                                 NULL), 0);
+    struct sea_turtle_string out;
+    assert_int_equal(sea_turtle_string_view_to_string(&object, &out), 0);
+    struct sea_turtle_string string;
+    assert_int_equal(sea_turtle_string_init(&string, u8"🐢", SIZE_MAX,
+                                            NULL), 0);
+    assert_int_equal(sea_turtle_string_compare(&out, &string), 0);
+    assert_int_equal(sea_turtle_string_count_of(&out),
+                     sea_turtle_string_count_of(&string));
+    uintmax_t hashes[2];
+    assert_int_equal(sea_turtle_string_hash(&out, &hashes[0]), 0);
+    assert_int_equal(sea_turtle_string_hash(&string, &hashes[1]), 0);
+    assert_int_equal(hashes[0], hashes[1]);
+    assert_int_equal(sea_turtle_string_invalidate(&string), 0);
+    assert_int_equal(sea_turtle_string_invalidate(&out), 0);
+}
+
+static void check_count_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_view_count(NULL, (void *) 1),
+            SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_count_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_view_count((void *) 1, NULL),
+            SEA_TURTLE_STRING_VIEW_ERROR_OUT_IS_NULL);
+}
+
+static void check_count(void **state) {
+    struct sea_turtle_string_view object;
+    assert_int_equal(sea_turtle_string_view_init(&object, u8"🐢🐢", SIZE_MAX,
+                                                 NULL), 0);
+    uintmax_t out;
+    assert_int_equal(sea_turtle_string_view_count(&object, &out), 0);
+    assert_int_equal(out, 2);
+}
+
+static void check_compare(void **state) {
+    const char *const chars = "abcabd";
+    struct sea_turtle_string_view a;
+    struct sea_turtle_string_view b;
+    struct sea_turtle_string_view c;
+    assert_int_equal(sea_turtle_string_view_init(&a, chars, 3, NULL), 0);
+    assert_int_equal(sea_turtle_string_view_init(&b, chars + 3, 3, NULL), 0);
+    assert_int_equal(sea_turtle_string_view_init(&c, chars, 2, NULL), 0);
+    assert_int_equal(sea_turtle_string_view_compare(&a, &b), -1);
+    assert_int_equal(sea_turtle_string_view_compare(&b, &a), 1);
+    assert_int_equal(sea_turtle_string_view_compare(&a, &a), 0);
+    assert_int_equal(sea_turtle_string_view_compare(&c, &a), -1);
+    assert_int_equal(sea_turtle_string_view_compare(&a, NULL), -1);
+    assert_int_equal(sea_turtle_string_view_compare(NULL, &a), 1);
+}
+
+static void check_hash_error_on_object_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_view_hash(NULL, (void *) 1),
+            SEA_TURTLE_STRING_VIEW_ERROR_OBJECT_IS_NULL);
+}
+
+static void check_hash_error_on_out_is_null(void **state) {
+    assert_int_equal(
+            sea_turtle_string_view_hash((void *) 1, NULL),
+            SEA_TURTLE_STRING_VIEW_ERROR_OUT_IS_NULL);
+}
+
+static void check_hash(void **state) {
+    const char *const chars = u8"[sea 🐢 turtle]";
+    struct sea_turtle_string_view object;
+    assert_int_equal(sea_turtle_string_view_init(
+            &object, chars + 1, strlen(chars) - 2, NULL), 0);
+    struct sea_turtle_string string;
+    assert_int_equal(sea_turtle_string_init(&string, u8"sea 🐢 turtle",
+                                            SIZE_MAX, NULL), 0);
+    uintmax_t out;
+    assert_int_equal(sea_turtle_string_view_hash(&object, &out), 0);
+    uintmax_t hash;
+    assert_int_equal(sea_turtle_string_hash(&string, &hash), 0);
+    assert_int_equal(out, hash);
+    assert_int_equal(sea_turtle_string_invalidate(&string), 0);
+}
+
+static void check_first_error_on_view_is_empty(void **state) {
+    struct sea_turtle_string_view object = {0};
+    const uint8_t *out;
+    assert_int_equal(sea_turtle_string_view_first(&object, &out),
+                     SEA_TURTLE_STRING_VIEW_ERROR_VIEW_IS_EMPTY);
+    assert_int_equal(sea_turtle_string_view_last(&object, &out),
+                     SEA_TURTLE_STRING_VIEW_ERROR_VIEW_IS_EMPTY);
+}
+
+static void check_iterate(void **state) {
+    /* the view ends in the middle of the bytes */
+    const char *const chars = u8"a€🐢b£c";
+    const uint32_t code_points[] = {'a', 0x20AC, 0x1F422, 'b'};
+    struct sea_turtle_string_view object;
+    assert_int_equal(sea_turtle_string_view_init(
+            &object, chars, strlen(u8"a€🐢b"), NULL), 0);
+    const uint8_t *at;
+    assert_int_equal(sea_turtle_string_view_first(&object, &at), 0);
+    size_t i = 0;
+    int error;
+    do {
+        uint32_t code_point;
+        assert_int_equal(sea_turtle_string_view_code_point(&object, at,
+                                                           &code_point), 0);
+        assert_int_equal(code_point, code_points[i++]);
+    } while (!(error = sea_turtle_string_view_next(&object, at, &at)));
+    assert_int_equal(error, SEA_TURTLE_STRING_VIEW_ERROR_END_OF_SEQUENCE);
+    assert_int_equal(i, 4);
+    assert_int_equal(sea_turtle_string_view_last(&object, &at), 0);
+    do {
+        uint32_t code_point;
+        assert_int_equal(sea_turtle_string_view_code_point(&object, at,
+                                                           &code_point), 0);
+        assert_int_equal(code_point, code_points[--i]);
+    } while (!(error = sea_turtle_string_view_prev(&object, at, &at)));
+    assert_int_equal(error, SEA_TURTLE_STRING_VIEW_ERROR_END_OF_SEQUENCE);
+    assert_int_equal(i, 0);
+}
+
+static void check_next_error_on_at_is_out_of_bounds(void **state) {
+    const char *const chars = "abc";
+    struct sea_turtle_string_view object;
+    assert_int_equal(sea_turtle_string_view_init(&object, chars, 2, NULL), 0);
+    const uint8_t *out;
+    const uint8_t *const end = (const uint8_t *) chars + 2;
+    assert_int_equal(sea_turtle_string_view_next(&object, end, &out),
+                     SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_OUT_OF_BOUNDS);
+    assert_int_equal(sea_turtle_string_view_prev(&object, end, &out),
+                     SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_OUT_OF_BOUNDS);
+    uint32_t code_point;
+    assert_int_equal(sea_turtle_string_view_code_point(&object, end,
+                                                       &code_point),
+                     SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_OUT_OF_BOUNDS);
+}
+
+static void check_next_error_on_at_is_invalid(void **state) {
+    const char *const chars = u8"🐢";
+    struct sea_turtle_string_view object;
+    assert_int_equal(sea_turtle_string_view_init(&object, chars, SIZE_MAX,
+                                                 NULL), 0);
+    const uint8_t *out;
+    const uint8_t *const at = (const uint8_t *) chars + 1;
+    assert_int_equal(sea_turtle_string_view_next(&object, at, &out),
+                     SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_INVALID);
+    assert_int_equal(sea_turtle_string_view_prev(&object, at, &out),
+                     SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_INVALID);
+    uint32_t code_point;
+    assert_int_equal(sea_turtle_string_view_code_point(&object, at,
+                                                       &code_point),
+                     SEA_TURTLE_STRING_VIEW_ERROR_AT_IS_INVALID);
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_init_error_on_object_is_null),
+            cmocka_unit_test(check_init_error_on_char_ptr_is_null),
+            cmocka_unit_test(check_init_error_on_size_is_zero),
+            cmocka_unit_test(check_init_error_on_char_ptr_is_malformed),
+            cmocka_unit_test(check_init),
+            cmocka_unit_test(check_init_string_error_on_object_is_null),
+            cmocka_unit_test(check_init_string_error_on_string_is_null),
+            cmocka_unit_test(check_init_string),
+            cmocka_unit_test(check_substring_error_on_object_is_null),
+            cmocka_unit_test(check_substring_error_on_out_is_null),
+            cmocka_unit_test(check_substring_error_on_index_is_out_of_bounds),
+            cmocka_unit_test(check_substring_error_on_count_is_out_of_bounds),
+            cmocka_unit_test(check_substring),
+            cmocka_unit_test(check_to_string_error_on_object_is_null),
+            cmocka_unit_test(check_to_string_error_on_out_is_null),
+            cmocka_unit_test(
+                    check_to_string_error_on_memory_allocation_failed),
+            cmocka_unit_test(check_to_string),
+            cmocka_unit_test(check_count_error_on_object_is_null),
+            cmocka_unit_test(check_count_error_on_out_is_null),
+            cmocka_unit_test(check_count),
+            cmocka_unit_test(check_compare),
+            cmocka_unit_test(check_hash_error_on_object_is_null),
+            cmocka_unit_test(check_hash_error_on_out_is_null),
+            cmocka_unit_test(check_hash),
+            cmocka_unit_test(check_first_error_on_view_is_empty),
+            cmocka_unit_test(check_iterate),
+            cmocka_unit_test(check_next_error_on_at_is_out_of_bounds),
+            cmocka_unit_test(check_next_error_on_at_is_invalid),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,135 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <string.h>
+#include <sea-turtle.h>
+
+#include <test/cmocka.h>
+
+#include "private/utf16.h"
+
+typedef void (*to_utf8_fn)(const uint8_t *, size_t, bool, uint8_t *);
+
+typedef void (*from_utf8_fn)(const uint8_t *, size_t, bool, uint8_t *,
+                             size_t);
+
+/* write code unit in the given byte order */
+static void put(uint8_t *const at, const uint16_t unit, const bool big) {
+    at[big ? 0 : 1] = unit >> 8;
+    at[big ? 1 : 0] = unit & 0xFF;
+}
+
+static void check_measure(void **state) {
+    /* "a£€🐉" */
+    const uint8_t little[] = {'a', 0, 0xA3, 0, 0xAC, 0x20, 0x3D, 0xD8,
+                              0x09, 0xDC};
+    size_t size;
+    uintmax_t code_points;
+    assert_int_equal(sea_turtle_utf16_measure(little, 5, false, &size,
+                                              &code_points), 0);
+    assert_int_equal(size, 1 + 2 + 3 + 4);
+    assert_int_equal(code_points, 4);
+    /* the same bytes read as big endian */
+    assert_int_equal(sea_turtle_utf16_measure(little, 3, true, &size,
+                                              &code_points), 0);
+    assert_int_equal(size, 3 + 3 + 3);
+    assert_int_equal(code_points, 3);
+    /* high surrogate without its low surrogate */
+    assert_int_equal(sea_turtle_utf16_measure(little, 4, false, &size,
+                                              &code_points),
+                     SEA_TURTLE_STRING_ERROR_UTF16_IS_MALFORMED);
+    /* low surrogate first */
+    assert_int_equal(sea_turtle_utf16_measure(little + 8, 1, false, &size,
+                                              &code_points),
+                     SEA_TURTLE_STRING_ERROR_UTF16_IS_MALFORMED);
+    /* NULL code unit after a run of ASCII */
+    uint8_t ascii[40] = {0};
+    for (size_t i = 0; i < 19; i++) {
+        ascii[2 * i] = 'a';
+    }
+    assert_int_equal(sea_turtle_utf16_measure(ascii, 19, false, &size,
+                                              &code_points), 0);
+    assert_int_equal(size, 19);
+    assert_int_equal(code_points, 19);
+    assert_int_equal(sea_turtle_utf16_measure(ascii, 20, false, &size,
+                                              &code_points),
+                     SEA_TURTLE_STRING_ERROR_UTF16_IS_MALFORMED);
+    assert_int_equal(sea_turtle_utf16_measure(ascii, 0, false, &size,
+                                              &code_points), 0);
+    assert_int_equal(size, 0);
+    assert_int_equal(code_points, 0);
+}
+
+static void check_transcode_matches_scalar(void **state) {
+    /* transcoding kernels of every implementation the CPU supports */
+    to_utf8_fn to_utf8[4] = {
+            sea_turtle_utf16_to_utf8, sea_turtle_utf16_to_utf8_scalar
+    };
+    from_utf8_fn from_utf8[4] = {
+            sea_turtle_utf16_from_utf8, sea_turtle_utf16_from_utf8_scalar
+    };
+    size_t count = 2;
+#if defined(SEA_TURTLE_UTF16_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.2")) {
+        to_utf8[count] = sea_turtle_utf16_to_utf8_sse42;
+        from_utf8[count++] = sea_turtle_utf16_from_utf8_sse42;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        to_utf8[count] = sea_turtle_utf16_to_utf8_avx2;
+        from_utf8[count++] = sea_turtle_utf16_from_utf8_avx2;
+    }
+#endif
+    /* a symbol of every UTF-8 encoded size in between runs of ASCII */
+    const uint32_t symbols[] = {0xA3, 0x20AC, 0x1F409};
+    uint8_t utf16[2 * 400];
+    uint8_t expected[4 * 400];
+    uint8_t utf8[4 * 400];
+    uint8_t units[2 * 400];
+    uint32_t seed = 42;
+    for (size_t round = 0; round < 2000; round++) {
+        const bool big = round & 1;
+        const size_t length = (seed = seed * 1103515245 + 12345) % 300;
+        size_t n = 0;
+        for (size_t i = 0; i < length; i++) {
+            seed = seed * 1103515245 + 12345;
+            /* mostly ASCII so that long runs occur */
+            const uint32_t c = (seed >> 8) % 16
+                               ? 1 + (seed >> 16) % 0x7F
+                               : symbols[(seed >> 16) % 3];
+            if (c < 0x10000) {
+                put(utf16 + 2 * n++, c, big);
+            } else {
+                put(utf16 + 2 * n++, 0xD800 + ((c - 0x10000) >> 10), big);
+                put(utf16 + 2 * n++, 0xDC00 + ((c - 0x10000) & 0x3FF), big);
+            }
+        }
+        size_t size;
+        uintmax_t code_points;
+        assert_int_equal(sea_turtle_utf16_measure(utf16, n, big, &size,
+                                                  &code_points), 0);
+        assert_int_equal(code_points, length);
+        sea_turtle_utf16_to_utf8_scalar(utf16, n, big, expected);
+        for (size_t i = 0; i < count; i++) {
+            memset(utf8, 0xFF, sizeof(utf8));
+            to_utf8[i](utf16, n, big, utf8);
+            assert_memory_equal(utf8, expected, size);
+            memset(units, 0xFF, sizeof(units));
+            from_utf8[i](expected, size, big, units, n);
+            assert_memory_equal(units, utf16, 2 * n);
+            /* nothing is written past the last code unit */
+            assert_int_equal(units[2 * n], 0xFF);
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_measure),
+            cmocka_unit_test(check_transcode_matches_scalar),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,335 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <string.h>
+#include <sea-turtle.h>
+
+#include <test/cmocka.h>
+
+#include "private/utf8.h"
+
+typedef int (*kernel_fn)(const uint8_t *, size_t, uintmax_t *);
+typedef int (*validate_fn)(size_t, const uint8_t *, size_t, size_t *,
+                           uintmax_t *);
+
+static kernel_fn kernels[5];
+
+static int kernel(const size_t which,
+                  const uint8_t *begin,
+                  const size_t size,
+                  size_t *out,
+                  uintmax_t *count) {
+    const size_t length = strnlen((const char *) begin, size);
+    uintmax_t c;
+    const int error = kernels[which](begin, length, &c);
+    if (!error) {
+        *out = length;
+        if (count) {
+            *count = c;
+        }
+    }
+    return error;
+}
+
+static int dispatch(const size_t which,
+                    const uint8_t *begin,
+                    const size_t size,
+                    size_t *out,
+                    uintmax_t *count) {
+    return sea_turtle_utf8_validate(begin, size, out, count);
+}
+
+static size_t implementations(validate_fn out[5]) {
+    size_t i = 0;
+    out[i] = dispatch;
+    kernels[i++] = NULL;
+    out[i] = kernel;
+    kernels[i++] = sea_turtle_utf8_validate_scalar;
+#if defined(SEA_TURTLE_UTF8_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.2")) {
+        out[i] = kernel;
+        kernels[i++] = sea_turtle_utf8_validate_sse42;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        out[i] = kernel;
+        kernels[i++] = sea_turtle_utf8_validate_avx2;
+    }
+    if (__builtin_cpu_supports("avx512bw")) {
+        out[i] = kernel;
+        kernels[i++] = sea_turtle_utf8_validate_avx512;
+    }
+#endif
+    return i;
+}
+
+static void check_validate_ascii(void **state) {
+    validate_fn fn[5];
+    const size_t count = implementations(fn);
+    uint8_t chars[300];
+    memset(chars, 'a', sizeof(chars));
+    for (size_t i = 0; i < count; i++) {
+        for (size_t size = 1; size <= sizeof(chars); size++) {
+            size_t out;
+            uintmax_t c;
+            assert_int_equal(fn[i](i, chars, size, &out, &c), 0);
+            assert_int_equal(out, size);
+            assert_int_equal(c, size);
+        }
+    }
+}
+
+static void check_validate_stops_at_null(void **state) {
+    validate_fn fn[5];
+    const size_t count = implementations(fn);
+    const char chars[] = u8"$£ह€한🐉$£ह€한🐉$£ह€한🐉$£ह€한🐉$£ह€한🐉";
+    for (size_t i = 0; i < count; i++) {
+        size_t out;
+        uintmax_t c;
+        assert_int_equal(fn[i](i, (const uint8_t *) chars, SIZE_MAX, &out, &c),
+                         0);
+        assert_int_equal(out, sizeof(chars) - 1);
+        assert_int_equal(c, 30);
+        assert_int_equal(fn[i](i, (const uint8_t *) chars, sizeof(chars),
+                               &out, NULL), 0);
+        assert_int_equal(out, sizeof(chars) - 1);
+    }
+}
+
+static void check_validate_error_on_malformed(void **state) {
+    validate_fn fn[5];
+    const size_t count = implementations(fn);
+    const char *malformed[] = {
+            "\x80", "\xBF", "\xC0\x80", "\xC1\xBF", "\xC2", "\xC2\x41",
+            "\xE0\x80\x80", "\xE0\x9F\xBF", "\xE2\x82", "\xED\xA0\x80",
+            "\xED\xBF\xBF", "\xF0\x80\x80\x80", "\xF0\x8F\xBF\xBF",
+            "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xF8\x88\x80\x80\x80",
+            "\xFF", "\xE2\x82\xAC\xAC", "\xF0\x9F\x90", "\xC3\xA9\xA9",
+    };
+    uint8_t chars[160];
+    for (size_t i = 0; i < count; i++) {
+        for (size_t o = 0; o < sizeof(malformed) / sizeof(malformed[0]);
+             o++) {
+            const size_t length = strlen(malformed[o]);
+            for (size_t at = 0; at < 96; at++) {
+                /* malformed sequence followed by more ASCII */
+                memset(chars, 'z', sizeof(chars));
+                memcpy(chars + at, malformed[o], length);
+                size_t out;
+                assert_int_equal(
+                        fn[i](i, chars, sizeof(chars), &out, NULL),
+                        SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_MALFORMED);
+                /* malformed sequence terminated by size */
+                assert_int_equal(
+                        fn[i](i, chars, at + length, &out, NULL),
+                        SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_MALFORMED);
+                /* malformed sequence terminated by NULL */
+                chars[at + length] = 0;
+                assert_int_equal(
+                        fn[i](i, chars, sizeof(chars), &out, NULL),
+                        SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_MALFORMED);
+            }
+        }
+    }
+}
+
+static void check_validate_error_on_truncated(void **state) {
+    validate_fn fn[5];
+    const size_t count = implementations(fn);
+    const char symbol[] = u8"🐢";
+    uint8_t chars[160];
+    for (size_t i = 0; i < count; i++) {
+        for (size_t at = 0; at < 96; at++) {
+            for (size_t length = 1; length < 4; length++) {
+                memset(chars, 'z', sizeof(chars));
+                memcpy(chars + at, symbol, length);
+                size_t out;
+                assert_int_equal(
+                        fn[i](i, chars, at + length, &out, NULL),
+                        SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_MALFORMED);
+                chars[at + length] = 0;
+                assert_int_equal(
+                        fn[i](i, chars, sizeof(chars), &out, NULL),
+                        SEA_TURTLE_STRING_ERROR_CHAR_PTR_IS_MALFORMED);
+            }
+            memcpy(chars + at, symbol, 4);
+            size_t out;
+            uintmax_t c;
+            assert_int_equal(fn[i](i, chars, at + 4, &out, &c), 0);
+            assert_int_equal(out, at + 4);
+            assert_int_equal(c, at + 1);
+        }
+    }
+}
+
+static void check_validate_matches_scalar(void **state) {
+    validate_fn fn[5];
+    const size_t count = implementations(fn);
+    const char *pieces[] = {
+            "a", "Z", " ", u8"£", u8"ह", u8"€", u8"한", u8"🐉", u8"\U0010FFFF",
+            "\xC0", "\x80", "\xED\xA0", "\xF4\x90", "\xE0", "\xF0", "",
+    };
+    const size_t length = sizeof(pieces) / sizeof(pieces[0]);
+    uint8_t chars[512];
+    uint32_t seed = 42;
+    for (size_t round = 0; round < 4000; round++) {
+        size_t size = 0;
+        const size_t limit = (seed = seed * 1103515245 + 12345) % 400;
+        while (size < limit) {
+            seed = seed * 1103515245 + 12345;
+            /* mostly valid pieces so that long valid runs are produced */
+            size_t which = (seed >> 16) % length;
+            if (which > 8 && (seed >> 8) % 16) {
+                which %= 9;
+            }
+            const char *piece = pieces[which];
+            const size_t n = which == length - 1 ? 1 : strlen(piece);
+            memcpy(chars + size, piece, n);
+            size += n;
+        }
+        if (!size) {
+            continue;
+        }
+        size_t expected_out;
+        uintmax_t expected_count;
+        const int expected = kernel(1, chars, size, &expected_out,
+                                    &expected_count);
+        for (size_t i = 0; i < count; i++) {
+            size_t out;
+            uintmax_t c;
+            assert_int_equal(fn[i](i, chars, size, &out, &c), expected);
+            if (!expected) {
+                assert_int_equal(out, expected_out);
+                assert_int_equal(c, expected_count);
+            }
+        }
+    }
+}
+
+static void check_incomplete(void **state) {
+    const char chars[] = u8"ab🐢";
+    /* every proper prefix of the last symbol is held back */
+    for (size_t i = 0; i < 4; i++) {
+        assert_int_equal(sea_turtle_utf8_incomplete((const uint8_t *) chars,
+                                                    2 + i), i);
+    }
+    assert_int_equal(sea_turtle_utf8_incomplete((const uint8_t *) chars, 6),
+                     0);
+    /* prefixes which can never complete are not */
+    assert_int_equal(sea_turtle_utf8_incomplete(
+            (const uint8_t *) "a\xE0\x80", 3), 0);
+    assert_int_equal(sea_turtle_utf8_incomplete(
+            (const uint8_t *) "a\xF5", 2), 0);
+    assert_int_equal(sea_turtle_utf8_incomplete(
+            (const uint8_t *) "\x80\x80\x80", 3), 0);
+}
+
+typedef const uint8_t *(*decode_fn)(const uint8_t *, const uint8_t *,
+                                    size_t, uint32_t *);
+typedef uint8_t *(*encode_fn)(const uint32_t *, size_t, uint8_t *);
+
+static size_t transcoders(decode_fn decode[4], encode_fn encode[4]) {
+    size_t i = 0;
+    decode[i] = sea_turtle_utf8_decode;
+    encode[i++] = sea_turtle_utf8_encode;
+    decode[i] = sea_turtle_utf8_decode_scalar;
+    encode[i++] = sea_turtle_utf8_encode_scalar;
+#if defined(SEA_TURTLE_UTF8_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.2")) {
+        decode[i] = sea_turtle_utf8_decode_sse42;
+        encode[i++] = sea_turtle_utf8_encode_sse42;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        decode[i] = sea_turtle_utf8_decode_avx2;
+        encode[i++] = sea_turtle_utf8_encode_avx2;
+    }
+#endif
+    return i;
+}
+
+static void check_encoded_size_error_on_code_point_is_invalid(void **state) {
+    const uint32_t invalid[] = {0, 0xD800, 0xDFFF, 0x110000, UINT32_MAX};
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        const uint32_t code_points[] = {'a', invalid[i], 'b'};
+        size_t out;
+        assert_int_equal(sea_turtle_utf8_encoded_size(code_points, 3, &out),
+                         SEA_TURTLE_STRING_ERROR_CODE_POINT_IS_INVALID);
+    }
+}
+
+static void check_encoded_size(void **state) {
+    const uint32_t code_points[] = {
+            0x24, 0x7F, 0x80, 0xA3, 0x7FF, 0x800, 0x939, 0xD7FF, 0xE000,
+            0xFFFF, 0x10000, 0x1F409, 0x10FFFF
+    };
+    size_t out;
+    assert_int_equal(sea_turtle_utf8_encoded_size(code_points, 13, &out), 0);
+    assert_int_equal(out, 2 + 3 * 2 + 5 * 3 + 3 * 4);
+    assert_int_equal(sea_turtle_utf8_encoded_size(code_points, 0, &out), 0);
+    assert_int_equal(out, 0);
+}
+
+static void check_transcode_matches_scalar(void **state) {
+    decode_fn decode[4];
+    encode_fn encode[4];
+    const size_t count = transcoders(decode, encode);
+    const uint32_t pieces[] = {'a', 'Z', ' ', 0xA3, 0x939, 0x20AC, 0xD55C,
+                               0x1F409, 0x10FFFF};
+    const size_t length = sizeof(pieces) / sizeof(pieces[0]);
+    uint32_t code_points[300];
+    uint8_t bytes[4 * 300];
+    uint32_t seed = 42;
+    for (size_t round = 0; round < 2000; round++) {
+        const size_t n = (seed = seed * 1103515245 + 12345) % 300;
+        for (size_t i = 0; i < n; i++) {
+            seed = seed * 1103515245 + 12345;
+            /* mostly ASCII so that long ASCII runs are produced */
+            size_t which = (seed >> 16) % length;
+            if (which > 2 && (seed >> 8) % 8) {
+                which %= 3;
+            }
+            code_points[i] = pieces[which];
+        }
+        size_t size;
+        assert_int_equal(sea_turtle_utf8_encoded_size(code_points, n,
+                                                      &size), 0);
+        for (size_t i = 0; i < count; i++) {
+            memset(bytes, 0, sizeof(bytes));
+            assert_ptr_equal(encode[i](code_points, n, bytes), bytes + size);
+            uint8_t expected[4 * 300];
+            assert_ptr_equal(sea_turtle_utf8_encode_scalar(code_points, n,
+                                                           expected),
+                             expected + size);
+            assert_memory_equal(bytes, expected, size);
+            uintmax_t c;
+            assert_int_equal(sea_turtle_utf8_validate_scalar(bytes, size,
+                                                             &c), 0);
+            assert_int_equal(c, n);
+            uint32_t out[300];
+            /* decoding never reads past the end */
+            assert_ptr_equal(decode[i](bytes, bytes + size, n, out),
+                             bytes + size);
+            assert_memory_equal(out, code_points, n * sizeof(*out));
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(check_validate_ascii),
+            cmocka_unit_test(check_validate_stops_at_null),
+            cmocka_unit_test(check_validate_error_on_malformed),
+            cmocka_unit_test(check_validate_error_on_truncated),
+            cmocka_unit_test(check_validate_matches_scalar),
+            cmocka_unit_test(check_incomplete),
+            cmocka_unit_test(
+                    check_encoded_size_error_on_code_point_is_invalid),
+            cmocka_unit_test(check_encoded_size),
+            cmocka_unit_test(check_transcode_matches_scalar),
+    };
+    //cmocka_set_message_output(CM_OUTPUT_XML);
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}